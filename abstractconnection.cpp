@@ -25,13 +25,78 @@
 ****************************************************************************/
 
 #include "abstractconnection_p.h"
+#include "flaptracer.h"
 #include <QHostInfo>
 #include <QBuffer>
 #include <QCoreApplication>
 #include <QNetworkProxy>
+#include <QThread>
+#include <QThreadStorage>
+#include <QTimerEvent>
+#if defined(Q_OS_LINUX)
+# include <sys/socket.h>
+# include <netinet/in.h>
+# include <netinet/tcp.h>
+#endif
 
 namespace Ireen {
 
+// Granularity of the keepalives and read timeouts
+const int livenessTickInterval = 5000;
+
+static QThreadStorage<LivenessTicker*> livenessTickers;
+
+// The ticker of the main thread would be freed only during the static
+// destruction, after the application it has its timer in is gone
+static void cleanupLivenessTicker()
+{
+	livenessTickers.setLocalData(0);
+}
+
+LivenessTicker *LivenessTicker::instance()
+{
+	if (!livenessTickers.hasLocalData()) {
+		livenessTickers.setLocalData(new LivenessTicker);
+		QCoreApplication *app = QCoreApplication::instance();
+		if (app && app->thread() == QThread::currentThread())
+			qAddPostRoutine(cleanupLivenessTicker);
+	}
+	return livenessTickers.localData();
+}
+
+LivenessTicker *LivenessTicker::current()
+{
+	return livenessTickers.hasLocalData() ? livenessTickers.localData() : 0;
+}
+
+void LivenessTicker::add(AbstractConnection *conn)
+{
+	m_connections.insert(conn);
+	if (!m_timer.isActive())
+		m_timer.start(livenessTickInterval, this);
+}
+
+void LivenessTicker::remove(AbstractConnection *conn)
+{
+	m_connections.remove(conn);
+	if (m_connections.isEmpty())
+		m_timer.stop();
+}
+
+void LivenessTicker::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_timer.timerId()) {
+		QObject::timerEvent(event);
+		return;
+	}
+	// The connections may be closed during the check
+	QList<AbstractConnection*> connections = m_connections.toList();
+	foreach (AbstractConnection *conn, connections) {
+		if (m_connections.contains(conn))
+			conn->checkLiveness();
+	}
+}
+
 ProtocolError::ProtocolError(const SNAC &snac)
 {
 	m_code = snac.read<qint16>();
@@ -99,10 +164,9 @@ QString ProtocolError::errorString()
 	}
 }
 
-ConnectionRate::ConnectionRate(const SNAC &sn, AbstractConnection *conn) :
-	m_conn(conn)
+ConnectionRate::ConnectionRate(quint16 groupId, const SNAC &sn, AbstractConnection *conn) :
+	m_groupId(groupId), m_conn(conn)
 {
-	m_groupId = sn.read<quint16>();
 	update(sn);
 }
 
@@ -140,6 +204,15 @@ void ConnectionRate::send(const SNAC &snac, bool priority)
 	}
 }
 
+void ConnectionRate::takeQueued(QQueue<SNAC> &highPriority, QQueue<SNAC> &lowPriority)
+{
+	m_timer.stop();
+	highPriority += m_highPriorityQueue;
+	lowPriority += m_lowPriorityQueue;
+	m_highPriorityQueue.clear();
+	m_lowPriorityQueue.clear();
+}
+
 bool ConnectionRate::testRate(bool priority)
 {
 	quint32 timeDiff = getTimeDiff(QDateTime::currentDateTime());
@@ -192,8 +265,11 @@ quint32 ConnectionRate::getTimeDiff(const QDateTime &dateTime)
 
 void AbstractConnectionPrivate::init(AbstractConnection *q)
 {
-	aliveTimer.setInterval(180000);
-	q->connect(&aliveTimer, SIGNAL(timeout()), SLOT(sendAlivePacket()));
+	keepAliveInterval = 180000;
+	readIdleTimeout = 0;
+	probeSent = false;
+	tcpKeepAlive = false;
+	tcpUserTimeout = 0;
 	socket = new Socket(q);
 #if IREEN_SSL_SUPPORT
 	socket->setProtocol(QSsl::TlsV1);
@@ -213,6 +289,13 @@ void AbstractConnectionPrivate::init(AbstractConnection *q)
 	}
 	id = (quint32) qrand();
 	error = AbstractConnection::NoError;
+	state = AbstractConnection::Unconnected;
+	tracer = 0;
+	traceId = 0;
+	pipelinedStartup = false;
+	rateInfoRequested = false;
+	servicesStarted = false;
+	replayingRateInfo = false;
 	q->m_infos << SNACInfo(ServiceFamily, ServiceServerReady)
 			<< SNACInfo(ServiceFamily, ServiceServerNameInfo)
 			<< SNACInfo(ServiceFamily, ServiceServerFamilies2)
@@ -234,9 +317,30 @@ AbstractConnection::AbstractConnection(QObject *parent) :
 	d_func()->init(this);
 }
 
+void AbstractConnectionPrivate::applySocketOptions()
+{
+	if (!tcpKeepAlive)
+		return;
+	socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+#if defined(Q_OS_LINUX) && defined(TCP_USER_TIMEOUT)
+	int fd = socket->socketDescriptor();
+	if (tcpUserTimeout > 0 && fd != -1) {
+		unsigned int timeout = tcpUserTimeout;
+		if (setsockopt(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &timeout, sizeof(timeout)) != 0)
+			debug(ConnectionDebug) << "Cannot set TCP_USER_TIMEOUT for the socket";
+	}
+#endif
+}
+
 AbstractConnection::~AbstractConnection()
 {
 	Q_D(AbstractConnection);
+	if (d->state == Connected) {
+		if (LivenessTicker *ticker = LivenessTicker::current())
+			ticker->remove(this);
+	}
+	if (d->tracer)
+		d->tracer->unregisterConnection(d->traceId);
 	foreach(const ConnectionRate *rate, d->rates)
 		delete rate;
 }
@@ -296,7 +400,7 @@ void AbstractConnection::setProxy(const QNetworkProxy &oldProxy)
 {
 	QNetworkProxy proxy = oldProxy;
 	proxy.setCapabilities(proxy.capabilities() &=~ QNetworkProxy::HostNameLookupCapability);
-	debug() << Q_FUNC_INFO << proxy.type() << proxy.hostName() << proxy.port() << proxy.capabilities();
+	debug(ConnectionDebug) << Q_FUNC_INFO << proxy.type() << proxy.hostName() << proxy.port() << proxy.capabilities();
 	d_func()->socket->setProxy(proxy);
 	emit proxyUpdated(proxy);
 }
@@ -412,6 +516,68 @@ AbstractConnection::AbstractConnection(AbstractConnectionPrivate *d, QObject *pa
 	d->init(this);
 }
 
+void AbstractConnection::setTracer(FlapTracer *tracer)
+{
+	Q_D(AbstractConnection);
+	if (d->tracer)
+		d->tracer->unregisterConnection(d->traceId);
+	d->tracer = tracer;
+	d->traceId = tracer ? tracer->registerConnection(this) : 0;
+}
+
+void AbstractConnection::setPipelinedStartup(bool enabled)
+{
+	d_func()->pipelinedStartup = enabled;
+}
+
+bool AbstractConnection::isPipelinedStartup() const
+{
+	return d_func()->pipelinedStartup;
+}
+
+void AbstractConnection::setKeepAliveInterval(int msec)
+{
+	d_func()->keepAliveInterval = qMax(msec, 0);
+}
+
+int AbstractConnection::keepAliveInterval() const
+{
+	return d_func()->keepAliveInterval;
+}
+
+void AbstractConnection::setReadIdleTimeout(int msec)
+{
+	d_func()->readIdleTimeout = qMax(msec, 0);
+}
+
+int AbstractConnection::readIdleTimeout() const
+{
+	return d_func()->readIdleTimeout;
+}
+
+void AbstractConnection::setTcpKeepAlive(bool enabled, int userTimeoutMsec)
+{
+	Q_D(AbstractConnection);
+	d->tcpKeepAlive = enabled;
+	d->tcpUserTimeout = enabled ? userTimeoutMsec : 0;
+	if (d->socket->state() == QAbstractSocket::ConnectedState) {
+		if (enabled)
+			d->applySocketOptions();
+		else
+			d->socket->setSocketOption(QAbstractSocket::KeepAliveOption, 0);
+	}
+}
+
+bool AbstractConnection::isTcpKeepAliveEnabled() const
+{
+	return d_func()->tcpKeepAlive;
+}
+
+FlapTracer *AbstractConnection::tracer() const
+{
+	return d_func()->tracer;
+}
+
 const FLAP &AbstractConnection::flap()
 {
 	return d_func()->flap;
@@ -440,21 +606,27 @@ void AbstractConnection::send(FLAP &flap)
 {
 	Q_D(AbstractConnection);
 	flap.setSeqNum(d->seqNum());
-	//debug(VeryVerbose) << "FLAP:" << flap.toByteArray().toHex().constData();
+	if (d->tracer)
+		d->tracer->trace(d->traceId, FlapTracer::OutgoingRecord, flap);
 	d->socket->write(flap);
+	d->lastWrite.start();
 	//d->socket->flush();
 }
 
 bool AbstractConnection::testRate(quint16 family, quint16 subtype, bool priority)
 {
-	ConnectionRate *rate = d_func()->ratesHash.value(family << 16 | subtype);
+	Q_D(AbstractConnection);
+	ConnectionRate *rate = d->ratesHash.value(family << 16 | subtype);
+	if (!rate)
+		// The same fallback as in send()
+		rate = d->rates.value(1);
 	return rate ? rate->testRate(priority) : true;
 }
 
 quint32 AbstractConnection::sendSnac(SNAC &snac)
 {
 	Q_D(AbstractConnection);
-	QString dbgStr;
+	const char *dbgStr;
 	quint32 id = 0;
 	// Not allow any snacs in unconnected state
 	if (d->state == Unconnected) {
@@ -473,7 +645,7 @@ quint32 AbstractConnection::sendSnac(SNAC &snac)
 		snac.lock();
 		send(flap);
 	}
-	debug(DebugVerbose) << dbgStr
+	debug(ConnectionDebug, DebugVerbose) << QString(dbgStr)
 					  .arg(snac.family(), 4, 16, QChar('0'))
 					  .arg(snac.subtype(), 4, 16, QChar('0'))
 					  .arg(metaObject()->className());
@@ -487,17 +659,20 @@ void AbstractConnection::setSeqNum(quint16 seqnum)
 
 void AbstractConnection::processNewConnection()
 {
-	debug(DebugVerbose) << QString("processNewConnection: %1 %2 %3")
+	Q_D(AbstractConnection);
+	debug(ConnectionDebug, DebugVerbose) << QString("processNewConnection: %1 %2 %3")
 					  .arg(flap().channel(), 2, 16, QChar('0'))
 					  .arg(flap().seqNum())
 					  .arg(flap().data().toHex().constData());
+	d->rateInfoRequested = false;
+	d->servicesStarted = false;
 	setState(Connecting);
 }
 
 void AbstractConnection::processCloseConnection()
 {
 	Q_D(AbstractConnection);
-	debug(DebugVerbose) << QString("processCloseConnection: %1 %2 %3")
+	debug(ConnectionDebug, DebugVerbose) << QString("processCloseConnection: %1 %2 %3")
 					  .arg(d->flap.channel(), 2, 16, QChar('0'))
 					  .arg(d->flap.seqNum())
 					  .arg(d->flap.data().toHex().constData());
@@ -510,7 +685,6 @@ void AbstractConnection::processCloseConnection()
 void AbstractConnection::onDisconnect()
 {
 	setState(Unconnected);
-	d_func()->aliveTimer.stop();
 	emit disconnected();
 }
 
@@ -539,9 +713,12 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 	switch ((sn.family() << 16) | sn.subtype()) {
 	// Server sends supported services list
 	case ServiceFamily << 16 | ServiceServerReady: {
-		QList<quint16> &services = d->services;
-		while (sn.dataSize() != 0)
+		QList<quint16> services;
+		while (sn.dataSize() != 0 && !sn.hasError())
 			services << sn.read<quint16>();
+		// The same services are served with the same rate classes as in the last session
+		bool sameServices = !d->rateInfo.isEmpty() && services == d->services;
+		d->services = services;
 		SNAC snac(ServiceFamily, ServiceClientFamilies);
 		// Sending the same as ICQ 6
 		snac.append<quint32>(0x00220001);
@@ -556,6 +733,20 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		snac.append<quint32>(0x000a0001);
 		snac.append<quint32>(0x000b0001);
 		send(snac);
+		if (d->pipelinedStartup) {
+			// The versions reply changes nothing in the rates request
+			d->rateInfoRequested = true;
+			sendSnac(ServiceFamily, ServiceClientReqRateInfo);
+			if (sameServices) {
+				debug(ConnectionDebug, DebugVerbose) << "Starting the services with the rate classes of the last session";
+				SNAC rates(ServiceFamily, ServiceServerAsksServices);
+				rates.setData(d->rateInfo);
+				d->servicesStarted = true;
+				d->replayingRateInfo = true;
+				dispatchSnac(rates);
+				d->replayingRateInfo = false;
+			}
+		}
 		break;
 	}
 		// This is the reply to CLI_REQINFO
@@ -577,30 +768,40 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		quint32 ip = tlvs.value(0x0a).read<quint32>();
 		d->ext_ip = QHostAddress(ip);
 
-		//debug() << conn->externalIP();
+		//debug(ConnectionDebug) << conn->externalIP();
 		break;
 	}
 		// Server sends its services version numbers
 	case ServiceFamily << 16 | ServiceServerFamilies2: {
+		if (d->rateInfoRequested)
+			break;
 		SNAC snac(ServiceFamily, ServiceClientReqRateInfo);
 		send(snac);
 		break;
 	}
 		// Server sends rate limits information
 	case ServiceFamily << 16 | ServiceServerAsksServices: {
-		foreach(const ConnectionRate *rate, d->rates)
-			delete rate;
+		// The existing classes are updated in place, so the snacs queued in them
+		// (e.g. with the rates replayed by the pipelined startup) are kept
+		QHash<quint16, ConnectionRate*> oldRates = d->rates;
 		d->rates.clear();
 		d->ratesHash.clear();
 
 		// Rate classes
 		quint16 groupCount = sn.read<quint16>();
 		for (int i = 0; i < groupCount; ++i) {
-			ConnectionRate *rate = new ConnectionRate(sn, this);
-			if (rate->isEmpty())
+			quint16 groupId = sn.read<quint16>();
+			ConnectionRate *rate = oldRates.take(groupId);
+			if (rate)
+				rate->update(sn);
+			else
+				rate = new ConnectionRate(groupId, sn, this);
+			if (rate->isEmpty() || rate->groupId() != 1) {
+				// the first rate class will be used by default anyway
+				oldRates.insert(groupId, rate);
 				continue;
-			if (rate->groupId() == 1) // the first rate class will be used by default anyway
-				d->rates.insert(rate->groupId(), rate);
+			}
+			d->rates.insert(rate->groupId(), rate);
 		}
 		// Rate groups
 		while (sn.dataSize() >= 4) {
@@ -616,6 +817,22 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 				d->ratesHash.insert(snacType, *rateItr);
 			}
 		}
+		// The snacs of the dropped classes go through the new ones
+		QQueue<SNAC> highPriority;
+		QQueue<SNAC> lowPriority;
+		foreach (ConnectionRate *rate, oldRates) {
+			rate->takeQueued(highPriority, lowPriority);
+			delete rate;
+		}
+		foreach (SNAC snac, highPriority)
+			send(snac, true);
+		foreach (SNAC snac, lowPriority)
+			send(snac, false);
+
+		// The rates of the last session are only used until the server sends the actual ones
+		if (d->replayingRateInfo)
+			break;
+		d->rateInfo = sn.data();
 
 		// Accepting rates
 		SNAC snac(ServiceFamily, ServiceClientRateAck);
@@ -628,11 +845,11 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		sn.read<QByteArray, quint16>(); // Unknown
 		quint16 code = sn.read<quint16>();
 		if (code == 2)
-			debug() << "Rate limits warning";
+			debug(ConnectionDebug) << "Rate limits warning";
 		if (code == 3)
-			debug() << "Rate limits hit";
+			debug(ConnectionDebug) << "Rate limits hit";
 		if (code == 4)
-			debug() << "Rate limits clear";
+			debug(ConnectionDebug) << "Rate limits clear";
 		quint32 groupId = sn.read<quint16>();
 		if (d->rates.contains(groupId))
 			d->rates.value(groupId)->update(sn);
@@ -640,7 +857,7 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 	}
 	case ServiceFamily << 16 | ServiceError: {
 		ProtocolError error(sn);
-		debug() << QString("Error (%1, %2): %3")
+		debug(ConnectionDebug) << QString("Error (%1, %2): %3")
 				   .arg(error.code(), 2, 16)
 				   .arg(error.subcode(), 2, 16)
 				   .arg(error.errorString());
@@ -652,9 +869,18 @@ void AbstractConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 void AbstractConnection::setState(AbstractConnection::State state)
 {
 	Q_D(AbstractConnection);
+	if (state == d->state)
+		return;
+	if (state == Connected) {
+		d->lastWrite.start();
+		d->lastRead.start();
+		d->probeSent = false;
+		LivenessTicker::instance()->add(this);
+	} else if (d->state == Connected) {
+		if (LivenessTicker *ticker = LivenessTicker::current())
+			ticker->remove(this);
+	}
 	d->state = state;
-	if (state == Connected)
-		d->aliveTimer.start();
 }
 
 quint16 AbstractConnection::generateFlapSequence()
@@ -668,18 +894,33 @@ void AbstractConnection::processSnac()
 {
 	Q_D(AbstractConnection);
 	SNAC snac = SNAC::fromByteArray(d->flap.data());
-	debug(DebugVerbose) << QString("SNAC(0x%1, 0x%2) is received from %3")
+	debug(ConnectionDebug, DebugVerbose) << QString("SNAC(0x%1, 0x%2) is received from %3")
 					  .arg(snac.family(), 4, 16, QChar('0'))
 					  .arg(snac.subtype(), 4, 16, QChar('0'))
 					  .arg(metaObject()->className());
+	if (d->servicesStarted && snac.family() == ServiceFamily && snac.subtype() == ServiceServerAsksServices) {
+		// The handlers have been already started by the pipelined startup,
+		// only the rates have to be updated and accepted
+		d->servicesStarted = false;
+		AbstractConnection::handleSNAC(this, snac);
+		return;
+	}
+	dispatchSnac(snac);
+}
+
+void AbstractConnection::dispatchSnac(SNAC &snac)
+{
+	Q_D(AbstractConnection);
 	bool found = false;
 	foreach(SNACHandler *handler, d->handlers.values((snac.family() << 16)| snac.subtype())) {
 		found = true;
 		snac.resetState();
+		// The handlers check the error flag of the SNAC themselves, as some
+		// of them read the optional fields past the end on purpose
 		handler->handleSNAC(this, snac);
 	}
 	if (!found) {
-		warning() << QString("No handlers for SNAC(0x%1, 0x%2) in %3")
+		warning(ConnectionDebug) << QString("No handlers for SNAC(0x%1, 0x%2) in %3")
 					 .arg(snac.family(), 4, 16, QChar('0'))
 					 .arg(snac.subtype(), 4, 16, QChar('0'))
 					 .arg(metaObject()->className());
@@ -690,44 +931,56 @@ void AbstractConnection::readData()
 {
 	Q_D(AbstractConnection);
 	if (d->socket->bytesAvailable() <= 0) {
-		debug() << "readyRead emmited but the socket is empty";
+		debug(ConnectionDebug) << "readyRead emmited but the socket is empty";
 		return;
 	}
+	d->lastRead.start();
+	d->probeSent = false;
 	if (d->flap.readData(d->socket)) {
 		if (d->flap.isFinished()) {
-			switch (d->flap.channel()) {
-			case 0x01:
-				processNewConnection();
-				break;
-			case 0x02:
-				processSnac();
-				break;
-			case 0x04:
-				processCloseConnection();
-				break;
-			default:
-				debug() << "Unknown shac channel" << hex << d->flap.channel();
-			case 0x03:
-				break;
-			case 0x05:
-				debug() << "Connection alive!";
-				break;
-			}
+			if (d->tracer)
+				d->tracer->trace(d->traceId, FlapTracer::IncomingRecord, d->flap);
+			processFlap();
 			d->flap.clear();
 		}
 		// Just give a chance to other parts of qutIM to do something if needed
 		if (d->socket->bytesAvailable())
 			QTimer::singleShot(0, this, SLOT(readData()));
 	} else {
-		critical() << "Strange situation at" << Q_FUNC_INFO << ":" << __LINE__;
+		critical(ConnectionDebug) << "Strange situation at" << Q_FUNC_INFO << ":" << __LINE__;
 		d->socket->close();
 	}
 }
 
+void AbstractConnection::processFlap()
+{
+	Q_D(AbstractConnection);
+	switch (d->flap.channel()) {
+	case 0x01:
+		processNewConnection();
+		break;
+	case 0x02:
+		processSnac();
+		break;
+	case 0x04:
+		processCloseConnection();
+		break;
+	default:
+		debug(ConnectionDebug) << "Unknown shac channel" << hex << d->flap.channel();
+	case 0x03:
+		break;
+	case 0x05:
+		debug(ConnectionDebug) << "Connection alive!";
+		break;
+	}
+}
+
 void AbstractConnection::stateChanged(QAbstractSocket::SocketState state)
 {
-	debug(DebugVerbose) << "New connection state" << state << this->metaObject()->className();
-	if (state == QAbstractSocket::UnconnectedState)
+	debug(ConnectionDebug, DebugVerbose) << "New connection state" << state << this->metaObject()->className();
+	if (state == QAbstractSocket::ConnectedState)
+		d_func()->applySocketOptions();
+	else if (state == QAbstractSocket::UnconnectedState)
 		onDisconnect();
 }
 
@@ -741,7 +994,28 @@ void AbstractConnection::error(QAbstractSocket::SocketError error)
 	}
 #endif
 	setError(SocketError, str);
-	debug() << "Connection error:" << error << errorString();
+	debug(ConnectionDebug) << "Connection error:" << error << errorString();
+}
+
+void AbstractConnection::checkLiveness()
+{
+	Q_D(AbstractConnection);
+	if (d->readIdleTimeout > 0) {
+		int idle = d->lastRead.elapsed();
+		if (idle >= d->readIdleTimeout) {
+			warning(ConnectionDebug) << "Nothing has been received for" << idle
+									 << "msec, closing the connection" << metaObject()->className();
+			setError(SocketError, tr("The server does not respond"));
+			return;
+		}
+		if (idle >= d->readIdleTimeout / 2 && !d->probeSent) {
+			// The server does not answer on keepalives, so ask it for something
+			d->probeSent = true;
+			sendSnac(ServiceFamily, ServiceClientReqinfo);
+		}
+	}
+	if (d->keepAliveInterval > 0 && d->lastWrite.elapsed() >= d->keepAliveInterval)
+		sendAlivePacket();
 }
 
 void AbstractConnection::sendAlivePacket()
@@ -749,7 +1023,7 @@ void AbstractConnection::sendAlivePacket()
 	FLAP flap(0x05);
 	flap.append<quint16>(0);
 	send(flap);
-	debug() << "Alive packet has been sent";
+	debug(ConnectionDebug) << "Alive packet has been sent";
 }
 
 } // namespace Ireen
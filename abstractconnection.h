@@ -42,6 +42,7 @@ namespace Ireen {
 
 class ConnectionRate;
 class AbstractConnectionPrivate;
+class FlapTracer;
 
 struct IREEN_EXPORT ProtocolError
 {
@@ -162,6 +163,26 @@ public:
 	State state() const;
 	void registerInitializationSnacs(const QList<SNACInfo> &snacs, bool append = true);
 	void registerInitializationSnac(quint16 family, quint16 subtype);
+	// Traces all FLAPs of the connection, the tracer is not owned by the connection
+	// and must outlive it
+	void setTracer(FlapTracer *tracer);
+	FlapTracer *tracer() const;
+	// Sends the rates request together with the families one and, when the server
+	// offers the same services as in the last session, starts the services with
+	// the rates of that session without waiting for the actual ones.
+	// Only the snacs registered as initialization ones are sent before the login is finished.
+	void setPipelinedStartup(bool enabled);
+	bool isPipelinedStartup() const;
+	// The keepalive is sent only when nothing has been sent for msec, 0 disables it
+	void setKeepAliveInterval(int msec);
+	int keepAliveInterval() const;
+	// The connection is considered dead and closed with SocketError when nothing
+	// has been received for msec, 0 disables the check. The precision is 5 seconds.
+	void setReadIdleTimeout(int msec);
+	int readIdleTimeout() const;
+	// Enables SO_KEEPALIVE and, where it is supported, TCP_USER_TIMEOUT for the socket
+	void setTcpKeepAlive(bool enabled, int userTimeoutMsec = 0);
+	bool isTcpKeepAliveEnabled() const;
 public slots:
 	void setProxy(const QNetworkProxy &proxy);
 signals:
@@ -188,8 +209,14 @@ private slots:
 	void stateChanged(QAbstractSocket::SocketState);
 	void error(QAbstractSocket::SocketError);
 	void sendAlivePacket();
+private:
+	void processFlap();
+	void dispatchSnac(SNAC &snac);
+	void checkLiveness();
 protected:
 	friend class ConnectionRate;
+	friend class LivenessTicker;
+	friend class FlapTracer;
 	QScopedPointer<AbstractConnectionPrivate> d_ptr;
 };
 
@@ -32,6 +32,7 @@
 #include <QTimer>
 #include <QDateTime>
 #include <QQueue>
+#include <QSet>
 
 namespace Ireen {
 
@@ -41,11 +42,13 @@ class ConnectionRate: public QObject
 {
 	Q_OBJECT
 public:
-	ConnectionRate(const SNAC &sn, AbstractConnection *conn);
+	ConnectionRate(quint16 groupId, const SNAC &sn, AbstractConnection *conn);
 	virtual ~ConnectionRate() {}
 	void update(const SNAC &sn);
 	quint16 groupId() { return m_groupId; }
 	void send(const SNAC &snac, bool priority);
+	// Moves the snacs waiting in the queues to the end of the given ones
+	void takeQueued(QQueue<SNAC> &highPriority, QQueue<SNAC> &lowPriority);
 	bool isEmpty() { return m_windowSize <= 1; }
 	bool testRate(bool priority);
 	bool startTimeout();
@@ -75,6 +78,23 @@ private:
 	AbstractConnection *m_conn;
 };
 
+// Checks the liveness of all connections of the thread on a single timer,
+// so their keepalives and timeouts are aligned to its ticks
+class LivenessTicker : public QObject
+{
+public:
+	static LivenessTicker *instance();
+	// Does not create the ticker, returns 0 if the thread has none
+	static LivenessTicker *current();
+	void add(AbstractConnection *conn);
+	void remove(AbstractConnection *conn);
+protected:
+	void timerEvent(QTimerEvent *event);
+private:
+	QSet<AbstractConnection*> m_connections;
+	QBasicTimer m_timer;
+};
+
 class AbstractConnectionPrivate
 {
 public:
@@ -94,10 +114,29 @@ public:
 	QString errorStr;
 	AbstractConnection::State state;
 	QSet<SNACInfo> initSnacs; // Snacs that are allowed when initializing connection
-	QTimer aliveTimer;
+	// Keepalives are sent only after keepAliveInterval msecs without outgoing data
+	int keepAliveInterval;
+	// The connection is closed after readIdleTimeout msecs without incoming data,
+	// a request is sent at the half of the timeout to make the server answer
+	int readIdleTimeout;
+	bool probeSent;
+	QTime lastWrite;
+	QTime lastRead;
+	bool tcpKeepAlive;
+	int tcpUserTimeout;
+	FlapTracer *tracer;
+	quint16 traceId;
+	bool pipelinedStartup;
+	bool rateInfoRequested;
+	// The services have been started with the rates of the last session
+	bool servicesStarted;
+	bool replayingRateInfo;
+	// The rate classes reply of the last session
+	QByteArray rateInfo;
 private:
 	friend class AbstractConnection;
 	void init(AbstractConnection *q);
+	void applySocketOptions();
 };
 
 } // namespace Ireen
@@ -30,6 +30,8 @@
 #include "abstractconnection_p.h"
 #include "roster.h"
 #include <QSet>
+#include <QTime>
+#include <QTimerEvent>
 #include <QDir>
 #include <QFile>
 #include <QImage>
@@ -40,16 +42,60 @@ namespace Ireen {
 
 QByteArray emptyHash = QByteArray::fromHex("0201d20472");
 
+// Maximum number of avatar requests that could wait for the reply at the same time
+const int maxInFlightRequests = 4;
+// How often the queue is checked while the rate class does not allow to send anything
+const int fetchQueueInterval = 250;
+// The server does not always answer on avatar requests, forget them after this timeout
+const int fetchRequestTimeout = 60000;
+
+struct InFlightPicture
+{
+	QByteArray hash;
+	QTime time;
+};
+
 class BuddyPictureHandlerPrivate : public AbstractConnectionPrivate
 {
 public:
+	void expireRequests();
+	void updateLatency(int latency);
 	Client *client;
-	QHash<QString, SNAC> deferredRequests;
+	QHash<QString, BuddyPicture> pendingRequests;
+	QHash<QString, InFlightPicture> inFlightRequests;
+	QQueue<QString> visibleQueue;
+	QQueue<QString> backgroundQueue;
+	QSet<QString> visibleContacts;
+	QBasicTimer fetchTimer;
+	quint32 receivedCount;
+	int lastLatency;
+	int averageLatency;
 	QByteArray cookie;
 	QByteArray accountAvatar;
 	QByteArray avatarHash;
 };
 
+void BuddyPictureHandlerPrivate::expireRequests()
+{
+	QHash<QString, InFlightPicture>::iterator itr = inFlightRequests.begin();
+	while (itr != inFlightRequests.end()) {
+		if (itr->time.elapsed() > fetchRequestTimeout) {
+			debug() << "BuddyPicture: avatar request of" << itr.key() << "has timed out";
+			itr = inFlightRequests.erase(itr);
+		} else {
+			++itr;
+		}
+	}
+}
+
+void BuddyPictureHandlerPrivate::updateLatency(int latency)
+{
+	lastLatency = latency;
+	// Exponential moving average with 1/8 weight of the new sample
+	averageLatency = receivedCount ? averageLatency + (latency - averageLatency) / 8 : latency;
+	++receivedCount;
+}
+
 BuddyPictureHandler::BuddyPictureHandler(Client *client, Roster *roster) :
 	AbstractConnection(new BuddyPictureHandlerPrivate, client)
 {
@@ -61,6 +107,9 @@ BuddyPictureHandler::BuddyPictureHandler(Client *client, Roster *roster) :
 	m_types << SsiBuddyIcon;
 
 	d->client = client;
+	d->receivedCount = 0;
+	d->lastLatency = 0;
+	d->averageLatency = 0;
 
 	socket()->setProxy(d->client->socket()->proxy());
 	registerHandler(this);
@@ -80,17 +129,64 @@ void BuddyPictureHandler::requestPicture(const QString &uin, const BuddyPicture
 	Q_D(BuddyPictureHandler);
 	if (picture.hash == d->avatarHash)
 		return; // Don't request pictures that we are currently uploading.
-	debug() << "BuddyPicture: request avatar of" << uin;
-	SNAC snac(AvatarFamily, AvatarGetRequest);
-	snac.append<quint8>(uin);
-	snac.append<quint8>(1); // unknown
-	snac.append<quint16>(picture.id);
-	snac.append<quint8>(picture.flags);
-	snac.append<quint8>(picture.hash);
-	if (state() == Connected)
-		send(snac);
+	QHash<QString, InFlightPicture>::const_iterator inFlightItr = d->inFlightRequests.constFind(uin);
+	if (inFlightItr != d->inFlightRequests.constEnd() && inFlightItr->hash == picture.hash)
+		return; // The same avatar is already requested.
+	QHash<QString, BuddyPicture>::iterator itr = d->pendingRequests.find(uin);
+	if (itr != d->pendingRequests.end()) {
+		// The request has not been sent yet, so just replace the outdated hash.
+		*itr = picture;
+		return;
+	}
+	debug(DebugVerbose) << "BuddyPicture: queue avatar request of" << uin;
+	d->pendingRequests.insert(uin, picture);
+	if (d->visibleContacts.contains(uin))
+		d->visibleQueue.enqueue(uin);
 	else
-		d->deferredRequests.insert(uin, snac);
+		d->backgroundQueue.enqueue(uin);
+	if (!d->fetchTimer.isActive())
+		sendNextRequests();
+}
+
+void BuddyPictureHandler::cancelPictureRequest(const QString &uin)
+{
+	Q_D(BuddyPictureHandler);
+	if (!d->pendingRequests.remove(uin))
+		return;
+	// A new request of the uin takes a new place in the queue
+	d->visibleQueue.removeAll(uin);
+	d->backgroundQueue.removeAll(uin);
+}
+
+void BuddyPictureHandler::setContactVisible(const QString &uin, bool visible)
+{
+	Q_D(BuddyPictureHandler);
+	if (!visible) {
+		d->visibleContacts.remove(uin);
+		return;
+	}
+	if (d->visibleContacts.contains(uin))
+		return;
+	d->visibleContacts.insert(uin);
+	if (d->pendingRequests.contains(uin)) {
+		d->backgroundQueue.removeOne(uin);
+		d->visibleQueue.enqueue(uin);
+		if (!d->fetchTimer.isActive())
+			sendNextRequests();
+	}
+}
+
+BuddyPictureQueueStats BuddyPictureHandler::queueStats() const
+{
+	Q_D(const BuddyPictureHandler);
+	BuddyPictureQueueStats stats = {
+		d->pendingRequests.size(),
+		d->inFlightRequests.size(),
+		d->receivedCount,
+		d->lastLatency,
+		d->averageLatency
+	};
+	return stats;
 }
 
 void BuddyPictureHandler::uploadAccountAvatar(const QString &avatar)
@@ -127,9 +223,7 @@ void BuddyPictureHandler::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 					"000f 0001 0110 164f"));// AvatarFamily
 			send(snac);
 			setState(Connected);
-			foreach (SNAC snac, d->deferredRequests)
-				send(snac);
-			d->deferredRequests.clear();
+			sendNextRequests();
 		}
 	} else {
 		if (snac.family() == ServiceFamily && snac.subtype() == ServerRedirectService) {
@@ -154,8 +248,23 @@ void BuddyPictureHandler::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 		QByteArray hash = snac.read<QByteArray, quint8>();
 		snac.skipData(21);
 		QByteArray image = snac.read<QByteArray, quint16>();
-		debug() << "BuddyPicture: avatar of" << uin << "received";
-		emit avatarReceived(uin, hash, image);
+		if (snac.hasError()) {
+			warning() << "BuddyPicture: malformed avatar reply for" << uin;
+			// The request is answered anyway, so it is not retried
+		}
+		QHash<QString, InFlightPicture>::iterator itr = d->inFlightRequests.find(uin);
+		if (itr != d->inFlightRequests.end()) {
+			d->updateLatency(itr->time.elapsed());
+			d->inFlightRequests.erase(itr);
+		}
+		QHash<QString, BuddyPicture>::const_iterator pendingItr = d->pendingRequests.constFind(uin);
+		if (pendingItr != d->pendingRequests.constEnd() && pendingItr->hash != hash) {
+			debug() << "BuddyPicture: outdated avatar of" << uin << "is ignored";
+		} else if (!snac.hasError()) {
+			debug() << "BuddyPicture: avatar of" << uin << "received";
+			emit avatarReceived(uin, hash, image);
+		}
+		sendNextRequests();
 		break;
 	}
 	case ServiceFamily << 16 | ServiceServerExtstatus: { // account avatar changed
@@ -166,6 +275,10 @@ void BuddyPictureHandler::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 			if (type == 0x0001) {
 				quint8 flags = tlv.read<quint8>();
 				QByteArray hash = tlv.read<QByteArray, quint8>();
+				if (tlv.hasError()) {
+					warning() << "BuddyPicture: malformed account avatar notification";
+					break;
+				}
 				if (flags >> 6 & 0x1 && !d->accountAvatar.isEmpty()) { // does it really work???
 					SNAC snac(AvatarFamily, AvatarUploadRequest);
 					snac.append<quint16>(1); // reference number ?
@@ -181,7 +294,7 @@ void BuddyPictureHandler::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 	case AvatarFamily << 16 | AvatarUploadAck: { // avatar uploaded
 		snac.skipData(4); // unknown
 		QByteArray hash = snac.read<QByteArray, quint8>();
-		if (hash == d->avatarHash) {
+		if (!snac.hasError() && hash == d->avatarHash) {
 			debug() << "Account's avatar has been successfully updated";
 			emit avatarReceived(d->client->uin(), d->avatarHash, d->accountAvatar);
 		} else {
@@ -222,7 +335,8 @@ bool BuddyPictureHandler::handleFeedbagItem(Feedbag *feedbag, const FeedbagItem
 		DataUnit data(item.field(0x00d5));
 		quint8 flags = data.read<quint8>();
 		QByteArray hash = data.read<QByteArray, quint8>();
-		updateAvatar(d->client->uin(), hash, 1, flags);
+		if (!data.hasError())
+			updateAvatar(d->client->uin(), hash, 1, flags);
 	}
 	return true;
 }
@@ -245,7 +359,11 @@ void BuddyPictureHandler::statusChanged(const QString &uin, const StatusItem &st
 void BuddyPictureHandler::onDisconnect()
 {
 	Q_D(BuddyPictureHandler);
-	d->deferredRequests.clear();
+	d->fetchTimer.stop();
+	d->pendingRequests.clear();
+	d->inFlightRequests.clear();
+	d->visibleQueue.clear();
+	d->backgroundQueue.clear();
 	d->avatarHash.clear();
 	d->accountAvatar.clear();
 	AbstractConnection::onDisconnect();
@@ -257,9 +375,61 @@ void BuddyPictureHandler::updateAvatar(const QString &uin, const QByteArray &has
 		BuddyPicture picture = { hash, id, flags };
 		emit avatarUpdated(uin, picture);
 	} else {
+		cancelPictureRequest(uin);
 		emit avatarRemoved(uin);
 	}
 }
 
+void BuddyPictureHandler::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == d_func()->fetchTimer.timerId())
+		sendNextRequests();
+	else
+		AbstractConnection::timerEvent(event);
+}
+
+void BuddyPictureHandler::sendNextRequests()
+{
+	Q_D(BuddyPictureHandler);
+	if (state() != Connected)
+		return;
+	d->expireRequests();
+	forever {
+		bool priority = !d->visibleQueue.isEmpty();
+		QQueue<QString> &queue = priority ? d->visibleQueue : d->backgroundQueue;
+		if (queue.isEmpty()) {
+			d->fetchTimer.stop();
+			break;
+		}
+		// Background requests wait until the rate level is far from the limit,
+		// so the avatar server never has a reason to throttle us.
+		if (d->inFlightRequests.size() >= maxInFlightRequests ||
+			!testRate(AvatarFamily, AvatarGetRequest, priority))
+		{
+			if (!d->fetchTimer.isActive())
+				d->fetchTimer.start(fetchQueueInterval, this);
+			break;
+		}
+		QString uin = queue.dequeue();
+		// Every pending uin is kept in exactly one of the queues
+		Q_ASSERT(d->pendingRequests.contains(uin));
+		BuddyPicture picture = d->pendingRequests.take(uin);
+
+		debug() << "BuddyPicture: request avatar of" << uin;
+		SNAC snac(AvatarFamily, AvatarGetRequest);
+		snac.append<quint8>(uin);
+		snac.append<quint8>(1); // unknown
+		snac.append<quint16>(picture.id);
+		snac.append<quint8>(picture.flags);
+		snac.append<quint8>(picture.hash);
+		send(snac, priority);
+
+		InFlightPicture &inFlight = d->inFlightRequests[uin];
+		inFlight.hash = picture.hash;
+		inFlight.time.start();
+	}
+}
+
+
 } // namespace Ireen
 
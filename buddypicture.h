@@ -57,6 +57,15 @@ struct IREEN_EXPORT BuddyPicture
 	quint16 flags;
 };
 
+struct IREEN_EXPORT BuddyPictureQueueStats
+{
+	int queueLength; // requests waiting for their turn
+	int inFlight; // requests that have been sent but not answered yet
+	quint32 received; // avatars received since the handler was created
+	int lastLatency; // msecs between the last request and its reply
+	int averageLatency; // moving average of the latency, msecs
+};
+
 class IREEN_EXPORT BuddyPictureHandler: public AbstractConnection, public FeedbagItemHandler
 {
 	Q_OBJECT
@@ -66,6 +75,10 @@ public:
 	BuddyPictureHandler(Client *client, Roster *roster);
 	virtual ~BuddyPictureHandler();
 	void requestPicture(const QString &uin, const BuddyPicture &picture);
+	void cancelPictureRequest(const QString &uin);
+	// Requests of visible contacts are sent before all others
+	void setContactVisible(const QString &uin, bool visible = true);
+	BuddyPictureQueueStats queueStats() const;
 	void uploadAccountAvatar(const QString &avatar);
 signals:
 	void avatarReceived(const QString &uin, const QByteArray &hash, const QByteArray &avatar);
@@ -78,10 +91,12 @@ protected:
 	void processCloseConnection();
 	bool handleFeedbagItem(Feedbag *feedbag, const FeedbagItem &item, Feedbag::ModifyType type, FeedbagError error);
 	void onDisconnect();
+	void timerEvent(QTimerEvent *event);
 private slots:
 	void statusChanged(const QString &uin, const Ireen::StatusItem &status);
 private:
 	void updateAvatar(const QString &uin, const QByteArray &hash, quint16 id, quint16 flags);
+	void sendNextRequests();
 };
 
 } // namespace Ireen
@@ -33,12 +33,14 @@
 
 #include "md5login.h"
 #include "oscarauth.h"
+#include "reconnectmanager_p.h"
+#include "servicemanager.h"
 
 #include <QHostInfo>
 #include <QBuffer>
 #include <QTimer>
+#include <QTimerEvent>
 #include <QNetworkProxy>
-#include <QMetaMethod>
 
 namespace Ireen {
 
@@ -210,25 +212,94 @@ void OAuthLoginData::setLastToken(const QVariant &tokenData)
 	d->lastToken = tokenData;
 }
 
+QString OAuthLoginData::clientLoginUrl() const
+{
+	return d->clientLoginUrl;
+}
+
+QString OAuthLoginData::startSessionUrl() const
+{
+	return d->startSessionUrl;
+}
+
+void OAuthLoginData::setAuthUrls(const QString &clientLoginUrl, const QString &startSessionUrl)
+{
+	d->clientLoginUrl = clientLoginUrl;
+	d->startSessionUrl = startSessionUrl;
+}
+
 #endif
 
 void ClientPrivate::sendUserInfo(bool force)
 {
 	if (!force && !q->isConnected())
 		return;
-	SNAC snac(LocationFamily, MessageFamily);
+	userInfoDirty = false;
 	TLV caps(0x05);
 	foreach (const Capability &cap, this->caps)
 		caps.append(cap);
 	foreach (const Capability &cap, typedCaps)
 		caps.append(cap);
+	// Do not resend the same set of capabilities
+	if (!force && caps.data() == publishedCaps)
+		return;
+	publishedCaps = caps.data();
+	SNAC snac(LocationFamily, MessageFamily);
 	snac.append(caps);
 	q->send(snac);
 }
 
+void ClientPrivate::scheduleUserInfo()
+{
+	userInfoDirty = true;
+	schedulePublishing();
+}
+
+void ClientPrivate::schedulePublishing()
+{
+	if (!publishTimer.isActive())
+		publishTimer.start(0, q);
+}
+
+void ClientPrivate::publishSessionState()
+{
+	publishTimer.stop();
+	if (statusDirty) {
+		statusDirty = false;
+		sendStatusSnac(pendingStatus);
+	}
+	if (userInfoDirty)
+		sendUserInfo();
+}
+
+void ClientPrivate::sendStatusSnac(const Status &status)
+{
+	SNAC snac(ServiceFamily, ServiceClientSetStatus);
+	snac.appendTLV<quint32>(0x06, (statusFlags << 16) | status.id()); // Status mode and security flags
+	snac.appendTLV<quint16>(0x08, 0x0000); // Error code
+	// Status item
+	DataUnit statusData;
+	{
+		SessionDataItem statusNote(0x02, 0x04);
+		QByteArray text = Util::utf8Codec()->fromUnicode(status.text());
+		if (text.size() > 251)
+			text.resize(251);
+		statusNote.append<quint16>(text);
+		statusNote.append<quint16>(0); // endcoding: utf8 by default
+		statusData.append(statusNote);
+	}
+	snac.appendTLV(0x1D, statusData);
+	snac.appendTLV<quint16>(0x1f, 0x00); // unknown
+	q->send(snac);
+}
+
 void ClientPrivate::connectToBOSS(const QString &host, quint16 port, const QByteArray &cookie)
 {
 	auth_cookie = cookie;
+	reconnectManager->d->setEndpoint(host, port, cookie);
+	// Connecting to the BOSS server directly, without a login method
+	if (!auth)
+		loginTime.start();
 	if (socket->state() != QAbstractSocket::UnconnectedState)
 		socket->abort();
 	socket->connectToHost(host, port);
@@ -245,6 +316,9 @@ void ClientPrivate::setFeedbag(Feedbag *feedbag_)
 void ClientPrivate::login(AbstractLoginMethod *newAuth)
 {
 	stopLogin();
+	reconnectManager->d->timer.stop();
+	reconnectManager->d->wanted = true;
+	loginTime.start();
 	q->setError(Client::NoError);
 	QObject *obj = newAuth->toObject();
 	q->connect(obj, SIGNAL(error(Ireen::AbstractConnection::ConnectionError)),
@@ -269,14 +343,21 @@ Client::Client(const QString &uin, QObject *parent) :
 {
 	Q_D(Client);
 	m_infos << SNACInfo(LocationFamily, LocationRightsReply)
-			<< SNACInfo(BosFamily, PrivacyRightsReply);
+			<< SNACInfo(BosFamily, PrivacyRightsReply)
+			<< SNACInfo(ExtensionsFamily, ExtensionsMetaSrvReply);
 
 	d->uin = uin;
 	d->statusFlags = 0x0000;
 	d->isIdle = false;
 	d->feedbag = 0;
+	d->auth = 0;
 	d->asciiCodec = QTextCodec::codecForLocale();
 	d->detectCodec = new DetectCodec(&d->asciiCodec);
+	d->requestTracker = new RequestTracker(this);
+	d->reconnectManager = new ReconnectManager(this);
+	d->serviceManager = new ServiceManager(this);
+	d->userInfoDirty = false;
+	d->statusDirty = false;
 
 	registerHandler(this);
 
@@ -311,14 +392,18 @@ void Client::login(const QString &password)
 
 void Client::login(const MD5LoginData &data)
 {
-	d_func()->login(new Md5Login(this, data));
+	Q_D(Client);
+	d->reconnectManager->d->setLoginData(data);
+	d->login(new Md5Login(this, data));
 }
 
 #if IREEN_SSL_SUPPORT
 
 void Client::login(const OAuthLoginData &data)
 {
-	d_func()->login(new OscarAuth(this, data));
+	Q_D(Client);
+	d->reconnectManager->d->setLoginData(data);
+	d->login(new OscarAuth(this, data));
 }
 
 #endif
@@ -332,6 +417,10 @@ void Client::disconnectFromHost(bool force)
 {
 	Q_D(Client);
 	d->status = Status::Offline;
+	d->reconnectManager->cancel();
+	// Let the server know about the last status change before leaving
+	if (d->publishTimer.isActive())
+		d->publishSessionState();
 	if (!d->stopLogin())
 		AbstractConnection::disconnectFromHost(force);
 }
@@ -417,14 +506,15 @@ void Client::setCapability(const Capability &capability, const QString &type)
 {
 	Q_D(Client);
 	d->setCapability(capability, type);
-	d->sendUserInfo();
+	d->scheduleUserInfo();
 }
 
 bool Client::removeCapability(const Capability &capability)
 {
 	Q_D(Client);
 	bool r = d->removeCapability(capability);
-	d->sendUserInfo();
+	if (r)
+		d->scheduleUserInfo();
 	return r;
 }
 
@@ -432,7 +522,8 @@ bool Client::removeCapability(const QString &type)
 {
 	Q_D(Client);
 	bool r = d->removeCapability(type);
-	d->sendUserInfo();
+	if (r)
+		d->scheduleUserInfo();
 	return r;
 }
 
@@ -478,6 +569,28 @@ void Client::setAsciiCodec(QTextCodec *codec)
 	d_func()->asciiCodec = codec ? codec : QTextCodec::codecForLocale();;
 }
 
+void Client::registerMetaReplyHandler(MetaReplyHandler *handler)
+{
+	Q_D(Client);
+	foreach (quint16 type, handler->metaTypes())
+		d->metaReplyHandlers.insert(type, handler);
+}
+
+RequestTracker *Client::requestTracker() const
+{
+	return d_func()->requestTracker;
+}
+
+ReconnectManager *Client::reconnectManager() const
+{
+	return d_func()->reconnectManager;
+}
+
+ServiceManager *Client::serviceManager() const
+{
+	return d_func()->serviceManager;
+}
+
 QTextCodec *Client::detectCodec() const
 {
 	return d_func()->detectCodec;
@@ -487,6 +600,11 @@ void Client::onDisconnect()
 {
 	Q_D(Client);
 	d->status = Status::Offline;
+	// Nothing is published to a dead socket or replayed into the next session
+	d->publishTimer.stop();
+	d->statusDirty = false;
+	d->userInfoDirty = false;
+	d->publishedCaps.clear();
 	AbstractConnection::onDisconnect();
 }
 
@@ -503,82 +621,37 @@ void Client::authError(ConnectionError e)
 	onDisconnect();
 }
 
-void Client::onCookieTimeout()
-{
-	Q_D(Client);
-	Q_ASSERT(qobject_cast<QTimer*>(sender()));
-	QTimer *timer = static_cast<QTimer*>(sender());
-	quint64 id = timer->property("cookieId").value<quint64>();
-	Q_ASSERT(id != 0);
-	Cookie cookie = d->cookies.take(id);
-	Q_ASSERT(!cookie.isEmpty());
-	QObject *receiver = cookie.receiver();
-	const char *member = cookie.member();
-	if (receiver && member) {
-		const QMetaObject *meta = receiver->metaObject();
-		const char type = member[0];
-		QByteArray tmp = QMetaObject::normalizedSignature(&member[1]);
-		member = tmp.constData();
-
-		int index = -1;
-		switch (type) {
-		case '0': index = meta->indexOfMethod(member); break;
-		case '1': index = meta->indexOfSlot(member);   break;
-		case '2': index = meta->indexOfSignal(member); break;
-		default:  break;
-		}
-
-		if (index != -1) {
-			meta->method(index).invoke(
-						receiver,
-						Qt::AutoConnection,
-						Q_ARG(Cookie, cookie),
-						Q_ARG(QString, cookie.uin()));
-		}
-	}
-	// cookie.unlock(); // Commented out as this cookie is already unlocked
-}
-
 void Client::sendStatus(Status status)
 {
 	Q_D(Client);
-	SNAC snac(ServiceFamily, ServiceClientSetStatus);
-	snac.appendTLV<quint32>(0x06, (d->statusFlags << 16) | status.id()); // Status mode and security flags
-	snac.appendTLV<quint16>(0x08, 0x0000); // Error code
-	// Status item
-	DataUnit statusData;
-	{
-		SessionDataItem statusNote(0x02, 0x04);
-		QByteArray text = Util::utf8Codec()->fromUnicode(status.text());
-		if (text.size() > 251)
-			text.resize(251);
-		statusNote.append<quint16>(text);
-		statusNote.append<quint16>(0); // endcoding: utf8 by default
-		statusData.append(statusNote);
-	}
-	snac.appendTLV(0x1D, statusData);
-	snac.appendTLV<quint16>(0x1f, 0x00); // unknown
-	send(snac);
+	d->pendingStatus = status;
+	d->statusDirty = true;
 
-	bool updateCaps = false;
 	QSet<QString> types = Status::allSupportedCapabilityTypes();
 	CapabilityHash caps = status.capabilities();
 	CapabilityHash::const_iterator itr = caps.constBegin();
 	CapabilityHash::const_iterator endItr = caps.constEnd();
-	while (itr != endItr) {
+	for (; itr != endItr; ++itr) {
 		if (itr->isNull())
 			continue;
 		types.remove(itr.key());
 		d->setCapability(itr.value(), itr.key());
-		updateCaps = true;
-		++itr;
+		d->userInfoDirty = true;
 	}
 	foreach (const QString &type, types) {
-		d->removeCapability(type);
-		updateCaps = true;
+		if (d->removeCapability(type))
+			d->userInfoDirty = true;
 	}
-	if (updateCaps)
-		d->sendUserInfo();
+	d->schedulePublishing();
+}
+
+void Client::timerEvent(QTimerEvent *event)
+{
+	Q_D(Client);
+	if (event->timerId() == d->publishTimer.timerId())
+		d->publishSessionState();
+	else
+		AbstractConnection::timerEvent(event);
 }
 
 void Client::handleSNAC(AbstractConnection *conn, const SNAC &sn)
@@ -611,6 +684,37 @@ void Client::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 			finishLogin();
 		break;
 	}
+	case ExtensionsFamily << 16 | ExtensionsMetaSrvReply: {
+		d->handleMetaReply(sn);
+		break;
+	}
+	}
+}
+
+void ClientPrivate::handleMetaReply(const SNAC &snac)
+{
+	TLVMap tlvs = snac.read<TLVMap>();
+	if (!tlvs.contains(0x01))
+		return;
+	DataUnit data(tlvs.value(0x01));
+	MetaReply reply;
+	data.skipData(2); // skip field length
+	reply.uin = data.read<quint32>(LittleEndian);
+	reply.type = data.read<quint16>(LittleEndian);
+	reply.sequence = data.read<quint16>(LittleEndian);
+	if (snac.hasError() || data.hasError()) {
+		warning(MetaInfoDebug) << "Malformed meta reply";
+		return;
+	}
+	reply.data = DataUnit(data.readData(data.dataSize()));
+	QList<MetaReplyHandler*> handlers = metaReplyHandlers.values(reply.type);
+	if (handlers.isEmpty()) {
+		debug(ConnectionDebug, DebugVerbose) << "No handlers for the meta reply with type" << hex << reply.type;
+		return;
+	}
+	foreach (MetaReplyHandler *handler, handlers) {
+		reply.data.resetState();
+		handler->handleMetaReply(reply);
 	}
 }
 
@@ -637,6 +741,7 @@ void Client::finishLogin()
 		"000b 0001 0110 164f"));
 	send(snac);
 	d->status = Status::Online;
+	debug(ConnectionDebug) << "Login is finished in" << d->loginTime.elapsed() << "msec";
 	emit loginFinished();
 }
 
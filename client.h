@@ -34,6 +34,10 @@
 namespace Ireen {
 
 class SNACHandler;
+class MetaReplyHandler;
+class RequestTracker;
+class ReconnectManager;
+class ServiceManager;
 class SNAC;
 class ProtocolNegotiation;
 class BuddyPictureHandler;
@@ -90,10 +94,36 @@ public:
 	void setVersion(int major, int minor, int secMinor, int patch);
 	QVariant lastToken() const;
 	void setLastToken(const QVariant &tokenData);
+	// The ICQ servers are used if the urls are empty
+	QString clientLoginUrl() const;
+	QString startSessionUrl() const;
+	void setAuthUrls(const QString &clientLoginUrl, const QString &startSessionUrl);
 private:
 	QSharedDataPointer<OAuthLoginDataPrivate> d;
 };
 
+// Tokens of all accounts of the process, keyed by uin. The OAuth login takes
+// the token from here when OAuthLoginData has none and puts every new token here.
+// If the file name is set, the tokens are kept in that file between restarts.
+// The changes are written in batches, about a second after the first of them,
+// and when the application quits.
+// A token includes the session secret in plain text, which is enough to start
+// a session of the account. The file is made readable by its owner only;
+// keep it out of the shared locations like a password file.
+class IREEN_EXPORT OAuthTokenCache
+{
+public:
+	static void setFileName(const QString &fileName);
+	static QString fileName();
+	// Returns the token only if it has not expired yet
+	static QVariant token(const QString &uin);
+	static void setToken(const QString &uin, const QVariant &token);
+	static void removeToken(const QString &uin);
+	static void clear();
+	// Writes the pending changes to the file at once
+	static void sync();
+};
+
 #endif
 
 class IREEN_EXPORT Client: public AbstractConnection
@@ -102,14 +132,14 @@ class IREEN_EXPORT Client: public AbstractConnection
 	Q_DECLARE_PRIVATE(Client)
 public:
 	Client(const QString &uin, QObject *parent);
-	void login(const QString &password);
-	void login(const MD5LoginData &data);
+	Q_INVOKABLE void login(const QString &password);
+	Q_INVOKABLE void login(const Ireen::MD5LoginData &data);
 #if IREEN_SSL_SUPPORT
-	void login(const OAuthLoginData &data);
+	Q_INVOKABLE void login(const Ireen::OAuthLoginData &data);
 #endif
-	void disconnectFromHost(bool force = false);
+	Q_INVOKABLE void disconnectFromHost(bool force = false);
 	QString uin() const;
-	void sendStatus(Status status);
+	Q_INVOKABLE void sendStatus(Ireen::Status status);
 	QAbstractSocket::SocketState socketState() const;
 	Status status() const;
 	bool isConnected();
@@ -123,16 +153,25 @@ public:
 	QTextCodec *asciiCodec() const;
 	void setAsciiCodec(QTextCodec *codec);
 	QTextCodec *detectCodec() const;
+	// Handlers are selected by the type of the meta reply,
+	// see MetaReplyHandler::metaTypes()
+	void registerMetaReplyHandler(MetaReplyHandler *handler);
+	// Tracks the cookies and other requests waiting for the reply
+	RequestTracker *requestTracker() const;
+	// Brings the client back online after the connection is lost, disabled by default
+	ReconnectManager *reconnectManager() const;
+	// Connections to the services which are not served by BOSS
+	ServiceManager *serviceManager() const;
 signals:
 	void loginFinished();
 	void loginTokenUpdated(const QVariant &token);
 protected:
 	void handleSNAC(AbstractConnection *conn, const SNAC &snac);
+	void timerEvent(QTimerEvent *event);
 private slots:
 	void onDisconnect();
 	void onError(ConnectionError error);
 	void authError(Ireen::AbstractConnection::ConnectionError error);
-	void onCookieTimeout();
 	void finishLogin();
 private:
 	void setIdle(bool allow);
@@ -142,10 +181,18 @@ private:
 	friend class Cookie;
 	friend class Md5Login;
 	friend class OscarAuth;
+	friend class ReconnectManager;
+	friend class LoginOrchestrator;
+	friend class ServiceManager;
 	friend class Feedbag;
 };
 
 } // namespace Ireen
 
+Q_DECLARE_METATYPE(Ireen::MD5LoginData)
+#if IREEN_SSL_SUPPORT
+Q_DECLARE_METATYPE(Ireen::OAuthLoginData)
+#endif
+
 #endif // IREEN_CONNECTION_H
 
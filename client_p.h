@@ -31,7 +31,11 @@
 #include "abstractconnection_p.h"
 #include "capability.h"
 #include "feedbag.h"
+#include "metareplyhandler.h"
+#include "requesttracker.h"
 #include <k8json/k8json.h>
+#include <QBasicTimer>
+#include <QTime>
 
 namespace Ireen {
 
@@ -86,6 +90,8 @@ public:
 	QString clienName;
 	QString distId;
 	QVariant lastToken;
+	QString clientLoginUrl;
+	QString startSessionUrl;
 };
 
 #endif
@@ -111,9 +117,15 @@ public:
 	void finishLogin();
 	void connectToBOSS(const QString &host, quint16 port, const QByteArray &cookie);
 	void sendUserInfo(bool force = false);
+	// Session state changes are published together at the end of the event loop turn
+	void scheduleUserInfo();
+	void schedulePublishing();
+	void publishSessionState();
+	void sendStatusSnac(const Status &status);
 	void setFeedbag(Feedbag *feedbag);
 	void login(AbstractLoginMethod *auth);
 	bool stopLogin();
+	void handleMetaReply(const SNAC &snac);
 public:
 	bool isIdle;
 	quint16 statusFlags;
@@ -128,6 +140,17 @@ public:
 	QTextCodec *asciiCodec;
 	DetectCodec *detectCodec;
 	AbstractLoginMethod *auth;
+	QMultiHash<quint16, MetaReplyHandler*> metaReplyHandlers;
+	RequestTracker *requestTracker;
+	ReconnectManager *reconnectManager;
+	ServiceManager *serviceManager;
+	QBasicTimer publishTimer;
+	bool userInfoDirty;
+	bool statusDirty;
+	Status pendingStatus;
+	QByteArray publishedCaps;
+	// Measures the time from the login start to loginFinished()
+	QTime loginTime;
 };
 
 } // namespace Ireen
@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "clientshardpool_p.h"
+#include "status.h"
+
+namespace Ireen {
+
+Client *ClientShard::createClient(const QString &uin)
+{
+	Client *client = new Client(uin, 0);
+	m_pool->initClient(client);
+	return client;
+}
+
+void ClientShard::destroyClient(Client *client)
+{
+	m_pool->cleanupClient(client);
+	delete client;
+}
+
+ClientShard *ClientShardPoolPrivate::shardOf(Client *client) const
+{
+	QMutexLocker locker(&mutex);
+	return clients.value(client);
+}
+
+bool ClientShardPoolPrivate::contains(Client *client) const
+{
+	if (shardOf(client))
+		return true;
+	debug(ConnectionDebug) << "The client" << client << "does not belong to the pool";
+	return false;
+}
+
+ClientShardPool::ClientShardPool(int threadCount, QObject *parent) :
+	QObject(parent), d(new ClientShardPoolPrivate)
+{
+	qRegisterMetaType<Ireen::Client*>("Ireen::Client*");
+	qRegisterMetaType<Ireen::Status>("Ireen::Status");
+	qRegisterMetaType<Ireen::MD5LoginData>("Ireen::MD5LoginData");
+#if IREEN_SSL_SUPPORT
+	qRegisterMetaType<Ireen::OAuthLoginData>("Ireen::OAuthLoginData");
+#endif
+	if (threadCount <= 0)
+		threadCount = qMax(1, QThread::idealThreadCount());
+	for (int i = 0; i < threadCount; ++i) {
+		ClientShard *shard = new ClientShard(this);
+		shard->moveToThread(&shard->thread);
+		shard->thread.start();
+		d->shards << shard;
+	}
+}
+
+ClientShardPool::~ClientShardPool()
+{
+	foreach (Client *client, clients())
+		destroyClient(client);
+	foreach (ClientShard *shard, d->shards) {
+		shard->thread.quit();
+		shard->thread.wait();
+		delete shard;
+	}
+}
+
+int ClientShardPool::threadCount() const
+{
+	return d->shards.size();
+}
+
+Client *ClientShardPool::createClient(const QString &uin)
+{
+	ClientShard *shard = 0;
+	{
+		QMutexLocker locker(&d->mutex);
+		foreach (ClientShard *current, d->shards) {
+			if (!shard || current->clientsCount < shard->clientsCount)
+				shard = current;
+		}
+		++shard->clientsCount;
+	}
+	Q_ASSERT(QThread::currentThread() != &shard->thread);
+	Client *client = 0;
+	QMetaObject::invokeMethod(shard, "createClient", Qt::BlockingQueuedConnection,
+							  Q_RETURN_ARG(Ireen::Client*, client), Q_ARG(QString, uin));
+	QMutexLocker locker(&d->mutex);
+	d->clients.insert(client, shard);
+	return client;
+}
+
+void ClientShardPool::destroyClient(Client *client)
+{
+	ClientShard *shard = d->shardOf(client);
+	if (!shard) {
+		debug(ConnectionDebug) << "The client" << client << "does not belong to the pool";
+		return;
+	}
+	Q_ASSERT(QThread::currentThread() != &shard->thread);
+	QMetaObject::invokeMethod(shard, "destroyClient", Qt::BlockingQueuedConnection,
+							  Q_ARG(Ireen::Client*, client));
+	QMutexLocker locker(&d->mutex);
+	d->clients.remove(client);
+	--shard->clientsCount;
+}
+
+QList<Client*> ClientShardPool::clients() const
+{
+	QMutexLocker locker(&d->mutex);
+	return d->clients.keys();
+}
+
+void ClientShardPool::login(Client *client, const MD5LoginData &data)
+{
+	if (!d->contains(client))
+		return;
+	QMetaObject::invokeMethod(client, "login", Qt::QueuedConnection,
+							  Q_ARG(Ireen::MD5LoginData, data));
+}
+
+#if IREEN_SSL_SUPPORT
+void ClientShardPool::login(Client *client, const OAuthLoginData &data)
+{
+	if (!d->contains(client))
+		return;
+	QMetaObject::invokeMethod(client, "login", Qt::QueuedConnection,
+							  Q_ARG(Ireen::OAuthLoginData, data));
+}
+#endif
+
+void ClientShardPool::sendStatus(Client *client, const Status &status)
+{
+	if (!d->contains(client))
+		return;
+	QMetaObject::invokeMethod(client, "sendStatus", Qt::QueuedConnection,
+							  Q_ARG(Ireen::Status, status));
+}
+
+void ClientShardPool::disconnectFromHost(Client *client, bool force)
+{
+	if (!d->contains(client))
+		return;
+	QMetaObject::invokeMethod(client, "disconnectFromHost", Qt::QueuedConnection,
+							  Q_ARG(bool, force));
+}
+
+void ClientShardPool::initClient(Client *client)
+{
+	Q_UNUSED(client);
+}
+
+void ClientShardPool::cleanupClient(Client *client)
+{
+	Q_UNUSED(client);
+}
+
+} // namespace Ireen
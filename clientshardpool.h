@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_CLIENTSHARDPOOL_H
+#define IREEN_CLIENTSHARDPOOL_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include "ireen_global.h"
+
+namespace Ireen {
+
+class Client;
+class ClientShard;
+class ClientShardPoolPrivate;
+class MD5LoginData;
+class OAuthLoginData;
+class Status;
+
+// Runs clients on a fixed number of worker threads, each with its own event loop.
+// Every client and everything attached to it lives in the thread of its shard,
+// so the application must not call them directly. The login, the status and
+// the disconnection are queued to the thread of the client by the pool,
+// anything else has to go through QMetaObject::invokeMethod() with
+// Qt::QueuedConnection. The signals of the clients have to be connected
+// with queued connections as well.
+class IREEN_EXPORT ClientShardPool : public QObject
+{
+	Q_OBJECT
+public:
+	// Uses QThread::idealThreadCount() threads if threadCount is not positive
+	explicit ClientShardPool(int threadCount = 0, QObject *parent = 0);
+	virtual ~ClientShardPool();
+	int threadCount() const;
+	// Both block until the client is constructed or destroyed in its thread,
+	// so they must not be called from the worker threads
+	Client *createClient(const QString &uin);
+	void destroyClient(Client *client);
+	QList<Client*> clients() const;
+	// Queue the call to the thread of the client, so they may be called
+	// from any thread. The client must belong to the pool.
+	void login(Client *client, const MD5LoginData &data);
+#if IREEN_SSL_SUPPORT
+	void login(Client *client, const OAuthLoginData &data);
+#endif
+	void sendStatus(Client *client, const Status &status);
+	void disconnectFromHost(Client *client, bool force = false);
+protected:
+	// Is called in the thread of the client right after its construction,
+	// this is the place to attach Feedbag, Roster, MessageHandler and so on
+	virtual void initClient(Client *client);
+	// Is called in the thread of the client before its destruction.
+	// Subclasses overriding it should destroy their clients in their own destructor.
+	virtual void cleanupClient(Client *client);
+private:
+	friend class ClientShard;
+	QScopedPointer<ClientShardPoolPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_CLIENTSHARDPOOL_H
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_CLIENTSHARDPOOL_P_H
+#define IREEN_CLIENTSHARDPOOL_P_H
+
+#include "clientshardpool.h"
+#include "client.h"
+#include <QThread>
+#include <QMutex>
+#include <QHash>
+#include <QMetaType>
+
+Q_DECLARE_METATYPE(Ireen::Client*)
+
+namespace Ireen {
+
+class ClientShard : public QObject
+{
+	Q_OBJECT
+public:
+	ClientShard(ClientShardPool *pool) : clientsCount(0), m_pool(pool) {}
+	QThread thread;
+	// Guarded by the mutex of the pool
+	int clientsCount;
+public slots:
+	Ireen::Client *createClient(const QString &uin);
+	void destroyClient(Ireen::Client *client);
+private:
+	ClientShardPool *m_pool;
+};
+
+class ClientShardPoolPrivate
+{
+public:
+	ClientShard *shardOf(Client *client) const;
+	// Complains about the clients of other pools
+	bool contains(Client *client) const;
+	QList<ClientShard*> shards;
+	QHash<Client*, ClientShard*> clients;
+	mutable QMutex mutex;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_CLIENTSHARDPOOL_P_H
@@ -27,11 +27,22 @@
 #include "capability.h"
 #include <QDataStream>
 #include <QtEndian>
+#include <QReadWriteLock>
 
 namespace Ireen {
 
 typedef QHash<Capability, QString> CapName;
 Q_GLOBAL_STATIC(CapName, capName)
+Q_GLOBAL_STATIC(QReadWriteLock, capNameLock)
+
+// Defined in buddycaps.cpp, looks up the static table of the well-known capabilities
+const char *knownCapabilityName(const Capability &capability);
+
+static void insertCapName(const Capability &capability, const QString &name)
+{
+	QWriteLocker locker(capNameLock());
+	capName()->insert(capability, name);
+}
 
 Capability::Capability()
 {
@@ -143,8 +154,15 @@ bool Capability::match(const Capability &o, quint8 len) const
 
 QString Capability::name() const
 {
-	QString name = capName()->value(*this);
+	QString name;
+	{
+		QReadLocker locker(capNameLock());
+		name = capName()->value(*this);
+	}
 	if (name.isNull()) {
+		if (const char *known = knownCapabilityName(*this))
+			return QLatin1String(known);
+
 		if (!isShort()) {
 			return toString();
 		} else {
@@ -205,26 +223,26 @@ Capabilities::const_iterator Capabilities::find(const Capability &capability, qu
 StandartCapability::StandartCapability(const QString &name, const QString &str) :
 	Capability(str)
 {
-	capName()->insert(*this, name);
+	insertCapName(*this, name);
 }
 
 StandartCapability::StandartCapability(const QString &name, const QByteArray &data) :
 	Capability(data)
 {
-	capName()->insert(*this, name);
+	insertCapName(*this, name);
 }
 
 StandartCapability::StandartCapability(const QString &name, quint32 d1, quint32 d2, quint32 d3, quint32 d4) :
 	Capability(d1, d2, d3, d4)
 {
-	capName()->insert(*this, name);
+	insertCapName(*this, name);
 }
 
 StandartCapability::StandartCapability(const QString &name, uint l, ushort w1, ushort w2, uchar b1,
 									   uchar b2, uchar b3, uchar b4, uchar b5, uchar b6, uchar b7, uchar b8) :
 	Capability(l, w1, w2, b1, b2, b3, b4, b5, b6, b7, b8)
 {
-	capName()->insert(*this, name);
+	insertCapName(*this, name);
 }
 
 StandartCapability::StandartCapability(const QString &name, quint8 d1, quint8 d2, quint8 d3, quint8 d4,
@@ -233,13 +251,13 @@ StandartCapability::StandartCapability(const QString &name, quint8 d1, quint8 d2
 
 	Capability(d1, d2, d3, d4, d5, d6, d7, d8, d9, d10, d11, d12, d13, d14, d15, d16)
 {
-	capName()->insert(*this, name);
+	insertCapName(*this, name);
 }
 
 StandartCapability::StandartCapability(const QString &name, quint16 data) :
 	Capability(data)
 {
-	capName()->insert(*this, name);
+	insertCapName(*this, name);
 }
 
 } // namespace Ireen
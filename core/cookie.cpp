@@ -26,28 +26,87 @@
 
 #include "cookie.h"
 #include "client_p.h"
+#include "requesttracker.h"
 #include <QDateTime>
-#include <QTimer>
+#include <QPointer>
+#include <QMetaMethod>
+#include <QMutex>
 
 namespace Ireen {
 
+Q_GLOBAL_STATIC(QMutex, cookieIdLock)
+
 class CookiePrivate: public QSharedData
 {
 public:
 	CookiePrivate(quint64 _id = 0):
-		id(_id), member(0)
+		id(_id), receiver(0), member(0)
 	{
-		timer.setSingleShot(true);
 	}
 
+	void startTracking(const Cookie &cookie, RequestContinuation *continuation, int msec) const;
 	quint64 id;
 	Client *client;
 	QString uin;
 	mutable QObject *receiver;
 	mutable QLatin1String member;
-	mutable QTimer timer;
 };
 
+// Drops the cookie from the client on timeout and notifies the receiver
+class CookieContinuation : public RequestContinuation
+{
+public:
+	CookieContinuation(const Cookie &cookie, QObject *receiver, int method, RequestContinuation *next) :
+		m_cookie(cookie), m_receiver(receiver), m_method(method), m_next(next)
+	{
+	}
+	~CookieContinuation()
+	{
+		delete m_next;
+	}
+	void resolve(const PendingRequest &request)
+	{
+		if (request.status() == PendingRequest::TimedOut) {
+			m_cookie.unlock();
+			if (m_receiver && m_method != -1) {
+				m_receiver->metaObject()->method(m_method).invoke(
+							m_receiver,
+							Qt::AutoConnection,
+							Q_ARG(Cookie, m_cookie),
+							Q_ARG(QString, m_cookie.uin()));
+			}
+		}
+		if (m_next)
+			m_next->resolve(request);
+	}
+private:
+	Cookie m_cookie;
+	QPointer<QObject> m_receiver;
+	int m_method;
+	RequestContinuation *m_next;
+};
+
+void CookiePrivate::startTracking(const Cookie &cookie, RequestContinuation *continuation, int msec) const
+{
+	int method = -1;
+	if (receiver && member.latin1() && *member.latin1()) {
+		// The method is resolved only once, when the cookie is locked
+		const QMetaObject *meta = receiver->metaObject();
+		const char type = member.latin1()[0];
+		QByteArray signature = QMetaObject::normalizedSignature(member.latin1() + 1);
+		switch (type) {
+		case '0': method = meta->indexOfMethod(signature); break;
+		case '1': method = meta->indexOfSlot(signature);   break;
+		case '2': method = meta->indexOfSignal(signature); break;
+		default:  break;
+		}
+		if (method == -1)
+			debug(ConnectionDebug) << "Cookie timeout handler" << member << "is not found in" << meta->className();
+	}
+	continuation = new CookieContinuation(cookie, receiver, method, continuation);
+	client->requestTracker()->start(PendingRequest::CookieKey, id, msec, continuation);
+}
+
 Cookie::Cookie(bool generate):
 	d_ptr(new CookiePrivate)
 {
@@ -103,11 +162,20 @@ void Cookie::lock(QObject *receiver, const char *member, int msec) const
 	Q_ASSERT(d->client);
 	Q_ASSERT(!isEmpty());
 	d->client->d_func()->cookies.insert(d->id, *this);
-	d->timer.setProperty("cookieId", d->id);
-	QObject::connect(&d->timer, SIGNAL(timeout()), d->client, SLOT(onCookieTimeout()));
 	d->receiver = receiver;
 	d->member = QLatin1String(member);
-	d->timer.start(msec);
+	d->startTracking(*this, 0, msec);
+}
+
+void Cookie::lock(RequestContinuation *continuation, int msec) const
+{
+	Q_D(const Cookie);
+	Q_ASSERT(d->client);
+	Q_ASSERT(!isEmpty());
+	d->client->d_func()->cookies.insert(d->id, *this);
+	d->receiver = 0;
+	d->member = QLatin1String(0);
+	d->startTracking(*this, continuation, msec);
 }
 
 bool Cookie::unlock() const
@@ -116,7 +184,7 @@ bool Cookie::unlock() const
 	Q_ASSERT(d->client);
 	Cookie cookie = d->client->d_func()->cookies.take(d->id);
 	if (!cookie.isEmpty()) {
-		cookie.d_func()->timer.stop();
+		d->client->requestTracker()->finish(PendingRequest::CookieKey, d->id);
 		d->receiver = 0;
 		d->member = QLatin1String(0);
 		return true;
@@ -176,6 +244,8 @@ const char *Cookie::member()
 
 quint64 Cookie::generateId()
 {
+	// Clients may live in different threads, and Qt has no 64-bit atomics
+	QMutexLocker locker(cookieIdLock());
 	static quint64 id = 10000;
 	return ++id;
 }
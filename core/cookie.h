@@ -35,6 +35,7 @@ namespace Ireen {
 
 class Client;
 class CookiePrivate;
+class RequestContinuation;
 
 class IREEN_EXPORT Cookie
 {
@@ -48,6 +49,8 @@ public:
 	Cookie &operator=(const Cookie &cookie);
 	virtual ~Cookie();
 	void lock(QObject *receiver = 0, const char *member = 0, int msec = 30000) const;
+	// The continuation is resolved when the cookie is unlocked or timed out
+	void lock(RequestContinuation *continuation, int msec = 30000) const;
 	bool unlock() const;
 	bool isLocked() const;
 	bool isEmpty() const;
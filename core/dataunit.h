@@ -46,15 +46,19 @@ class TLVMap;
 class IREEN_EXPORT DataUnit
 {
 public:
-	DataUnit() { m_state = 0; m_max_size = 0; }
-	DataUnit(const DataUnit &unit) { m_data = unit.m_data; m_state = 0; m_max_size = 0; }
-	DataUnit(const QByteArray &data) { m_data = data; m_state = 0; m_max_size = 0; }
+	DataUnit() { m_state = 0; m_max_size = 0; m_error = false; }
+	DataUnit(const DataUnit &unit) { m_data = unit.m_data; m_state = 0; m_max_size = 0; m_error = false; }
+	DataUnit(const QByteArray &data) { m_data = data; m_state = 0; m_max_size = 0; m_error = false; }
 	const QByteArray &data() const { return m_data; }
 	operator QByteArray() const { return data(); }
-	void setData(const QByteArray &data) { m_data = data; m_state = 0; }
+	void setData(const QByteArray &data) { m_data = data; m_state = 0; m_error = false; }
 	inline QByteArray readData(uint size) const;
 	inline void skipData(uint num) const { m_state = qMin<uint>(m_state + num, m_data.size()); }
-	inline void resetState() const { m_state = 0; }
+	inline void resetState() const { m_state = 0; m_error = false; }
+	// Is set when a read goes past the end of the data and stays set
+	// until the state is reset, so parsers can check it once at the end
+	inline bool hasError() const { return m_error; }
+	inline void setError() const { m_error = true; }
 	inline uint dataSize() const { return m_data.size() > m_state ? m_data.size() - m_state : 0; }
 	inline QByteArray readAll() const;
 	int state() const { return m_state; }
@@ -96,12 +100,16 @@ protected:
 private:
 	int m_max_size;
 	mutable int m_state;
+	mutable bool m_error;
 };
 
 QByteArray DataUnit::readData(uint size) const
 {
 	QByteArray str;
-	size = qMin(dataSize(), size);
+	if (size > dataSize()) {
+		m_error = true;
+		size = dataSize();
+	}
 	str = m_data.mid(m_state, size);
 	m_state += size;
 	return str;
@@ -198,10 +206,40 @@ struct toDataUnitHelper<T, true>
 	}
 };
 
+// Appends the data to the buffer in place, avoiding a temporary
+// QByteArray for integers
+template<typename T, bool is_int = is_simple<T>::value>
+struct appendToByteArrayHelper
+{
+	static inline void append(QByteArray &buf, const T &data)
+	{
+		buf += toDataUnitHelper<T>::toByteArray(data);
+	}
+	static inline void append(QByteArray &buf, const T &data, ByteOrder bo)
+	{
+		buf += toDataUnitHelper<T>::toByteArray(data, bo);
+	}
+};
+
+template<typename T>
+struct appendToByteArrayHelper<T, true>
+{
+	static inline void append(QByteArray &buf, T data, ByteOrder bo = BigEndian)
+	{
+		int size = buf.size();
+		buf.resize(size + sizeof(T));
+		uchar *dest = reinterpret_cast<uchar *>(buf.data()) + size;
+		if (bo == BigEndian)
+			qToBigEndian<T>(data, dest);
+		else
+			qToLittleEndian<T>(data, dest);
+	}
+};
+
 template<typename T>
 Q_INLINE_TEMPLATE void DataUnit::append(const T& data)
 {
-	m_data += toDataUnitHelper<T>::toByteArray(data);
+	appendToByteArrayHelper<T>::append(m_data, data);
 	ensure_value();
 }
 
@@ -214,7 +252,7 @@ inline void DataUnit::append(const char *data)
 template<typename T>
 Q_INLINE_TEMPLATE void DataUnit::append(const T &data, ByteOrder bo)
 {
-	m_data += toDataUnitHelper<T>::toByteArray(data, bo);
+	appendToByteArrayHelper<T>::append(m_data, data, bo);
 	ensure_value();
 }
 
@@ -233,7 +271,9 @@ inline void DataUnit::append(const char *data, QTextCodec *codec)
 template<typename L>
 Q_INLINE_TEMPLATE void DataUnit::append(const QByteArray &data, ByteOrder bo)
 {
-	m_data += toDataUnitHelper<L>::toByteArray(data, bo);
+	m_data.reserve(m_data.size() + sizeof(L) + data.size());
+	appendToByteArrayHelper<L>::append(m_data, data.size(), bo);
+	m_data += data;
 	ensure_value();
 }
 
@@ -277,9 +317,12 @@ struct fromDataUnitHelper<T, true>
 	static inline T fromByteArray(const DataUnit &d, ByteOrder bo = BigEndian)
 	{
 		int state = d.state();
-		d.skipData(sizeof(T));
-		if (state >= d.data().size())
+		if (d.dataSize() < sizeof(T)) {
+			d.setError();
+			d.skipData(sizeof(T));
 			return 0;
+		}
+		d.skipData(sizeof(T));
 		return bo == BigEndian ?
 					qFromBigEndian<T>((const uchar *) d.data().constData() + state) :
 					qFromLittleEndian<T>((const uchar *) d.data().constData() + state);
@@ -292,8 +335,10 @@ struct fromDataUnitHelper<qint8, true>
 	static inline qint8 fromByteArray(const DataUnit &d, ByteOrder bo = BigEndian) // TODO: remove bo
 	{
 		Q_UNUSED(bo);
-		if (d.dataSize() < 1)
+		if (d.dataSize() < 1) {
+			d.setError();
 			return 0;
+		}
 		d.skipData(1);
 		return d.data().at(d.state()-1);
 	}
@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "ireen_global.h"
+#include <QStringList>
+
+namespace Ireen {
+
+signed char debugLevels[DebugCategoriesCount] = {
+	DebugInfo, DebugInfo, DebugInfo, DebugInfo, DebugInfo, DebugInfo
+};
+
+static const char * const categoryNames[DebugCategoriesCount] = {
+	"general", "connection", "roster", "messages", "metainfo", "filetransfer"
+};
+
+static DebugLevel toDebugLevel(const QString &str)
+{
+	bool ok;
+	int level = str.toInt(&ok);
+	if (!ok)
+		return DebugInfo;
+	return static_cast<DebugLevel>(qBound<int>(DebugDisabled, level, DebugVeryVerbose));
+}
+
+struct DebugLevelsInitializer
+{
+	DebugLevelsInitializer()
+	{
+		QByteArray env = qgetenv("IREEN_DEBUG");
+		if (env.isEmpty())
+			return;
+		foreach (const QString &item, QString::fromLatin1(env).split(',', QString::SkipEmptyParts)) {
+			int index = item.indexOf(':');
+			if (index == -1) {
+				setDebugLevel(toDebugLevel(item));
+				continue;
+			}
+			QString name = item.left(index).trimmed();
+			for (int i = 0; i < DebugCategoriesCount; ++i) {
+				if (name == QLatin1String(categoryNames[i]))
+					setDebugLevel(static_cast<DebugCategory>(i), toDebugLevel(item.mid(index + 1)));
+			}
+		}
+	}
+};
+
+static DebugLevelsInitializer debugLevelsInitializer;
+
+void setDebugLevel(DebugCategory category, DebugLevel level)
+{
+	Q_ASSERT(category >= 0 && category < DebugCategoriesCount);
+	// The applications check only the runtime level, the messages above
+	// the maximum level are not compiled in anyway
+	debugLevels[category] = qMin<int>(level, IREEN_DEBUG_MAX_LEVEL);
+}
+
+void setDebugLevel(DebugLevel level)
+{
+	for (int i = 0; i < DebugCategoriesCount; ++i)
+		setDebugLevel(static_cast<DebugCategory>(i), level);
+}
+
+DebugLevel debugLevel(DebugCategory category)
+{
+	Q_ASSERT(category >= 0 && category < DebugCategoriesCount);
+	return static_cast<DebugLevel>(debugLevels[category]);
+}
+
+DebugLevel debugMaxLevel()
+{
+	return IREEN_DEBUG_MAX_LEVEL;
+}
+
+} // namespace Ireen
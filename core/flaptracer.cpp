@@ -0,0 +1,279 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "flaptracer.h"
+#include "abstractconnection_p.h"
+#include <QThread>
+#include <QFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QSet>
+
+namespace Ireen {
+
+static const char captureMagic[] = "IRTR";
+static const quint16 captureVersion = 2;
+
+class FlapTracerPrivate;
+
+class FlapTraceWriter : public QThread
+{
+public:
+	FlapTraceWriter(FlapTracerPrivate *d) : d(d) {}
+protected:
+	void run();
+private:
+	FlapTracerPrivate *d;
+};
+
+class FlapTracerPrivate
+{
+public:
+	// The indices run over twice the ring size to tell a full ring from an empty one
+	enum { RingSize = 4096, IndexMask = RingSize * 2 - 1 };
+	struct Record
+	{
+		quint32 time;
+		quint8 type;
+		quint16 connection;
+		quint8 channel;
+		quint16 sequence;
+		QByteArray data;
+	};
+	FlapTracerPrivate() : writer(this), producer(0), isOpen(false) {}
+	void push(quint8 type, quint16 connection, quint8 channel, quint16 sequence, const QByteArray &data);
+	bool drain();
+	// Written by the producer only
+	QAtomicInt head;
+	// Written by the writer thread only
+	QAtomicInt tail;
+	QAtomicInt dropped;
+	QAtomicInt stopped;
+	Record ring[RingSize];
+	QFile file;
+	QDataStream out;
+	QTime time;
+	FlapTraceWriter writer;
+	// Class names of the connections by their ids, empty for the free ids
+	QList<QByteArray> connections;
+	QList<quint16> freeIds;
+	QThread *producer;
+	bool isOpen;
+};
+
+void FlapTracerPrivate::push(quint8 type, quint16 connection, quint8 channel,
+							 quint16 sequence, const QByteArray &data)
+{
+	Q_ASSERT_X(!producer || producer == QThread::currentThread(), "FlapTracer",
+			   "the traced connections live in different threads");
+	int h = head;
+	int t = tail.fetchAndAddAcquire(0);
+	if (((h - t) & IndexMask) == RingSize) {
+		dropped.ref();
+		return;
+	}
+	Record &record = ring[h & (RingSize - 1)];
+	record.time = time.elapsed();
+	record.type = type;
+	record.connection = connection;
+	record.channel = channel;
+	record.sequence = sequence;
+	record.data = data;
+	head.fetchAndStoreRelease((h + 1) & IndexMask);
+}
+
+bool FlapTracerPrivate::drain()
+{
+	int t = tail;
+	int h = head.fetchAndAddAcquire(0);
+	if (t == h)
+		return false;
+	while (t != h) {
+		Record &record = ring[t & (RingSize - 1)];
+		out << record.time << record.type << record.connection << record.channel
+			<< record.sequence << quint16(record.data.size());
+		out.writeRawData(record.data.constData(), record.data.size());
+		record.data = QByteArray();
+		t = (t + 1) & IndexMask;
+		tail.fetchAndStoreRelease(t);
+	}
+	return true;
+}
+
+void FlapTraceWriter::run()
+{
+	forever {
+		bool stop = d->stopped.fetchAndAddAcquire(0);
+		if (!d->drain()) {
+			if (stop)
+				break;
+			msleep(20);
+		}
+	}
+	d->file.flush();
+}
+
+FlapTracer::FlapTracer() :
+	d(new FlapTracerPrivate)
+{
+}
+
+FlapTracer::~FlapTracer()
+{
+	close();
+}
+
+bool FlapTracer::open(const QString &fileName)
+{
+	close();
+	d->file.setFileName(fileName);
+	if (!d->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		debug(ConnectionDebug) << "Cannot open the capture file" << fileName << d->file.errorString();
+		return false;
+	}
+	QDateTime now = QDateTime::currentDateTime();
+	d->out.setDevice(&d->file);
+	d->out.writeRawData(captureMagic, 4);
+	d->out << captureVersion << quint64(now.toTime_t()) * 1000 + now.time().msec();
+	d->time.start();
+	d->head = 0;
+	d->tail = 0;
+	d->dropped = 0;
+	d->stopped = 0;
+	d->isOpen = true;
+	for (int i = 0; i < d->connections.size(); ++i) {
+		if (!d->connections.at(i).isEmpty())
+			d->push(ConnectionRecord, i, 0, 0, d->connections.at(i));
+	}
+	d->writer.start(QThread::LowPriority);
+	return true;
+}
+
+void FlapTracer::close()
+{
+	if (!d->isOpen)
+		return;
+	d->isOpen = false;
+	d->stopped.fetchAndStoreRelease(1);
+	d->writer.wait();
+	d->out.setDevice(0);
+	d->file.close();
+	if (d->dropped != 0)
+		debug(ConnectionDebug) << int(d->dropped) << "FLAPs were not traced";
+}
+
+bool FlapTracer::isOpen() const
+{
+	return d->isOpen;
+}
+
+int FlapTracer::droppedCount() const
+{
+	return d->dropped;
+}
+
+quint16 FlapTracer::registerConnection(const AbstractConnection *connection)
+{
+	if (!d->producer)
+		d->producer = connection->thread();
+	Q_ASSERT_X(d->producer == connection->thread(), "FlapTracer",
+			   "the traced connections live in different threads");
+	QByteArray className = connection->metaObject()->className();
+	quint16 id;
+	if (!d->freeIds.isEmpty()) {
+		id = d->freeIds.takeFirst();
+		d->connections[id] = className;
+	} else {
+		Q_ASSERT(d->connections.size() < 0x10000);
+		id = d->connections.size();
+		d->connections << className;
+	}
+	if (d->isOpen)
+		d->push(ConnectionRecord, id, 0, 0, className);
+	return id;
+}
+
+void FlapTracer::unregisterConnection(quint16 connection)
+{
+	if (connection >= d->connections.size() || d->connections.at(connection).isEmpty())
+		return;
+	d->connections[connection] = QByteArray();
+	d->freeIds << connection;
+}
+
+void FlapTracer::trace(quint16 connection, RecordType type, const FLAP &flap)
+{
+	if (d->isOpen)
+		d->push(type, connection, flap.channel(), flap.seqNum(), flap.data());
+}
+
+int FlapTracer::replay(const QString &fileName, AbstractConnection *connection)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return -1;
+	QDataStream in(&file);
+	char magic[4];
+	quint16 version;
+	quint64 startTime;
+	if (in.readRawData(magic, 4) != 4 || qstrncmp(magic, captureMagic, 4) != 0)
+		return -1;
+	in >> version >> startTime;
+	if (version != captureVersion)
+		return -1;
+
+	QByteArray className = connection->metaObject()->className();
+	AbstractConnectionPrivate *p = connection->d_func();
+	QSet<quint16> connections;
+	int count = 0;
+	while (!in.atEnd()) {
+		quint32 time;
+		quint8 type, channel;
+		quint16 id, sequence, length;
+		in >> time >> type >> id >> channel >> sequence >> length;
+		QByteArray data(length, '\0');
+		if (in.readRawData(data.data(), length) != length)
+			break;
+		if (type == ConnectionRecord) {
+			if (data == className)
+				connections.insert(id);
+			else
+				connections.remove(id);
+		} else if (type == IncomingRecord && channel == 0x02 && connections.contains(id)) {
+			// Only SNACs are replayed, the login and the disconnection
+			// would change the state of the connection
+			FLAP flap(channel);
+			flap.setSeqNum(sequence);
+			flap.append(data);
+			p->flap = flap;
+			connection->processSnac();
+			p->flap.clear();
+			++count;
+		}
+	}
+	return count;
+}
+
+} // namespace Ireen
@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_FLAPTRACER_H
+#define IREEN_FLAPTRACER_H
+
+#include <QScopedPointer>
+#include "flap.h"
+
+namespace Ireen {
+
+class AbstractConnection;
+class FlapTracerPrivate;
+
+// Writes FLAPs of the connections to a binary capture file.
+// The FLAPs are queued in a single-producer ring and written by a background
+// thread, so all traced connections must live in the same thread. Processes
+// with clients in several threads (see ClientShardPool) need a tracer per thread.
+//
+// File format (big endian):
+//   header: "IRTR", quint16 version, quint64 capture start in msecs since epoch
+//   record: quint32 msecs since capture start, quint8 record type,
+//           quint16 connection id, quint8 channel, quint16 sequence,
+//           quint16 data length, data
+// A ConnectionRecord carries the class name of the connection as its data.
+// The ids of destroyed connections are reused, a new ConnectionRecord
+// is written every time an id is given to another connection.
+class IREEN_EXPORT FlapTracer
+{
+	Q_DISABLE_COPY(FlapTracer)
+public:
+	enum RecordType
+	{
+		IncomingRecord,
+		OutgoingRecord,
+		ConnectionRecord
+	};
+	FlapTracer();
+	~FlapTracer();
+	bool open(const QString &fileName);
+	void close();
+	bool isOpen() const;
+	// Number of records dropped because the writer did not keep up
+	int droppedCount() const;
+	quint16 registerConnection(const AbstractConnection *connection);
+	void unregisterConnection(quint16 connection);
+	void trace(quint16 connection, RecordType type, const FLAP &flap);
+	// Feeds incoming SNACs of the captured connections with the same class
+	// as the connection through its handlers. The other channels are skipped,
+	// so the state of the connection is not changed by the replay.
+	// Returns the number of replayed SNACs or -1 if the file is not a capture file.
+	static int replay(const QString &fileName, AbstractConnection *connection);
+private:
+	QScopedPointer<FlapTracerPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_FLAPTRACER_H
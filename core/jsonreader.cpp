@@ -0,0 +1,278 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "jsonreader.h"
+
+namespace Ireen {
+
+JsonReader::JsonReader(const QByteArray &data) :
+	m_data(data),
+	m_pos(m_data.constData()),
+	m_end(m_data.constData() + m_data.size()),
+	m_token(Invalid),
+	m_valueBegin(0),
+	m_valueEnd(0),
+	m_escaped(false)
+{
+}
+
+void JsonReader::skipBlanks()
+{
+	while (m_pos < m_end) {
+		char c = *m_pos;
+		if (c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != ',')
+			break;
+		++m_pos;
+	}
+}
+
+JsonReader::Token JsonReader::next()
+{
+	if (m_token == Invalid && m_valueBegin)
+		return Invalid;
+	skipBlanks();
+	if (m_pos >= m_end)
+		return m_token = End;
+	m_valueBegin = m_pos;
+	char c = *m_pos++;
+	switch (c) {
+	case '{':
+		m_token = BeginObject;
+		break;
+	case '}':
+		m_token = EndObject;
+		break;
+	case '[':
+		m_token = BeginArray;
+		break;
+	case ']':
+		m_token = EndArray;
+		break;
+	case '"': {
+		m_escaped = false;
+		m_valueBegin = m_pos;
+		while (m_pos < m_end && *m_pos != '"') {
+			if (*m_pos == '\\') {
+				m_escaped = true;
+				++m_pos;
+			}
+			++m_pos;
+		}
+		if (m_pos >= m_end)
+			return m_token = Invalid;
+		m_valueEnd = m_pos++;
+		while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\r' || *m_pos == '\n'))
+			++m_pos;
+		if (m_pos < m_end && *m_pos == ':') {
+			++m_pos;
+			m_token = Name;
+		} else {
+			m_token = String;
+		}
+		return m_token;
+	}
+	case 't':
+	case 'f':
+	case 'n':
+		while (m_pos < m_end && *m_pos >= 'a' && *m_pos <= 'z')
+			++m_pos;
+		m_valueEnd = m_pos;
+		if (m_valueEnd - m_valueBegin == 4 && !qstrncmp(m_valueBegin, "true", 4))
+			m_token = Bool;
+		else if (m_valueEnd - m_valueBegin == 5 && !qstrncmp(m_valueBegin, "false", 5))
+			m_token = Bool;
+		else if (m_valueEnd - m_valueBegin == 4 && !qstrncmp(m_valueBegin, "null", 4))
+			m_token = Null;
+		else
+			m_token = Invalid;
+		return m_token;
+	default:
+		if (c != '-' && (c < '0' || c > '9'))
+			return m_token = Invalid;
+		while (m_pos < m_end) {
+			c = *m_pos;
+			if ((c < '0' || c > '9') && c != '.' && c != 'e' && c != 'E' && c != '-' && c != '+')
+				break;
+			++m_pos;
+		}
+		m_valueEnd = m_pos;
+		return m_token = Number;
+	}
+	m_valueEnd = m_pos;
+	return m_token;
+}
+
+static inline int hexValue(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return 0;
+}
+
+QString JsonReader::string() const
+{
+	if (m_token != Name && m_token != String)
+		return QString();
+	if (!m_escaped)
+		return QString::fromUtf8(m_valueBegin, m_valueEnd - m_valueBegin);
+	QString result;
+	result.reserve(m_valueEnd - m_valueBegin);
+	const char *begin = m_valueBegin;
+	const char *p = m_valueBegin;
+	while (p < m_valueEnd) {
+		if (*p != '\\') {
+			++p;
+			continue;
+		}
+		result += QString::fromUtf8(begin, p - begin);
+		if (++p >= m_valueEnd)
+			break;
+		switch (*p) {
+		case 'b':
+			result += QLatin1Char('\b');
+			break;
+		case 'f':
+			result += QLatin1Char('\f');
+			break;
+		case 'n':
+			result += QLatin1Char('\n');
+			break;
+		case 'r':
+			result += QLatin1Char('\r');
+			break;
+		case 't':
+			result += QLatin1Char('\t');
+			break;
+		case 'u':
+			if (m_valueEnd - p > 4) {
+				ushort code = 0;
+				for (int i = 1; i <= 4; ++i)
+					code = (code << 4) | hexValue(p[i]);
+				// Surrogate pairs are simply written one after another
+				result += QChar(code);
+				p += 4;
+			}
+			break;
+		default:
+			result += QLatin1Char(*p);
+			break;
+		}
+		begin = ++p;
+	}
+	result += QString::fromUtf8(begin, m_valueEnd - begin);
+	return result;
+}
+
+QVariant JsonReader::value() const
+{
+	switch (m_token) {
+	case String:
+		return string();
+	case Bool:
+		return *m_valueBegin == 't';
+	case Number: {
+		QByteArray number = QByteArray::fromRawData(m_valueBegin, m_valueEnd - m_valueBegin);
+		bool ok;
+		if (number.contains('.') || number.contains('e') || number.contains('E'))
+			return number.toDouble(&ok);
+		return number.toLongLong(&ok);
+	}
+	default:
+		return QVariant();
+	}
+}
+
+void JsonReader::skipValue()
+{
+	if (m_token != BeginObject && m_token != BeginArray)
+		return;
+	int depth = 1;
+	while (depth > 0) {
+		switch (next()) {
+		case BeginObject:
+		case BeginArray:
+			++depth;
+			break;
+		case EndObject:
+		case EndArray:
+			--depth;
+			break;
+		case Invalid:
+		case End:
+			return;
+		default:
+			break;
+		}
+	}
+}
+
+QHash<QByteArray, QVariant> JsonReader::readFields(const QByteArray &data, const QSet<QByteArray> &paths)
+{
+	QHash<QByteArray, QVariant> fields;
+	// Objects on the way to the requested values
+	QSet<QByteArray> prefixes;
+	foreach (const QByteArray &path, paths) {
+		for (int i = path.indexOf('/'); i != -1; i = path.indexOf('/', i + 1))
+			prefixes.insert(path.left(i));
+	}
+	JsonReader reader(data);
+	if (reader.next() != BeginObject)
+		return fields;
+	QByteArray path;
+	QList<int> pathLengths;
+	while (true) {
+		Token token = reader.next();
+		if (token == EndObject) {
+			if (pathLengths.isEmpty())
+				break;
+			path.truncate(pathLengths.takeLast());
+			continue;
+		}
+		if (token != Name)
+			break;
+		QByteArray name = path;
+		if (!name.isEmpty())
+			name += '/';
+		name += reader.string().toUtf8();
+		token = reader.next();
+		if (token == BeginObject && prefixes.contains(name)) {
+			pathLengths.append(path.size());
+			path = name;
+		} else if (token == BeginObject || token == BeginArray) {
+			reader.skipValue();
+		} else if (token == Invalid || token == End) {
+			break;
+		} else if (paths.contains(name)) {
+			fields.insert(name, reader.value());
+		}
+	}
+	return fields;
+}
+
+} // namespace Ireen
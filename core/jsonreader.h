@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_JSONREADER_H
+#define IREEN_JSONREADER_H
+
+#include "ireen_global.h"
+#include <QByteArray>
+#include <QVariant>
+#include <QHash>
+#include <QSet>
+
+namespace Ireen {
+
+// Pull parser walking over the JSON document without building
+// a tree of variants, it trusts the document to be well-formed
+class IREEN_EXPORT JsonReader
+{
+public:
+	enum Token
+	{
+		Invalid,
+		BeginObject,
+		EndObject,
+		BeginArray,
+		EndArray,
+		Name,
+		String,
+		Number,
+		Bool,
+		Null,
+		End
+	};
+	JsonReader(const QByteArray &data);
+	Token next();
+	Token token() const { return m_token; }
+	// The name or the string value, unescaped
+	QString string() const;
+	// The value of the scalar token
+	QVariant value() const;
+	// Skips the object or the array which starts at the current token
+	void skipValue();
+	bool hasError() const { return m_token == Invalid; }
+	// Reads only the values at the paths like "response/data/token/a",
+	// the rest of the document is skipped. Arrays are not looked into.
+	static QHash<QByteArray, QVariant> readFields(const QByteArray &data, const QSet<QByteArray> &paths);
+private:
+	void skipBlanks();
+	QByteArray m_data;
+	const char *m_pos;
+	const char *m_end;
+	Token m_token;
+	const char *m_valueBegin;
+	const char *m_valueEnd;
+	bool m_escaped;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_JSONREADER_H
@@ -26,6 +26,7 @@
 
 #include "messages.h"
 #include "buddycaps.h"
+#include <QtEndian>
 
 namespace Ireen {
 
@@ -145,6 +146,21 @@ void Channel2MessageData::init(const QByteArray &message, bool utf8, const Cooki
 	init(0, tlv);
 }
 
+MessageTemplate::MessageTemplate()
+{
+}
+
+MessageTemplate::MessageTemplate(const Channel1MessageData &data, bool storeMessage, bool requestAck)
+{
+	DataUnit body;
+	body.appendTLV(0x0002, data.data());
+	if (requestAck)
+		body.appendTLV(0x0003);
+	if (storeMessage)
+		body.appendTLV(0x0006);
+	m_body = body.data();
+}
+
 ServerMessage::ServerMessage() :
 	SNAC(MessageFamily, MessageSrvSend)
 {
@@ -169,6 +185,25 @@ ServerMessage::ServerMessage(const QString &uin, const Channel2BasicMessageData
 	appendTLV(0x05, data.data());
 }
 
+ServerMessage::ServerMessage(const QString &uin, const MessageTemplate &message, const Cookie &cookie) :
+	SNAC(MessageFamily, MessageSrvSend)
+{
+	QByteArray name = Util::defaultCodec()->fromUnicode(uin);
+	if (name.size() > 0xfe)
+		name.resize(0xfe);
+	const QByteArray &body = message.body();
+	// The whole message is written into one buffer of the final size
+	QByteArray data(8 + 2 + 1 + name.size() + body.size(), Qt::Uninitialized);
+	uchar *ptr = reinterpret_cast<uchar*>(data.data());
+	qToBigEndian<quint64>(cookie.id(), ptr);
+	qToBigEndian<quint16>(message.channel(), ptr + 8);
+	ptr[10] = name.size();
+	ptr += 11;
+	memcpy(ptr, name.constData(), name.size());
+	memcpy(ptr + name.size(), body.constData(), body.size());
+	setData(data);
+}
+
 void ServerMessage::init(const QString &uin, qint16 channel, const Cookie &cookie)
 {
 	append(cookie); // cookie
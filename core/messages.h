@@ -123,12 +123,29 @@ protected:
 	void init(const QByteArray &message, bool utf8 = true, const Cookie &cookie = Cookie(true));
 };
 
+// The part of a channel 1 message which is the same for all recipients,
+// encoded once. ServerMessage only writes the cookie and the uin before it.
+class IREEN_EXPORT MessageTemplate
+{
+public:
+	MessageTemplate();
+	// With requestAck the server confirms every message by MessageSrvAck,
+	// see MessageHandler::messageAccepted()
+	MessageTemplate(const Channel1MessageData &data, bool storeMessage = true, bool requestAck = true);
+	bool isEmpty() const { return m_body.isEmpty(); }
+	quint16 channel() const { return 1; }
+	const QByteArray &body() const { return m_body; }
+private:
+	QByteArray m_body;
+};
+
 class IREEN_EXPORT ServerMessage: public SNAC
 {
 public:
 	ServerMessage();
 	ServerMessage(const QString &uin, const Channel1MessageData &data, const Cookie &cookie, bool storeMessage = true);
 	ServerMessage(const QString &uin, const Channel2BasicMessageData &data);
+	ServerMessage(const QString &uin, const MessageTemplate &message, const Cookie &cookie);
 protected:
 	void init(const QString &uin, qint16 channel, const Cookie &cookie = Cookie(true));
 };
@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_METAREPLYHANDLER_H
+#define IREEN_METAREPLYHANDLER_H
+
+#include <QObject>
+#include "dataunit.h"
+
+namespace Ireen {
+
+// The header of SNAC(ExtensionsFamily, ExtensionsMetaSrvReply) is parsed
+// only once by the client, the handlers receive the rest of the packet.
+struct MetaReply
+{
+	quint32 uin;
+	quint16 type;
+	quint16 sequence;
+	DataUnit data;
+};
+
+class IREEN_EXPORT MetaReplyHandler
+{
+public:
+	virtual ~MetaReplyHandler();
+	const QList<quint16> &metaTypes() { return m_metaTypes; }
+	virtual void handleMetaReply(const MetaReply &reply) = 0;
+protected:
+	QList<quint16> m_metaTypes;
+};
+
+} // namespace Ireen
+
+Q_DECLARE_INTERFACE(Ireen::MetaReplyHandler, "org.qutim.ireen.MetaReplyHandler")
+
+#endif // IREEN_METAREPLYHANDLER_H
@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "requesttracker.h"
+#include <QBasicTimer>
+#include <QTimerEvent>
+#include <QDateTime>
+#include <QHash>
+#include <QMap>
+#include <limits.h>
+
+namespace Ireen {
+
+typedef QPair<int, quint64> RequestKey;
+
+struct TrackedRequest
+{
+	PendingRequest request;
+	RequestContinuation *continuation;
+	QTime started;
+	qint64 deadline;
+};
+
+class RequestTrackerPrivate
+{
+public:
+	RequestTrackerPrivate(RequestTracker *q) : q(q) {}
+	static qint64 currentMsecs();
+	static quint64 statisticsKey(int type, quint32 kind) { return (quint64(type) << 32) | kind; }
+	bool take(const RequestKey &key, TrackedRequest &tracked);
+	void account(const TrackedRequest &tracked);
+	void resolve(TrackedRequest &tracked, PendingRequest::Status status);
+	void updateTimer();
+	RequestTracker *q;
+	QHash<RequestKey, TrackedRequest> requests;
+	QMultiMap<qint64, RequestKey> deadlines;
+	QHash<quint64, RequestStatistics> statistics;
+	QBasicTimer timer;
+};
+
+qint64 RequestTrackerPrivate::currentMsecs()
+{
+	QDateTime now = QDateTime::currentDateTime();
+	return qint64(now.toTime_t()) * 1000 + now.time().msec();
+}
+
+bool RequestTrackerPrivate::take(const RequestKey &key, TrackedRequest &tracked)
+{
+	QHash<RequestKey, TrackedRequest>::iterator itr = requests.find(key);
+	if (itr == requests.end())
+		return false;
+	tracked = *itr;
+	requests.erase(itr);
+	deadlines.remove(tracked.deadline, key);
+	RequestStatistics &stats = statistics[statisticsKey(key.first, tracked.request.kind())];
+	--stats.inFlight;
+	return true;
+}
+
+void RequestTrackerPrivate::account(const TrackedRequest &tracked)
+{
+	const PendingRequest &request = tracked.request;
+	RequestStatistics &stats = statistics[statisticsKey(request.type(), request.kind())];
+	switch (request.status()) {
+	case PendingRequest::Finished: {
+		++stats.finished;
+		int bucket = 0;
+		while (bucket < RequestStatistics::BucketsCount - 1 &&
+			   request.latency() >= RequestStatistics::bucketLimit(bucket))
+		{
+			++bucket;
+		}
+		++stats.histogram[bucket];
+		break;
+	}
+	case PendingRequest::TimedOut:
+		++stats.timedOut;
+		break;
+	case PendingRequest::Canceled:
+		++stats.canceled;
+		break;
+	default:
+		break;
+	}
+}
+
+void RequestTrackerPrivate::resolve(TrackedRequest &tracked, PendingRequest::Status status)
+{
+	tracked.request.m_status = status;
+	tracked.request.m_latency = tracked.started.elapsed();
+	account(tracked);
+	if (status != PendingRequest::Canceled && tracked.continuation)
+		tracked.continuation->resolve(tracked.request);
+	delete tracked.continuation;
+}
+
+void RequestTrackerPrivate::updateTimer()
+{
+	if (deadlines.isEmpty()) {
+		timer.stop();
+		return;
+	}
+	qint64 delay = deadlines.constBegin().key() - currentMsecs();
+	timer.start(int(qBound<qint64>(0, delay, INT_MAX)), q);
+}
+
+PendingRequest::PendingRequest() :
+	m_type(CookieKey), m_id(0), m_kind(0), m_status(Waiting), m_latency(0)
+{
+}
+
+RequestContinuation::~RequestContinuation()
+{
+}
+
+RequestStatistics::RequestStatistics() :
+	inFlight(0), finished(0), timedOut(0), canceled(0)
+{
+	qMemSet(histogram, 0, sizeof(histogram));
+}
+
+int RequestStatistics::bucketLimit(int bucket)
+{
+	static const int limits[BucketsCount] = {
+		50, 100, 200, 500, 1000, 2000, 5000, 10000, 30000, INT_MAX
+	};
+	Q_ASSERT(bucket >= 0 && bucket < BucketsCount);
+	return limits[bucket];
+}
+
+RequestTracker::RequestTracker(QObject *parent) :
+	QObject(parent), d(new RequestTrackerPrivate(this))
+{
+}
+
+RequestTracker::~RequestTracker()
+{
+	QHash<RequestKey, TrackedRequest>::iterator itr = d->requests.begin();
+	QHash<RequestKey, TrackedRequest>::iterator endItr = d->requests.end();
+	for (; itr != endItr; ++itr)
+		delete itr->continuation;
+}
+
+void RequestTracker::start(PendingRequest::KeyType type, quint64 id, int msec,
+						   RequestContinuation *continuation, quint32 kind)
+{
+	RequestKey key(type, id);
+	cancel(type, id);
+	TrackedRequest tracked;
+	tracked.request.m_type = type;
+	tracked.request.m_id = id;
+	tracked.request.m_kind = kind;
+	tracked.continuation = continuation;
+	tracked.started.start();
+	tracked.deadline = RequestTrackerPrivate::currentMsecs() + msec;
+	d->requests.insert(key, tracked);
+	d->deadlines.insert(tracked.deadline, key);
+	++d->statistics[RequestTrackerPrivate::statisticsKey(type, kind)].inFlight;
+	if (d->deadlines.constBegin().key() == tracked.deadline)
+		d->updateTimer();
+}
+
+bool RequestTracker::finish(PendingRequest::KeyType type, quint64 id)
+{
+	TrackedRequest tracked;
+	if (!d->take(RequestKey(type, id), tracked))
+		return false;
+	d->updateTimer();
+	d->resolve(tracked, PendingRequest::Finished);
+	return true;
+}
+
+bool RequestTracker::cancel(PendingRequest::KeyType type, quint64 id)
+{
+	TrackedRequest tracked;
+	if (!d->take(RequestKey(type, id), tracked))
+		return false;
+	d->updateTimer();
+	d->resolve(tracked, PendingRequest::Canceled);
+	return true;
+}
+
+bool RequestTracker::contains(PendingRequest::KeyType type, quint64 id) const
+{
+	return d->requests.contains(RequestKey(type, id));
+}
+
+int RequestTracker::inFlightCount(PendingRequest::KeyType type) const
+{
+	int count = 0;
+	QHash<quint64, RequestStatistics>::const_iterator itr = d->statistics.constBegin();
+	QHash<quint64, RequestStatistics>::const_iterator endItr = d->statistics.constEnd();
+	for (; itr != endItr; ++itr) {
+		if (int(itr.key() >> 32) == type)
+			count += itr->inFlight;
+	}
+	return count;
+}
+
+QList<quint32> RequestTracker::kinds(PendingRequest::KeyType type) const
+{
+	QList<quint32> list;
+	foreach (quint64 key, d->statistics.keys()) {
+		if (int(key >> 32) == type)
+			list << quint32(key);
+	}
+	return list;
+}
+
+RequestStatistics RequestTracker::statistics(PendingRequest::KeyType type, quint32 kind) const
+{
+	return d->statistics.value(RequestTrackerPrivate::statisticsKey(type, kind));
+}
+
+void RequestTracker::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != d->timer.timerId()) {
+		QObject::timerEvent(event);
+		return;
+	}
+	// Take all expired requests first, as continuations are free to start new ones
+	QList<TrackedRequest> expired;
+	qint64 now = RequestTrackerPrivate::currentMsecs();
+	while (!d->deadlines.isEmpty() && d->deadlines.constBegin().key() <= now) {
+		TrackedRequest tracked;
+		d->take(d->deadlines.constBegin().value(), tracked);
+		expired << tracked;
+	}
+	d->updateTimer();
+	for (int i = 0; i < expired.size(); ++i) {
+		debug(ConnectionDebug, DebugVerbose) << "Request" << expired.at(i).request.id() << "of type"
+							<< expired.at(i).request.type() << "timed out";
+		d->resolve(expired[i], PendingRequest::TimedOut);
+	}
+}
+
+} // namespace Ireen
@@ -0,0 +1,141 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_REQUESTTRACKER_H
+#define IREEN_REQUESTTRACKER_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include "ireen_global.h"
+
+namespace Ireen {
+
+class RequestTracker;
+class RequestTrackerPrivate;
+
+class IREEN_EXPORT PendingRequest
+{
+public:
+	enum KeyType
+	{
+		CookieKey,
+		SnacKey,
+		MetaSequenceKey
+	};
+	enum Status
+	{
+		Waiting,
+		Finished,
+		TimedOut,
+		Canceled
+	};
+	PendingRequest();
+	KeyType type() const { return m_type; }
+	quint64 id() const { return m_id; }
+	// The kind of the request, which the statistics is collected for,
+	// for example the type of a meta request
+	quint32 kind() const { return m_kind; }
+	Status status() const { return m_status; }
+	// Msecs between the start of the request and its resolution
+	int latency() const { return m_latency; }
+private:
+	friend class RequestTracker;
+	friend class RequestTrackerPrivate;
+	KeyType m_type;
+	quint64 m_id;
+	quint32 m_kind;
+	Status m_status;
+	int m_latency;
+};
+
+// Is called once, when the request is finished or timed out.
+// Canceled requests are dropped without calling the continuation.
+class IREEN_EXPORT RequestContinuation
+{
+public:
+	virtual ~RequestContinuation();
+	virtual void resolve(const PendingRequest &request) = 0;
+};
+
+template <typename T>
+class MemberContinuation : public RequestContinuation
+{
+public:
+	typedef void (T::*Method)(const PendingRequest &request);
+	MemberContinuation(T *object, Method method) : m_object(object), m_method(method) {}
+	void resolve(const PendingRequest &request) { (m_object->*m_method)(request); }
+private:
+	T *m_object;
+	Method m_method;
+};
+
+template <typename T>
+inline RequestContinuation *continuation(T *object, void (T::*method)(const PendingRequest &))
+{
+	return new MemberContinuation<T>(object, method);
+}
+
+struct IREEN_EXPORT RequestStatistics
+{
+	enum { BucketsCount = 10 };
+	RequestStatistics();
+	int inFlight;
+	quint32 finished;
+	quint32 timedOut;
+	quint32 canceled;
+	// The number of finished requests with the latency below bucketLimit(i)
+	// and not below the previous limit
+	quint32 histogram[BucketsCount];
+	static int bucketLimit(int bucket);
+};
+
+// Correlates requests with their replies and handles their deadlines
+// using a single timer.
+class IREEN_EXPORT RequestTracker : public QObject
+{
+	Q_OBJECT
+public:
+	RequestTracker(QObject *parent = 0);
+	virtual ~RequestTracker();
+	// Starts tracking of the request, the tracker takes the ownership of the continuation.
+	// The previous request with the same key is canceled.
+	void start(PendingRequest::KeyType type, quint64 id, int msec,
+			   RequestContinuation *continuation = 0, quint32 kind = 0);
+	// Both return false if the request is not tracked
+	bool finish(PendingRequest::KeyType type, quint64 id);
+	bool cancel(PendingRequest::KeyType type, quint64 id);
+	bool contains(PendingRequest::KeyType type, quint64 id) const;
+	int inFlightCount(PendingRequest::KeyType type) const;
+	QList<quint32> kinds(PendingRequest::KeyType type) const;
+	RequestStatistics statistics(PendingRequest::KeyType type, quint32 kind) const;
+protected:
+	void timerEvent(QTimerEvent *event);
+private:
+	QScopedPointer<RequestTrackerPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_REQUESTTRACKER_H
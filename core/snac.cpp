@@ -59,8 +59,13 @@ SNAC SNAC::fromByteArray(const QByteArray &d)
 	if (snac.m_flags & 0x8000) {
 		// Some unknown data
 		int offset = snac.read<quint16>() + 2; // sizeof(quint16)
+		// The length of the unknown data may be broken, so it is
+		// not allowed to point past the end of the snac
+		if (offset > snac.m_data.size())
+			offset = snac.m_data.size();
 		snac.m_data = QByteArray::fromRawData(snac.m_data.constData() + offset,
 											  snac.m_data.size() - offset);
+		snac.resetState();
 	}
 	return snac;
 }
@@ -51,6 +51,7 @@ public:
 	QByteArray header() const;
 	inline operator QByteArray() const { return toByteArray(); }
 	inline bool isEmpty() const { return m_family == 0 && m_subtype == 0; }
+	inline const Cookie &cookie() const { return m_cookie; }
 	void setCookie(const Cookie &cookie, QObject *receiver = 0, const char *member = 0, int msec = 30000);
 	void lock();
 private:
@@ -40,6 +40,7 @@ quint32 TLVMap::valuesSize() const
 TLVMap::operator QByteArray() const
 {
 	QByteArray data;
+	data.reserve(valuesSize());
 	foreach(const TLV &tlv, *this)
 		data += tlv;
 	return data;
@@ -93,10 +93,12 @@ Q_INLINE_TEMPLATE TLV::TLV(quint16 type, const T &data):
 
 QByteArray TLV::toByteArray(ByteOrder bo) const
 {
-	DataUnit data;
-	data.append<quint16>(m_type, bo);
-	data.append<quint16>(m_data, bo);
-	return data.data();
+	QByteArray data;
+	data.reserve(m_data.size() + 4);
+	appendToByteArrayHelper<quint16>::append(data, m_type, bo);
+	appendToByteArrayHelper<quint16>::append(data, m_data.size(), bo);
+	data += m_data;
+	return data;
 }
 
 TLV TLV::fromByteArray(const QByteArray &data, ByteOrder bo)
@@ -174,13 +176,12 @@ struct fromDataUnitHelper<TLV>
 	static inline TLV fromByteArray(const DataUnit &d, ByteOrder bo = BigEndian)
 	{
 		TLV tlv(0xffff);
-		if (d.dataSize() < 4)
+		if (d.dataSize() == 0)
 			return tlv;
 		tlv.setType(d.read<quint16>(bo));
-		if (d.dataSize() < 2)
+		tlv.append(d.read<QByteArray, quint16>(bo));
+		if (d.hasError())
 			tlv.setType(0xffff);
-		else
-			tlv.append(d.read<QByteArray, quint16>(bo));
 		return tlv;
 	}
 };
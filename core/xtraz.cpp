@@ -25,26 +25,26 @@
 ****************************************************************************/
 
 #include "xtraz.h"
-#include <QXmlStreamWriter>
+#include "xtraz_p.h"
 
 namespace Ireen {
 
 class XtrazRequestPacket: public ServerMessage
 {
 public:
-	XtrazRequestPacket(const QString &uin, const QString &query, const QString &notify);
+	XtrazRequestPacket(const QString &uin, const QByteArray &body);
 };
 
 class XtrazResponsePacket: public ServerResponseMessage
 {
 public:
-	XtrazResponsePacket(const QString &uin, const QString &response, const Cookie &cookie);
+	XtrazResponsePacket(const QString &uin, const QByteArray &body, const Cookie &cookie);
 };
 
 class XtrazData: public Tlv2711
 {
 public:
-	XtrazData(const QString &body, const Cookie &cookie = Cookie(true));
+	XtrazData(const QByteArray &body, const Cookie &cookie = Cookie(true));
 };
 
 class XtrazDataPrivate : public QSharedData
@@ -53,28 +53,28 @@ public:
 	QString service;
 	QHash<QString, QString> data;
 protected:
-	void parseData(QXmlStreamReader &xml);
+	void parseData(XtrazReader &xml);
 };
 
 class XtrazRequestPrivate : public XtrazDataPrivate
 {
 public:
 	QString pluginId;
-	void parse(const QString &query, const QString &notify);
+	void parse(XtrazReader &query, XtrazReader &notify);
 private:
-	void parseQuery(const QString &query);
-	void parseNotify(const QString &notify);
-	void parseSrv(QXmlStreamReader &xml);
+	void parseQuery(XtrazReader &xml);
+	void parseNotify(XtrazReader &xml);
+	void parseSrv(XtrazReader &xml);
 };
 
 class XtrazResponsePrivate : public XtrazDataPrivate
 {
 public:
 	QString event;
-	void parse(const QString &response);
-	void parseRet(QXmlStreamReader &xml);
-	void parseSrv(QXmlStreamReader &xml);
-	void parseVal(QXmlStreamReader &xml);
+	void parse(XtrazReader &xml);
+	void parseRet(XtrazReader &xml);
+	void parseSrv(XtrazReader &xml);
+	void parseVal(XtrazReader &xml);
 };
 
 class XtrazPrivate : public QSharedData
@@ -87,7 +87,387 @@ public:
 	QScopedPointer<XtrazResponse> response;
 };
 
-XtrazData::XtrazData(const QString &body, const Cookie &cookie) :
+static inline bool isXmlSpace(int ch)
+{
+	return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+static const char *xmlEntity(char ch, bool attribute)
+{
+	switch (ch) {
+	case '<': return "&lt;";
+	case '>': return "&gt;";
+	case '&': return "&amp;";
+	case '"': return "&quot;";
+	case '\n': return attribute ? "&#10;" : 0;
+	case '\r': return attribute ? "&#13;" : 0;
+	case '\t': return attribute ? "&#9;" : 0;
+	default: return 0;
+	}
+}
+
+static void appendUtf8(QByteArray &out, uint code)
+{
+	if (code < 0x80) {
+		out += static_cast<char>(code);
+	} else if (code < 0x800) {
+		out += static_cast<char>(0xc0 | (code >> 6));
+		out += static_cast<char>(0x80 | (code & 0x3f));
+	} else if (code < 0x10000) {
+		out += static_cast<char>(0xe0 | (code >> 12));
+		out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+		out += static_cast<char>(0x80 | (code & 0x3f));
+	} else {
+		out += static_cast<char>(0xf0 | (code >> 18));
+		out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+		out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+		out += static_cast<char>(0x80 | (code & 0x3f));
+	}
+}
+
+// Appends the character referenced by the entity; unknown entities are kept as is
+static void appendEntity(QByteArray &out, const QByteArray &entity)
+{
+	bool ok = true;
+	if (entity == "lt") {
+		out += '<';
+	} else if (entity == "gt") {
+		out += '>';
+	} else if (entity == "amp") {
+		out += '&';
+	} else if (entity == "quot") {
+		out += '"';
+	} else if (entity == "apos") {
+		out += '\'';
+	} else if (entity.startsWith("#x")) {
+		appendUtf8(out, entity.mid(2).toUInt(&ok, 16));
+	} else if (entity.startsWith('#')) {
+		appendUtf8(out, entity.mid(1).toUInt(&ok));
+	} else {
+		ok = false;
+	}
+	if (!ok)
+		out += '&' + entity + ';';
+}
+
+void XtrazWriter::writeStartElement(const QByteArray &name)
+{
+	closeStartTag();
+	writeMarkup('<');
+	*m_buffer += name;
+	m_elements << name;
+	m_inStartTag = true;
+}
+
+void XtrazWriter::writeAttribute(const QByteArray &name, const QString &value)
+{
+	Q_ASSERT(m_inStartTag);
+	// Embedded documents use apostrophes, as the quotes are escaped in them
+	char quote = m_level ? '\'' : '"';
+	*m_buffer += ' ';
+	*m_buffer += name;
+	*m_buffer += '=';
+	*m_buffer += quote;
+	QByteArray data = value.toUtf8();
+	for (int i = 0; i < data.size(); ++i)
+		writeEscaped(data.at(i), m_level + 1, true);
+	*m_buffer += quote;
+}
+
+void XtrazWriter::writeCharacters(const QString &text)
+{
+	closeStartTag();
+	QByteArray data = text.toUtf8();
+	for (int i = 0; i < data.size(); ++i)
+		writeEscaped(data.at(i), m_level + 1, false);
+}
+
+void XtrazWriter::writeTextElement(const QByteArray &name, const QString &text)
+{
+	writeStartElement(name);
+	writeCharacters(text);
+	writeEndElement();
+}
+
+void XtrazWriter::writeEndElement()
+{
+	closeStartTag();
+	writeMarkup('<');
+	writeMarkup('/');
+	*m_buffer += m_elements.takeLast();
+	writeMarkup('>');
+}
+
+void XtrazWriter::writeMarkup(char ch)
+{
+	writeEscaped(ch, m_level, false);
+}
+
+void XtrazWriter::writeEscaped(char ch, int times, bool attribute)
+{
+	const char *entity = times > 0 ? xmlEntity(ch, attribute) : 0;
+	if (!entity) {
+		*m_buffer += ch;
+		return;
+	}
+	// The entity itself is escaped as usual text on the outer levels
+	for (; *entity; ++entity)
+		writeEscaped(*entity, times - 1, false);
+}
+
+void XtrazWriter::closeStartTag()
+{
+	if (m_inStartTag) {
+		writeMarkup('>');
+		m_inStartTag = false;
+	}
+}
+
+XtrazReader::XtrazReader(const char *begin, const char *end, bool embedded) :
+	m_pos(begin), m_end(end), m_embedded(embedded), m_peeked(-2),
+	m_pendingPos(0), m_carriageReturn(false), m_token(Characters), m_emptyElement(false)
+{
+}
+
+XtrazReader::Token XtrazReader::readNext()
+{
+	if (m_emptyElement) {
+		m_emptyElement = false;
+		return m_token = EndElement;
+	}
+	int ch = peek();
+	if (ch < 0)
+		return m_token = EndDocument;
+	if (ch != '<') {
+		m_text.clear();
+		while ((ch = peek()) >= 0 && ch != '<') {
+			get();
+			if (ch == '&')
+				readEntity(m_text);
+			else
+				m_text += static_cast<char>(ch);
+		}
+		return m_token = Characters;
+	}
+	get();
+	ch = peek();
+	if (ch == '?') {
+		// Skip the processing instructions
+		readUntil("?>", 0);
+		return readNext();
+	} else if (ch == '!') {
+		get();
+		ch = peek();
+		if (ch == '[') {
+			// <![CDATA[...]]>, the text is taken as is
+			for (int i = 0; i < 7; ++i)
+				get();
+			readUntil("]]>", &m_text);
+			return m_token = Characters;
+		} else if (ch == '-') {
+			// <!-- ... -->, the comment may contain '>'
+			get();
+			get();
+			readUntil("-->", 0);
+		} else {
+			// <!DOCTYPE ...>
+			while ((ch = get()) >= 0 && ch != '>') {}
+		}
+		return readNext();
+	}
+	bool isEnd = ch == '/';
+	if (isEnd)
+		get();
+	readName(m_name);
+	m_attributes.clear();
+	forever {
+		skipSpaces();
+		ch = get();
+		if (ch < 0)
+			return m_token = EndDocument;
+		if (ch == '>')
+			break;
+		if (ch == '/') {
+			m_emptyElement = !isEnd;
+			continue;
+		}
+		QByteArray name(1, static_cast<char>(ch));
+		QByteArray value;
+		while ((ch = peek()) >= 0 && ch != '=' && ch != '>' && !isXmlSpace(ch))
+			name += static_cast<char>(get());
+		skipSpaces();
+		if (peek() == '=') {
+			get();
+			skipSpaces();
+			int quote = get();
+			while ((ch = get()) >= 0 && ch != quote) {
+				if (ch == '&')
+					readEntity(value);
+				else
+					value += static_cast<char>(ch);
+			}
+		}
+		m_attributes << qMakePair(name, value);
+	}
+	return m_token = isEnd ? EndElement : StartElement;
+}
+
+QString XtrazReader::attribute(const QByteArray &name) const
+{
+	for (int i = 0; i < m_attributes.size(); ++i) {
+		if (m_attributes.at(i).first == name)
+			return QString::fromUtf8(m_attributes.at(i).second);
+	}
+	return QString();
+}
+
+QString XtrazReader::readElementText()
+{
+	QByteArray text;
+	int depth = 1;
+	while (depth > 0 && readNext() != EndDocument) {
+		if (m_token == StartElement)
+			++depth;
+		else if (m_token == EndElement)
+			--depth;
+		else if (depth == 1)
+			text += m_text;
+	}
+	return QString::fromUtf8(text);
+}
+
+void XtrazReader::skipCurrentElement()
+{
+	int depth = 1;
+	while (depth > 0 && readNext() != EndDocument) {
+		if (m_token == StartElement)
+			++depth;
+		else if (m_token == EndElement)
+			--depth;
+	}
+}
+
+XtrazReader XtrazReader::readEmbedded()
+{
+	Q_ASSERT(!m_embedded && m_token == StartElement && m_peeked == -2);
+	if (m_emptyElement)
+		return XtrazReader();
+	static const char cdataStart[] = "<![CDATA[";
+	static const int cdataStartLength = sizeof(cdataStart) - 1;
+	if (m_end - m_pos > cdataStartLength && !qstrncmp(m_pos, cdataStart, cdataStartLength)) {
+		// The document is not escaped inside CDATA
+		const char *begin = m_pos + cdataStartLength;
+		const char *end = begin;
+		while (end + 2 < m_end && qstrncmp(end, "]]>", 3))
+			++end;
+		if (end + 2 >= m_end)
+			end = m_end;
+		m_pos = end == m_end ? m_end : end + 3;
+		return XtrazReader(begin, end, false);
+	}
+	// The escaped text cannot contain '<', so the reader stops
+	// right before the end of the current element
+	const char *begin = m_pos;
+	while (m_pos != m_end && *m_pos != '<')
+		++m_pos;
+	return XtrazReader(begin, m_pos, true);
+}
+
+int XtrazReader::get()
+{
+	if (m_peeked != -2) {
+		int ch = m_peeked;
+		m_peeked = -2;
+		return ch;
+	}
+	return getRaw();
+}
+
+int XtrazReader::peek()
+{
+	if (m_peeked == -2)
+		m_peeked = getRaw();
+	return m_peeked;
+}
+
+int XtrazReader::getRaw()
+{
+	// The line ends are normalized to '\n' as QXmlStreamReader does,
+	// the ones which are written as character references are kept
+	int ch = readChar();
+	if (m_carriageReturn) {
+		m_carriageReturn = false;
+		if (ch == '\n')
+			ch = readChar();
+	}
+	if (ch == '\r') {
+		m_carriageReturn = true;
+		return '\n';
+	}
+	return ch;
+}
+
+int XtrazReader::readChar()
+{
+	if (m_pendingPos < m_pending.size())
+		return static_cast<uchar>(m_pending.at(m_pendingPos++));
+	if (m_pos == m_end)
+		return -1;
+	char ch = *m_pos++;
+	if (!m_embedded || ch != '&')
+		return static_cast<uchar>(ch);
+	// Remove the escaping of the outer document
+	const char *begin = m_pos;
+	while (m_pos != m_end && *m_pos != ';')
+		++m_pos;
+	m_pending.clear();
+	m_pendingPos = 0;
+	appendEntity(m_pending, QByteArray::fromRawData(begin, m_pos - begin));
+	if (m_pos != m_end)
+		++m_pos;
+	return readChar();
+}
+
+void XtrazReader::readEntity(QByteArray &out)
+{
+	QByteArray entity;
+	int ch;
+	while ((ch = get()) >= 0 && ch != ';')
+		entity += static_cast<char>(ch);
+	appendEntity(out, entity);
+}
+
+void XtrazReader::readUntil(const char *terminator, QByteArray *text)
+{
+	int length = qstrlen(terminator);
+	QByteArray data;
+	int ch;
+	while ((ch = get()) >= 0) {
+		data += static_cast<char>(ch);
+		if (data.endsWith(terminator)) {
+			data.chop(length);
+			break;
+		}
+	}
+	if (text)
+		*text = data;
+}
+
+void XtrazReader::readName(QByteArray &name)
+{
+	name.clear();
+	int ch;
+	while ((ch = peek()) >= 0 && ch != '>' && ch != '/' && !isXmlSpace(ch))
+		name += static_cast<char>(get());
+}
+
+void XtrazReader::skipSpaces()
+{
+	while (peek() >= 0 && isXmlSpace(peek()))
+		get();
+}
+
+XtrazData::XtrazData(const QByteArray &body, const Cookie &cookie) :
 	Tlv2711(MsgPlugin, 0, 0, 1, cookie)
 {
 	appendEmptyPacket();
@@ -111,20 +491,8 @@ XtrazData::XtrazData(const QString &body, const Cookie &cookie) :
 	append<quint32>(data.data(), LittleEndian);
 }
 
-XtrazRequestPacket::XtrazRequestPacket(const QString &uin, const QString &query, const QString &notify)
+XtrazRequestPacket::XtrazRequestPacket(const QString &uin, const QByteArray &body)
 {
-	QString body;
-	{
-		QXmlStreamWriter xml(&body);
-		xml.writeStartElement("N");
-		xml.writeStartElement("QUERY");
-		xml.writeCharacters(query);
-		xml.writeEndElement();
-		xml.writeStartElement("NOTIFY");
-		xml.writeCharacters(notify);
-		xml.writeEndElement();
-		xml.writeEndElement();
-	}
 	XtrazData data(body);
 	Cookie cookie = data.cookie();
 	cookie.setUin(uin);
@@ -134,28 +502,19 @@ XtrazRequestPacket::XtrazRequestPacket(const QString &uin, const QString &query,
 	appendTLV(0x03);
 }
 
-XtrazResponsePacket::XtrazResponsePacket(const QString &uin, const QString &response, const Cookie &cookie) :
+XtrazResponsePacket::XtrazResponsePacket(const QString &uin, const QByteArray &body, const Cookie &cookie) :
 	ServerResponseMessage(uin, 2, 3, cookie)
 {
-	QString body;
-	{
-		QXmlStreamWriter xml(&body);
-		xml.writeStartElement("NR");
-		xml.writeStartElement("RES");
-		xml.writeCharacters(response);
-		xml.writeEndElement();
-		xml.writeEndElement();
-	}
 	XtrazData data(body, cookie);
 	append(data.data());
 }
 
-void XtrazDataPrivate::parseData(QXmlStreamReader &xml)
+void XtrazDataPrivate::parseData(XtrazReader &xml)
 {
 	while (!xml.atEnd()) {
 		xml.readNext();
 		if (xml.isStartElement())
-			data.insert(xml.name().toString(), xml.readElementText());
+			data.insert(QString::fromUtf8(xml.name()), xml.readElementText());
 		else if (xml.isEndElement())
 			return;
 	}
@@ -220,48 +579,43 @@ void XtrazRequest::setValue(const QString &name, const QString &value)
 
 SNAC XtrazRequest::snac(const QString &uin) const
 {
-	QString query;
-	{
-		QXmlStreamWriter xml(&query);
-		xml.writeStartElement("Q");
-		xml.writeStartElement("PluginID");
-		xml.writeCharacters(d->pluginId);
-		xml.writeEndElement();
-		xml.writeEndElement();
-		query.replace('"', '\'');
-	}
-	QString notify;
-	{
-		QXmlStreamWriter xml(&notify);
-		xml.writeStartElement("srv");
-		xml.writeStartElement("id");
-		xml.writeCharacters(d->service);
-		xml.writeEndElement();
-		xml.writeStartElement("req");
-		QHashIterator<QString, QString> itr(d->data);
-		while (itr.hasNext()) {
-			itr.next();
-			xml.writeStartElement(itr.key());
-			xml.writeCharacters(itr.value());
-			xml.writeEndElement();
-		}
-		xml.writeEndElement();
-		xml.writeEndElement();
-		notify.replace('"', '\'');
+	QByteArray body;
+	XtrazWriter xml(&body);
+	xml.writeStartElement("N");
+	xml.writeStartElement("QUERY");
+	xml.beginEmbedded();
+	xml.writeStartElement("Q");
+	xml.writeTextElement("PluginID", d->pluginId);
+	xml.writeEndElement();
+	xml.endEmbedded();
+	xml.writeEndElement();
+	xml.writeStartElement("NOTIFY");
+	xml.beginEmbedded();
+	xml.writeStartElement("srv");
+	xml.writeTextElement("id", d->service);
+	xml.writeStartElement("req");
+	QHashIterator<QString, QString> itr(d->data);
+	while (itr.hasNext()) {
+		itr.next();
+		xml.writeTextElement(itr.key().toUtf8(), itr.value());
 	}
-	return XtrazRequestPacket(uin, query, notify);
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.endEmbedded();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	return XtrazRequestPacket(uin, body);
 }
 
-void XtrazRequestPrivate::parse(const QString &query, const QString &notify)
+void XtrazRequestPrivate::parse(XtrazReader &query, XtrazReader &notify)
 {
 	parseQuery(query);
 	if (!pluginId.isEmpty())
 		parseNotify(notify);
 }
 
-void XtrazRequestPrivate::parseQuery(const QString &query)
+void XtrazRequestPrivate::parseQuery(XtrazReader &xml)
 {
-	QXmlStreamReader xml(query);
 	while (!xml.atEnd()) {
 		xml.readNext();
 		if (xml.isStartElement()) {
@@ -271,9 +625,8 @@ void XtrazRequestPrivate::parseQuery(const QString &query)
 	}
 }
 
-void XtrazRequestPrivate::parseNotify(const QString &notify)
+void XtrazRequestPrivate::parseNotify(XtrazReader &xml)
 {
-	QXmlStreamReader xml(notify);
 	while (!xml.atEnd()) {
 		xml.readNext();
 		if (xml.isStartElement()) {
@@ -287,7 +640,7 @@ void XtrazRequestPrivate::parseNotify(const QString &notify)
 	}
 }
 
-void XtrazRequestPrivate::parseSrv(QXmlStreamReader &xml)
+void XtrazRequestPrivate::parseSrv(XtrazReader &xml)
 {
 	while (!xml.atEnd()) {
 		xml.readNext();
@@ -304,9 +657,8 @@ void XtrazRequestPrivate::parseSrv(QXmlStreamReader &xml)
 	}
 }
 
-void XtrazResponsePrivate::parse(const QString &response)
+void XtrazResponsePrivate::parse(XtrazReader &xml)
 {
-	QXmlStreamReader xml(response);
 	while (!xml.atEnd()) {
 		xml.readNext();
 		if (xml.isStartElement()) {
@@ -320,9 +672,9 @@ void XtrazResponsePrivate::parse(const QString &response)
 	}
 }
 
-void XtrazResponsePrivate::parseRet(QXmlStreamReader &xml)
+void XtrazResponsePrivate::parseRet(XtrazReader &xml)
 {
-	event = xml.attributes().value("event").toString();
+	event = xml.attribute("event");
 	while (!xml.atEnd()) {
 		xml.readNext();
 		if (xml.isStartElement()) {
@@ -336,7 +688,7 @@ void XtrazResponsePrivate::parseRet(QXmlStreamReader &xml)
 	}
 }
 
-void XtrazResponsePrivate::parseSrv(QXmlStreamReader &xml)
+void XtrazResponsePrivate::parseSrv(XtrazReader &xml)
 {
 	while (!xml.atEnd()) {
 		xml.readNext();
@@ -353,7 +705,7 @@ void XtrazResponsePrivate::parseSrv(QXmlStreamReader &xml)
 	}
 }
 
-void XtrazResponsePrivate::parseVal(QXmlStreamReader &xml)
+void XtrazResponsePrivate::parseVal(XtrazReader &xml)
 {
 	while (!xml.atEnd()) {
 		xml.readNext();
@@ -427,32 +779,31 @@ void  XtrazResponse::setValue(const QString &name, const QString &value)
 
 SNAC XtrazResponse::snac(const QString &uin, quint64 cookie) const
 {
-	QString response;
-	{
-		QXmlStreamWriter xml(&response);
-		xml.writeStartElement("ret");
-		xml.writeAttribute("event", d->event);
-		xml.writeStartElement("srv");
-		xml.writeStartElement("id");
-		xml.writeCharacters(d->service);
-		xml.writeEndElement();
-		xml.writeStartElement("val");
-		xml.writeAttribute("srv_id", d->service);
-		xml.writeStartElement("Root");
-		QHashIterator<QString, QString> itr(d->data);
-		while (itr.hasNext()) {
-			itr.next();
-			xml.writeStartElement(itr.key());
-			xml.writeCharacters(itr.value());
-			xml.writeEndElement();
-		}
-		xml.writeEndElement();
-		xml.writeEndElement();
-		xml.writeEndElement();
-		xml.writeEndElement();
-		response.replace('"', '\'');
+	QByteArray body;
+	XtrazWriter xml(&body);
+	xml.writeStartElement("NR");
+	xml.writeStartElement("RES");
+	xml.beginEmbedded();
+	xml.writeStartElement("ret");
+	xml.writeAttribute("event", d->event);
+	xml.writeStartElement("srv");
+	xml.writeTextElement("id", d->service);
+	xml.writeStartElement("val");
+	xml.writeAttribute("srv_id", d->service);
+	xml.writeStartElement("Root");
+	QHashIterator<QString, QString> itr(d->data);
+	while (itr.hasNext()) {
+		itr.next();
+		xml.writeTextElement(itr.key().toUtf8(), itr.value());
 	}
-	return XtrazResponsePacket(uin, response, cookie);
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.endEmbedded();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	return XtrazResponsePacket(uin, body, cookie);
 }
 
 XtrazPrivate::XtrazPrivate()
@@ -488,20 +839,32 @@ XtrazPrivate &XtrazPrivate::operator=(const XtrazPrivate &rhs)
 Xtraz::Xtraz(const QString &message) :
 	d(new XtrazPrivate)
 {
-	debug() << Q_FUNC_INFO << message;
-	QXmlStreamReader xml(message);
-	QString query;
-	QString notify;
-	QString response;
+	parse(message.toUtf8());
+}
+
+Xtraz::Xtraz(const QByteArray &message) :
+	d(new XtrazPrivate)
+{
+	parse(message);
+}
+
+void Xtraz::parse(const QByteArray &message)
+{
+	debug(MessagesDebug) << Q_FUNC_INFO << message;
+	XtrazReader xml(message.constData(), message.constData() + message.size());
+	// The embedded documents are parsed in place, without unescaping them
+	XtrazReader query;
+	XtrazReader notify;
+	XtrazReader response;
 	while (!xml.atEnd()) {
 		xml.readNext();
 		if (xml.isStartElement()) {
 			if (xml.name() == "QUERY")
-				query = xml.readElementText();
+				query = xml.readEmbedded();
 			else if (xml.name() == "NOTIFY")
-				notify = xml.readElementText();
+				notify = xml.readEmbedded();
 			else if (xml.name() == "RES")
-				response = xml.readElementText();
+				response = xml.readEmbedded();
 		}
 	}
 	if (!query.isEmpty() && !notify.isEmpty()) {
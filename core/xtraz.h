@@ -96,6 +96,8 @@ public:
 		Invalid
 	};
 	Xtraz(const QString &message);
+	// The message is expected to be in UTF-8
+	Xtraz(const QByteArray &message);
 	~Xtraz();
 	Xtraz &operator=(const Xtraz &rhs);
 	Type type();
@@ -104,6 +106,7 @@ public:
 private:
 	Xtraz();
 	Xtraz(const Xtraz &xtraz);
+	void parse(const QByteArray &message);
 	QSharedDataPointer<XtrazPrivate> d;
 };
 
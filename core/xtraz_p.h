@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Ruslan Nigmatullin <euroelessar@yandex.ru>
+**                  Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_XTRAZ_P_H
+#define IREEN_XTRAZ_P_H
+
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+namespace Ireen {
+
+// Writes xtraz documents directly to a UTF-8 buffer. The documents which
+// are embedded into the text of QUERY, NOTIFY and RES elements are escaped
+// for the second time on the fly, so they are never serialized separately.
+class XtrazWriter
+{
+public:
+	XtrazWriter(QByteArray *buffer) : m_buffer(buffer), m_level(0), m_inStartTag(false) {}
+	// The elements written between beginEmbedded() and endEmbedded() are
+	// the text of the current element
+	void beginEmbedded() { closeStartTag(); ++m_level; }
+	void endEmbedded() { closeStartTag(); --m_level; }
+	void writeStartElement(const QByteArray &name);
+	void writeAttribute(const QByteArray &name, const QString &value);
+	void writeCharacters(const QString &text);
+	void writeTextElement(const QByteArray &name, const QString &text);
+	void writeEndElement();
+private:
+	void writeMarkup(char ch);
+	void writeEscaped(char ch, int times, bool attribute);
+	void closeStartTag();
+	QByteArray *m_buffer;
+	int m_level;
+	bool m_inStartTag;
+	QList<QByteArray> m_elements;
+};
+
+// A pull parser of xtraz documents. An embedded document is read directly
+// from the escaped text of the outer one without unescaping it first.
+class XtrazReader
+{
+public:
+	enum Token
+	{
+		StartElement,
+		EndElement,
+		Characters,
+		EndDocument
+	};
+	XtrazReader(const char *begin = 0, const char *end = 0, bool embedded = false);
+	Token readNext();
+	bool atEnd() const { return m_token == EndDocument; }
+	bool isStartElement() const { return m_token == StartElement; }
+	bool isEndElement() const { return m_token == EndElement; }
+	bool isEmpty() const { return m_pos == m_end; }
+	const QByteArray &name() const { return m_name; }
+	QString attribute(const QByteArray &name) const;
+	QString readElementText();
+	void skipCurrentElement();
+	// Returns the reader of the document embedded into the current element
+	XtrazReader readEmbedded();
+private:
+	int get();
+	int peek();
+	int getRaw();
+	int readChar();
+	void readEntity(QByteArray &out);
+	// Reads the text up to the terminator and skips the terminator
+	void readUntil(const char *terminator, QByteArray *text);
+	void readName(QByteArray &name);
+	void skipSpaces();
+	const char *m_pos;
+	const char *m_end;
+	bool m_embedded;
+	int m_peeked;
+	QByteArray m_pending;
+	int m_pendingPos;
+	bool m_carriageReturn;
+	Token m_token;
+	bool m_emptyElement;
+	QByteArray m_name;
+	QByteArray m_text;
+	QList<QPair<QByteArray, QByteArray> > m_attributes;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_XTRAZ_P_H
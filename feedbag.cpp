@@ -255,13 +255,13 @@ bool FeedbagItemPrivate::isSendingAllowed(const FeedbagItem &item, Feedbag::Modi
 {
 	FeedbagPrivate *d = feedbag->d.data();
 	if (!d->client->isConnected()) {
-		warning() << "Trying to send the feedbag item while offline:" << item;
+		warning(RosterDebug) << "Trying to send the feedbag item while offline:" << item;
 		return false;
 	}
 	if (operation == Feedbag::Add) {
 		quint16 limit = d->limits.value(item.type());
 		if (limit > 0 && d->itemsByType.value(item.type()).size() >= limit) {
-			warning() << "Limit for feedbag item type" << item.type() << "exceeded";
+			warning(RosterDebug) << "Limit for feedbag item type" << item.type() << "exceeded";
 			return false;
 		}
 	}
@@ -518,7 +518,7 @@ void FeedbagPrivate::handleItem(FeedbagItem &item, Feedbag::ModifyType type, Fee
 {
 	Q_Q(Feedbag);
 	if (!handlers.contains(item.type())) {
-		debug() << "The feedbag item ignored:" << item;
+		debug(RosterDebug) << "The feedbag item ignored:" << item;
 		return;
 	}
 	const QPair<quint16, quint16> id = item.pairId();
@@ -544,21 +544,21 @@ void FeedbagPrivate::handleItem(FeedbagItem &item, Feedbag::ModifyType type, Fee
 	if (!found) {
 		if (error == FeedbagError::NoError) {
 			if (type == Feedbag::Remove) {
-				debug(DebugVerbose) << "The feedbag item has been removed:" << item;
+				debug(RosterDebug, DebugVerbose) << "The feedbag item has been removed:" << item;
 			} else if (type == Feedbag::Modify) {
-				debug(DebugVerbose) << "The feedbag item has been updated:" << item;
+				debug(RosterDebug, DebugVerbose) << "The feedbag item has been updated:" << item;
 			} else {
-				debug(DebugVerbose) << "The feedbag item has been added:" << item;
+				debug(RosterDebug, DebugVerbose) << "The feedbag item has been added:" << item;
 			}
 		} else {
 			if (type == Feedbag::Remove) {
-				debug(DebugVerbose).nospace() << "The feedbag item has not been removed: "
+				debug(RosterDebug, DebugVerbose).nospace() << "The feedbag item has not been removed: "
 										 << error.errorString() << ". (" << error.code() << ")" << item;
 			} else if (type == Feedbag::Modify) {
-				debug(DebugVerbose) << "The feedbag item has not been updated:"
+				debug(RosterDebug, DebugVerbose) << "The feedbag item has not been updated:"
 							   << error.errorString() << ". (" << error.code() << ")" << item;
 			} else {
-				debug(DebugVerbose) << "The feedbag item has not been added:"
+				debug(RosterDebug, DebugVerbose) << "The feedbag item has not been added:"
 							   << error.errorString() << ". (" << error.code() << ")" << item;
 			}
 		}
@@ -630,12 +630,18 @@ FeedbagItemPrivate *FeedbagPrivate::getFeedbagItemPrivate(const SNAC &snac)
 	quint16 itemType = snac.read<quint16>();
 	if (!handlers.contains(itemType)) {
 		// TODO: add better debugging.
-		debug() << "The feedbag item ignored with type" << itemType << "and name" << recordName;
+		debug(RosterDebug) << "The feedbag item ignored with type" << itemType << "and name" << recordName;
 		snac.skipData(snac.read<quint16>());
 		return 0;
 	}
+	DataUnit data = snac.read<DataUnit, quint16>();
+	TLVMap tlvs = data.read<TLVMap>();
+	if (snac.hasError() || data.hasError()) {
+		debug(RosterDebug) << "The feedbag item" << recordName << "is malformed";
+		return 0;
+	}
 	FeedbagItemPrivate *item = new FeedbagItemPrivate(q_func(), itemType, itemId, groupId, recordName);
-	item->tlvs = snac.read<DataUnit, quint16>().read<TLVMap>();
+	item->tlvs = tlvs;
 	return item;
 }
 
@@ -647,11 +653,11 @@ void FeedbagPrivate::updateList()
 	client->sendSnac(ListsFamily, ListsCliModifyStart);
 	SNAC snac;
 	QList<FeedbagQueueItem> items;
-	debug() << "Trying to change" << modifyQueue.size() << "items:";
+	debug(RosterDebug) << "Trying to change" << modifyQueue.size() << "items:";
 	for (int i = 0; i <= modifyQueue.size(); ++i) {
 		const FeedbagQueueItem *item = i < modifyQueue.size() ? &modifyQueue.at(i) : 0;
 		if (item)
-			debug() << item->type << item->item;
+			debug(RosterDebug) << item->type << item->item;
 		QByteArray data = item ? item->item.d->data(item->type) : QByteArray();
 		if (!item || item->type != snac.subtype() || !snac.canAppend(data.size())) {
 			if (!items.isEmpty()) {
@@ -976,7 +982,7 @@ void Feedbag::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 	switch ((sn.family() << 16) | sn.subtype()) {
 	case ListsFamily << 16 | ListsError: {
 		 ProtocolError error(sn);
-		 debug() << QString("Error (%1, %2): %3")
+		 debug(RosterDebug) << QString("Error (%1, %2): %3")
 				 .arg(error.code(), 2, 16)
 				 .arg(error.subcode(), 2, 16)
 				 .arg(error.errorString());
@@ -1001,7 +1007,7 @@ void Feedbag::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		break;
 	}
 	case ListsFamily << 16 | ListsUpToDate: {
-		 debug() << "Local contactlist is up to date";
+		 debug(RosterDebug) << "Local contactlist is up to date";
 		 d->firstPacket = true;
 		 d->finishLoading();
 		 break;
@@ -1015,12 +1021,12 @@ void Feedbag::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		quint8 version = sn.read<quint8>();
 		quint16 count = sn.read<quint16>();
 		bool isLast = !(sn.flags() & 0x0001);
-		debug() << "SSI: number of entries is" << count << "version is" << version;
-		for (uint i = 0; i < count; i++) {
+		debug(RosterDebug) << "SSI: number of entries is" << count << "version is" << version;
+		for (uint i = 0; i < count && !sn.hasError(); i++) {
 			FeedbagItemPrivate *itemPrivate = d->getFeedbagItemPrivate(sn);
 			if (itemPrivate) {
 				FeedbagItem item(itemPrivate);
-				debug() << "Receive item:" << item;
+				debug(RosterDebug) << "Receive item:" << item;
 				d->newItems << item;
 			}
 		}
@@ -1035,7 +1041,7 @@ void Feedbag::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 	case ListsFamily << 16 | ListsUpdateGroup: // Server sends contact list updates
 	case ListsFamily << 16 | ListsAddToList: // Server sends new items
 	case ListsFamily << 16 | ListsRemoveFromList: { // Items have been removed
-		while (sn.dataSize() != 0) {
+		while (sn.dataSize() != 0 && !sn.hasError()) {
 			FeedbagItemPrivate *itemPrivate = d->getFeedbagItemPrivate(sn);
 			if (itemPrivate) {
 				FeedbagItem item(itemPrivate);
@@ -1045,8 +1051,8 @@ void Feedbag::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		break;
 	}
 	case ListsFamily << 16 | ListsAck: {
-		while (sn.dataSize() != 0) {
-			debug() << "Received with id:" << sn.id();
+		while (sn.dataSize() != 0 && !d->itemsForRequests.isEmpty()) {
+			debug(RosterDebug) << "Received with id:" << sn.id();
 			QSet<quint16> groups;
 			foreach (FeedbagQueueItem operation, d->itemsForRequests.takeFirst()) {
 				FeedbagError error(sn);
@@ -1066,10 +1072,10 @@ void Feedbag::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		break;
 	}
 	case ListsFamily << 16 | ListsCliModifyStart:
-		debug(DebugVerbose) << "The server has started modification of the contact list";
+		debug(RosterDebug, DebugVerbose) << "The server has started modification of the contact list";
 		break;
 	case ListsFamily << 16 | ListsCliModifyEnd:
-		debug(DebugVerbose) << "The server has ended modification of the contact list";
+		debug(RosterDebug, DebugVerbose) << "The server has ended modification of the contact list";
 		break;
 	// Server sends SSI service limitations to client
 	case ListsFamily << 16 | ListsSrvReplyLists: {
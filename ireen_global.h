@@ -29,8 +29,11 @@
 
 #include <QDebug>
 #include <QWeakPointer>
+#include <new>
 
-#if defined(IREEN_BUILD_LIBRARY)
+#if defined(IREEN_STATIC)
+#  define IREEN_EXPORT
+#elif defined(IREEN_BUILD_LIBRARY)
 #  define IREEN_EXPORT Q_DECL_EXPORT
 #else
 #  define IREEN_EXPORT Q_DECL_IMPORT
@@ -38,16 +41,132 @@
 
 namespace Ireen {
 
-// Just a stub for now...
 enum DebugLevel
 {
+	DebugDisabled = -1,
 	DebugInfo = 0,
 	DebugVerbose,
 	DebugVeryVerbose
 };
-inline QDebug debug(DebugLevel level = DebugInfo) { Q_UNUSED(level); return QDebug(QtDebugMsg); }
-inline QDebug warning(DebugLevel level = DebugInfo) { Q_UNUSED(level); return QDebug(QtWarningMsg); }
-inline QDebug critical(DebugLevel level = DebugInfo) { Q_UNUSED(level); return QDebug(QtCriticalMsg); }
+
+enum DebugCategory
+{
+	GeneralDebug = 0,
+	ConnectionDebug,
+	RosterDebug,
+	MessagesDebug,
+	MetaInfoDebug,
+	FileTransferDebug,
+	DebugCategoriesCount
+};
+
+// Runtime levels of the categories, DebugInfo by default.
+// The initial levels can be set by the IREEN_DEBUG environment variable,
+// for example IREEN_DEBUG=1 or IREEN_DEBUG=connection:2,roster:1
+// The levels are never set above debugMaxLevel().
+IREEN_EXPORT void setDebugLevel(DebugCategory category, DebugLevel level);
+IREEN_EXPORT void setDebugLevel(DebugLevel level);
+IREEN_EXPORT DebugLevel debugLevel(DebugCategory category);
+// The most verbose level compiled into the library, see IREEN_DEBUG_MAX_LEVEL
+IREEN_EXPORT DebugLevel debugMaxLevel();
+
+extern IREEN_EXPORT signed char debugLevels[DebugCategoriesCount];
+
+inline bool isDebugEnabled(DebugCategory category, DebugLevel level = DebugInfo)
+{
+	return level <= debugLevels[category];
+}
+inline bool isDebugEnabled(DebugLevel level = DebugInfo) { return isDebugEnabled(GeneralDebug, level); }
+
+inline QDebug debugStream(DebugCategory = GeneralDebug, DebugLevel = DebugInfo) { return QDebug(QtDebugMsg); }
+inline QDebug debugStream(DebugLevel) { return QDebug(QtDebugMsg); }
+inline QDebug warningStream(DebugCategory = GeneralDebug, DebugLevel = DebugInfo) { return QDebug(QtWarningMsg); }
+inline QDebug warningStream(DebugLevel) { return QDebug(QtWarningMsg); }
+inline QDebug criticalStream(DebugCategory = GeneralDebug, DebugLevel = DebugInfo) { return QDebug(QtCriticalMsg); }
+inline QDebug criticalStream(DebugLevel) { return QDebug(QtCriticalMsg); }
+
+// IREEN_DEBUG(), IREEN_DEBUG(level) or IREEN_DEBUG(category, level) << ...
+// Nothing after the macro is evaluated if the level is disabled.
+#define IREEN_LOG(stream, ...) \
+	if (!::Ireen::isDebugEnabled(__VA_ARGS__)) {} else ::Ireen::stream(__VA_ARGS__)
+#define IREEN_DEBUG(...) IREEN_LOG(debugStream, __VA_ARGS__)
+#define IREEN_WARNING(...) IREEN_LOG(warningStream, __VA_ARGS__)
+#define IREEN_CRITICAL(...) IREEN_LOG(criticalStream, __VA_ARGS__)
+
+// Stream returned by debug(), warning() and critical(). It writes nothing
+// if the message is filtered out.
+class DebugStream
+{
+public:
+	inline DebugStream() : m_enabled(false) {}
+	inline explicit DebugStream(QtMsgType type) : m_enabled(true) { new (m_data) QDebug(type); }
+	inline DebugStream(const DebugStream &other) : m_enabled(other.m_enabled)
+	{ if (m_enabled) new (m_data) QDebug(*other.stream()); }
+	inline ~DebugStream() { if (m_enabled) stream()->~QDebug(); }
+	inline bool isEnabled() const { return m_enabled; }
+	inline DebugStream &space() { if (m_enabled) stream()->space(); return *this; }
+	inline DebugStream &nospace() { if (m_enabled) stream()->nospace(); return *this; }
+	inline DebugStream &operator<<(QTextStreamFunction f) { if (m_enabled) *stream() << f; return *this; }
+	inline DebugStream &operator<<(QTextStreamManipulator m) { if (m_enabled) *stream() << m; return *this; }
+	template<typename T>
+	inline DebugStream &operator<<(const T &t) { if (m_enabled) *stream() << t; return *this; }
+private:
+	DebugStream &operator=(const DebugStream &other);
+	inline QDebug *stream() const { return reinterpret_cast<QDebug*>(const_cast<void**>(m_data)); }
+	// QDebug is kept in place, it is only a pointer to the shared stream
+	void *m_data[(sizeof(QDebug) + sizeof(void*) - 1) / sizeof(void*)];
+	bool m_enabled;
+};
+
+// For the code outside the library. The arguments are evaluated even
+// if the message is filtered out; use IREEN_DEBUG() to skip them.
+inline DebugStream debug(DebugCategory category, DebugLevel level = DebugInfo)
+{
+	if (!isDebugEnabled(category, level))
+		return DebugStream();
+	return DebugStream(QtDebugMsg);
+}
+inline DebugStream debug(DebugLevel level = DebugInfo) { return debug(GeneralDebug, level); }
+
+inline DebugStream warning(DebugCategory category, DebugLevel level = DebugInfo)
+{
+	if (!isDebugEnabled(category, level))
+		return DebugStream();
+	return DebugStream(QtWarningMsg);
+}
+inline DebugStream warning(DebugLevel level = DebugInfo) { return warning(GeneralDebug, level); }
+
+inline DebugStream critical(DebugCategory category, DebugLevel level = DebugInfo)
+{
+	if (!isDebugEnabled(category, level))
+		return DebugStream();
+	return DebugStream(QtCriticalMsg);
+}
+inline DebugStream critical(DebugLevel level = DebugInfo) { return critical(GeneralDebug, level); }
+
+#if defined(IREEN_BUILD_LIBRARY)
+// Messages above this level are not compiled into the library.
+// The applications see the value through debugMaxLevel().
+# ifndef IREEN_DEBUG_MAX_LEVEL
+#  ifdef QT_NO_DEBUG
+#   define IREEN_DEBUG_MAX_LEVEL Ireen::DebugInfo
+#  else
+#   define IREEN_DEBUG_MAX_LEVEL Ireen::DebugVeryVerbose
+#  endif
+# endif
+
+static inline bool isDebugCompiled(DebugCategory, DebugLevel level = DebugInfo) { return level <= IREEN_DEBUG_MAX_LEVEL; }
+static inline bool isDebugCompiled(DebugLevel level = DebugInfo) { return level <= IREEN_DEBUG_MAX_LEVEL; }
+
+// Inside the library debug(), debug(level) or debug(category, level) << ...
+// skip the arguments of the disabled messages, like IREEN_DEBUG() does.
+# define IREEN_LIBRARY_LOG(stream, ...) \
+	if (!::Ireen::isDebugCompiled(__VA_ARGS__) || !::Ireen::isDebugEnabled(__VA_ARGS__)) {} \
+	else ::Ireen::stream(__VA_ARGS__)
+# define debug(...) IREEN_LIBRARY_LOG(debugStream, __VA_ARGS__)
+# define warning(...) IREEN_LIBRARY_LOG(warningStream, __VA_ARGS__)
+# define critical(...) IREEN_LIBRARY_LOG(criticalStream, __VA_ARGS__)
+#endif
 
 enum SnacFamily
 {
@@ -0,0 +1,471 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "loginorchestrator_p.h"
+#include "reconnectmanager.h"
+#include "client_p.h"
+#include <QTimerEvent>
+#include <qmath.h>
+
+namespace Ireen {
+
+OrchestratedLogin *LoginOrchestratorPrivate::entry(QObject *client) const
+{
+	return logins.value(client);
+}
+
+void LoginOrchestratorPrivate::add(Client *client, OrchestratedLogin *login)
+{
+	login->client = client;
+	login->attempt = 0;
+	logins.insert(client, login);
+	q->connect(client, SIGNAL(loginFinished()), SLOT(onLoginFinished()));
+	q->connect(client, SIGNAL(disconnected()), SLOT(onDisconnected()));
+	q->connect(client, SIGNAL(destroyed(QObject*)), SLOT(onClientDestroyed(QObject*)));
+	if (client->isConnected()) {
+		login->state = OrchestratedLogin::Online;
+		++online;
+	} else {
+		enqueue(login);
+		timeToAllOnline = -1;
+	}
+	schedule();
+}
+
+void LoginOrchestratorPrivate::remove(OrchestratedLogin *login)
+{
+	switch (login->state) {
+	case OrchestratedLogin::Pending:
+		queue.removeOne(login);
+		break;
+	case OrchestratedLogin::InProgress:
+		--inProgress;
+		break;
+	case OrchestratedLogin::Online:
+		--online;
+		break;
+	case OrchestratedLogin::Failed:
+		--failed;
+		break;
+	case OrchestratedLogin::Reconnecting:
+	case OrchestratedLogin::Offline:
+		break;
+	}
+	logins.remove(login->client);
+	delete login;
+	schedule();
+	checkFinished();
+}
+
+void LoginOrchestratorPrivate::enqueue(OrchestratedLogin *login)
+{
+	login->state = OrchestratedLogin::Pending;
+	int i = queue.size();
+	while (i > 0 && queue.at(i - 1)->weight < login->weight)
+		--i;
+	queue.insert(i, login);
+}
+
+void LoginOrchestratorPrivate::refill()
+{
+	int msec = refillTime.restart();
+	tokens = qMin<qreal>(burst, tokens + msec * rate / 1000);
+}
+
+void LoginOrchestratorPrivate::admit(OrchestratedLogin *login)
+{
+	login->state = OrchestratedLogin::InProgress;
+	++inProgress;
+	debug(ConnectionDebug) << "Admitting the login of" << login->client->uin()
+						   << "attempt" << login->attempt + 1;
+	switch (login->method) {
+	case OrchestratedLogin::Md5Method:
+		login->client->login(login->md5Data);
+		break;
+#if IREEN_SSL_SUPPORT
+	case OrchestratedLogin::OAuthMethod:
+		login->client->login(login->oauthData);
+		break;
+#endif
+	default:
+		break;
+	}
+}
+
+void LoginOrchestratorPrivate::fail(OrchestratedLogin *login, AbstractConnection::ConnectionError error)
+{
+	login->state = OrchestratedLogin::Failed;
+	++failed;
+	debug(ConnectionDebug) << "The login of" << login->client->uin() << "has failed:" << error;
+	emit q->clientFailed(login->client, error);
+	emit q->progress(online, failed, logins.size());
+}
+
+void LoginOrchestratorPrivate::backOff()
+{
+	// The logins being in progress are rejected by the same limit,
+	// one pause is enough for all of them
+	if (backingOff)
+		return;
+	++backoffLevel;
+	int delay = initialBackoff;
+	for (int i = 1; i < backoffLevel && delay < maximumBackoff; ++i)
+		delay = delay > maximumBackoff / 2 ? maximumBackoff : delay * 2;
+	delay = qMin(delay, maximumBackoff);
+	int quarter = delay / 4;
+	if (quarter > 0)
+		delay -= qrand() % (quarter + 1);
+	warning(ConnectionDebug) << "The server limits the logins, pausing them for" << delay << "msec";
+	backingOff = true;
+	tokens = 0;
+	timer.start(delay, q);
+	emit q->backingOff(delay);
+}
+
+void LoginOrchestratorPrivate::onOnlineLost(OrchestratedLogin *login)
+{
+	--online;
+	Client *client = login->client;
+	AbstractConnection::ConnectionError error = client->error();
+	if (error == AbstractConnection::NoError) {
+		login->state = OrchestratedLogin::Offline;
+	} else if (client->reconnectManager()->isReconnectScheduled()) {
+		// The ReconnectManager has reacted first, onLoginFinished() takes the client back
+		login->state = OrchestratedLogin::Reconnecting;
+	} else if (ReconnectManager::isRecoverable(error)) {
+		debug(ConnectionDebug) << "The connection of" << client->uin() << "is lost, queueing its login";
+		login->attempt = 0;
+		enqueue(login);
+		timeToAllOnline = -1;
+		if (isRateLimit(error))
+			backOff();
+	} else {
+		fail(login, error);
+		return;
+	}
+	emit q->progress(online, failed, logins.size());
+	schedule();
+}
+
+void LoginOrchestratorPrivate::schedule()
+{
+	if (!running || backingOff)
+		return;
+	timer.stop();
+	refill();
+	while (!queue.isEmpty() && tokens >= 1
+		   && (maximumInProgress <= 0 || inProgress < maximumInProgress))
+	{
+		tokens -= 1;
+		admit(queue.takeFirst());
+	}
+	// The end of a login in progress reschedules the admissions
+	if (queue.isEmpty() || (maximumInProgress > 0 && inProgress >= maximumInProgress))
+		return;
+	int delay = qCeil((1 - tokens) * 1000 / rate);
+	timer.start(qMax(delay, 1), q);
+}
+
+void LoginOrchestratorPrivate::checkFinished()
+{
+	if (!running || timeToAllOnline >= 0 || !queue.isEmpty() || inProgress > 0)
+		return;
+	timeToAllOnline = startTime.elapsed();
+	debug(ConnectionDebug) << online << "clients are online," << failed << "have failed, in"
+						   << timeToAllOnline << "msec";
+	emit q->finished();
+}
+
+bool LoginOrchestratorPrivate::isRateLimit(AbstractConnection::ConnectionError error)
+{
+	switch (error) {
+	case AbstractConnection::ConnectionLimitExceeded:
+	case AbstractConnection::ConnectionLimitExceededReservation:
+	case AbstractConnection::RateLimitExceededReservation:
+	case AbstractConnection::RateLimitExceeded:
+		return true;
+	default:
+		return false;
+	}
+}
+
+LoginOrchestrator::LoginOrchestrator(QObject *parent) :
+	QObject(parent), d(new LoginOrchestratorPrivate)
+{
+	d->q = this;
+	d->running = false;
+	d->rate = 5;
+	d->burst = 10;
+	d->tokens = 0;
+	d->maximumInProgress = 20;
+	d->inProgress = 0;
+	d->online = 0;
+	d->failed = 0;
+	d->maximumAttempts = 3;
+	d->initialBackoff = 10 * 1000;
+	d->maximumBackoff = 5 * 60 * 1000;
+	d->backoffLevel = 0;
+	d->backingOff = false;
+	d->timeToAllOnline = -1;
+}
+
+LoginOrchestrator::~LoginOrchestrator()
+{
+	qDeleteAll(d->logins);
+}
+
+void LoginOrchestrator::addClient(Client *client, const MD5LoginData &data, int weight)
+{
+	removeClient(client);
+	OrchestratedLogin *login = new OrchestratedLogin;
+	login->weight = weight;
+	login->method = OrchestratedLogin::Md5Method;
+	login->md5Data = data;
+	d->add(client, login);
+}
+
+#if IREEN_SSL_SUPPORT
+void LoginOrchestrator::addClient(Client *client, const OAuthLoginData &data, int weight)
+{
+	removeClient(client);
+	OrchestratedLogin *login = new OrchestratedLogin;
+	login->weight = weight;
+	login->method = OrchestratedLogin::OAuthMethod;
+	login->oauthData = data;
+	d->add(client, login);
+}
+#endif
+
+void LoginOrchestrator::removeClient(Client *client)
+{
+	OrchestratedLogin *login = d->entry(client);
+	if (!login)
+		return;
+	disconnect(client, 0, this, 0);
+	d->remove(login);
+}
+
+QList<Client*> LoginOrchestrator::clients() const
+{
+	QList<Client*> clients;
+	foreach (OrchestratedLogin *login, d->logins)
+		clients << login->client;
+	return clients;
+}
+
+void LoginOrchestrator::setRate(qreal loginsPerSecond, int burst)
+{
+	d->refill();
+	d->rate = qMax<qreal>(loginsPerSecond, 0.01);
+	d->burst = qMax(burst, 1);
+	d->tokens = qMin<qreal>(d->tokens, d->burst);
+	d->schedule();
+}
+
+qreal LoginOrchestrator::rate() const
+{
+	return d->rate;
+}
+
+int LoginOrchestrator::burst() const
+{
+	return d->burst;
+}
+
+void LoginOrchestrator::setMaximumInProgress(int count)
+{
+	d->maximumInProgress = qMax(count, 0);
+	d->schedule();
+}
+
+int LoginOrchestrator::maximumInProgress() const
+{
+	return d->maximumInProgress;
+}
+
+void LoginOrchestrator::setBackoffDelays(int initialMsec, int maximumMsec)
+{
+	d->initialBackoff = qMax(initialMsec, 0);
+	d->maximumBackoff = qMax(maximumMsec, d->initialBackoff);
+}
+
+void LoginOrchestrator::setMaximumAttempts(int count)
+{
+	d->maximumAttempts = qMax(count, 1);
+}
+
+int LoginOrchestrator::maximumAttempts() const
+{
+	return d->maximumAttempts;
+}
+
+int LoginOrchestrator::pendingCount() const
+{
+	return d->queue.size();
+}
+
+int LoginOrchestrator::inProgressCount() const
+{
+	return d->inProgress;
+}
+
+int LoginOrchestrator::onlineCount() const
+{
+	return d->online;
+}
+
+int LoginOrchestrator::failedCount() const
+{
+	return d->failed;
+}
+
+bool LoginOrchestrator::isRunning() const
+{
+	return d->running;
+}
+
+bool LoginOrchestrator::isBackingOff() const
+{
+	return d->backingOff;
+}
+
+int LoginOrchestrator::elapsed() const
+{
+	return d->running ? d->startTime.elapsed() : 0;
+}
+
+int LoginOrchestrator::timeToAllOnline() const
+{
+	return d->timeToAllOnline;
+}
+
+void LoginOrchestrator::start()
+{
+	if (d->running)
+		return;
+	d->running = true;
+	d->startTime.start();
+	d->timeToAllOnline = -1;
+	d->backoffLevel = 0;
+	d->tokens = d->burst;
+	d->refillTime.start();
+	// Give the failed clients another chance
+	foreach (OrchestratedLogin *login, d->logins) {
+		if (login->state != OrchestratedLogin::Failed)
+			continue;
+		--d->failed;
+		login->attempt = 0;
+		d->enqueue(login);
+	}
+	d->schedule();
+	d->checkFinished();
+}
+
+void LoginOrchestrator::stop()
+{
+	d->running = false;
+	d->backingOff = false;
+	d->timer.stop();
+}
+
+void LoginOrchestrator::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == d->timer.timerId()) {
+		d->timer.stop();
+		if (d->backingOff) {
+			// Start with an empty bucket, so the logins come back slowly
+			d->backingOff = false;
+			d->tokens = 0;
+			d->refillTime.start();
+		}
+		d->schedule();
+	} else {
+		QObject::timerEvent(event);
+	}
+}
+
+void LoginOrchestrator::onLoginFinished()
+{
+	OrchestratedLogin *login = d->entry(sender());
+	if (!login || login->state == OrchestratedLogin::Online)
+		return;
+	// The client may also be brought online by its ReconnectManager
+	if (login->state == OrchestratedLogin::Pending)
+		d->queue.removeOne(login);
+	else if (login->state == OrchestratedLogin::InProgress)
+		--d->inProgress;
+	else if (login->state == OrchestratedLogin::Failed)
+		--d->failed;
+	login->state = OrchestratedLogin::Online;
+	++d->online;
+	d->backoffLevel = 0;
+	emit clientOnline(login->client);
+	emit progress(d->online, d->failed, d->logins.size());
+	d->schedule();
+	d->checkFinished();
+}
+
+void LoginOrchestrator::onDisconnected()
+{
+	OrchestratedLogin *login = d->entry(sender());
+	if (!login)
+		return;
+	if (login->state == OrchestratedLogin::Online) {
+		d->onOnlineLost(login);
+		return;
+	}
+	if (login->state != OrchestratedLogin::InProgress)
+		return;
+	Client *client = login->client;
+	// The login method is replacing the connection
+	if (client->d_func()->auth)
+		return;
+	--d->inProgress;
+	// The retries of the clients being logged in are done here
+	client->reconnectManager()->cancel();
+	AbstractConnection::ConnectionError error = client->error();
+	if (error == AbstractConnection::NoError) {
+		// The login is cancelled by the user
+		d->fail(login, error);
+	} else if (LoginOrchestratorPrivate::isRateLimit(error)) {
+		// The client is not to blame, the attempt is not counted
+		d->enqueue(login);
+		d->backOff();
+	} else if (ReconnectManager::isRecoverable(error) && ++login->attempt < d->maximumAttempts) {
+		d->enqueue(login);
+	} else {
+		d->fail(login, error);
+	}
+	d->schedule();
+	d->checkFinished();
+}
+
+void LoginOrchestrator::onClientDestroyed(QObject *object)
+{
+	if (OrchestratedLogin *login = d->entry(object))
+		d->remove(login);
+}
+
+} // namespace Ireen
@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_LOGINORCHESTRATOR_H
+#define IREEN_LOGINORCHESTRATOR_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include "client.h"
+
+namespace Ireen {
+
+class LoginOrchestratorPrivate;
+
+// Logs in many clients without tripping the connection and rate limits
+// of the server. The logins are admitted through a token bucket: up to
+// burst logins at once, then rate logins per second, with no more than
+// the maximum of logins being in progress at the same time.
+// If the server reports a rate or connection limit, all admissions are
+// paused with an exponential backoff and the bucket is emptied.
+// Clients with bigger weight are admitted first, clients with equal
+// weight are admitted in the order they were added.
+// A client losing its connection after the login is no longer counted as
+// online. It is left to its ReconnectManager if that one has scheduled
+// a reconnect, otherwise its login is queued again.
+// The clients must live in the thread of the orchestrator.
+class IREEN_EXPORT LoginOrchestrator : public QObject
+{
+	Q_OBJECT
+public:
+	explicit LoginOrchestrator(QObject *parent = 0);
+	virtual ~LoginOrchestrator();
+	void addClient(Client *client, const MD5LoginData &data, int weight = 1);
+#if IREEN_SSL_SUPPORT
+	void addClient(Client *client, const OAuthLoginData &data, int weight = 1);
+#endif
+	void removeClient(Client *client);
+	QList<Client*> clients() const;
+	// Logins per second and the capacity of the bucket, 5 and 10 by default
+	void setRate(qreal loginsPerSecond, int burst);
+	qreal rate() const;
+	int burst() const;
+	// 20 by default, 0 means no limit
+	void setMaximumInProgress(int count);
+	int maximumInProgress() const;
+	// Delays of the global pause after the rate limit errors, 10 sec and 5 min by default
+	void setBackoffDelays(int initialMsec, int maximumMsec);
+	// Attempts per client for the errors the client may recover from, 3 by default
+	void setMaximumAttempts(int count);
+	int maximumAttempts() const;
+	int pendingCount() const;
+	int inProgressCount() const;
+	int onlineCount() const;
+	int failedCount() const;
+	bool isRunning() const;
+	bool isBackingOff() const;
+	// Milliseconds since start(), and the time it took to bring all the clients
+	// online (or to fail them), -1 while the orchestrator is still running
+	int elapsed() const;
+	int timeToAllOnline() const;
+public slots:
+	void start();
+	void stop();
+signals:
+	void clientOnline(Ireen::Client *client);
+	void clientFailed(Ireen::Client *client, Ireen::AbstractConnection::ConnectionError error);
+	void backingOff(int msec);
+	void progress(int online, int failed, int total);
+	void finished();
+protected:
+	void timerEvent(QTimerEvent *event);
+private slots:
+	void onLoginFinished();
+	void onDisconnected();
+	void onClientDestroyed(QObject *object);
+private:
+	QScopedPointer<LoginOrchestratorPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_LOGINORCHESTRATOR_H
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_LOGINORCHESTRATOR_P_H
+#define IREEN_LOGINORCHESTRATOR_P_H
+
+#include "loginorchestrator.h"
+#include <QBasicTimer>
+#include <QTime>
+
+namespace Ireen {
+
+struct OrchestratedLogin
+{
+	enum State
+	{
+		Pending,
+		InProgress,
+		Online,
+		Failed,
+		// Lost the connection after the login, its ReconnectManager brings it back
+		Reconnecting,
+		// Disconnected by the application after the login
+		Offline
+	};
+	enum LoginMethod
+	{
+		Md5Method,
+		OAuthMethod
+	};
+	Client *client;
+	int weight;
+	State state;
+	int attempt;
+	LoginMethod method;
+	MD5LoginData md5Data;
+#if IREEN_SSL_SUPPORT
+	OAuthLoginData oauthData;
+#endif
+};
+
+class LoginOrchestratorPrivate
+{
+public:
+	OrchestratedLogin *entry(QObject *client) const;
+	void add(Client *client, OrchestratedLogin *login);
+	void remove(OrchestratedLogin *login);
+	void enqueue(OrchestratedLogin *login);
+	void refill();
+	void admit(OrchestratedLogin *login);
+	void fail(OrchestratedLogin *login, AbstractConnection::ConnectionError error);
+	void backOff();
+	void onOnlineLost(OrchestratedLogin *login);
+	void schedule();
+	void checkFinished();
+	static bool isRateLimit(AbstractConnection::ConnectionError error);
+public:
+	LoginOrchestrator *q;
+	QHash<QObject*, OrchestratedLogin*> logins;
+	// Ordered by weight, the first one is admitted next
+	QList<OrchestratedLogin*> queue;
+	bool running;
+	qreal rate;
+	int burst;
+	qreal tokens;
+	QTime refillTime;
+	int maximumInProgress;
+	int inProgress;
+	int online;
+	int failed;
+	int maximumAttempts;
+	int initialBackoff;
+	int maximumBackoff;
+	// Number of the rate limit errors in a row
+	int backoffLevel;
+	bool backingOff;
+	QTime startTime;
+	int timeToAllOnline;
+	QBasicTimer timer;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_LOGINORCHESTRATOR_P_H
@@ -27,6 +27,7 @@
 #include "md5login.h"
 #include "util.h"
 #include "client_p.h"
+#include "reconnectmanager_p.h"
 #include <QCryptographicHash>
 #include <QUrl>
 #include <QNetworkProxy>
@@ -87,6 +88,13 @@ void Md5Login::login()
 		QString loginServer = m_loginData.loginServer();
 		if (loginServer.isEmpty())
 			loginServer = QLatin1String("login.icq.com");
+		m_loginHost = loginServer;
+		// Do not resolve the same host for every client of the process
+		QList<QHostAddress> addresses = ReconnectManagerPrivate::cachedAddresses(loginServer);
+		if (!addresses.isEmpty()) {
+			connectToLoginServer(addresses);
+			return;
+		}
 		m_hostReqId = QHostInfo::lookupHost(loginServer, this, SLOT(hostFound(QHostInfo)));
 	}
 }
@@ -102,15 +110,29 @@ void Md5Login::hostFound(const QHostInfo &host)
 {
 	m_hostReqId = 0;
 	if (!host.addresses().isEmpty()) {
-		quint16 loginPort = m_loginData.loginServerPort();
-		if (loginPort == 0)
-			loginPort = 5190;
-		socket()->connectToHost(host.addresses().at(qrand() % host.addresses().size()), loginPort);
+		ReconnectManagerPrivate::cacheAddresses(m_loginHost, host.addresses());
+		connectToLoginServer(host.addresses());
 	} else {
 		setError(HostNotFound, tr("No IP addresses were found for the host '%1'").arg(m_loginData.loginServer()));
 	}
 }
 
+void Md5Login::connectToLoginServer(const QList<QHostAddress> &addresses)
+{
+	quint16 loginPort = m_loginData.loginServerPort();
+	if (loginPort == 0)
+		loginPort = 5190;
+	socket()->connectToHost(addresses.at(qrand() % addresses.size()), loginPort);
+}
+
+void Md5Login::onError(ConnectionError error)
+{
+	// The cached addresses of the login server may be outdated
+	if (error == SocketError && !m_loginHost.isEmpty())
+		ReconnectManagerPrivate::dropAddresses(m_loginHost);
+	AbstractConnection::onError(error);
+}
+
 void Md5Login::processNewConnection()
 {
 	AbstractConnection::processNewConnection();
@@ -49,14 +49,18 @@ protected:
 	virtual void processNewConnection();
 	virtual void processCloseConnection();
 	virtual void handleSNAC(AbstractConnection *conn, const SNAC &snac);
+	virtual void onError(ConnectionError error);
 private slots:
 	void hostFound(const QHostInfo &host);
+private:
+	void connectToLoginServer(const QList<QHostAddress> &addresses);
 private:
 #if IREEN_SSL_SUPPORT
 	bool useSsl;
 #endif
 	quint16 m_bossPort;
 	MD5LoginData m_loginData;
+	QString m_loginHost;
 	QByteArray m_bossAddr;
 	QByteArray m_cookie;
 	Client *m_client;
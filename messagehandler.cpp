@@ -28,15 +28,42 @@
 #include "messages.h"
 #include "client.h"
 #include "buddycaps.h"
+#include "metareplyhandler.h"
 #include <QColor>
+#include <QBasicTimer>
+#include <QTime>
+#include <QTimerEvent>
 
 namespace Ireen {
 
-class MessageHandlerPrivate : public SNACHandler
+// Typing state of a conversation as seen by the contact
+struct OutgoingTyping
+{
+	OutgoingTyping() : sent(MtnFinished), pending(false), changedAt(0), sentAt(-1) {}
+	MTN sent;
+	MTN state;
+	bool pending;
+	// The first change since the last notification
+	int changedAt;
+	int sentAt;
+};
+
+// Typing state of a conversation as reported to the application
+struct IncomingTyping
+{
+	IncomingTyping() : emitted(MtnFinished), pending(false), emittedAt(-1) {}
+	MTN emitted;
+	MTN state;
+	bool pending;
+	int emittedAt;
+};
+
+class MessageHandlerPrivate : public SNACHandler, public MetaReplyHandler
 {
 public:
 	MessageHandlerPrivate(MessageHandler *q_ptr, Client *client);
 	void handleSNAC(AbstractConnection *client, const SNAC &snac);
+	void handleMetaReply(const MetaReply &reply);
 	void handleMessage(const SNAC &snac);
 	void handleResponse(const SNAC &snac);
 	QString handleChannel1Message(const QString &uin, const TLVMap &tlvs);
@@ -44,8 +71,20 @@ public:
 	QString handleChannel4Message(const QString &uin, const TLVMap &tlvs);
 	QString handleTlv2711(const DataUnit &data, const QString &uin, quint16 ack, const Cookie &msgCookie);
 	void sendMetaInfoRequest(quint16 type);
+	void handleTyping(const QString &uin, MTN state);
+	void flushTyping();
+	void clearTyping();
+	// Milliseconds since the event at msec, QTime wraps at midnight
+	int since(int msec) const;
 public:
 	bool detectCodec;
+	QHash<QString, OutgoingTyping> outgoingTyping;
+	QHash<QString, IncomingTyping> incomingTyping;
+	int typingWindow;
+	int typingInterval;
+	int typingDebounce;
+	QTime typingClock;
+	QBasicTimer typingTimer;
 	QMultiHash<Capability, MessagePlugin *> msg_plugins;
 	QMultiHash<Tlv2711Type, Tlv2711Plugin *> tlvs2711Plugins;
 	Client *client;
@@ -61,16 +100,22 @@ MessageHandlerPrivate::MessageHandlerPrivate(MessageHandler *q_ptr, Client *clie
 			<< SNACInfo(MessageFamily, MessageSrvRecv)
 			<< SNACInfo(MessageFamily, MessageSrvAck)
 			<< SNACInfo(MessageFamily, MessageMtn)
-			<< SNACInfo(MessageFamily, MessageSrvError)
-			<< SNACInfo(ExtensionsFamily, ExtensionsMetaSrvReply);
+			<< SNACInfo(MessageFamily, MessageSrvError);
+	m_metaTypes << 0x0041 << 0x0042;
 
 	this->client = client;
 	detectCodec = true;
+	typingWindow = 300;
+	typingInterval = 2000;
+	typingDebounce = 300;
+	typingClock.start();
 	client->registerInitializationSnac(MessageFamily, MessageCliReqIcbm);
 	client->registerInitializationSnac(MessageFamily, MessageCliSetParams);
 	client->registerHandler(this);
+	client->registerMetaReplyHandler(this);
 
 	q->connect(client, SIGNAL(loginFinished()), SLOT(loginFinished()));
+	q->connect(client, SIGNAL(disconnected()), SLOT(onDisconnected()));
 }
 
 MessagePlugin::~MessagePlugin()
@@ -111,6 +156,47 @@ void MessageHandler::setDetectCodec(bool detectCodec)
 	d->detectCodec = detectCodec;
 }
 
+void MessageHandler::sendTypingNotification(const QString &uin, MTN state)
+{
+	OutgoingTyping &typing = d->outgoingTyping[uin];
+	if (!typing.pending) {
+		// The contact already knows the state
+		if (state == typing.sent)
+			return;
+		typing.pending = true;
+		typing.changedAt = d->typingClock.elapsed();
+	}
+	typing.state = state;
+	d->flushTyping();
+}
+
+void MessageHandler::setTypingNotificationDelays(int windowMsec, int intervalMsec)
+{
+	d->typingWindow = qMax(windowMsec, 0);
+	d->typingInterval = qMax(intervalMsec, 0);
+}
+
+void MessageHandler::setTypingNotificationDebounce(int msec)
+{
+	d->typingDebounce = qMax(msec, 0);
+	if (d->typingDebounce == 0)
+		d->flushTyping();
+}
+
+QList<Cookie> MessageHandler::sendMessage(const QStringList &uins, const MessageTemplate &message)
+{
+	QList<Cookie> cookies;
+	cookies.reserve(uins.size());
+	foreach (const QString &uin, uins) {
+		Cookie cookie(d->client, uin, Cookie::generateId());
+		ServerMessage snac(uin, message, cookie);
+		d->client->send(snac, false);
+		cookies << cookie;
+	}
+	debug(MessagesDebug) << "Queued a message for" << uins.size() << "recipients";
+	return cookies;
+}
+
 void MessageHandlerPrivate::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 {
 	Q_ASSERT(conn == conn);
@@ -151,9 +237,13 @@ void MessageHandlerPrivate::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		Cookie cookie = sn.read<Cookie>();
 		quint16 channel = sn.read<quint16>();
 		QString uin = sn.read<QString, qint8>();
+		if (sn.hasError()) {
+			warning(MessagesDebug) << "Malformed message acknowledgement";
+			break;
+		}
 		cookie.setClient(this->client);
 		cookie.setUin(uin);
-		debug() << QString("Server accepted message for delivery to %1 on channel %2").arg(uin).arg(channel);
+		debug(MessagesDebug) << QString("Server accepted message for delivery to %1 on channel %2").arg(uin).arg(channel);
 		emit q->messageAccepted(cookie, uin, channel);
 		break;
 	}
@@ -165,33 +255,18 @@ void MessageHandlerPrivate::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		Q_UNUSED(channel);
 		QString uin = sn.read<QString, qint8>();
 		MTN type = MTN(sn.read<quint16>());
+		if (sn.hasError()) {
+			warning(MessagesDebug) << "Malformed typing notification";
+			break;
+		}
 		if (type != MtnFinished && type != MtnTyped && type != MtnBegun && type != MtnGone)
 			type = MtnUnknown;
-		emit q->typingNotification(uin, type);
-		break;
-	}
-	case ExtensionsFamily << 16 | ExtensionsMetaSrvReply: {
-		TLVMap tlvs = sn.read<TLVMap>();
-		if (tlvs.contains(0x01)) {
-			DataUnit data(tlvs.value(0x01));
-			data.skipData(6); // skip length field + my uin
-			quint16 metaType = data.read<quint16>(LittleEndian);
-			switch (metaType) {
-			case (0x0041):
-				// Offline message.
-				// It seems it's not used anymore.
-				break;
-			case (0x0042):
-				// Delete offline messages from the server.
-				sendMetaInfoRequest(0x003E);
-				break;
-			}
-		}
+		handleTyping(uin, type);
 		break;
 	}
 	case MessageFamily << 16 | MessageSrvError: {
 		ProtocolError error(sn);
-		debug() << QString("Error (%1, %2): %3")
+		debug(MessagesDebug) << QString("Error (%1, %2): %3")
 				.arg(error.code(), 2, 16)
 				.arg(error.subcode(), 2, 16)
 				.arg(error.errorString());
@@ -200,30 +275,146 @@ void MessageHandlerPrivate::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 	}
 }
 
+void MessageHandlerPrivate::handleMetaReply(const MetaReply &reply)
+{
+	switch (reply.type) {
+	case (0x0041):
+		// Offline message.
+		// It seems it's not used anymore.
+		break;
+	case (0x0042):
+		// Delete offline messages from the server.
+		sendMetaInfoRequest(0x003E);
+		break;
+	}
+}
+
 void MessageHandler::loginFinished()
 {
 	// Offline messages request
 	d->sendMetaInfoRequest(0x003C);
 }
 
+void MessageHandler::onDisconnected()
+{
+	d->clearTyping();
+}
+
+void MessageHandler::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == d->typingTimer.timerId())
+		d->flushTyping();
+	else
+		QObject::timerEvent(event);
+}
+
+int MessageHandlerPrivate::since(int msec) const
+{
+	int diff = typingClock.elapsed() - msec;
+	return diff < 0 ? diff + 24 * 60 * 60 * 1000 : diff;
+}
+
+void MessageHandlerPrivate::handleTyping(const QString &uin, MTN state)
+{
+	if (typingDebounce <= 0) {
+		emit q->typingNotification(uin, state);
+		return;
+	}
+	IncomingTyping &typing = incomingTyping[uin];
+	if (state == typing.emitted) {
+		// The change has been reverted before it was reported
+		typing.pending = false;
+		return;
+	}
+	typing.state = state;
+	typing.pending = true;
+	flushTyping();
+}
+
+void MessageHandlerPrivate::flushTyping()
+{
+	bool waiting = false;
+
+	QHash<QString, IncomingTyping>::iterator in = incomingTyping.begin();
+	while (in != incomingTyping.end()) {
+		IncomingTyping &typing = in.value();
+		if (typing.pending && (typing.emittedAt < 0 || since(typing.emittedAt) >= typingDebounce)) {
+			typing.pending = false;
+			typing.emitted = typing.state;
+			typing.emittedAt = typingClock.elapsed();
+			emit q->typingNotification(in.key(), typing.state);
+		}
+		if (typing.pending) {
+			waiting = true;
+		} else if ((typing.emitted == MtnFinished || typing.emitted == MtnGone)
+				   && since(typing.emittedAt) >= typingDebounce) {
+			in = incomingTyping.erase(in);
+			continue;
+		}
+		++in;
+	}
+
+	// The notifications are meaningless for the next session
+	if (client->state() != AbstractConnection::Connected)
+		outgoingTyping.clear();
+	QHash<QString, OutgoingTyping>::iterator out = outgoingTyping.begin();
+	while (out != outgoingTyping.end()) {
+		OutgoingTyping &typing = out.value();
+		if (typing.pending && typing.state == typing.sent) {
+			// The changes within the window cancelled each other
+			typing.pending = false;
+		} else if (typing.pending) {
+			bool due = since(typing.changedAt) >= typingWindow
+					&& (typing.sentAt < 0 || since(typing.sentAt) >= typingInterval);
+			// Only the free room of the rate class is used, the messages are never delayed
+			if (due && client->testRate(MessageFamily, MessageMtn, false)) {
+				MTNMessage snac(out.key(), typing.state);
+				client->send(snac, false);
+				typing.sent = typing.state;
+				typing.sentAt = typingClock.elapsed();
+				typing.pending = false;
+			} else {
+				waiting = true;
+			}
+		}
+		if (!typing.pending && (typing.sent == MtnFinished || typing.sent == MtnGone)
+				&& (typing.sentAt < 0 || since(typing.sentAt) >= typingInterval)) {
+			out = outgoingTyping.erase(out);
+			continue;
+		}
+		++out;
+	}
+
+	if (!waiting)
+		typingTimer.stop();
+	else if (!typingTimer.isActive())
+		typingTimer.start(100, q);
+}
+
+void MessageHandlerPrivate::clearTyping()
+{
+	outgoingTyping.clear();
+	incomingTyping.clear();
+	typingTimer.stop();
+}
+
 void MessageHandlerPrivate::handleMessage(const SNAC &snac)
 {
 	Cookie cookie = snac.read<Cookie>();
 	quint16 channel = snac.read<quint16>();
 	QString uin = snac.read<QString, quint8>();
-	if (uin.isEmpty()) {
-		debug() << "Received a broken message packet";
-		debug(DebugVeryVerbose) << "The packet:" << snac.data().toHex();
+	quint16 warningLevel = snac.read<quint16>();
+	Q_UNUSED(warningLevel);
+	snac.skipData(2); // unused number of tlvs
+	TLVMap tlvs = snac.read<TLVMap>();
+	if (uin.isEmpty() || snac.hasError()) {
+		debug(MessagesDebug) << "Received a broken message packet";
+		debug(MessagesDebug, DebugVeryVerbose) << "The packet:" << snac.data().toHex();
 		return;
 	}
 
 	cookie.setClient(client);
 	cookie.setUin(uin);
-
-	quint16 warning = snac.read<quint16>();
-	Q_UNUSED(warning);
-	snac.skipData(2); // unused number of tlvs
-	TLVMap tlvs = snac.read<TLVMap>();
 	QString message;
 	switch (channel) {
 	case 0x0001: // message
@@ -236,7 +427,7 @@ void MessageHandlerPrivate::handleMessage(const SNAC &snac)
 		message = handleChannel4Message(uin, tlvs);
 		break;
 	default:
-		Ireen::warning() << "Unknown message channel:" << channel;
+		warning(MessagesDebug) << "Unknown message channel:" << channel;
 	}
 
 	if (!message.isEmpty()) {
@@ -245,6 +436,8 @@ void MessageHandlerPrivate::handleMessage(const SNAC &snac)
 			time = QDateTime::fromTime_t(tlvs.value(0x0016).read<quint32>());
 		else
 			time = QDateTime::currentDateTime();
+		// The message ends the typing, a late notification must not restart it
+		incomingTyping.remove(uin);
 		emit q->messageReceived(uin, message, time, cookie, channel);
 	}
 }
@@ -254,14 +447,18 @@ void MessageHandlerPrivate::handleResponse(const SNAC &snac)
 	Cookie cookie = snac.read<Cookie>();
 	quint16 format = snac.read<quint16>();
 	if (format != 2) {
-		debug() << "Unknown response format" << format;
+		debug(MessagesDebug) << "Unknown response format" << format;
 		return;
 	}
 
 	QString uin = snac.read<QString, quint8>();
+	snac.skipData(2); //quint16 reason = snac.read<quint16>();
+	if (snac.hasError()) {
+		debug(MessagesDebug) << "Received a broken message response";
+		return;
+	}
 	cookie.setClient(client);
 	cookie.setUin(uin);
-	snac.skipData(2); //quint16 reason = snac.read<quint16>();
 	handleTlv2711(snac, uin, 2, cookie);
 }
 
@@ -272,13 +469,15 @@ QString MessageHandlerPrivate::handleChannel1Message(const QString &uin, const T
 		DataUnit data(tlvs.value(0x0002));
 		TLVMap msgTlvs = data.read<TLVMap>();
 		if (msgTlvs.contains(0x0501))
-			debug(DebugVerbose) << "Message has" << msgTlvs.value(0x0501).data().toHex().constData() << "caps";
+			debug(MessagesDebug, DebugVerbose) << "Message has" << msgTlvs.value(0x0501).data().toHex().constData() << "caps";
 		foreach(const TLV &tlv, msgTlvs.values(0x0101))
 		{
 			DataUnit msg_data(tlv);
 			quint16 charset = msg_data.read<quint16>();
 			quint16 codepage = msg_data.read<quint16>();
 			Q_UNUSED(codepage);
+			if (msg_data.hasError())
+				continue;
 			QByteArray data = msg_data.readAll();
 			QTextCodec *codec = 0;
 			if (charset == CodecUtf16Be)
@@ -290,9 +489,9 @@ QString MessageHandlerPrivate::handleChannel1Message(const QString &uin, const T
 			message += codec->toUnicode(data);
 		}
 	} else {
-		debug() << "Incorrect message on channel 1 from" << uin << ": SNAC should contain TLV 2";
+		debug(MessagesDebug) << "Incorrect message on channel 1 from" << uin << ": SNAC should contain TLV 2";
 	}
-	debug(DebugVerbose) << "New message has been received on channel 1:" << message;
+	debug(MessagesDebug, DebugVerbose) << "New message has been received on channel 1:" << message;
 	return message;
 }
 
@@ -303,13 +502,13 @@ QString MessageHandlerPrivate::handleChannel2Message(const QString &uin, const T
 		quint16 type = data.read<quint16>();
 		data.skipData(8); // again cookie
 		Capability guid = data.read<Capability>();
-		if (guid.isEmpty()) {
-			debug() << "Incorrect message on channel 2 from" << uin << ": guid is not found";
+		if (data.hasError() || guid.isEmpty()) {
+			debug(MessagesDebug) << "Incorrect message on channel 2 from" << uin << ": guid is not found";
 			return QString();
 		}
 		if (guid == ICQ_CAPABILITY_SRVxRELAY) {
 			if (type == 1) {
-				debug() << "Abort messages on channel 2 is ignored";
+				debug(MessagesDebug) << "Abort messages on channel 2 is ignored";
 				return QString();
 			}
 			TLVMap tlvs = data.read<TLVMap>();
@@ -318,7 +517,7 @@ QString MessageHandlerPrivate::handleChannel2Message(const QString &uin, const T
 				DataUnit data(tlvs.value(0x2711));
 				return handleTlv2711(data, uin, ack, msgCookie);
 			} else
-				debug() << "Message on channel 2 should contain TLV 2711";
+				debug(MessagesDebug) << "Message on channel 2 should contain TLV 2711";
 		} else {
 			QList<MessagePlugin *> plugins = msg_plugins.values(guid);
 			if (!plugins.isEmpty()) {
@@ -326,7 +525,7 @@ QString MessageHandlerPrivate::handleChannel2Message(const QString &uin, const T
 				for (int i = 0; i < plugins.size(); i++)
 					plugins.at(i)->processMessage(uin, guid, plugin_data, type, msgCookie);
 			} else {
-				debug() << IMPLEMENT_ME
+				debug(MessagesDebug) << IMPLEMENT_ME
 						<< QString("Message (channel 2) from %1 with type %2 and guid %3 is not processed.")
 						.arg(uin)
 						.arg(type)
@@ -334,7 +533,7 @@ QString MessageHandlerPrivate::handleChannel2Message(const QString &uin, const T
 			}
 		}
 	} else
-		debug() << "Incorrect message on channel 2 from" << uin << ": SNAC should contain TLV 5";
+		debug(MessagesDebug) << "Incorrect message on channel 2 from" << uin << ": SNAC should contain TLV 5";
 	return QString();
 }
 
@@ -351,21 +550,25 @@ QString MessageHandlerPrivate::handleChannel4Message(const QString &uin, const T
 		QByteArray msg_data = data.read<QByteArray, quint16>(LittleEndian);
 		Q_UNUSED(flags);
 		Q_UNUSED(msg_data);
-		debug() << IMPLEMENT_ME << QString("Message (channel 3) from %1 with type %2 is not processed.").arg(uin).arg(type);
+		if (data.hasError()) {
+			debug(MessagesDebug) << "Incorrect message on channel 4 from" << uin << ": TLV 5 is truncated";
+			return QString();
+		}
+		debug(MessagesDebug) << IMPLEMENT_ME << QString("Message (channel 3) from %1 with type %2 is not processed.").arg(uin).arg(type);
 	} else
-		debug() << "Incorrect message on channel 4 from" << uin << ": SNAC should contain TLV 5";
+		debug(MessagesDebug) << "Incorrect message on channel 4 from" << uin << ": SNAC should contain TLV 5";
 	return QString();
 }
 
 QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString &uin, quint16 ack, const Cookie &msgCookie)
 {
 	if (ack == 2 && !msgCookie.unlock()) {
-		debug().nospace() << "Skipped unexpected response message with cookie " << msgCookie.id();
+		debug(MessagesDebug).nospace() << "Skipped unexpected response message with cookie " << msgCookie.id();
 		return QString();
 	}
 	quint16 id = data.read<quint16>(LittleEndian);
 	if (id != 0x1B) {
-		debug() << "Unknown message id in TLV 2711";
+		debug(MessagesDebug) << "Unknown message id in TLV 2711";
 		return QString();
 	}
 	quint16 version = data.read<quint16>(LittleEndian);
@@ -376,6 +579,10 @@ QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString
 	id = data.read<quint16>(LittleEndian);
 	quint16 cookie = data.read<quint16>(LittleEndian);
 	Q_UNUSED(cookie);
+	if (data.hasError()) {
+		debug(MessagesDebug) << "Truncated TLV 2711 from" << uin;
+		return QString();
+	}
 	if (guid == ICQ_CAPABILITY_PSIG_MESSAGE) {
 		data.skipData(12);
 		quint8 type = data.read<quint8>();
@@ -389,19 +596,16 @@ QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString
 		if (type == MsgPlain && ack != 2) // Plain message
 		{
 			QByteArray message_data = data.read<QByteArray, quint16>(LittleEndian);
+			if (data.hasError()) {
+				debug(MessagesDebug) << "Truncated message text from" << uin;
+				return QString();
+			}
 			message_data.resize(message_data.size() - 1);
-			QColor foreground(data.read<quint8>(),
-							  data.read<quint8>(),
-							  data.read<quint8>(),
-							  data.read<quint8>());
-			QColor background(data.read<quint8>(),
-							  data.read<quint8>(),
-							  data.read<quint8>(),
-							  data.read<quint8>());
-			Q_UNUSED(foreground);
-			Q_UNUSED(background);
+			// The colors and the capabilities are optional,
+			// so they are read only when present
+			data.skipData(8); // foreground and background colors
 			QTextCodec *codec = NULL;
-			while (data.dataSize() > 0) {
+			while (data.dataSize() >= 4) {
 				QString guid = data.read<QString, quint32>(LittleEndian);
 				if (!detectCodec) {
 					if (guid.compare(ICQ_CAPABILITY_UTF8.toString(), Qt::CaseInsensitive) == 0) {
@@ -409,7 +613,7 @@ QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString
 					}
 				}
 				if (guid.compare(ICQ_CAPABILITY_RTFxMSGS.toString(), Qt::CaseInsensitive) == 0) {
-					debug() << "RTF is not supported";
+					debug(MessagesDebug) << "RTF is not supported";
 					return QString();
 				}
 			}
@@ -420,7 +624,7 @@ QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString
 					codec = client->asciiCodec();
 			}
 			QString message = codec->toUnicode(message_data);
-			debug(DebugVerbose) << "New message has been received on channel 2:" << message;
+			debug(MessagesDebug, DebugVerbose) << "New message has been received on channel 2:" << message;
 			return message;
 		} else if (MsgPlugin) {
 			data.skipData(3);
@@ -431,9 +635,11 @@ QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString
 			DataUnit pluginData = data.read<DataUnit, quint32>(LittleEndian);
 			if (pluginType.isNull()) {
 				if (ack == 2) {
-					debug() << "Message with id" << msgCookie.id() << "has been delivered";
+					debug(MessagesDebug) << "Message with id" << msgCookie.id() << "has been delivered";
 					emit q->messageDelivered(msgCookie, uin);
 				}
+			} else if (data.hasError() || info.hasError()) {
+				debug(MessagesDebug) << "Truncated plugin message from" << uin;
 			} else {
 				bool found = false;
 				foreach (Tlv2711Plugin *plugin, tlvs2711Plugins.values(Tlv2711Type(pluginType, pluginId))) {
@@ -441,14 +647,14 @@ QString MessageHandlerPrivate::handleTlv2711(const DataUnit &data, const QString
 					found = true;
 				}
 				if (!found) {
-					debug() << "Unhandled plugin message" << pluginType.toString()
+					debug(MessagesDebug) << "Unhandled plugin message" << pluginType.toString()
 							<< pluginId << pluginName << pluginData.data().toHex();
 				}
 			}
 		} else
-			debug() << "Unhandled TLV 2711 message with type" << hex << type;
+			debug(MessagesDebug) << "Unhandled TLV 2711 message with type" << hex << type;
 	} else {
-		debug() << "Unknown format of TLV 2711";
+		debug(MessagesDebug) << "Unknown format of TLV 2711";
 	}
 	return QString();
 }
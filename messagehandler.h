@@ -31,6 +31,7 @@
 #include "core/messages.h"
 
 #include "core/capability.h"
+#include <QStringList>
 
 namespace Ireen {
 
@@ -70,6 +71,21 @@ public:
 	void registerHandler(const Capability &capability, MessagePlugin *handler);
 	void registerHandler(const Capability &type, quint16 id, Tlv2711Plugin *handler);
 	void setDetectCodec(bool detectCodec = true);
+	// Sends the same message to all the recipients. The message is encoded once,
+	// the snacs are queued in the rate class of the messages behind the interactive
+	// traffic. Returns the cookies in the order of the recipients, the server
+	// reports each accepted message by messageAccepted() if the template requests it.
+	QList<Cookie> sendMessage(const QStringList &uins, const MessageTemplate &message);
+	// Typing notifications are coalesced: the changes made within the window are
+	// sent as one, the state the contact already knows is not sent again, and
+	// a contact gets no more than one notification per interval. They are sent only
+	// when the rate class has room for them, so they never delay the messages.
+	void sendTypingNotification(const QString &uin, MTN state);
+	// 300 msec and 2 sec by default
+	void setTypingNotificationDelays(int windowMsec, int intervalMsec);
+	// Notifications of a contact are reported no more often than once per msec,
+	// the last state wins. 300 msec by default, 0 reports every notification.
+	void setTypingNotificationDebounce(int msec);
 signals:
 	// The message identified by cookie has been received by the server and
 	// it agreed to pass it to the destination.
@@ -81,8 +97,11 @@ signals:
 	// A new message has been received.
 	void messageReceived(const QString &uin, const QString &message, const QDateTime &time,
 						 const Ireen::Cookie &cookie, quint16 channel);
+protected:
+	void timerEvent(QTimerEvent *event);
 private slots:
 	void loginFinished();
+	void onDisconnected();
 private:
 	friend class MessageHandlerPrivate;
 	QScopedPointer<MessageHandlerPrivate> d;
@@ -26,6 +26,7 @@
 #include "abstractmetarequest_p.h"
 #include "../core/snac.h"
 #include "../client.h"
+#include "../core/requesttracker.h"
 #include "metainfo_p.h"
 
 namespace Ireen {
@@ -56,7 +57,7 @@ bool AbstractMetaRequest::isDone() const
 
 void AbstractMetaRequest::setTimeout(int msec)
 {
-	d_func()->timer.setInterval(msec);
+	d_func()->timeout = msec;
 }
 
 AbstractMetaRequest::ErrorType AbstractMetaRequest::errorType()
@@ -79,21 +80,43 @@ void AbstractMetaRequest::timeout()
 	close(false, Timeout, tr("The server did not answer on the metarequest"));
 }
 
+void AbstractMetaRequest::onRequestResolved(const PendingRequest &request)
+{
+	if (request.status() == PendingRequest::TimedOut)
+		timeout();
+}
+
 AbstractMetaRequest::AbstractMetaRequest(MetaInfo *metaInfo, AbstractMetaRequestPrivate *d) :
 	d_ptr(d)
 {
 	d->id = metaInfo->d->nextId();
 	d->metaInfo = metaInfo;
 	d->ok = false;
-	d->timer.setInterval(60000);
-	d->timer.setSingleShot(true);
+	d->timeout = 60000;
 	d->errorType = NoError;
-	connect(&d->timer, SIGNAL(timeout()), this, SLOT(timeout()));
+}
+
+bool AbstractMetaRequest::isCacheable() const
+{
+	return false;
 }
 
 void AbstractMetaRequest::sendRequest(quint16 type, const DataUnit &extendData) const
 {
 	Q_D(const AbstractMetaRequest);
+	AbstractMetaRequest *self = const_cast<AbstractMetaRequest*>(this);
+	MetaInfoPrivate *metaInfo = d->metaInfo->d.data();
+	if (isCacheable()) {
+		d->cacheKey = MetaInfoPrivate::cacheKey(type, extendData.data());
+		if (metaInfo->replayCached(self, d->cacheKey))
+			return;
+		if (metaInfo->attachRequest(self, d->cacheKey)) {
+			client()->requestTracker()->start(PendingRequest::MetaSequenceKey, d->id, d->timeout,
+											  continuation(self, &AbstractMetaRequest::onRequestResolved), type);
+			return;
+		}
+		metaInfo->startSharedRequest(self, d->cacheKey);
+	}
 	SNAC snac(ExtensionsFamily, ExtensionsMetaCliRequest);
 	DataUnit tlvData;
 	DataUnit data;
@@ -105,9 +128,10 @@ void AbstractMetaRequest::sendRequest(quint16 type, const DataUnit &extendData)
 	tlvData.append<quint16>(data.data().size(), LittleEndian);
 	tlvData.append(data.data());
 	snac.appendTLV(1, tlvData);
-	d->metaInfo->d->addRequest(const_cast<AbstractMetaRequest*>(this));
+	metaInfo->addRequest(self);
 	client()->send(snac);
-	d->timer.start();
+	client()->requestTracker()->start(PendingRequest::MetaSequenceKey, d->id, d->timeout,
+									  continuation(self, &AbstractMetaRequest::onRequestResolved), type);
 }
 
 void AbstractMetaRequest::close(bool ok, ErrorType error, const QString &errorString)
@@ -116,7 +140,14 @@ void AbstractMetaRequest::close(bool ok, ErrorType error, const QString &errorSt
 	d->ok = ok;
 	d->errorType = error;
 	d->errorString = errorString;
-	if (d->metaInfo->d->removeRequest(this) || ok)
+	RequestTracker *tracker = client()->requestTracker();
+	if (ok || error == ProtocolError)
+		tracker->finish(PendingRequest::MetaSequenceKey, d->id);
+	else
+		tracker->cancel(PendingRequest::MetaSequenceKey, d->id);
+	bool wasActive = d->metaInfo->d->removeRequest(this);
+	d->metaInfo->d->finishRequest(this, ok, error, errorString);
+	if (wasActive || ok)
 		emit done(ok);
 }
 
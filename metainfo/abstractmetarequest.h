@@ -35,6 +35,7 @@ namespace Ireen {
 class AbstractMetaRequestPrivate;
 class MetaInfo;
 class Client;
+class PendingRequest;
 
 class IREEN_EXPORT AbstractMetaRequest : public QObject
 {
@@ -66,10 +67,17 @@ private slots:
 	void timeout();
 protected:
 	friend class MetaInfo;
+	friend class MetaInfoPrivate;
 	AbstractMetaRequest(MetaInfo *metaInfo, AbstractMetaRequestPrivate *d);
 	virtual bool handleData(quint16 type, const DataUnit &data) = 0;
+	// Cacheable requests share the server reply with identical requests
+	// and are answered from the MetaInfo cache without sending anything.
+	// The cached reply is delivered from the event loop, like the server one.
+	virtual bool isCacheable() const;
 	void sendRequest(quint16 type, const DataUnit &data) const;
 	void close(bool ok, ErrorType error = NoError, const QString &errorString = QString());
+private:
+	void onRequestResolved(const PendingRequest &request);
 protected:
 	QScopedPointer<AbstractMetaRequestPrivate> d_ptr;
 };
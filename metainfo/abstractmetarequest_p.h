@@ -27,7 +27,6 @@
 #define IREEN_ABSTRACTMETAREQUEST_P_H
 
 #include "abstractmetarequest.h"
-#include <QTimer>
 
 namespace Ireen {
 
@@ -37,9 +36,10 @@ public:
 	quint16 id;
 	MetaInfo *metaInfo;
 	bool ok;
-	mutable QTimer timer;
+	int timeout;
 	AbstractMetaRequest::ErrorType errorType;
 	QString errorString;
+	mutable QByteArray cacheKey;
 };
 
 } // namespace Ireen
@@ -36,24 +36,24 @@ void ShortInfoMetaRequestPrivate::readString(MetaFieldEnum value, const DataUnit
 {
 	QString str = readSString(data, metaInfo->client());
 	if (!str.isEmpty())
-		values.insert(value, str);
+		info()->setString(value, str);
 }
 
 void ShortInfoMetaRequestPrivate::readFlag(MetaFieldEnum value, const DataUnit &data)
 {
-	bool f = static_cast<bool>(data.read<quint8>());
-	values.insert(value, f);
+	info()->setNumber(value, data.read<quint8>() != 0);
 }
 
 void ShortInfoMetaRequestPrivate::dump()
 {
-	QHashIterator<MetaFieldKey, QVariant> itr(values);
-	while (itr.hasNext()) {
-		itr.next();
-		if (itr.value().canConvert<CategoryList>())
-			debug() << itr.key().toString() << itr.value().value<CategoryList>();
+	for (int i = FirstMetaField; i <= LastMetaField; ++i) {
+		MetaFieldEnum field = static_cast<MetaFieldEnum>(i);
+		if (!values.contains(field))
+			continue;
+		if (MetaInfoValuesPrivate::fieldType(field) == MetaInfoValuesPrivate::CategoryListField)
+			debug(MetaInfoDebug) << MetaFieldKey(field).toString() << values.categories(field);
 		else
-			debug() << itr.key().toString() << itr.value();
+			debug(MetaInfoDebug) << MetaFieldKey(field).toString() << values.value(field);
 	}
 }
 
@@ -66,11 +66,16 @@ ShortInfoMetaRequest::ShortInfoMetaRequest(MetaInfo *metaInfo, const QString &ui
 	Q_ASSERT(ok && "Cannot request information about an aim contact");
 }
 
-MetaInfoValuesHash ShortInfoMetaRequest::values() const
+MetaInfoValues ShortInfoMetaRequest::info() const
 {
 	return d_func()->values;
 }
 
+MetaInfoValuesHash ShortInfoMetaRequest::values() const
+{
+	return d_func()->values.toHash();
+}
+
 QVariant ShortInfoMetaRequest::value(MetaFieldKey key, const QVariant &def) const
 {
 	return d_func()->values.value(key, def);
@@ -88,6 +93,11 @@ ShortInfoMetaRequest::ShortInfoMetaRequest()
 {
 }
 
+bool ShortInfoMetaRequest::isCacheable() const
+{
+	return true;
+}
+
 bool ShortInfoMetaRequest::handleData(quint16 type, const DataUnit &data)
 {
 	Q_D(ShortInfoMetaRequest);
@@ -102,35 +112,31 @@ bool ShortInfoMetaRequest::handleData(quint16 type, const DataUnit &data)
 	{
 		quint8 genderId = data.read<quint8>();
 		if (genderId)
-			d->values.insert(Gender, genders().value(genderId));
+			d->info()->setNumber(Gender, genderId);
 	}
-	debug() << d->uin << "short info:";
+	debug(MetaInfoDebug) << d->uin << "short info:";
 	d->dump();
 	close(true);
 	return true;
 }
 
 template <typename T>
-void FullInfoMetaRequestPrivate::readField(MetaFieldEnum value, const DataUnit &data, const FieldNamesList &list)
+void FullInfoMetaRequestPrivate::readField(MetaFieldEnum value, const DataUnit &data, const FieldNamesTable &list)
 {
-	QString str = list.value(data.read<T>(LittleEndian));
-	if (!str.isEmpty())
-		values.insert(value, str);
+	T code = data.read<T>(LittleEndian);
+	if (list.contains(code))
+		info()->setNumber(value, code);
 }
 
-void FullInfoMetaRequestPrivate::readCategories(MetaFieldEnum value, const DataUnit &data, const FieldNamesList &list)
+void FullInfoMetaRequestPrivate::readCategories(MetaFieldEnum value, const DataUnit &data, const FieldNamesTable &list)
 {
-	CategoryList result;
 	quint8 count = data.read<quint8>();
-	Category category;
 	for (int i = 0; i < count; ++i) {
-		category.category = list.value(data.read<quint16>(LittleEndian));
-		category.keyword = readSString(data, metaInfo->client());
-		if (!category.category.isEmpty())
-			result << category;
+		quint16 code = data.read<quint16>(LittleEndian);
+		QString keyword = readSString(data, metaInfo->client());
+		if (list.contains(code))
+			info()->addItem(value, code, keyword);
 	}
-	if (!result.isEmpty())
-		values.insert(value, QVariant::fromValue(result));
 }
 
 void FullInfoMetaRequestPrivate::handleBasicInfo(const DataUnit &data)
@@ -147,7 +153,7 @@ void FullInfoMetaRequestPrivate::handleBasicInfo(const DataUnit &data)
 	readString(CellPhone, data);
 	readString(HomeZipCode, data);
 	readField<quint16>(HomeCountry, data, countries());
-	values.insert(GMT, data.read<qint8>());
+	info()->setNumber(GMT, data.read<qint8>());
 	readFlag(AuthFlag, data);
 	readFlag(WebawareFlag, data);
 	readFlag(DirectConnectionFlag, data);
@@ -158,11 +164,11 @@ void FullInfoMetaRequestPrivate::handleMoreInfo(const DataUnit &data)
 {
 	quint16 age = data.read<quint16>(LittleEndian);
 	if (age != 0)
-		values.insert(Age, age);
+		info()->setNumber(Age, age);
 	{
 		quint8 genderId = data.read<quint8>();
 		if (genderId)
-			values.insert(Gender, genders().value(genderId));
+			info()->setNumber(Gender, genderId);
 	}
 	readString(Homepage, data);
 	{
@@ -170,38 +176,30 @@ void FullInfoMetaRequestPrivate::handleMoreInfo(const DataUnit &data)
 		quint8 m = data.read<quint8>();
 		quint8 d =  data.read<quint8>();
 		if (QDate::isValid(y, m, d))
-			values.insert(Birthday, QDate(y, m, d));
+			info()->setNumber(Birthday, QDate(y, m, d).toJulianDay());
 	}
-	{
-		QStringList langList;
-		for (int i = 0; i < 3; ++i) {
-			QString lang = languages().value(data.read<quint8>());
-			if (!lang.isEmpty())
-				langList << lang;
-		}
-		if (!langList.isEmpty())
-			values.insert(Languages, langList);
+	for (int i = 0; i < 3; ++i) {
+		quint8 lang = data.read<quint8>();
+		if (languages().contains(lang))
+			info()->addItem(Languages, lang);
 	}
 	data.skipData(2); // 0x0000 unknown
 	readString(OriginalCity, data);
 	readString(OriginalState, data);
 	readField<quint16>(OriginalCountry, data, countries());
-	values.insert(GMT, data.read<qint8>());
+	info()->setNumber(GMT, data.read<qint8>());
 }
 
 void FullInfoMetaRequestPrivate::handleEmails(const DataUnit &data)
 {
-	QStringList emails;
 	quint8 count = data.read<quint8>();
 	for (int i = 0; i < count; ++i) {
 		bool isPublish = data.read<quint8>();
 		Q_UNUSED(isPublish);
 		QString email = readSString(data, metaInfo->client());
 		if (!email.isEmpty())
-			emails << email;
+			info()->addItem(Emails, 0, email);
 	}
-	if (!emails.isEmpty())
-		values.insert(Emails, emails);
 }
 
 void FullInfoMetaRequestPrivate::handleHomepage(const DataUnit &data)
@@ -247,6 +245,11 @@ FullInfoMetaRequest::FullInfoMetaRequest()
 {
 }
 
+bool FullInfoMetaRequest::isCacheable() const
+{
+	return true;
+}
+
 bool FullInfoMetaRequest::handleData(quint16 type, const DataUnit &data)
 {
 	Q_D(FullInfoMetaRequest);
@@ -284,7 +287,7 @@ bool FullInfoMetaRequest::handleData(quint16 type, const DataUnit &data)
 	emit infoUpdated(static_cast<State>(type));
 	if (type == StateAffilations) {
 		close(true);
-		debug() << d->uin << "full info:";
+		debug(MetaInfoDebug) << d->uin << "full info:";
 		d->dump();
 	}
 	return true;
@@ -27,6 +27,7 @@
 #define IREEN_INFOMETAREQUEST_H
 
 #include "abstractmetarequest.h"
+#include "metainfovalues.h"
 
 namespace Ireen {
 
@@ -42,6 +43,7 @@ class IREEN_EXPORT ShortInfoMetaRequest : public AbstractMetaRequest
 public:
 	// If uin is empty, the information will be requested for the account
 	ShortInfoMetaRequest(MetaInfo *metaInfo, const QString &uin = QString());
+	MetaInfoValues info() const;
 	MetaInfoValuesHash values() const;
 	QVariant value(MetaFieldKey key, const QVariant &defaultValue = QVariant()) const;
 	template <typename T>
@@ -50,6 +52,7 @@ public:
 protected:
 	ShortInfoMetaRequest();
 	virtual bool handleData(quint16 type, const DataUnit &data);
+	virtual bool isCacheable() const;
 };
 
 class IREEN_EXPORT FullInfoMetaRequest : public ShortInfoMetaRequest
@@ -74,6 +77,9 @@ signals:
 protected:
 	FullInfoMetaRequest();
 	virtual bool handleData(quint16 type, const DataUnit &data);
+	// The full info is cached separately from the short one,
+	// all its reply packets are replayed from the cache
+	virtual bool isCacheable() const;
 };
 
 template <typename T>
@@ -28,14 +28,18 @@
 
 #include "infometarequest.h"
 #include "abstractmetarequest_p.h"
+#include "metainfovalues_p.h"
 
 namespace Ireen {
 
+struct FieldNamesTable;
+
 class ShortInfoMetaRequestPrivate : public AbstractMetaRequestPrivate
 {
 public:
-	MetaInfoValuesHash values;
+	MetaInfoValues values;
 	quint32 uin;
+	MetaInfoValuesPrivate *info() { return values.d.data(); }
 	inline void readString(MetaFieldEnum value, const DataUnit &data);
 	inline void readFlag(MetaFieldEnum value, const DataUnit &data);
 	void dump();
@@ -45,8 +49,8 @@ class FullInfoMetaRequestPrivate : public ShortInfoMetaRequestPrivate
 {
 public:
 	template <typename T>
-	void readField(MetaFieldEnum value, const DataUnit &data, const FieldNamesList &list);
-	void readCategories(MetaFieldEnum value, const DataUnit &data, const FieldNamesList &list);
+	void readField(MetaFieldEnum value, const DataUnit &data, const FieldNamesTable &list);
+	void readCategories(MetaFieldEnum value, const DataUnit &data, const FieldNamesTable &list);
 	void handleBasicInfo(const DataUnit &data);
 	void handleMoreInfo(const DataUnit &data);
 	void handleEmails(const DataUnit &data);
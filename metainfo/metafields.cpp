@@ -24,721 +24,757 @@
 ****************************************************************************/
 
 #include "metafields_p.h"
+#include <QCoreApplication>
 
 namespace Ireen {
 
-static FieldNamesList init_countries_list()
+static bool fieldNameLessThan(const FieldName &name, quint32 code)
 {
-	FieldNamesList list;
-	list.insert(9999, QT_TRANSLATE_NOOP("Country", "Other"));
-	list.insert(93, QT_TRANSLATE_NOOP("Country", "Afghanistan"));
-	list.insert(355, QT_TRANSLATE_NOOP("Country", "Albania"));
-	list.insert(213, QT_TRANSLATE_NOOP("Country", "Algeria"));
-	list.insert(376, QT_TRANSLATE_NOOP("Country", "Andorra"));
-	list.insert(244, QT_TRANSLATE_NOOP("Country", "Angola"));
-	list.insert(101, QT_TRANSLATE_NOOP("Country", "Anguilla"));
-	list.insert(1021, QT_TRANSLATE_NOOP("Country", "Antigua and Barbuda"));
-	list.insert(5902, QT_TRANSLATE_NOOP("Country", "Antilles"));
-	list.insert(54, QT_TRANSLATE_NOOP("Country", "Argentina"));
-	list.insert(374, QT_TRANSLATE_NOOP("Country", "Armenia"));
-	list.insert(297, QT_TRANSLATE_NOOP("Country", "Aruba"));
-	list.insert(247, QT_TRANSLATE_NOOP("Country", "Ascension Island"));
-	list.insert(61, QT_TRANSLATE_NOOP("Country", "Australia"));
-	list.insert(43, QT_TRANSLATE_NOOP("Country", "Austria"));
-	list.insert(994, QT_TRANSLATE_NOOP("Country", "Azerbaijan"));
-	list.insert(103, QT_TRANSLATE_NOOP("Country", "Bahamas"));
-	list.insert(973, QT_TRANSLATE_NOOP("Country", "Bahrain"));
-	list.insert(880, QT_TRANSLATE_NOOP("Country", "Bangladesh"));
-	list.insert(104, QT_TRANSLATE_NOOP("Country", "Barbados"));
-	list.insert(120, QT_TRANSLATE_NOOP("Country", "Barbuda"));
-	list.insert(375, QT_TRANSLATE_NOOP("Country", "Belarus"));
-	list.insert(32, QT_TRANSLATE_NOOP("Country", "Belgium"));
-	list.insert(501, QT_TRANSLATE_NOOP("Country", "Belize"));
-	list.insert(229, QT_TRANSLATE_NOOP("Country", "Benin"));
-	list.insert(105, QT_TRANSLATE_NOOP("Country", "Bermuda"));
-	list.insert(975, QT_TRANSLATE_NOOP("Country", "Bhutan"));
-	list.insert(591, QT_TRANSLATE_NOOP("Country", "Bolivia"));
-	list.insert(387, QT_TRANSLATE_NOOP("Country", "Bosnia and Herzegovina"));
-	list.insert(267, QT_TRANSLATE_NOOP("Country", "Botswana"));
-	list.insert(55, QT_TRANSLATE_NOOP("Country", "Brazil"));
-	list.insert(106, QT_TRANSLATE_NOOP("Country", "British Virgin Islands"));
-	list.insert(673, QT_TRANSLATE_NOOP("Country", "Brunei"));
-	list.insert(359, QT_TRANSLATE_NOOP("Country", "Bulgaria"));
-	list.insert(226, QT_TRANSLATE_NOOP("Country", "Burkina Faso"));
-	list.insert(257, QT_TRANSLATE_NOOP("Country", "Burundi"));
-	list.insert(855, QT_TRANSLATE_NOOP("Country", "Cambodia"));
-	list.insert(237, QT_TRANSLATE_NOOP("Country", "Cameroon"));
-	list.insert(107, QT_TRANSLATE_NOOP("Country", "Canada"));
-	list.insert(178, QT_TRANSLATE_NOOP("Country", "Canary Islands"));
-	list.insert(238, QT_TRANSLATE_NOOP("Country", "Cape Verde Islands"));
-	list.insert(108, QT_TRANSLATE_NOOP("Country", "Cayman Islands"));
-	list.insert(236, QT_TRANSLATE_NOOP("Country", "Central African Republic"));
-	list.insert(235, QT_TRANSLATE_NOOP("Country", "Chad"));
-	list.insert(56, QT_TRANSLATE_NOOP("Country", "Chile, Republic of"));
-	list.insert(86, QT_TRANSLATE_NOOP("Country", "China"));
-	list.insert(672, QT_TRANSLATE_NOOP("Country", "Christmas Island"));
-	list.insert(6102, QT_TRANSLATE_NOOP("Country", "Cocos (Keeling) Islands"));
-	list.insert(57, QT_TRANSLATE_NOOP("Country", "Colombia"));
-	list.insert(2691, QT_TRANSLATE_NOOP("Country", "Comoros"));
-	list.insert(242, QT_TRANSLATE_NOOP("Country", "Congo, (Republic of the)"));
-	list.insert(243, QT_TRANSLATE_NOOP("Country", "Congo, Democratic Republic of (Zaire)"));
-	list.insert(682, QT_TRANSLATE_NOOP("Country", "Cook Islands"));
-	list.insert(506, QT_TRANSLATE_NOOP("Country", "Costa Rica"));
-	list.insert(225, QT_TRANSLATE_NOOP("Country", "Cote d'Ivoire (Ivory Coast)"));
-	list.insert(385, QT_TRANSLATE_NOOP("Country", "Croatia"));
-	list.insert(53, QT_TRANSLATE_NOOP("Country", "Cuba"));
-	list.insert(357, QT_TRANSLATE_NOOP("Country", "Cyprus"));
-	list.insert(42, QT_TRANSLATE_NOOP("Country", "Czech Republic"));
-	list.insert(45, QT_TRANSLATE_NOOP("Country", "Denmark"));
-	list.insert(246, QT_TRANSLATE_NOOP("Country", "Diego Garcia"));
-	list.insert(253, QT_TRANSLATE_NOOP("Country", "Djibouti"));
-	list.insert(109, QT_TRANSLATE_NOOP("Country", "Dominica"));
-	list.insert(110, QT_TRANSLATE_NOOP("Country", "Dominican Republic"));
-	list.insert(593, QT_TRANSLATE_NOOP("Country", "Ecuador"));
-	list.insert(20, QT_TRANSLATE_NOOP("Country", "Egypt"));
-	list.insert(503, QT_TRANSLATE_NOOP("Country", "El Salvador"));
-	list.insert(240, QT_TRANSLATE_NOOP("Country", "Equatorial Guinea"));
-	list.insert(291, QT_TRANSLATE_NOOP("Country", "Eritrea"));
-	list.insert(372, QT_TRANSLATE_NOOP("Country", "Estonia"));
-	list.insert(251, QT_TRANSLATE_NOOP("Country", "Ethiopia"));
-	list.insert(298, QT_TRANSLATE_NOOP("Country", "Faeroe Islands"));
-	list.insert(500, QT_TRANSLATE_NOOP("Country", "Falkland Islands"));
-	list.insert(679, QT_TRANSLATE_NOOP("Country", "Fiji"));
-	list.insert(358, QT_TRANSLATE_NOOP("Country", "Finland"));
-	list.insert(33, QT_TRANSLATE_NOOP("Country", "France"));
-	list.insert(5901, QT_TRANSLATE_NOOP("Country", "French Antilles"));
-	list.insert(594, QT_TRANSLATE_NOOP("Country", "French Guiana"));
-	list.insert(689, QT_TRANSLATE_NOOP("Country", "French Polynesia"));
-	list.insert(241, QT_TRANSLATE_NOOP("Country", "Gabon"));
-	list.insert(220, QT_TRANSLATE_NOOP("Country", "Gambia"));
-	list.insert(995, QT_TRANSLATE_NOOP("Country", "Georgia"));
-	list.insert(49, QT_TRANSLATE_NOOP("Country", "Germany"));
-	list.insert(233, QT_TRANSLATE_NOOP("Country", "Ghana"));
-	list.insert(350, QT_TRANSLATE_NOOP("Country", "Gibraltar"));
-	list.insert(30, QT_TRANSLATE_NOOP("Country", "Greece"));
-	list.insert(299, QT_TRANSLATE_NOOP("Country", "Greenland"));
-	list.insert(111, QT_TRANSLATE_NOOP("Country", "Grenada"));
-	list.insert(590, QT_TRANSLATE_NOOP("Country", "Guadeloupe"));
-	list.insert(671, QT_TRANSLATE_NOOP("Country", "Guam, US Territory of"));
-	list.insert(502, QT_TRANSLATE_NOOP("Country", "Guatemala"));
-	list.insert(224, QT_TRANSLATE_NOOP("Country", "Guinea"));
-	list.insert(245, QT_TRANSLATE_NOOP("Country", "Guinea-Bissau"));
-	list.insert(592, QT_TRANSLATE_NOOP("Country", "Guyana"));
-	list.insert(509, QT_TRANSLATE_NOOP("Country", "Haiti"));
-	list.insert(504, QT_TRANSLATE_NOOP("Country", "Honduras"));
-	list.insert(852, QT_TRANSLATE_NOOP("Country", "Hong Kong"));
-	list.insert(36, QT_TRANSLATE_NOOP("Country", "Hungary"));
-	list.insert(354, QT_TRANSLATE_NOOP("Country", "Iceland"));
-	list.insert(91, QT_TRANSLATE_NOOP("Country", "India"));
-	list.insert(62, QT_TRANSLATE_NOOP("Country", "Indonesia"));
-	list.insert(98, QT_TRANSLATE_NOOP("Country", "Iran (Islamic Republic of)"));
-	list.insert(964, QT_TRANSLATE_NOOP("Country", "Iraq"));
-	list.insert(353, QT_TRANSLATE_NOOP("Country", "Ireland"));
-	list.insert(972, QT_TRANSLATE_NOOP("Country", "Israel"));
-	list.insert(39, QT_TRANSLATE_NOOP("Country", "Italy"));
-	list.insert(112, QT_TRANSLATE_NOOP("Country", "Jamaica"));
-	list.insert(81, QT_TRANSLATE_NOOP("Country", "Japan"));
-	list.insert(962, QT_TRANSLATE_NOOP("Country", "Jordan"));
-	list.insert(705, QT_TRANSLATE_NOOP("Country", "Kazakhstan"));
-	list.insert(254, QT_TRANSLATE_NOOP("Country", "Kenya"));
-	list.insert(686, QT_TRANSLATE_NOOP("Country", "Kiribati"));
-	list.insert(850, QT_TRANSLATE_NOOP("Country", "Korea (North Korea), Democratic People's Republic of"));
-	list.insert(82, QT_TRANSLATE_NOOP("Country", "Korea (South Korea), Republic of"));
-	list.insert(965, QT_TRANSLATE_NOOP("Country", "Kuwait"));
-	list.insert(706, QT_TRANSLATE_NOOP("Country", "Kyrgyzstan"));
-	list.insert(856, QT_TRANSLATE_NOOP("Country", "Lao People's Democratic Republic"));
-	list.insert(371, QT_TRANSLATE_NOOP("Country", "Latvia"));
-	list.insert(961, QT_TRANSLATE_NOOP("Country", "Lebanon"));
-	list.insert(266, QT_TRANSLATE_NOOP("Country", "Lesotho"));
-	list.insert(231, QT_TRANSLATE_NOOP("Country", "Liberia"));
-	list.insert(218, QT_TRANSLATE_NOOP("Country", "Libyan Arab Jamahiriya"));
-	list.insert(4101, QT_TRANSLATE_NOOP("Country", "Liechtenstein"));
-	list.insert(370, QT_TRANSLATE_NOOP("Country", "Lithuania"));
-	list.insert(352, QT_TRANSLATE_NOOP("Country", "Luxembourg"));
-	list.insert(853, QT_TRANSLATE_NOOP("Country", "Macau"));
-	list.insert(389, QT_TRANSLATE_NOOP("Country", "Macedonia (F.Y.R.O.M.)"));
-	list.insert(261, QT_TRANSLATE_NOOP("Country", "Madagascar"));
-	list.insert(265, QT_TRANSLATE_NOOP("Country", "Malawi"));
-	list.insert(60, QT_TRANSLATE_NOOP("Country", "Malaysia"));
-	list.insert(960, QT_TRANSLATE_NOOP("Country", "Maldives"));
-	list.insert(223, QT_TRANSLATE_NOOP("Country", "Mali"));
-	list.insert(356, QT_TRANSLATE_NOOP("Country", "Malta"));
-	list.insert(692, QT_TRANSLATE_NOOP("Country", "Marshall Islands"));
-	list.insert(596, QT_TRANSLATE_NOOP("Country", "Martinique"));
-	list.insert(222, QT_TRANSLATE_NOOP("Country", "Mauritania"));
-	list.insert(230, QT_TRANSLATE_NOOP("Country", "Mauritius"));
-	list.insert(269, QT_TRANSLATE_NOOP("Country", "Mayotte Island"));
-	list.insert(52, QT_TRANSLATE_NOOP("Country", "Mexico"));
-	list.insert(691, QT_TRANSLATE_NOOP("Country", "Micronesia, Federated States of"));
-	list.insert(373, QT_TRANSLATE_NOOP("Country", "Moldova, Republic of"));
-	list.insert(377, QT_TRANSLATE_NOOP("Country", "Monaco"));
-	list.insert(976, QT_TRANSLATE_NOOP("Country", "Mongolia"));
-	list.insert(113, QT_TRANSLATE_NOOP("Country", "Montserrat"));
-	list.insert(212, QT_TRANSLATE_NOOP("Country", "Morocco"));
-	list.insert(258, QT_TRANSLATE_NOOP("Country", "Mozambique"));
-	list.insert(95, QT_TRANSLATE_NOOP("Country", "Myanmar"));
-	list.insert(264, QT_TRANSLATE_NOOP("Country", "Namibia"));
-	list.insert(674, QT_TRANSLATE_NOOP("Country", "Nauru"));
-	list.insert(977, QT_TRANSLATE_NOOP("Country", "Nepal"));
-	list.insert(31, QT_TRANSLATE_NOOP("Country", "Netherlands"));
-	list.insert(599, QT_TRANSLATE_NOOP("Country", "Netherlands Antilles"));
-	list.insert(114, QT_TRANSLATE_NOOP("Country", "Nevis"));
-	list.insert(687, QT_TRANSLATE_NOOP("Country", "New Caledonia"));
-	list.insert(64, QT_TRANSLATE_NOOP("Country", "New Zealand"));
-	list.insert(505, QT_TRANSLATE_NOOP("Country", "Nicaragua"));
-	list.insert(227, QT_TRANSLATE_NOOP("Country", "Niger"));
-	list.insert(234, QT_TRANSLATE_NOOP("Country", "Nigeria"));
-	list.insert(683, QT_TRANSLATE_NOOP("Country", "Niue"));
-	list.insert(6722, QT_TRANSLATE_NOOP("Country", "Norfolk Island"));
-	list.insert(47, QT_TRANSLATE_NOOP("Country", "Norway"));
-	list.insert(968, QT_TRANSLATE_NOOP("Country", "Oman"));
-	list.insert(92, QT_TRANSLATE_NOOP("Country", "Pakistan"));
-	list.insert(680, QT_TRANSLATE_NOOP("Country", "Palau"));
-	list.insert(507, QT_TRANSLATE_NOOP("Country", "Panama"));
-	list.insert(675, QT_TRANSLATE_NOOP("Country", "Papua New Guinea"));
-	list.insert(595, QT_TRANSLATE_NOOP("Country", "Paraguay"));
-	list.insert(51, QT_TRANSLATE_NOOP("Country", "Peru"));
-	list.insert(63, QT_TRANSLATE_NOOP("Country", "Philippines"));
-	list.insert(48, QT_TRANSLATE_NOOP("Country", "Poland"));
-	list.insert(351, QT_TRANSLATE_NOOP("Country", "Portugal"));
-	list.insert(121, QT_TRANSLATE_NOOP("Country", "Puerto Rico, Common Wealth of"));
-	list.insert(974, QT_TRANSLATE_NOOP("Country", "Qatar"));
-	list.insert(262, QT_TRANSLATE_NOOP("Country", "Reunion Island"));
-	list.insert(40, QT_TRANSLATE_NOOP("Country", "Romania"));
-	list.insert(6701, QT_TRANSLATE_NOOP("Country", "Rota Island"));
-	list.insert(7, QT_TRANSLATE_NOOP("Country", "Russia"));
-	list.insert(250, QT_TRANSLATE_NOOP("Country", "Rwanda"));
-	list.insert(290, QT_TRANSLATE_NOOP("Country", "Saint Helena"));
-	list.insert(115, QT_TRANSLATE_NOOP("Country", "Saint Kitts"));
-	list.insert(1141, QT_TRANSLATE_NOOP("Country", "Saint Kitts and Nevis"));
-	list.insert(122, QT_TRANSLATE_NOOP("Country", "Saint Lucia"));
-	list.insert(508, QT_TRANSLATE_NOOP("Country", "Saint Pierre and Miquelon"));
-	list.insert(116, QT_TRANSLATE_NOOP("Country", "Saint Vincent and the Grenadines"));
-	list.insert(670, QT_TRANSLATE_NOOP("Country", "Saipan Island"));
-	list.insert(684, QT_TRANSLATE_NOOP("Country", "Samoa"));
-	list.insert(378, QT_TRANSLATE_NOOP("Country", "San Marino"));
-	list.insert(239, QT_TRANSLATE_NOOP("Country", "Sao Tome & Principe"));
-	list.insert(966, QT_TRANSLATE_NOOP("Country", "Saudi Arabia"));
-	list.insert(442, QT_TRANSLATE_NOOP("Country", "Scotland"));
-	list.insert(221, QT_TRANSLATE_NOOP("Country", "Senegal"));
-	list.insert(248, QT_TRANSLATE_NOOP("Country", "Seychelles"));
-	list.insert(232, QT_TRANSLATE_NOOP("Country", "Sierra Leone"));
-	list.insert(65, QT_TRANSLATE_NOOP("Country", "Singapore"));
-	list.insert(4201, QT_TRANSLATE_NOOP("Country", "Slovakia"));
-	list.insert(386, QT_TRANSLATE_NOOP("Country", "Slovenia"));
-	list.insert(677, QT_TRANSLATE_NOOP("Country", "Solomon Islands"));
-	list.insert(252, QT_TRANSLATE_NOOP("Country", "Somalia"));
-	list.insert(27, QT_TRANSLATE_NOOP("Country", "South Africa"));
-	list.insert(34, QT_TRANSLATE_NOOP("Country", "Spain"));
-	list.insert(94, QT_TRANSLATE_NOOP("Country", "Sri Lanka"));
-	list.insert(249, QT_TRANSLATE_NOOP("Country", "Sudan"));
-	list.insert(597, QT_TRANSLATE_NOOP("Country", "Suriname"));
-	list.insert(268, QT_TRANSLATE_NOOP("Country", "Swaziland"));
-	list.insert(46, QT_TRANSLATE_NOOP("Country", "Sweden"));
-	list.insert(41, QT_TRANSLATE_NOOP("Country", "Switzerland"));
-	list.insert(963, QT_TRANSLATE_NOOP("Country", "Syrian Arab Republic"));
-	list.insert(886, QT_TRANSLATE_NOOP("Country", "Taiwan"));
-	list.insert(708, QT_TRANSLATE_NOOP("Country", "Tajikistan"));
-	list.insert(255, QT_TRANSLATE_NOOP("Country", "Tanzania, United Republic of"));
-	list.insert(66, QT_TRANSLATE_NOOP("Country", "Thailand"));
-	list.insert(6702, QT_TRANSLATE_NOOP("Country", "Tinian Island"));
-	list.insert(228, QT_TRANSLATE_NOOP("Country", "Togo"));
-	list.insert(690, QT_TRANSLATE_NOOP("Country", "Tokelau"));
-	list.insert(676, QT_TRANSLATE_NOOP("Country", "Tonga"));
-	list.insert(117, QT_TRANSLATE_NOOP("Country", "Trinidad and Tobago"));
-	list.insert(216, QT_TRANSLATE_NOOP("Country", "Tunisia"));
-	list.insert(90, QT_TRANSLATE_NOOP("Country", "Turkey"));
-	list.insert(709, QT_TRANSLATE_NOOP("Country", "Turkmenistan"));
-	list.insert(118, QT_TRANSLATE_NOOP("Country", "Turks and Caicos Islands"));
-	list.insert(688, QT_TRANSLATE_NOOP("Country", "Tuvalu"));
-	list.insert(256, QT_TRANSLATE_NOOP("Country", "Uganda"));
-	list.insert(380, QT_TRANSLATE_NOOP("Country", "Ukraine"));
-	list.insert(971, QT_TRANSLATE_NOOP("Country", "United Arab Emirates"));
-	list.insert(44, QT_TRANSLATE_NOOP("Country", "United Kingdom"));
-	list.insert(598, QT_TRANSLATE_NOOP("Country", "Uruguay"));
-	list.insert(1, QT_TRANSLATE_NOOP("Country", "USA"));
-	list.insert(711, QT_TRANSLATE_NOOP("Country", "Uzbekistan"));
-	list.insert(678, QT_TRANSLATE_NOOP("Country", "Vanuatu"));
-	list.insert(379, QT_TRANSLATE_NOOP("Country", "Vatican City"));
-	list.insert(58, QT_TRANSLATE_NOOP("Country", "Venezuela"));
-	list.insert(84, QT_TRANSLATE_NOOP("Country", "Viet Nam"));
-	list.insert(123, QT_TRANSLATE_NOOP("Country", "Virgin Islands of the United States"));
-	list.insert(441, QT_TRANSLATE_NOOP("Country", "Wales"));
-	list.insert(681, QT_TRANSLATE_NOOP("Country", "Wallis and Futuna Islands"));
-	list.insert(685, QT_TRANSLATE_NOOP("Country", "Western Samoa"));
-	list.insert(967, QT_TRANSLATE_NOOP("Country", "Yemen"));
-	list.insert(381, QT_TRANSLATE_NOOP("Country", "Yugoslavia"));
-	list.insert(382, QT_TRANSLATE_NOOP("Country", "Yugoslavia - Montenegro"));
-	list.insert(3811, QT_TRANSLATE_NOOP("Country", "Yugoslavia - Serbia"));
-	list.insert(260, QT_TRANSLATE_NOOP("Country", "Zambia"));
-	list.insert(263, QT_TRANSLATE_NOOP("Country", "Zimbabwe"));
-	return list;
+	return name.code < code;
 }
 
-const FieldNamesList &countries()
+const FieldName *FieldNamesTable::find(quint32 code) const
 {
-	static FieldNamesList list = init_countries_list();
-	return list;
+	const FieldName *end = names + count;
+	const FieldName *itr = qLowerBound(names, end, code, fieldNameLessThan);
+	return itr != end && itr->code == code ? itr : 0;
 }
 
-static FieldNamesList init_interests_list()
+QString FieldNamesTable::value(quint32 code) const
 {
-	FieldNamesList list;
-	list.insert(137, QT_TRANSLATE_NOOP("Interest", "50's"));
-	list.insert(134, QT_TRANSLATE_NOOP("Interest", "60's"));
-	list.insert(135, QT_TRANSLATE_NOOP("Interest", "70's"));
-	list.insert(136, QT_TRANSLATE_NOOP("Interest", "80's"));
-	list.insert(100, QT_TRANSLATE_NOOP("Interest", "Art"));
-	list.insert(128, QT_TRANSLATE_NOOP("Interest", "Astronomy"));
-	list.insert(147, QT_TRANSLATE_NOOP("Interest", "Audio and Visual"));
-	list.insert(125, QT_TRANSLATE_NOOP("Interest", "Business"));
-	list.insert(146, QT_TRANSLATE_NOOP("Interest", "Business Services"));
-	list.insert(101, QT_TRANSLATE_NOOP("Interest", "Cars"));
-	list.insert(102, QT_TRANSLATE_NOOP("Interest", "Celebrity Fans"));
-	list.insert(130, QT_TRANSLATE_NOOP("Interest", "Clothing"));
-	list.insert(103, QT_TRANSLATE_NOOP("Interest", "Collections"));
-	list.insert(104, QT_TRANSLATE_NOOP("Interest", "Computers"));
-	list.insert(105, QT_TRANSLATE_NOOP("Interest", "Culture"));
-	list.insert(122, QT_TRANSLATE_NOOP("Interest", "Ecology"));
-	list.insert(139, QT_TRANSLATE_NOOP("Interest", "Entertainment"));
-	list.insert(138, QT_TRANSLATE_NOOP("Interest", "Finance and Corporate"));
-	list.insert(106, QT_TRANSLATE_NOOP("Interest", "Fitness"));
-	list.insert(142, QT_TRANSLATE_NOOP("Interest", "Health and Beauty"));
-	list.insert(108, QT_TRANSLATE_NOOP("Interest", "Hobbies"));
-	list.insert(150, QT_TRANSLATE_NOOP("Interest", "Home Automation"));
-	list.insert(144, QT_TRANSLATE_NOOP("Interest", "Household Products"));
-	list.insert(107, QT_TRANSLATE_NOOP("Interest", "Games"));
-	list.insert(124, QT_TRANSLATE_NOOP("Interest", "Government"));
-	list.insert(109, QT_TRANSLATE_NOOP("Interest", "ICQ - Help"));
-	list.insert(110, QT_TRANSLATE_NOOP("Interest", "Internet"));
-	list.insert(111, QT_TRANSLATE_NOOP("Interest", "Lifestyle"));
-	list.insert(145, QT_TRANSLATE_NOOP("Interest", "Mail Order Catalog"));
-	list.insert(143, QT_TRANSLATE_NOOP("Interest", "Media"));
-	list.insert(112, QT_TRANSLATE_NOOP("Interest", "Movies and TV"));
-	list.insert(113, QT_TRANSLATE_NOOP("Interest", "Music"));
-	list.insert(126, QT_TRANSLATE_NOOP("Interest", "Mystics"));
-	list.insert(123, QT_TRANSLATE_NOOP("Interest", "News and Media"));
-	list.insert(114, QT_TRANSLATE_NOOP("Interest", "Outdoors"));
-	list.insert(115, QT_TRANSLATE_NOOP("Interest", "Parenting"));
-	list.insert(131, QT_TRANSLATE_NOOP("Interest", "Parties"));
-	list.insert(116, QT_TRANSLATE_NOOP("Interest", "Pets and Animals"));
-	list.insert(149, QT_TRANSLATE_NOOP("Interest", "Publishing"));
-	list.insert(117, QT_TRANSLATE_NOOP("Interest", "Religion"));
-	list.insert(141, QT_TRANSLATE_NOOP("Interest", "Retail Stores"));
-	list.insert(118, QT_TRANSLATE_NOOP("Interest", "Science"));
-	list.insert(119, QT_TRANSLATE_NOOP("Interest", "Skills"));
-	list.insert(133, QT_TRANSLATE_NOOP("Interest", "Social science"));
-	list.insert(129, QT_TRANSLATE_NOOP("Interest", "Space"));
-	list.insert(148, QT_TRANSLATE_NOOP("Interest", "Sporting and Athletic"));
-	list.insert(120, QT_TRANSLATE_NOOP("Interest", "Sports"));
-	list.insert(127, QT_TRANSLATE_NOOP("Interest", "Travel"));
-	list.insert(121, QT_TRANSLATE_NOOP("Interest", "Web Design"));
-	list.insert(132, QT_TRANSLATE_NOOP("Interest", "Women"));
-	return list;
+	const FieldName *name = find(code);
+	return name ? QString::fromLatin1(name->text) : QString();
 }
 
-const FieldNamesList &interests()
+QString FieldNamesTable::translatedValue(quint32 code) const
 {
-	static FieldNamesList list = init_interests_list();
-	return list;
+	const FieldName *name = find(code);
+	if (!name)
+		return QString();
+	const char *ctx = name->context ? name->context : context;
+	return ctx ? QCoreApplication::translate(ctx, name->text) : QString::fromLatin1(name->text);
 }
 
-static FieldNamesList init_languages_list()
+quint32 FieldNamesTable::key(const QString &text, quint32 defaultKey) const
 {
-	FieldNamesList list;
-	list.insert(55, QT_TRANSLATE_NOOP("Language", "Afrikaans"));
-	list.insert(58, QT_TRANSLATE_NOOP("Language", "Albanian"));
-	list.insert(1, QT_TRANSLATE_NOOP("Language", "Arabic"));
-	list.insert(59, QT_TRANSLATE_NOOP("Language", "Armenian"));
-	list.insert(68, QT_TRANSLATE_NOOP("Language", "Azerbaijani"));
-	list.insert(72, QT_TRANSLATE_NOOP("Language", "Belorussian"));
-	list.insert(2, QT_TRANSLATE_NOOP("Language", "Bhojpuri"));
-	list.insert(56, QT_TRANSLATE_NOOP("Language", "Bosnian"));
-	list.insert(3, QT_TRANSLATE_NOOP("Language", "Bulgarian"));
-	list.insert(4, QT_TRANSLATE_NOOP("Language", "Burmese"));
-	list.insert(5, QT_TRANSLATE_NOOP("Language", "Cantonese"));
-	list.insert(6, QT_TRANSLATE_NOOP("Language", "Catalan"));
-	list.insert(61, QT_TRANSLATE_NOOP("Language", "Chamorro"));
-	list.insert(7, QT_TRANSLATE_NOOP("Language", "Chinese"));
-	list.insert(8, QT_TRANSLATE_NOOP("Language", "Croatian"));
-	list.insert(9, QT_TRANSLATE_NOOP("Language", "Czech"));
-	list.insert(10, QT_TRANSLATE_NOOP("Language", "Danish"));
-	list.insert(11, QT_TRANSLATE_NOOP("Language", "Dutch"));
-	list.insert(12, QT_TRANSLATE_NOOP("Language", "English"));
-	list.insert(13, QT_TRANSLATE_NOOP("Language", "Esperanto"));
-	list.insert(14, QT_TRANSLATE_NOOP("Language", "Estonian"));
-	list.insert(15, QT_TRANSLATE_NOOP("Language", "Farsi"));
-	list.insert(16, QT_TRANSLATE_NOOP("Language", "Finnish"));
-	list.insert(17, QT_TRANSLATE_NOOP("Language", "French"));
-	list.insert(18, QT_TRANSLATE_NOOP("Language", "Gaelic"));
-	list.insert(19, QT_TRANSLATE_NOOP("Language", "German"));
-	list.insert(20, QT_TRANSLATE_NOOP("Language", "Greek"));
-	list.insert(70, QT_TRANSLATE_NOOP("Language", "Gujarati"));
-	list.insert(21, QT_TRANSLATE_NOOP("Language", "Hebrew"));
-	list.insert(22, QT_TRANSLATE_NOOP("Language", "Hindi"));
-	list.insert(23, QT_TRANSLATE_NOOP("Language", "Hungarian"));
-	list.insert(24, QT_TRANSLATE_NOOP("Language", "Icelandic"));
-	list.insert(25, QT_TRANSLATE_NOOP("Language", "Indonesian"));
-	list.insert(26, QT_TRANSLATE_NOOP("Language", "Italian"));
-	list.insert(27, QT_TRANSLATE_NOOP("Language", "Japanese"));
-	list.insert(28, QT_TRANSLATE_NOOP("Language", "Khmer"));
-	list.insert(29, QT_TRANSLATE_NOOP("Language", "Korean"));
-	list.insert(69, QT_TRANSLATE_NOOP("Language", "Kurdish"));
-	list.insert(30, QT_TRANSLATE_NOOP("Language", "Lao"));
-	list.insert(31, QT_TRANSLATE_NOOP("Language", "Latvian"));
-	list.insert(32, QT_TRANSLATE_NOOP("Language", "Lithuanian"));
-	list.insert(65, QT_TRANSLATE_NOOP("Language", "Macedonian"));
-	list.insert(33, QT_TRANSLATE_NOOP("Language", "Malay"));
-	list.insert(63, QT_TRANSLATE_NOOP("Language", "Mandarin"));
-	list.insert(62, QT_TRANSLATE_NOOP("Language", "Mongolian"));
-	list.insert(34, QT_TRANSLATE_NOOP("Language", "Norwegian"));
-	list.insert(57, QT_TRANSLATE_NOOP("Language", "Persian"));
-	list.insert(35, QT_TRANSLATE_NOOP("Language", "Polish"));
-	list.insert(36, QT_TRANSLATE_NOOP("Language", "Portuguese"));
-	list.insert(60, QT_TRANSLATE_NOOP("Language", "Punjabi"));
-	list.insert(37, QT_TRANSLATE_NOOP("Language", "Romanian"));
-	list.insert(38, QT_TRANSLATE_NOOP("Language", "Russian"));
-	list.insert(39, QT_TRANSLATE_NOOP("Language", "Serbian"));
-	list.insert(66, QT_TRANSLATE_NOOP("Language", "Sindhi"));
-	list.insert(40, QT_TRANSLATE_NOOP("Language", "Slovak"));
-	list.insert(41, QT_TRANSLATE_NOOP("Language", "Slovenian"));
-	list.insert(42, QT_TRANSLATE_NOOP("Language", "Somali"));
-	list.insert(43, QT_TRANSLATE_NOOP("Language", "Spanish"));
-	list.insert(44, QT_TRANSLATE_NOOP("Language", "Swahili"));
-	list.insert(45, QT_TRANSLATE_NOOP("Language", "Swedish"));
-	list.insert(46, QT_TRANSLATE_NOOP("Language", "Tagalog"));
-	list.insert(64, QT_TRANSLATE_NOOP("Language", "Taiwanese"));
-	list.insert(71, QT_TRANSLATE_NOOP("Language", "Tamil"));
-	list.insert(47, QT_TRANSLATE_NOOP("Language", "Tatar"));
-	list.insert(48, QT_TRANSLATE_NOOP("Language", "Thai"));
-	list.insert(49, QT_TRANSLATE_NOOP("Language", "Turkish"));
-	list.insert(50, QT_TRANSLATE_NOOP("Language", "Ukrainian"));
-	list.insert(51, QT_TRANSLATE_NOOP("Language", "Urdu"));
-	list.insert(52, QT_TRANSLATE_NOOP("Language", "Vietnamese"));
-	list.insert(67, QT_TRANSLATE_NOOP("Language", "Welsh"));
-	list.insert(53, QT_TRANSLATE_NOOP("Language", "Yiddish"));
-	list.insert(54, QT_TRANSLATE_NOOP("Language", "Yoruba"));
-	return list;
+	for (int i = 0; i < count; ++i) {
+		if (text == QLatin1String(names[i].text))
+			return names[i].code;
+	}
+	return defaultKey;
 }
 
-const FieldNamesList &languages()
-{
-	static FieldNamesList list = init_languages_list();
-	return list;
-}
+// All the tables must be sorted by code, as FieldNamesTable uses binary search
+static const FieldName countriesNames[] = {
+	{ 1, QT_TRANSLATE_NOOP("Country", "USA") },
+	{ 7, QT_TRANSLATE_NOOP("Country", "Russia") },
+	{ 20, QT_TRANSLATE_NOOP("Country", "Egypt") },
+	{ 27, QT_TRANSLATE_NOOP("Country", "South Africa") },
+	{ 30, QT_TRANSLATE_NOOP("Country", "Greece") },
+	{ 31, QT_TRANSLATE_NOOP("Country", "Netherlands") },
+	{ 32, QT_TRANSLATE_NOOP("Country", "Belgium") },
+	{ 33, QT_TRANSLATE_NOOP("Country", "France") },
+	{ 34, QT_TRANSLATE_NOOP("Country", "Spain") },
+	{ 36, QT_TRANSLATE_NOOP("Country", "Hungary") },
+	{ 39, QT_TRANSLATE_NOOP("Country", "Italy") },
+	{ 40, QT_TRANSLATE_NOOP("Country", "Romania") },
+	{ 41, QT_TRANSLATE_NOOP("Country", "Switzerland") },
+	{ 42, QT_TRANSLATE_NOOP("Country", "Czech Republic") },
+	{ 43, QT_TRANSLATE_NOOP("Country", "Austria") },
+	{ 44, QT_TRANSLATE_NOOP("Country", "United Kingdom") },
+	{ 45, QT_TRANSLATE_NOOP("Country", "Denmark") },
+	{ 46, QT_TRANSLATE_NOOP("Country", "Sweden") },
+	{ 47, QT_TRANSLATE_NOOP("Country", "Norway") },
+	{ 48, QT_TRANSLATE_NOOP("Country", "Poland") },
+	{ 49, QT_TRANSLATE_NOOP("Country", "Germany") },
+	{ 51, QT_TRANSLATE_NOOP("Country", "Peru") },
+	{ 52, QT_TRANSLATE_NOOP("Country", "Mexico") },
+	{ 53, QT_TRANSLATE_NOOP("Country", "Cuba") },
+	{ 54, QT_TRANSLATE_NOOP("Country", "Argentina") },
+	{ 55, QT_TRANSLATE_NOOP("Country", "Brazil") },
+	{ 56, QT_TRANSLATE_NOOP("Country", "Chile, Republic of") },
+	{ 57, QT_TRANSLATE_NOOP("Country", "Colombia") },
+	{ 58, QT_TRANSLATE_NOOP("Country", "Venezuela") },
+	{ 60, QT_TRANSLATE_NOOP("Country", "Malaysia") },
+	{ 61, QT_TRANSLATE_NOOP("Country", "Australia") },
+	{ 62, QT_TRANSLATE_NOOP("Country", "Indonesia") },
+	{ 63, QT_TRANSLATE_NOOP("Country", "Philippines") },
+	{ 64, QT_TRANSLATE_NOOP("Country", "New Zealand") },
+	{ 65, QT_TRANSLATE_NOOP("Country", "Singapore") },
+	{ 66, QT_TRANSLATE_NOOP("Country", "Thailand") },
+	{ 81, QT_TRANSLATE_NOOP("Country", "Japan") },
+	{ 82, QT_TRANSLATE_NOOP("Country", "Korea (South Korea), Republic of") },
+	{ 84, QT_TRANSLATE_NOOP("Country", "Viet Nam") },
+	{ 86, QT_TRANSLATE_NOOP("Country", "China") },
+	{ 90, QT_TRANSLATE_NOOP("Country", "Turkey") },
+	{ 91, QT_TRANSLATE_NOOP("Country", "India") },
+	{ 92, QT_TRANSLATE_NOOP("Country", "Pakistan") },
+	{ 93, QT_TRANSLATE_NOOP("Country", "Afghanistan") },
+	{ 94, QT_TRANSLATE_NOOP("Country", "Sri Lanka") },
+	{ 95, QT_TRANSLATE_NOOP("Country", "Myanmar") },
+	{ 98, QT_TRANSLATE_NOOP("Country", "Iran (Islamic Republic of)") },
+	{ 101, QT_TRANSLATE_NOOP("Country", "Anguilla") },
+	{ 103, QT_TRANSLATE_NOOP("Country", "Bahamas") },
+	{ 104, QT_TRANSLATE_NOOP("Country", "Barbados") },
+	{ 105, QT_TRANSLATE_NOOP("Country", "Bermuda") },
+	{ 106, QT_TRANSLATE_NOOP("Country", "British Virgin Islands") },
+	{ 107, QT_TRANSLATE_NOOP("Country", "Canada") },
+	{ 108, QT_TRANSLATE_NOOP("Country", "Cayman Islands") },
+	{ 109, QT_TRANSLATE_NOOP("Country", "Dominica") },
+	{ 110, QT_TRANSLATE_NOOP("Country", "Dominican Republic") },
+	{ 111, QT_TRANSLATE_NOOP("Country", "Grenada") },
+	{ 112, QT_TRANSLATE_NOOP("Country", "Jamaica") },
+	{ 113, QT_TRANSLATE_NOOP("Country", "Montserrat") },
+	{ 114, QT_TRANSLATE_NOOP("Country", "Nevis") },
+	{ 115, QT_TRANSLATE_NOOP("Country", "Saint Kitts") },
+	{ 116, QT_TRANSLATE_NOOP("Country", "Saint Vincent and the Grenadines") },
+	{ 117, QT_TRANSLATE_NOOP("Country", "Trinidad and Tobago") },
+	{ 118, QT_TRANSLATE_NOOP("Country", "Turks and Caicos Islands") },
+	{ 120, QT_TRANSLATE_NOOP("Country", "Barbuda") },
+	{ 121, QT_TRANSLATE_NOOP("Country", "Puerto Rico, Common Wealth of") },
+	{ 122, QT_TRANSLATE_NOOP("Country", "Saint Lucia") },
+	{ 123, QT_TRANSLATE_NOOP("Country", "Virgin Islands of the United States") },
+	{ 178, QT_TRANSLATE_NOOP("Country", "Canary Islands") },
+	{ 212, QT_TRANSLATE_NOOP("Country", "Morocco") },
+	{ 213, QT_TRANSLATE_NOOP("Country", "Algeria") },
+	{ 216, QT_TRANSLATE_NOOP("Country", "Tunisia") },
+	{ 218, QT_TRANSLATE_NOOP("Country", "Libyan Arab Jamahiriya") },
+	{ 220, QT_TRANSLATE_NOOP("Country", "Gambia") },
+	{ 221, QT_TRANSLATE_NOOP("Country", "Senegal") },
+	{ 222, QT_TRANSLATE_NOOP("Country", "Mauritania") },
+	{ 223, QT_TRANSLATE_NOOP("Country", "Mali") },
+	{ 224, QT_TRANSLATE_NOOP("Country", "Guinea") },
+	{ 225, QT_TRANSLATE_NOOP("Country", "Cote d'Ivoire (Ivory Coast)") },
+	{ 226, QT_TRANSLATE_NOOP("Country", "Burkina Faso") },
+	{ 227, QT_TRANSLATE_NOOP("Country", "Niger") },
+	{ 228, QT_TRANSLATE_NOOP("Country", "Togo") },
+	{ 229, QT_TRANSLATE_NOOP("Country", "Benin") },
+	{ 230, QT_TRANSLATE_NOOP("Country", "Mauritius") },
+	{ 231, QT_TRANSLATE_NOOP("Country", "Liberia") },
+	{ 232, QT_TRANSLATE_NOOP("Country", "Sierra Leone") },
+	{ 233, QT_TRANSLATE_NOOP("Country", "Ghana") },
+	{ 234, QT_TRANSLATE_NOOP("Country", "Nigeria") },
+	{ 235, QT_TRANSLATE_NOOP("Country", "Chad") },
+	{ 236, QT_TRANSLATE_NOOP("Country", "Central African Republic") },
+	{ 237, QT_TRANSLATE_NOOP("Country", "Cameroon") },
+	{ 238, QT_TRANSLATE_NOOP("Country", "Cape Verde Islands") },
+	{ 239, QT_TRANSLATE_NOOP("Country", "Sao Tome & Principe") },
+	{ 240, QT_TRANSLATE_NOOP("Country", "Equatorial Guinea") },
+	{ 241, QT_TRANSLATE_NOOP("Country", "Gabon") },
+	{ 242, QT_TRANSLATE_NOOP("Country", "Congo, (Republic of the)") },
+	{ 243, QT_TRANSLATE_NOOP("Country", "Congo, Democratic Republic of (Zaire)") },
+	{ 244, QT_TRANSLATE_NOOP("Country", "Angola") },
+	{ 245, QT_TRANSLATE_NOOP("Country", "Guinea-Bissau") },
+	{ 246, QT_TRANSLATE_NOOP("Country", "Diego Garcia") },
+	{ 247, QT_TRANSLATE_NOOP("Country", "Ascension Island") },
+	{ 248, QT_TRANSLATE_NOOP("Country", "Seychelles") },
+	{ 249, QT_TRANSLATE_NOOP("Country", "Sudan") },
+	{ 250, QT_TRANSLATE_NOOP("Country", "Rwanda") },
+	{ 251, QT_TRANSLATE_NOOP("Country", "Ethiopia") },
+	{ 252, QT_TRANSLATE_NOOP("Country", "Somalia") },
+	{ 253, QT_TRANSLATE_NOOP("Country", "Djibouti") },
+	{ 254, QT_TRANSLATE_NOOP("Country", "Kenya") },
+	{ 255, QT_TRANSLATE_NOOP("Country", "Tanzania, United Republic of") },
+	{ 256, QT_TRANSLATE_NOOP("Country", "Uganda") },
+	{ 257, QT_TRANSLATE_NOOP("Country", "Burundi") },
+	{ 258, QT_TRANSLATE_NOOP("Country", "Mozambique") },
+	{ 260, QT_TRANSLATE_NOOP("Country", "Zambia") },
+	{ 261, QT_TRANSLATE_NOOP("Country", "Madagascar") },
+	{ 262, QT_TRANSLATE_NOOP("Country", "Reunion Island") },
+	{ 263, QT_TRANSLATE_NOOP("Country", "Zimbabwe") },
+	{ 264, QT_TRANSLATE_NOOP("Country", "Namibia") },
+	{ 265, QT_TRANSLATE_NOOP("Country", "Malawi") },
+	{ 266, QT_TRANSLATE_NOOP("Country", "Lesotho") },
+	{ 267, QT_TRANSLATE_NOOP("Country", "Botswana") },
+	{ 268, QT_TRANSLATE_NOOP("Country", "Swaziland") },
+	{ 269, QT_TRANSLATE_NOOP("Country", "Mayotte Island") },
+	{ 290, QT_TRANSLATE_NOOP("Country", "Saint Helena") },
+	{ 291, QT_TRANSLATE_NOOP("Country", "Eritrea") },
+	{ 297, QT_TRANSLATE_NOOP("Country", "Aruba") },
+	{ 298, QT_TRANSLATE_NOOP("Country", "Faeroe Islands") },
+	{ 299, QT_TRANSLATE_NOOP("Country", "Greenland") },
+	{ 350, QT_TRANSLATE_NOOP("Country", "Gibraltar") },
+	{ 351, QT_TRANSLATE_NOOP("Country", "Portugal") },
+	{ 352, QT_TRANSLATE_NOOP("Country", "Luxembourg") },
+	{ 353, QT_TRANSLATE_NOOP("Country", "Ireland") },
+	{ 354, QT_TRANSLATE_NOOP("Country", "Iceland") },
+	{ 355, QT_TRANSLATE_NOOP("Country", "Albania") },
+	{ 356, QT_TRANSLATE_NOOP("Country", "Malta") },
+	{ 357, QT_TRANSLATE_NOOP("Country", "Cyprus") },
+	{ 358, QT_TRANSLATE_NOOP("Country", "Finland") },
+	{ 359, QT_TRANSLATE_NOOP("Country", "Bulgaria") },
+	{ 370, QT_TRANSLATE_NOOP("Country", "Lithuania") },
+	{ 371, QT_TRANSLATE_NOOP("Country", "Latvia") },
+	{ 372, QT_TRANSLATE_NOOP("Country", "Estonia") },
+	{ 373, QT_TRANSLATE_NOOP("Country", "Moldova, Republic of") },
+	{ 374, QT_TRANSLATE_NOOP("Country", "Armenia") },
+	{ 375, QT_TRANSLATE_NOOP("Country", "Belarus") },
+	{ 376, QT_TRANSLATE_NOOP("Country", "Andorra") },
+	{ 377, QT_TRANSLATE_NOOP("Country", "Monaco") },
+	{ 378, QT_TRANSLATE_NOOP("Country", "San Marino") },
+	{ 379, QT_TRANSLATE_NOOP("Country", "Vatican City") },
+	{ 380, QT_TRANSLATE_NOOP("Country", "Ukraine") },
+	{ 381, QT_TRANSLATE_NOOP("Country", "Yugoslavia") },
+	{ 382, QT_TRANSLATE_NOOP("Country", "Yugoslavia - Montenegro") },
+	{ 385, QT_TRANSLATE_NOOP("Country", "Croatia") },
+	{ 386, QT_TRANSLATE_NOOP("Country", "Slovenia") },
+	{ 387, QT_TRANSLATE_NOOP("Country", "Bosnia and Herzegovina") },
+	{ 389, QT_TRANSLATE_NOOP("Country", "Macedonia (F.Y.R.O.M.)") },
+	{ 441, QT_TRANSLATE_NOOP("Country", "Wales") },
+	{ 442, QT_TRANSLATE_NOOP("Country", "Scotland") },
+	{ 500, QT_TRANSLATE_NOOP("Country", "Falkland Islands") },
+	{ 501, QT_TRANSLATE_NOOP("Country", "Belize") },
+	{ 502, QT_TRANSLATE_NOOP("Country", "Guatemala") },
+	{ 503, QT_TRANSLATE_NOOP("Country", "El Salvador") },
+	{ 504, QT_TRANSLATE_NOOP("Country", "Honduras") },
+	{ 505, QT_TRANSLATE_NOOP("Country", "Nicaragua") },
+	{ 506, QT_TRANSLATE_NOOP("Country", "Costa Rica") },
+	{ 507, QT_TRANSLATE_NOOP("Country", "Panama") },
+	{ 508, QT_TRANSLATE_NOOP("Country", "Saint Pierre and Miquelon") },
+	{ 509, QT_TRANSLATE_NOOP("Country", "Haiti") },
+	{ 590, QT_TRANSLATE_NOOP("Country", "Guadeloupe") },
+	{ 591, QT_TRANSLATE_NOOP("Country", "Bolivia") },
+	{ 592, QT_TRANSLATE_NOOP("Country", "Guyana") },
+	{ 593, QT_TRANSLATE_NOOP("Country", "Ecuador") },
+	{ 594, QT_TRANSLATE_NOOP("Country", "French Guiana") },
+	{ 595, QT_TRANSLATE_NOOP("Country", "Paraguay") },
+	{ 596, QT_TRANSLATE_NOOP("Country", "Martinique") },
+	{ 597, QT_TRANSLATE_NOOP("Country", "Suriname") },
+	{ 598, QT_TRANSLATE_NOOP("Country", "Uruguay") },
+	{ 599, QT_TRANSLATE_NOOP("Country", "Netherlands Antilles") },
+	{ 670, QT_TRANSLATE_NOOP("Country", "Saipan Island") },
+	{ 671, QT_TRANSLATE_NOOP("Country", "Guam, US Territory of") },
+	{ 672, QT_TRANSLATE_NOOP("Country", "Christmas Island") },
+	{ 673, QT_TRANSLATE_NOOP("Country", "Brunei") },
+	{ 674, QT_TRANSLATE_NOOP("Country", "Nauru") },
+	{ 675, QT_TRANSLATE_NOOP("Country", "Papua New Guinea") },
+	{ 676, QT_TRANSLATE_NOOP("Country", "Tonga") },
+	{ 677, QT_TRANSLATE_NOOP("Country", "Solomon Islands") },
+	{ 678, QT_TRANSLATE_NOOP("Country", "Vanuatu") },
+	{ 679, QT_TRANSLATE_NOOP("Country", "Fiji") },
+	{ 680, QT_TRANSLATE_NOOP("Country", "Palau") },
+	{ 681, QT_TRANSLATE_NOOP("Country", "Wallis and Futuna Islands") },
+	{ 682, QT_TRANSLATE_NOOP("Country", "Cook Islands") },
+	{ 683, QT_TRANSLATE_NOOP("Country", "Niue") },
+	{ 684, QT_TRANSLATE_NOOP("Country", "Samoa") },
+	{ 685, QT_TRANSLATE_NOOP("Country", "Western Samoa") },
+	{ 686, QT_TRANSLATE_NOOP("Country", "Kiribati") },
+	{ 687, QT_TRANSLATE_NOOP("Country", "New Caledonia") },
+	{ 688, QT_TRANSLATE_NOOP("Country", "Tuvalu") },
+	{ 689, QT_TRANSLATE_NOOP("Country", "French Polynesia") },
+	{ 690, QT_TRANSLATE_NOOP("Country", "Tokelau") },
+	{ 691, QT_TRANSLATE_NOOP("Country", "Micronesia, Federated States of") },
+	{ 692, QT_TRANSLATE_NOOP("Country", "Marshall Islands") },
+	{ 705, QT_TRANSLATE_NOOP("Country", "Kazakhstan") },
+	{ 706, QT_TRANSLATE_NOOP("Country", "Kyrgyzstan") },
+	{ 708, QT_TRANSLATE_NOOP("Country", "Tajikistan") },
+	{ 709, QT_TRANSLATE_NOOP("Country", "Turkmenistan") },
+	{ 711, QT_TRANSLATE_NOOP("Country", "Uzbekistan") },
+	{ 850, QT_TRANSLATE_NOOP("Country", "Korea (North Korea), Democratic People's Republic of") },
+	{ 852, QT_TRANSLATE_NOOP("Country", "Hong Kong") },
+	{ 853, QT_TRANSLATE_NOOP("Country", "Macau") },
+	{ 855, QT_TRANSLATE_NOOP("Country", "Cambodia") },
+	{ 856, QT_TRANSLATE_NOOP("Country", "Lao People's Democratic Republic") },
+	{ 880, QT_TRANSLATE_NOOP("Country", "Bangladesh") },
+	{ 886, QT_TRANSLATE_NOOP("Country", "Taiwan") },
+	{ 960, QT_TRANSLATE_NOOP("Country", "Maldives") },
+	{ 961, QT_TRANSLATE_NOOP("Country", "Lebanon") },
+	{ 962, QT_TRANSLATE_NOOP("Country", "Jordan") },
+	{ 963, QT_TRANSLATE_NOOP("Country", "Syrian Arab Republic") },
+	{ 964, QT_TRANSLATE_NOOP("Country", "Iraq") },
+	{ 965, QT_TRANSLATE_NOOP("Country", "Kuwait") },
+	{ 966, QT_TRANSLATE_NOOP("Country", "Saudi Arabia") },
+	{ 967, QT_TRANSLATE_NOOP("Country", "Yemen") },
+	{ 968, QT_TRANSLATE_NOOP("Country", "Oman") },
+	{ 971, QT_TRANSLATE_NOOP("Country", "United Arab Emirates") },
+	{ 972, QT_TRANSLATE_NOOP("Country", "Israel") },
+	{ 973, QT_TRANSLATE_NOOP("Country", "Bahrain") },
+	{ 974, QT_TRANSLATE_NOOP("Country", "Qatar") },
+	{ 975, QT_TRANSLATE_NOOP("Country", "Bhutan") },
+	{ 976, QT_TRANSLATE_NOOP("Country", "Mongolia") },
+	{ 977, QT_TRANSLATE_NOOP("Country", "Nepal") },
+	{ 994, QT_TRANSLATE_NOOP("Country", "Azerbaijan") },
+	{ 995, QT_TRANSLATE_NOOP("Country", "Georgia") },
+	{ 1021, QT_TRANSLATE_NOOP("Country", "Antigua and Barbuda") },
+	{ 1141, QT_TRANSLATE_NOOP("Country", "Saint Kitts and Nevis") },
+	{ 2691, QT_TRANSLATE_NOOP("Country", "Comoros") },
+	{ 3811, QT_TRANSLATE_NOOP("Country", "Yugoslavia - Serbia") },
+	{ 4101, QT_TRANSLATE_NOOP("Country", "Liechtenstein") },
+	{ 4201, QT_TRANSLATE_NOOP("Country", "Slovakia") },
+	{ 5901, QT_TRANSLATE_NOOP("Country", "French Antilles") },
+	{ 5902, QT_TRANSLATE_NOOP("Country", "Antilles") },
+	{ 6102, QT_TRANSLATE_NOOP("Country", "Cocos (Keeling) Islands") },
+	{ 6701, QT_TRANSLATE_NOOP("Country", "Rota Island") },
+	{ 6702, QT_TRANSLATE_NOOP("Country", "Tinian Island") },
+	{ 6722, QT_TRANSLATE_NOOP("Country", "Norfolk Island") },
+	{ 9999, QT_TRANSLATE_NOOP("Country", "Other") },
+};
 
-static FieldNamesList init_pasts_list()
-{
-	FieldNamesList list;
-	list.insert(300, QT_TRANSLATE_NOOP("Past", "Elementary School"));
-	list.insert(301, QT_TRANSLATE_NOOP("Past", "High School"));
-	list.insert(302, QT_TRANSLATE_NOOP("Past", "College"));
-	list.insert(303, QT_TRANSLATE_NOOP("Past", "University"));
-	list.insert(304, QT_TRANSLATE_NOOP("Past", "Military"));
-	list.insert(305, QT_TRANSLATE_NOOP("Past", "Past Work Place"));
-	list.insert(306, QT_TRANSLATE_NOOP("Past", "Past Organization"));
-	list.insert(399, QT_TRANSLATE_NOOP("Past", "Other"));
-	return list;
-}
+static const FieldNamesTable countriesTable = {
+	"Country", countriesNames, sizeof(countriesNames) / sizeof(FieldName)
+};
 
-const FieldNamesList &pasts()
+const FieldNamesTable &countries()
 {
-	static FieldNamesList list = init_pasts_list();
-	return list;
+	return countriesTable;
 }
 
-static FieldNamesList init_genders_list()
-{
-	FieldNamesList list;
-	QString maleStr = QT_TRANSLATE_NOOP("Gender", "Male");
-	QString femaleStr = QT_TRANSLATE_NOOP("Gender", "Female");
-	list.insert(1, femaleStr);
-	list.insert(2, maleStr);
-	list.insert('M', maleStr);
-	list.insert('F', femaleStr);
-	return list;
-}
+static const FieldName interestsNames[] = {
+	{ 100, QT_TRANSLATE_NOOP("Interest", "Art") },
+	{ 101, QT_TRANSLATE_NOOP("Interest", "Cars") },
+	{ 102, QT_TRANSLATE_NOOP("Interest", "Celebrity Fans") },
+	{ 103, QT_TRANSLATE_NOOP("Interest", "Collections") },
+	{ 104, QT_TRANSLATE_NOOP("Interest", "Computers") },
+	{ 105, QT_TRANSLATE_NOOP("Interest", "Culture") },
+	{ 106, QT_TRANSLATE_NOOP("Interest", "Fitness") },
+	{ 107, QT_TRANSLATE_NOOP("Interest", "Games") },
+	{ 108, QT_TRANSLATE_NOOP("Interest", "Hobbies") },
+	{ 109, QT_TRANSLATE_NOOP("Interest", "ICQ - Help") },
+	{ 110, QT_TRANSLATE_NOOP("Interest", "Internet") },
+	{ 111, QT_TRANSLATE_NOOP("Interest", "Lifestyle") },
+	{ 112, QT_TRANSLATE_NOOP("Interest", "Movies and TV") },
+	{ 113, QT_TRANSLATE_NOOP("Interest", "Music") },
+	{ 114, QT_TRANSLATE_NOOP("Interest", "Outdoors") },
+	{ 115, QT_TRANSLATE_NOOP("Interest", "Parenting") },
+	{ 116, QT_TRANSLATE_NOOP("Interest", "Pets and Animals") },
+	{ 117, QT_TRANSLATE_NOOP("Interest", "Religion") },
+	{ 118, QT_TRANSLATE_NOOP("Interest", "Science") },
+	{ 119, QT_TRANSLATE_NOOP("Interest", "Skills") },
+	{ 120, QT_TRANSLATE_NOOP("Interest", "Sports") },
+	{ 121, QT_TRANSLATE_NOOP("Interest", "Web Design") },
+	{ 122, QT_TRANSLATE_NOOP("Interest", "Ecology") },
+	{ 123, QT_TRANSLATE_NOOP("Interest", "News and Media") },
+	{ 124, QT_TRANSLATE_NOOP("Interest", "Government") },
+	{ 125, QT_TRANSLATE_NOOP("Interest", "Business") },
+	{ 126, QT_TRANSLATE_NOOP("Interest", "Mystics") },
+	{ 127, QT_TRANSLATE_NOOP("Interest", "Travel") },
+	{ 128, QT_TRANSLATE_NOOP("Interest", "Astronomy") },
+	{ 129, QT_TRANSLATE_NOOP("Interest", "Space") },
+	{ 130, QT_TRANSLATE_NOOP("Interest", "Clothing") },
+	{ 131, QT_TRANSLATE_NOOP("Interest", "Parties") },
+	{ 132, QT_TRANSLATE_NOOP("Interest", "Women") },
+	{ 133, QT_TRANSLATE_NOOP("Interest", "Social science") },
+	{ 134, QT_TRANSLATE_NOOP("Interest", "60's") },
+	{ 135, QT_TRANSLATE_NOOP("Interest", "70's") },
+	{ 136, QT_TRANSLATE_NOOP("Interest", "80's") },
+	{ 137, QT_TRANSLATE_NOOP("Interest", "50's") },
+	{ 138, QT_TRANSLATE_NOOP("Interest", "Finance and Corporate") },
+	{ 139, QT_TRANSLATE_NOOP("Interest", "Entertainment") },
+	{ 141, QT_TRANSLATE_NOOP("Interest", "Retail Stores") },
+	{ 142, QT_TRANSLATE_NOOP("Interest", "Health and Beauty") },
+	{ 143, QT_TRANSLATE_NOOP("Interest", "Media") },
+	{ 144, QT_TRANSLATE_NOOP("Interest", "Household Products") },
+	{ 145, QT_TRANSLATE_NOOP("Interest", "Mail Order Catalog") },
+	{ 146, QT_TRANSLATE_NOOP("Interest", "Business Services") },
+	{ 147, QT_TRANSLATE_NOOP("Interest", "Audio and Visual") },
+	{ 148, QT_TRANSLATE_NOOP("Interest", "Sporting and Athletic") },
+	{ 149, QT_TRANSLATE_NOOP("Interest", "Publishing") },
+	{ 150, QT_TRANSLATE_NOOP("Interest", "Home Automation") },
+};
 
-const FieldNamesList &genders()
-{
-	static FieldNamesList list = init_genders_list();
-	return list;
-}
+static const FieldNamesTable interestsTable = {
+	"Interest", interestsNames, sizeof(interestsNames) / sizeof(FieldName)
+};
 
-static FieldNamesList init_study_levels_list()
+const FieldNamesTable &interests()
 {
-	FieldNamesList list;
-	list.insert(4, QT_TRANSLATE_NOOP("StudyLevel", "Associated degree"));
-	list.insert(5, QT_TRANSLATE_NOOP("StudyLevel", "Bachelor's degree"));
-	list.insert(1, QT_TRANSLATE_NOOP("StudyLevel", "Elementary"));
-	list.insert(2, QT_TRANSLATE_NOOP("StudyLevel", "High-school"));
-	list.insert(6, QT_TRANSLATE_NOOP("StudyLevel", "Master's degree"));
-	list.insert(7, QT_TRANSLATE_NOOP("StudyLevel", "PhD"));
-	list.insert(8, QT_TRANSLATE_NOOP("StudyLevel", "Postdoctoral"));
-	list.insert(3, QT_TRANSLATE_NOOP("StudyLevel", "University / College"));
-	return list;
+	return interestsTable;
 }
 
-const FieldNamesList &study_levels()
-{
-	static FieldNamesList list = init_study_levels_list();
-	return list;
-}
+static const FieldName languagesNames[] = {
+	{ 1, QT_TRANSLATE_NOOP("Language", "Arabic") },
+	{ 2, QT_TRANSLATE_NOOP("Language", "Bhojpuri") },
+	{ 3, QT_TRANSLATE_NOOP("Language", "Bulgarian") },
+	{ 4, QT_TRANSLATE_NOOP("Language", "Burmese") },
+	{ 5, QT_TRANSLATE_NOOP("Language", "Cantonese") },
+	{ 6, QT_TRANSLATE_NOOP("Language", "Catalan") },
+	{ 7, QT_TRANSLATE_NOOP("Language", "Chinese") },
+	{ 8, QT_TRANSLATE_NOOP("Language", "Croatian") },
+	{ 9, QT_TRANSLATE_NOOP("Language", "Czech") },
+	{ 10, QT_TRANSLATE_NOOP("Language", "Danish") },
+	{ 11, QT_TRANSLATE_NOOP("Language", "Dutch") },
+	{ 12, QT_TRANSLATE_NOOP("Language", "English") },
+	{ 13, QT_TRANSLATE_NOOP("Language", "Esperanto") },
+	{ 14, QT_TRANSLATE_NOOP("Language", "Estonian") },
+	{ 15, QT_TRANSLATE_NOOP("Language", "Farsi") },
+	{ 16, QT_TRANSLATE_NOOP("Language", "Finnish") },
+	{ 17, QT_TRANSLATE_NOOP("Language", "French") },
+	{ 18, QT_TRANSLATE_NOOP("Language", "Gaelic") },
+	{ 19, QT_TRANSLATE_NOOP("Language", "German") },
+	{ 20, QT_TRANSLATE_NOOP("Language", "Greek") },
+	{ 21, QT_TRANSLATE_NOOP("Language", "Hebrew") },
+	{ 22, QT_TRANSLATE_NOOP("Language", "Hindi") },
+	{ 23, QT_TRANSLATE_NOOP("Language", "Hungarian") },
+	{ 24, QT_TRANSLATE_NOOP("Language", "Icelandic") },
+	{ 25, QT_TRANSLATE_NOOP("Language", "Indonesian") },
+	{ 26, QT_TRANSLATE_NOOP("Language", "Italian") },
+	{ 27, QT_TRANSLATE_NOOP("Language", "Japanese") },
+	{ 28, QT_TRANSLATE_NOOP("Language", "Khmer") },
+	{ 29, QT_TRANSLATE_NOOP("Language", "Korean") },
+	{ 30, QT_TRANSLATE_NOOP("Language", "Lao") },
+	{ 31, QT_TRANSLATE_NOOP("Language", "Latvian") },
+	{ 32, QT_TRANSLATE_NOOP("Language", "Lithuanian") },
+	{ 33, QT_TRANSLATE_NOOP("Language", "Malay") },
+	{ 34, QT_TRANSLATE_NOOP("Language", "Norwegian") },
+	{ 35, QT_TRANSLATE_NOOP("Language", "Polish") },
+	{ 36, QT_TRANSLATE_NOOP("Language", "Portuguese") },
+	{ 37, QT_TRANSLATE_NOOP("Language", "Romanian") },
+	{ 38, QT_TRANSLATE_NOOP("Language", "Russian") },
+	{ 39, QT_TRANSLATE_NOOP("Language", "Serbian") },
+	{ 40, QT_TRANSLATE_NOOP("Language", "Slovak") },
+	{ 41, QT_TRANSLATE_NOOP("Language", "Slovenian") },
+	{ 42, QT_TRANSLATE_NOOP("Language", "Somali") },
+	{ 43, QT_TRANSLATE_NOOP("Language", "Spanish") },
+	{ 44, QT_TRANSLATE_NOOP("Language", "Swahili") },
+	{ 45, QT_TRANSLATE_NOOP("Language", "Swedish") },
+	{ 46, QT_TRANSLATE_NOOP("Language", "Tagalog") },
+	{ 47, QT_TRANSLATE_NOOP("Language", "Tatar") },
+	{ 48, QT_TRANSLATE_NOOP("Language", "Thai") },
+	{ 49, QT_TRANSLATE_NOOP("Language", "Turkish") },
+	{ 50, QT_TRANSLATE_NOOP("Language", "Ukrainian") },
+	{ 51, QT_TRANSLATE_NOOP("Language", "Urdu") },
+	{ 52, QT_TRANSLATE_NOOP("Language", "Vietnamese") },
+	{ 53, QT_TRANSLATE_NOOP("Language", "Yiddish") },
+	{ 54, QT_TRANSLATE_NOOP("Language", "Yoruba") },
+	{ 55, QT_TRANSLATE_NOOP("Language", "Afrikaans") },
+	{ 56, QT_TRANSLATE_NOOP("Language", "Bosnian") },
+	{ 57, QT_TRANSLATE_NOOP("Language", "Persian") },
+	{ 58, QT_TRANSLATE_NOOP("Language", "Albanian") },
+	{ 59, QT_TRANSLATE_NOOP("Language", "Armenian") },
+	{ 60, QT_TRANSLATE_NOOP("Language", "Punjabi") },
+	{ 61, QT_TRANSLATE_NOOP("Language", "Chamorro") },
+	{ 62, QT_TRANSLATE_NOOP("Language", "Mongolian") },
+	{ 63, QT_TRANSLATE_NOOP("Language", "Mandarin") },
+	{ 64, QT_TRANSLATE_NOOP("Language", "Taiwanese") },
+	{ 65, QT_TRANSLATE_NOOP("Language", "Macedonian") },
+	{ 66, QT_TRANSLATE_NOOP("Language", "Sindhi") },
+	{ 67, QT_TRANSLATE_NOOP("Language", "Welsh") },
+	{ 68, QT_TRANSLATE_NOOP("Language", "Azerbaijani") },
+	{ 69, QT_TRANSLATE_NOOP("Language", "Kurdish") },
+	{ 70, QT_TRANSLATE_NOOP("Language", "Gujarati") },
+	{ 71, QT_TRANSLATE_NOOP("Language", "Tamil") },
+	{ 72, QT_TRANSLATE_NOOP("Language", "Belorussian") },
+};
 
-static FieldNamesList init_industries_list()
-{
-	FieldNamesList list;
-	list.insert(2, QT_TRANSLATE_NOOP("Industry", "Agriculture"));
-	list.insert(3, QT_TRANSLATE_NOOP("Industry", "Arts"));
-	list.insert(4, QT_TRANSLATE_NOOP("Industry", "Construction"));
-	list.insert(5, QT_TRANSLATE_NOOP("Industry", "Consumer Goods"));
-	list.insert(6, QT_TRANSLATE_NOOP("Industry", "Corporate Services"));
-	list.insert(7, QT_TRANSLATE_NOOP("Industry", "Education"));
-	list.insert(8, QT_TRANSLATE_NOOP("Industry", "Finance"));
-	list.insert(9, QT_TRANSLATE_NOOP("Industry", "Government"));
-	list.insert(10, QT_TRANSLATE_NOOP("Industry", "High Tech"));
-	list.insert(11, QT_TRANSLATE_NOOP("Industry", "Legal"));
-	list.insert(12, QT_TRANSLATE_NOOP("Industry", "Manufacturing"));
-	list.insert(13, QT_TRANSLATE_NOOP("Industry", "Media"));
-	list.insert(14, QT_TRANSLATE_NOOP("Industry", "Medical & Health Care"));
-	list.insert(15, QT_TRANSLATE_NOOP("Industry", "Non-Profit Organization Management"));
-	list.insert(19, QT_TRANSLATE_NOOP("Industry", "Other"));
-	list.insert(16, QT_TRANSLATE_NOOP("Industry", "Recreation, Travel & Entertainment"));
-	list.insert(17, QT_TRANSLATE_NOOP("Industry", "Service Industry"));
-	list.insert(18, QT_TRANSLATE_NOOP("Industry", "Transportation"));
-	return list;
-}
+static const FieldNamesTable languagesTable = {
+	"Language", languagesNames, sizeof(languagesNames) / sizeof(FieldName)
+};
 
-const FieldNamesList &industries()
+const FieldNamesTable &languages()
 {
-	static FieldNamesList list = init_industries_list();
-	return list;
+	return languagesTable;
 }
 
-static FieldNamesList init_occupations_list()
-{
-	FieldNamesList list;
-	list.insert(1, QT_TRANSLATE_NOOP("Occupation", "Academic"));
-	list.insert(2, QT_TRANSLATE_NOOP("Occupation", "Administrative"));
-	list.insert(3, QT_TRANSLATE_NOOP("Occupation", "Art/Entertainment"));
-	list.insert(4, QT_TRANSLATE_NOOP("Occupation", "College Student"));
-	list.insert(5, QT_TRANSLATE_NOOP("Occupation", "Computers"));
-	list.insert(6, QT_TRANSLATE_NOOP("Occupation", "Community & Social"));
-	list.insert(7, QT_TRANSLATE_NOOP("Occupation", "Education"));
-	list.insert(8, QT_TRANSLATE_NOOP("Occupation", "Engineering"));
-	list.insert(9, QT_TRANSLATE_NOOP("Occupation", "Financial Services"));
-	list.insert(10, QT_TRANSLATE_NOOP("Occupation", "Government"));
-	list.insert(11, QT_TRANSLATE_NOOP("Occupation", "High School Student"));
-	list.insert(12, QT_TRANSLATE_NOOP("Occupation", "Home"));
-	list.insert(13, QT_TRANSLATE_NOOP("Occupation", "ICQ - Providing Help"));
-	list.insert(14, QT_TRANSLATE_NOOP("Occupation", "Law"));
-	list.insert(15, QT_TRANSLATE_NOOP("Occupation", "Managerial"));
-	list.insert(16, QT_TRANSLATE_NOOP("Occupation", "Manufacturing"));
-	list.insert(17, QT_TRANSLATE_NOOP("Occupation", "Medical/Health"));
-	list.insert(18, QT_TRANSLATE_NOOP("Occupation", "Military"));
-	list.insert(19, QT_TRANSLATE_NOOP("Occupation", "Non-Government Organization"));
-	list.insert(20, QT_TRANSLATE_NOOP("Occupation", "Professional"));
-	list.insert(21, QT_TRANSLATE_NOOP("Occupation", "Retail"));
-	list.insert(22, QT_TRANSLATE_NOOP("Occupation", "Retired"));
-	list.insert(23, QT_TRANSLATE_NOOP("Occupation", "Science & Research"));
-	list.insert(24, QT_TRANSLATE_NOOP("Occupation", "Sports"));
-	list.insert(25, QT_TRANSLATE_NOOP("Occupation", "Technical"));
-	list.insert(26, QT_TRANSLATE_NOOP("Occupation", "University Student"));
-	list.insert(27, QT_TRANSLATE_NOOP("Occupation", "Web Building"));
-	list.insert(99, QT_TRANSLATE_NOOP("Occupation", "Other Services"));
-	return list;
-}
+static const FieldName pastsNames[] = {
+	{ 300, QT_TRANSLATE_NOOP("Past", "Elementary School") },
+	{ 301, QT_TRANSLATE_NOOP("Past", "High School") },
+	{ 302, QT_TRANSLATE_NOOP("Past", "College") },
+	{ 303, QT_TRANSLATE_NOOP("Past", "University") },
+	{ 304, QT_TRANSLATE_NOOP("Past", "Military") },
+	{ 305, QT_TRANSLATE_NOOP("Past", "Past Work Place") },
+	{ 306, QT_TRANSLATE_NOOP("Past", "Past Organization") },
+	{ 399, QT_TRANSLATE_NOOP("Past", "Other") },
+};
 
-const FieldNamesList &occupations()
-{
-	static FieldNamesList list = init_occupations_list();
-	return list;
-}
+static const FieldNamesTable pastsTable = {
+	"Past", pastsNames, sizeof(pastsNames) / sizeof(FieldName)
+};
 
-static FieldNamesList init_affilations_list()
+const FieldNamesTable &pasts()
 {
-	FieldNamesList list;
-	list.insert(200, QT_TRANSLATE_NOOP("Affiliation", "Alumni Org."));
-	list.insert(201, QT_TRANSLATE_NOOP("Affiliation", "Charity Org."));
-	list.insert(202, QT_TRANSLATE_NOOP("Affiliation", "Club/Social Org."));
-	list.insert(203, QT_TRANSLATE_NOOP("Affiliation", "Community Org."));
-	list.insert(204, QT_TRANSLATE_NOOP("Affiliation", "Cultural Org."));
-	list.insert(205, QT_TRANSLATE_NOOP("Affiliation", "Fan Clubs"));
-	list.insert(206, QT_TRANSLATE_NOOP("Affiliation", "Fraternity/Sorority"));
-	list.insert(207, QT_TRANSLATE_NOOP("Affiliation", "Hobbyists Org."));
-	list.insert(208, QT_TRANSLATE_NOOP("Affiliation", "International Org."));
-	list.insert(209, QT_TRANSLATE_NOOP("Affiliation", "Nature and Environment Org."));
-	list.insert(210, QT_TRANSLATE_NOOP("Affiliation", "Professional Org."));
-	list.insert(211, QT_TRANSLATE_NOOP("Affiliation", "Scientific/Technical Org."));
-	list.insert(212, QT_TRANSLATE_NOOP("Affiliation", "Self Improvement Group"));
-	list.insert(213, QT_TRANSLATE_NOOP("Affiliation", "Spiritual/Religious Org."));
-	list.insert(214, QT_TRANSLATE_NOOP("Affiliation", "Sports Org."));
-	list.insert(215, QT_TRANSLATE_NOOP("Affiliation", "Support Org."));
-	list.insert(216, QT_TRANSLATE_NOOP("Affiliation", "Trade and Business Org."));
-	list.insert(217, QT_TRANSLATE_NOOP("Affiliation", "Union"));
-	list.insert(218, QT_TRANSLATE_NOOP("Affiliation", "Volunteer Org."));
-	list.insert(299, QT_TRANSLATE_NOOP("Affiliation", "Other"));
-	return list;
+	return pastsTable;
 }
 
-const FieldNamesList &affilations()
+static const FieldName gendersNames[] = {
+	{ 1, QT_TRANSLATE_NOOP("Gender", "Female") },
+	{ 2, QT_TRANSLATE_NOOP("Gender", "Male") },
+	{ 'F', QT_TRANSLATE_NOOP("Gender", "Female") },
+	{ 'M', QT_TRANSLATE_NOOP("Gender", "Male") },
+};
+
+static const FieldNamesTable gendersTable = {
+	"Gender", gendersNames, sizeof(gendersNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &genders()
 {
-	static FieldNamesList list = init_affilations_list();
-	return list;
+	return gendersTable;
 }
 
-static AgesList init_ages_list()
+static const FieldName studyLevelsNames[] = {
+	{ 1, QT_TRANSLATE_NOOP("StudyLevel", "Elementary") },
+	{ 2, QT_TRANSLATE_NOOP("StudyLevel", "High-school") },
+	{ 3, QT_TRANSLATE_NOOP("StudyLevel", "University / College") },
+	{ 4, QT_TRANSLATE_NOOP("StudyLevel", "Associated degree") },
+	{ 5, QT_TRANSLATE_NOOP("StudyLevel", "Bachelor's degree") },
+	{ 6, QT_TRANSLATE_NOOP("StudyLevel", "Master's degree") },
+	{ 7, QT_TRANSLATE_NOOP("StudyLevel", "PhD") },
+	{ 8, QT_TRANSLATE_NOOP("StudyLevel", "Postdoctoral") },
+};
+
+static const FieldNamesTable studyLevelsTable = {
+	"StudyLevel", studyLevelsNames, sizeof(studyLevelsNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &study_levels()
 {
-	AgesList list;
-	list.insert(0x0011000D, QT_TRANSLATE_NOOP("Age", "13-17"));
-	list.insert(0x00160012, QT_TRANSLATE_NOOP("Age", "18-22"));
-	list.insert(0x001D0017, QT_TRANSLATE_NOOP("Age", "23-29"));
-	list.insert(0x0027001E, QT_TRANSLATE_NOOP("Age", "30-39"));
-	list.insert(0x00310028, QT_TRANSLATE_NOOP("Age", "40-49"));
-	list.insert(0x003B0032, QT_TRANSLATE_NOOP("Age", "50-59"));
-	list.insert(0x2710003C, QT_TRANSLATE_NOOP("Age", "60-above"));
-	return list;
+	return studyLevelsTable;
 }
 
-const AgesList &ages()
+static const FieldName industriesNames[] = {
+	{ 2, QT_TRANSLATE_NOOP("Industry", "Agriculture") },
+	{ 3, QT_TRANSLATE_NOOP("Industry", "Arts") },
+	{ 4, QT_TRANSLATE_NOOP("Industry", "Construction") },
+	{ 5, QT_TRANSLATE_NOOP("Industry", "Consumer Goods") },
+	{ 6, QT_TRANSLATE_NOOP("Industry", "Corporate Services") },
+	{ 7, QT_TRANSLATE_NOOP("Industry", "Education") },
+	{ 8, QT_TRANSLATE_NOOP("Industry", "Finance") },
+	{ 9, QT_TRANSLATE_NOOP("Industry", "Government") },
+	{ 10, QT_TRANSLATE_NOOP("Industry", "High Tech") },
+	{ 11, QT_TRANSLATE_NOOP("Industry", "Legal") },
+	{ 12, QT_TRANSLATE_NOOP("Industry", "Manufacturing") },
+	{ 13, QT_TRANSLATE_NOOP("Industry", "Media") },
+	{ 14, QT_TRANSLATE_NOOP("Industry", "Medical & Health Care") },
+	{ 15, QT_TRANSLATE_NOOP("Industry", "Non-Profit Organization Management") },
+	{ 16, QT_TRANSLATE_NOOP("Industry", "Recreation, Travel & Entertainment") },
+	{ 17, QT_TRANSLATE_NOOP("Industry", "Service Industry") },
+	{ 18, QT_TRANSLATE_NOOP("Industry", "Transportation") },
+	{ 19, QT_TRANSLATE_NOOP("Industry", "Other") },
+};
+
+static const FieldNamesTable industriesTable = {
+	"Industry", industriesNames, sizeof(industriesNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &industries()
 {
-	static AgesList list = init_ages_list();
-	return list;
+	return industriesTable;
 }
 
-static FieldNamesList init_maritals_list()
+static const FieldName occupationsNames[] = {
+	{ 1, QT_TRANSLATE_NOOP("Occupation", "Academic") },
+	{ 2, QT_TRANSLATE_NOOP("Occupation", "Administrative") },
+	{ 3, QT_TRANSLATE_NOOP("Occupation", "Art/Entertainment") },
+	{ 4, QT_TRANSLATE_NOOP("Occupation", "College Student") },
+	{ 5, QT_TRANSLATE_NOOP("Occupation", "Computers") },
+	{ 6, QT_TRANSLATE_NOOP("Occupation", "Community & Social") },
+	{ 7, QT_TRANSLATE_NOOP("Occupation", "Education") },
+	{ 8, QT_TRANSLATE_NOOP("Occupation", "Engineering") },
+	{ 9, QT_TRANSLATE_NOOP("Occupation", "Financial Services") },
+	{ 10, QT_TRANSLATE_NOOP("Occupation", "Government") },
+	{ 11, QT_TRANSLATE_NOOP("Occupation", "High School Student") },
+	{ 12, QT_TRANSLATE_NOOP("Occupation", "Home") },
+	{ 13, QT_TRANSLATE_NOOP("Occupation", "ICQ - Providing Help") },
+	{ 14, QT_TRANSLATE_NOOP("Occupation", "Law") },
+	{ 15, QT_TRANSLATE_NOOP("Occupation", "Managerial") },
+	{ 16, QT_TRANSLATE_NOOP("Occupation", "Manufacturing") },
+	{ 17, QT_TRANSLATE_NOOP("Occupation", "Medical/Health") },
+	{ 18, QT_TRANSLATE_NOOP("Occupation", "Military") },
+	{ 19, QT_TRANSLATE_NOOP("Occupation", "Non-Government Organization") },
+	{ 20, QT_TRANSLATE_NOOP("Occupation", "Professional") },
+	{ 21, QT_TRANSLATE_NOOP("Occupation", "Retail") },
+	{ 22, QT_TRANSLATE_NOOP("Occupation", "Retired") },
+	{ 23, QT_TRANSLATE_NOOP("Occupation", "Science & Research") },
+	{ 24, QT_TRANSLATE_NOOP("Occupation", "Sports") },
+	{ 25, QT_TRANSLATE_NOOP("Occupation", "Technical") },
+	{ 26, QT_TRANSLATE_NOOP("Occupation", "University Student") },
+	{ 27, QT_TRANSLATE_NOOP("Occupation", "Web Building") },
+	{ 99, QT_TRANSLATE_NOOP("Occupation", "Other Services") },
+};
+
+static const FieldNamesTable occupationsTable = {
+	"Occupation", occupationsNames, sizeof(occupationsNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &occupations()
 {
-	FieldNamesList list;
-	list.insert(10, QT_TRANSLATE_NOOP("Marital", "Single"));
-	list.insert(11, QT_TRANSLATE_NOOP("Marital", "Close relationships"));
-	list.insert(12, QT_TRANSLATE_NOOP("Marital", "Engaged"));
-	list.insert(20, QT_TRANSLATE_NOOP("Marital", "Married"));
-	list.insert(30, QT_TRANSLATE_NOOP("Marital", "Divorced"));
-	list.insert(31, QT_TRANSLATE_NOOP("Marital", "Separated"));
-	list.insert(40, QT_TRANSLATE_NOOP("Marital", "Widowed"));
-	list.insert(50, QT_TRANSLATE_NOOP("Marital", "Open relationship"));
-	list.insert(255, QT_TRANSLATE_NOOP("Marital", "Other"));
-	return list;
+	return occupationsTable;
 }
 
-const FieldNamesList &maritals()
+static const FieldName affilationsNames[] = {
+	{ 200, QT_TRANSLATE_NOOP("Affiliation", "Alumni Org.") },
+	{ 201, QT_TRANSLATE_NOOP("Affiliation", "Charity Org.") },
+	{ 202, QT_TRANSLATE_NOOP("Affiliation", "Club/Social Org.") },
+	{ 203, QT_TRANSLATE_NOOP("Affiliation", "Community Org.") },
+	{ 204, QT_TRANSLATE_NOOP("Affiliation", "Cultural Org.") },
+	{ 205, QT_TRANSLATE_NOOP("Affiliation", "Fan Clubs") },
+	{ 206, QT_TRANSLATE_NOOP("Affiliation", "Fraternity/Sorority") },
+	{ 207, QT_TRANSLATE_NOOP("Affiliation", "Hobbyists Org.") },
+	{ 208, QT_TRANSLATE_NOOP("Affiliation", "International Org.") },
+	{ 209, QT_TRANSLATE_NOOP("Affiliation", "Nature and Environment Org.") },
+	{ 210, QT_TRANSLATE_NOOP("Affiliation", "Professional Org.") },
+	{ 211, QT_TRANSLATE_NOOP("Affiliation", "Scientific/Technical Org.") },
+	{ 212, QT_TRANSLATE_NOOP("Affiliation", "Self Improvement Group") },
+	{ 213, QT_TRANSLATE_NOOP("Affiliation", "Spiritual/Religious Org.") },
+	{ 214, QT_TRANSLATE_NOOP("Affiliation", "Sports Org.") },
+	{ 215, QT_TRANSLATE_NOOP("Affiliation", "Support Org.") },
+	{ 216, QT_TRANSLATE_NOOP("Affiliation", "Trade and Business Org.") },
+	{ 217, QT_TRANSLATE_NOOP("Affiliation", "Union") },
+	{ 218, QT_TRANSLATE_NOOP("Affiliation", "Volunteer Org.") },
+	{ 299, QT_TRANSLATE_NOOP("Affiliation", "Other") },
+};
+
+static const FieldNamesTable affilationsTable = {
+	"Affiliation", affilationsNames, sizeof(affilationsNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &affilations()
 {
-	static FieldNamesList list = init_maritals_list();
-	return list;
+	return affilationsTable;
 }
 
-static FieldNamesList init_fields_list()
+static const FieldName agesNames[] = {
+	{ 0x0011000D, QT_TRANSLATE_NOOP("Age", "13-17") },
+	{ 0x00160012, QT_TRANSLATE_NOOP("Age", "18-22") },
+	{ 0x001D0017, QT_TRANSLATE_NOOP("Age", "23-29") },
+	{ 0x0027001E, QT_TRANSLATE_NOOP("Age", "30-39") },
+	{ 0x00310028, QT_TRANSLATE_NOOP("Age", "40-49") },
+	{ 0x003B0032, QT_TRANSLATE_NOOP("Age", "50-59") },
+	{ 0x2710003C, QT_TRANSLATE_NOOP("Age", "60-above") },
+};
+
+static const FieldNamesTable agesTable = {
+	"Age", agesNames, sizeof(agesNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &ages()
 {
-	FieldNamesList list;
-	list.insert(Nick, QT_TRANSLATE_NOOP("MetaInfo", "Nick"));
-	list.insert(FirstName, QT_TRANSLATE_NOOP("MetaInfo", "First name"));
-	list.insert(LastName, QT_TRANSLATE_NOOP("MetaInfo", "Last name"));
-	list.insert(Email, QT_TRANSLATE_NOOP("MetaInfo", "Email"));
-	list.insert(HomeCity, QT_TRANSLATE_NOOP("MetaInfoHome", "City"));
-	list.insert(HomeState, QT_TRANSLATE_NOOP("MetaInfoHome", "State"));
-	list.insert(HomePhone, QT_TRANSLATE_NOOP("MetaInfoHome", "Phone"));
-	list.insert(HomeFax, QT_TRANSLATE_NOOP("MetaInfoHome", "Fax"));
-	list.insert(HomeAddress, QT_TRANSLATE_NOOP("MetaInfoHome", "Address"));
-	list.insert(CellPhone, QT_TRANSLATE_NOOP("MetaInfo", "Cell phone"));
-	list.insert(HomeZipCode, QT_TRANSLATE_NOOP("MetaInfoHome", "Zip code"));
-	list.insert(HomeCountry, QT_TRANSLATE_NOOP("MetaInfoHome", "Country"));
-	list.insert(GMT, QT_TRANSLATE_NOOP("MetaInfo", "GMT"));
-	list.insert(AuthFlag, QT_TRANSLATE_NOOP("MetaInfo", "Authorization"));
-	list.insert(WebawareFlag, QT_TRANSLATE_NOOP("MetaInfo", "Webaware"));
-	list.insert(DirectConnectionFlag, QT_TRANSLATE_NOOP("MetaInfo", "Direct connection"));
-	list.insert(PublishPrimaryEmailFlag, QT_TRANSLATE_NOOP("MetaInfo", "Public primary email"));
-	list.insert(Age, QT_TRANSLATE_NOOP("MetaInfo", "Age"));
-	list.insert(Gender, QT_TRANSLATE_NOOP("MetaInfo", "Gender"));
-	list.insert(Homepage, QT_TRANSLATE_NOOP("MetaInfo", "Homepage"));
-	list.insert(Birthday, QT_TRANSLATE_NOOP("MetaInfo", "Birthday"));
-	list.insert(Languages, QT_TRANSLATE_NOOP("MetaInfo", "Languages"));
-	list.insert(OriginalCity, QT_TRANSLATE_NOOP("MetaInfoOriginal", "City"));
-	list.insert(OriginalState, QT_TRANSLATE_NOOP("MetaInfoOriginal", "State"));
-	list.insert(OriginalCountry, QT_TRANSLATE_NOOP("MetaInfoOriginal", "Country"));
-	list.insert(WorkCity, QT_TRANSLATE_NOOP("MetaInfoWork", "City"));
-	list.insert(WorkState, QT_TRANSLATE_NOOP("MetaInfoWork", "State"));
-	list.insert(WorkPhone, QT_TRANSLATE_NOOP("MetaInfoWork", "Phone"));
-	list.insert(WorkFax, QT_TRANSLATE_NOOP("MetaInfoWork", "Fax"));
-	list.insert(WorkAddress, QT_TRANSLATE_NOOP("MetaInfoWork", "Address"));
-	list.insert(WorkZip, QT_TRANSLATE_NOOP("MetaInfoWork", "Zip"));
-	list.insert(WorkCountry, QT_TRANSLATE_NOOP("MetaInfoWork", "Country"));
-	list.insert(WorkCompany, QT_TRANSLATE_NOOP("MetaInfoWork", "Company"));
-	list.insert(WorkDepartment, QT_TRANSLATE_NOOP("MetaInfoWork", "Department"));
-	list.insert(WorkPosition, QT_TRANSLATE_NOOP("MetaInfoWork", "Position"));
-	list.insert(WorkOccupation, QT_TRANSLATE_NOOP("MetaInfoWork", "Occupation"));
-	list.insert(WorkWebpage, QT_TRANSLATE_NOOP("MetaInfoWork", "Webpage"));
-	list.insert(Emails, QT_TRANSLATE_NOOP("MetaInfo", "Emails"));
-	list.insert(Notes, QT_TRANSLATE_NOOP("MetaInfo", "Notes"));
-	list.insert(Interests, QT_TRANSLATE_NOOP("MetaInfo", "Interests"));
-	list.insert(Pasts, QT_TRANSLATE_NOOP("MetaInfo", "Pasts"));
-	list.insert(Affilations, QT_TRANSLATE_NOOP("MetaInfo", "Affilations"));
-	list.insert(Uin, QT_TRANSLATE_NOOP("MetaInfo", "UIN"));
-	list.insert(AgeRange, QT_TRANSLATE_NOOP("MetaInfo", "Age"));
-	list.insert(OnlineFlag, QT_TRANSLATE_NOOP("MetaInfo", "online only"));
-	return list;
+	return agesTable;
 }
 
-const FieldNamesList &fields()
+static const FieldName maritalsNames[] = {
+	{ 10, QT_TRANSLATE_NOOP("Marital", "Single") },
+	{ 11, QT_TRANSLATE_NOOP("Marital", "Close relationships") },
+	{ 12, QT_TRANSLATE_NOOP("Marital", "Engaged") },
+	{ 20, QT_TRANSLATE_NOOP("Marital", "Married") },
+	{ 30, QT_TRANSLATE_NOOP("Marital", "Divorced") },
+	{ 31, QT_TRANSLATE_NOOP("Marital", "Separated") },
+	{ 40, QT_TRANSLATE_NOOP("Marital", "Widowed") },
+	{ 50, QT_TRANSLATE_NOOP("Marital", "Open relationship") },
+	{ 255, QT_TRANSLATE_NOOP("Marital", "Other") },
+};
+
+static const FieldNamesTable maritalsTable = {
+	"Marital", maritalsNames, sizeof(maritalsNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &maritals()
 {
-	static FieldNamesList list = init_fields_list();
-	return list;
+	return maritalsTable;
 }
 
-static FieldNamesList init_fields_names_list()
+static const FieldName fieldsNames[] = {
+	{ Uin, QT_TRANSLATE_NOOP("MetaInfo", "UIN") },
+	{ Nick, QT_TRANSLATE_NOOP("MetaInfo", "Nick") },
+	{ FirstName, QT_TRANSLATE_NOOP("MetaInfo", "First name") },
+	{ LastName, QT_TRANSLATE_NOOP("MetaInfo", "Last name") },
+	{ Email, QT_TRANSLATE_NOOP("MetaInfo", "Email") },
+	{ HomeCity, QT_TRANSLATE_NOOP("MetaInfoHome", "City"), "MetaInfoHome" },
+	{ HomeState, QT_TRANSLATE_NOOP("MetaInfoHome", "State"), "MetaInfoHome" },
+	{ HomePhone, QT_TRANSLATE_NOOP("MetaInfoHome", "Phone"), "MetaInfoHome" },
+	{ HomeFax, QT_TRANSLATE_NOOP("MetaInfoHome", "Fax"), "MetaInfoHome" },
+	{ HomeAddress, QT_TRANSLATE_NOOP("MetaInfoHome", "Address"), "MetaInfoHome" },
+	{ CellPhone, QT_TRANSLATE_NOOP("MetaInfo", "Cell phone") },
+	{ HomeZipCode, QT_TRANSLATE_NOOP("MetaInfoHome", "Zip code"), "MetaInfoHome" },
+	{ HomeCountry, QT_TRANSLATE_NOOP("MetaInfoHome", "Country"), "MetaInfoHome" },
+	{ GMT, QT_TRANSLATE_NOOP("MetaInfo", "GMT") },
+	{ AuthFlag, QT_TRANSLATE_NOOP("MetaInfo", "Authorization") },
+	{ WebawareFlag, QT_TRANSLATE_NOOP("MetaInfo", "Webaware") },
+	{ DirectConnectionFlag, QT_TRANSLATE_NOOP("MetaInfo", "Direct connection") },
+	{ PublishPrimaryEmailFlag, QT_TRANSLATE_NOOP("MetaInfo", "Public primary email") },
+	{ Age, QT_TRANSLATE_NOOP("MetaInfo", "Age") },
+	{ Gender, QT_TRANSLATE_NOOP("MetaInfo", "Gender") },
+	{ Homepage, QT_TRANSLATE_NOOP("MetaInfo", "Homepage") },
+	{ Birthday, QT_TRANSLATE_NOOP("MetaInfo", "Birthday") },
+	{ Languages, QT_TRANSLATE_NOOP("MetaInfo", "Languages") },
+	{ OriginalCity, QT_TRANSLATE_NOOP("MetaInfoOriginal", "City"), "MetaInfoOriginal" },
+	{ OriginalState, QT_TRANSLATE_NOOP("MetaInfoOriginal", "State"), "MetaInfoOriginal" },
+	{ OriginalCountry, QT_TRANSLATE_NOOP("MetaInfoOriginal", "Country"), "MetaInfoOriginal" },
+	{ WorkCity, QT_TRANSLATE_NOOP("MetaInfoWork", "City"), "MetaInfoWork" },
+	{ WorkState, QT_TRANSLATE_NOOP("MetaInfoWork", "State"), "MetaInfoWork" },
+	{ WorkPhone, QT_TRANSLATE_NOOP("MetaInfoWork", "Phone"), "MetaInfoWork" },
+	{ WorkFax, QT_TRANSLATE_NOOP("MetaInfoWork", "Fax"), "MetaInfoWork" },
+	{ WorkAddress, QT_TRANSLATE_NOOP("MetaInfoWork", "Address"), "MetaInfoWork" },
+	{ WorkZip, QT_TRANSLATE_NOOP("MetaInfoWork", "Zip"), "MetaInfoWork" },
+	{ WorkCountry, QT_TRANSLATE_NOOP("MetaInfoWork", "Country"), "MetaInfoWork" },
+	{ WorkCompany, QT_TRANSLATE_NOOP("MetaInfoWork", "Company"), "MetaInfoWork" },
+	{ WorkDepartment, QT_TRANSLATE_NOOP("MetaInfoWork", "Department"), "MetaInfoWork" },
+	{ WorkPosition, QT_TRANSLATE_NOOP("MetaInfoWork", "Position"), "MetaInfoWork" },
+	{ WorkOccupation, QT_TRANSLATE_NOOP("MetaInfoWork", "Occupation"), "MetaInfoWork" },
+	{ WorkWebpage, QT_TRANSLATE_NOOP("MetaInfoWork", "Webpage"), "MetaInfoWork" },
+	{ Emails, QT_TRANSLATE_NOOP("MetaInfo", "Emails") },
+	{ Notes, QT_TRANSLATE_NOOP("MetaInfo", "Notes") },
+	{ Interests, QT_TRANSLATE_NOOP("MetaInfo", "Interests") },
+	{ Pasts, QT_TRANSLATE_NOOP("MetaInfo", "Pasts") },
+	{ Affilations, QT_TRANSLATE_NOOP("MetaInfo", "Affilations") },
+	{ AgeRange, QT_TRANSLATE_NOOP("MetaInfo", "Age") },
+	{ OnlineFlag, QT_TRANSLATE_NOOP("MetaInfo", "online only") },
+};
+
+static const FieldNamesTable fieldsTable = {
+	"MetaInfo", fieldsNames, sizeof(fieldsNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &fields()
 {
-	FieldNamesList list;
-	list.insert(Nick, "nick");
-	list.insert(FirstName, "firstName");
-	list.insert(LastName, "lastName");
-	list.insert(Email, "email");
-	list.insert(HomeCity, "homeCity");
-	list.insert(HomeState, "homeState");
-	list.insert(HomePhone, "homePhone");
-	list.insert(HomeFax, "homeFax");
-	list.insert(HomeAddress, "homeAddress");
-	list.insert(CellPhone, "cellPhone");
-	list.insert(HomeZipCode, "homeZipCode");
-	list.insert(HomeCountry, "homeCountry");
-	list.insert(GMT, "GMT");
-	list.insert(AuthFlag, "authFlag");
-	list.insert(WebawareFlag, "webawareFlag");
-	list.insert(DirectConnectionFlag, "directConnectionFlag");
-	list.insert(PublishPrimaryEmailFlag, "puslishPrimaryEmailFlag");
-	list.insert(Age, "age");
-	list.insert(Gender, "gender");
-	list.insert(Homepage, "homepage");
-	list.insert(Birthday, "birthday");
-	list.insert(Languages, "languages");
-	list.insert(OriginalCity, "originalCity");
-	list.insert(OriginalState, "originalState");
-	list.insert(OriginalCountry, "originalCountry");
-	list.insert(WorkCity, "workCity");
-	list.insert(WorkState, "workState");
-	list.insert(WorkPhone, "workPhone");
-	list.insert(WorkFax, "workFax");
-	list.insert(WorkAddress, "workAddress");
-	list.insert(WorkZip, "workZip");
-	list.insert(WorkCountry, "workCountry");
-	list.insert(WorkCompany, "workCompany");
-	list.insert(WorkDepartment, "workDepartment");
-	list.insert(WorkPosition, "workPosition");
-	list.insert(WorkOccupation, "workOccupation");
-	list.insert(WorkWebpage, "workWebpage");
-	list.insert(Emails, "emails");
-	list.insert(Notes, "notes");
-	list.insert(Interests, "interests");
-	list.insert(Pasts, "pasts");
-	list.insert(Affilations, "affilations");
-	list.insert(Uin, "uin");
-	list.insert(AgeRange, "ages");
-	list.insert(OnlineFlag, "online");
-	return list;
+	return fieldsTable;
 }
 
-const FieldNamesList &fields_names()
+static const FieldName fieldIdsNames[] = {
+	{ Uin, "uin" },
+	{ Nick, "nick" },
+	{ FirstName, "firstName" },
+	{ LastName, "lastName" },
+	{ Email, "email" },
+	{ HomeCity, "homeCity" },
+	{ HomeState, "homeState" },
+	{ HomePhone, "homePhone" },
+	{ HomeFax, "homeFax" },
+	{ HomeAddress, "homeAddress" },
+	{ CellPhone, "cellPhone" },
+	{ HomeZipCode, "homeZipCode" },
+	{ HomeCountry, "homeCountry" },
+	{ GMT, "GMT" },
+	{ AuthFlag, "authFlag" },
+	{ WebawareFlag, "webawareFlag" },
+	{ DirectConnectionFlag, "directConnectionFlag" },
+	{ PublishPrimaryEmailFlag, "puslishPrimaryEmailFlag" },
+	{ Age, "age" },
+	{ Gender, "gender" },
+	{ Homepage, "homepage" },
+	{ Birthday, "birthday" },
+	{ Languages, "languages" },
+	{ OriginalCity, "originalCity" },
+	{ OriginalState, "originalState" },
+	{ OriginalCountry, "originalCountry" },
+	{ WorkCity, "workCity" },
+	{ WorkState, "workState" },
+	{ WorkPhone, "workPhone" },
+	{ WorkFax, "workFax" },
+	{ WorkAddress, "workAddress" },
+	{ WorkZip, "workZip" },
+	{ WorkCountry, "workCountry" },
+	{ WorkCompany, "workCompany" },
+	{ WorkDepartment, "workDepartment" },
+	{ WorkPosition, "workPosition" },
+	{ WorkOccupation, "workOccupation" },
+	{ WorkWebpage, "workWebpage" },
+	{ Emails, "emails" },
+	{ Notes, "notes" },
+	{ Interests, "interests" },
+	{ Pasts, "pasts" },
+	{ Affilations, "affilations" },
+	{ AgeRange, "ages" },
+	{ OnlineFlag, "online" },
+};
+
+static const FieldNamesTable fieldIdsTable = {
+	0, fieldIdsNames, sizeof(fieldIdsNames) / sizeof(FieldName)
+};
+
+const FieldNamesTable &fields_names()
 {
-	static FieldNamesList list = init_fields_names_list();
-	return list;
+	return fieldIdsTable;
 }
 
 } // namespace Ireen
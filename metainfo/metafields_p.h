@@ -30,18 +30,43 @@
 
 namespace Ireen {
 
-const FieldNamesList &countries();
-const FieldNamesList &interests();
-const FieldNamesList &languages();
-const FieldNamesList &pasts();
-const FieldNamesList &genders();
-const FieldNamesList &study_levels();
-const FieldNamesList &industries();
-const FieldNamesList &occupations();
-const FieldNamesList &affilations();
-const AgesList &ages();
-const FieldNamesList &fields();
-const FieldNamesList &fields_names();
+struct FieldName
+{
+	quint32 code;
+	const char *text;
+	// If it is null, the context of the table is used
+	const char *context;
+};
+
+// The lookup table for the protocol codes; the names are kept as
+// static strings and converted to QString only on the access.
+struct FieldNamesTable
+{
+	const char *context;
+	const FieldName *names;
+	int count;
+
+	bool contains(quint32 code) const { return find(code) != 0; }
+	// Returns the untranslated name of the code
+	QString value(quint32 code) const;
+	QString translatedValue(quint32 code) const;
+	quint32 key(const QString &text, quint32 defaultKey = 0) const;
+private:
+	const FieldName *find(quint32 code) const;
+};
+
+const FieldNamesTable &countries();
+const FieldNamesTable &interests();
+const FieldNamesTable &languages();
+const FieldNamesTable &pasts();
+const FieldNamesTable &genders();
+const FieldNamesTable &study_levels();
+const FieldNamesTable &industries();
+const FieldNamesTable &occupations();
+const FieldNamesTable &affilations();
+const FieldNamesTable &ages();
+const FieldNamesTable &fields();
+const FieldNamesTable &fields_names();
 
 } // namespace Ireen
 
@@ -38,17 +38,141 @@ void MetaInfoPrivate::addRequest(AbstractMetaRequest *request)
 
 bool MetaInfoPrivate::removeRequest(AbstractMetaRequest *request)
 {
+	cachedReplies.remove(request->id());
 	return requests.remove(request->id()) > 0;
 }
 
+QByteArray MetaInfoPrivate::cacheKey(quint16 type, const QByteArray &data)
+{
+	DataUnit key;
+	key.append<quint16>(type, LittleEndian);
+	key.append(data);
+	return key.data();
+}
+
+bool MetaInfoPrivate::replayCached(AbstractMetaRequest *request, const QByteArray &key)
+{
+	MetaInfoCacheEntry *entry = cache.object(key);
+	if (!entry)
+		return false;
+	if (entry->time.secsTo(QDateTime::currentDateTime()) >= cacheTimeout) {
+		cache.remove(key);
+		return false;
+	}
+	debug(MetaInfoDebug, DebugVerbose) << "Metainfo request" << request->id() << "is answered from the cache";
+	// The reply is delivered from the event loop, as the server one would be,
+	// so the caller has a chance to connect to the request after sending it
+	if (cachedReplies.isEmpty())
+		QMetaObject::invokeMethod(q, "replayCachedReplies", Qt::QueuedConnection);
+	cachedReplies.insert(request->id(), entry->packets);
+	addRequest(request);
+	return true;
+}
+
+void MetaInfoPrivate::replayCachedReplies()
+{
+	QHash<quint16, QList<MetaInfoPacket> > replies = cachedReplies;
+	cachedReplies.clear();
+	QHash<quint16, QList<MetaInfoPacket> >::const_iterator itr = replies.constBegin();
+	for (; itr != replies.constEnd(); ++itr) {
+		// The request could be closed by the handlers of the previous ones
+		AbstractMetaRequest *request = requests.value(itr.key());
+		if (!request)
+			continue;
+		foreach (const MetaInfoPacket &packet, *itr)
+			request->handleData(packet.first, DataUnit(packet.second));
+		if (requests.value(itr.key()) == request && !request->isDone())
+			request->close(true);
+	}
+}
+
+bool MetaInfoPrivate::attachRequest(AbstractMetaRequest *request, const QByteArray &key)
+{
+	QHash<QByteArray, SharedMetaRequest>::iterator itr = sharedRequests.find(key);
+	if (itr == sharedRequests.end())
+		return false;
+	debug(MetaInfoDebug, DebugVerbose) << "Metainfo request" << request->id()
+						<< "waits for the reply to" << itr->leader->id();
+	// The packets that have been already received
+	foreach (const MetaInfoPacket &packet, itr->packets)
+		request->handleData(packet.first, DataUnit(packet.second));
+	itr->followers << request;
+	addRequest(request);
+	return true;
+}
+
+void MetaInfoPrivate::startSharedRequest(AbstractMetaRequest *request, const QByteArray &key)
+{
+	SharedMetaRequest &shared = sharedRequests[key];
+	shared.leader = request;
+	shared.followers.clear();
+	shared.packets.clear();
+}
+
+void MetaInfoPrivate::dispatchData(AbstractMetaRequest *request, quint16 type, const QByteArray &data)
+{
+	const QByteArray &key = request->d_func()->cacheKey;
+	if (!key.isEmpty()) {
+		QHash<QByteArray, SharedMetaRequest>::iterator itr = sharedRequests.find(key);
+		if (itr != sharedRequests.end() && itr->leader == request) {
+			itr->packets << MetaInfoPacket(type, data);
+			// Followers could be closed by the packet, so iterate over the copy
+			QList<AbstractMetaRequest*> followers = itr->followers;
+			foreach (AbstractMetaRequest *follower, followers)
+				follower->handleData(type, DataUnit(data));
+		}
+	}
+	if (!request->handleData(type, DataUnit(data)))
+		debug(MetaInfoDebug) << "Unexpected metainfo response with type" << hex << type;
+}
+
+void MetaInfoPrivate::finishRequest(AbstractMetaRequest *request, bool ok,
+									AbstractMetaRequest::ErrorType error, const QString &errorString)
+{
+	const QByteArray &key = request->d_func()->cacheKey;
+	if (key.isEmpty())
+		return;
+	QHash<QByteArray, SharedMetaRequest>::iterator itr = sharedRequests.find(key);
+	if (itr == sharedRequests.end())
+		return;
+	if (itr->leader != request) {
+		itr->followers.removeOne(request);
+		return;
+	}
+	SharedMetaRequest shared = *itr;
+	sharedRequests.erase(itr);
+	if (ok && cacheTimeout > 0) {
+		MetaInfoCacheEntry *entry = new MetaInfoCacheEntry;
+		entry->packets = shared.packets;
+		entry->time = QDateTime::currentDateTime();
+		cache.insert(key, entry);
+	}
+	foreach (AbstractMetaRequest *follower, shared.followers) {
+		if (!requests.contains(follower->id()))
+			continue; // The follower is already closed
+		if (error == AbstractMetaRequest::Canceled) {
+			// Only the sent request has been canceled, others are still
+			// waiting for the reply, so the first of them takes its place.
+			removeRequest(follower);
+			follower->send();
+		} else {
+			follower->close(ok, error, errorString);
+		}
+	}
+}
+
 MetaInfo::MetaInfo(Client *client) :
 	d(new MetaInfoPrivate)
 {
+	d->q = this;
 	d->sequence = 0;
 	d->client = client;
-	m_infos << SNACInfo(ExtensionsFamily, ExtensionsMetaSrvReply)
-			<< SNACInfo(ExtensionsFamily, ExtensionsMetaError);
+	d->cacheTimeout = 300;
+	d->cache.setMaxCost(1000);
+	m_infos << SNACInfo(ExtensionsFamily, ExtensionsMetaError);
+	m_metaTypes << 0x07da;
 	client->registerHandler(this);
+	client->registerMetaReplyHandler(this);
 	connect(client, SIGNAL(disconnected()),
 			SLOT(onDisconnected()));
 }
@@ -62,36 +186,49 @@ Client *MetaInfo::client() const
 	return d->client;
 }
 
+void MetaInfo::setCacheTimeout(int secs)
+{
+	d->cacheTimeout = secs;
+	if (secs <= 0)
+		d->cache.clear();
+}
+
+int MetaInfo::cacheTimeout() const
+{
+	return d->cacheTimeout;
+}
+
+void MetaInfo::setCacheSize(int maxEntries)
+{
+	d->cache.setMaxCost(maxEntries);
+}
+
+int MetaInfo::cacheSize() const
+{
+	return d->cache.maxCost();
+}
+
+void MetaInfo::clearCache(const QString &uin)
+{
+	if (uin.isEmpty()) {
+		d->cache.clear();
+		return;
+	}
+	// Info requests contain the uin right after the request type
+	DataUnit uinData;
+	uinData.append<quint32>(uin.toUInt(), LittleEndian);
+	foreach (const QByteArray &key, d->cache.keys()) {
+		if (key.mid(2, 4) == uinData.data())
+			d->cache.remove(key);
+	}
+}
+
 void MetaInfo::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 {
 	Q_UNUSED(conn);
-	if (snac.family() == ExtensionsFamily && snac.subtype() == ExtensionsMetaSrvReply) {
-		TLVMap tlvs = snac.read<TLVMap>();
-		if (tlvs.contains(0x01)) {
-			DataUnit data(tlvs.value(0x01));
-			data.skipData(6); // skip field length + my uin
-			quint16 metaType = data.read<quint16>(LittleEndian);
-			if (metaType == 0x07da) {
-				quint16 reqNumber = data.read<quint16>(LittleEndian);
-				QHash<quint16, AbstractMetaRequest*>::iterator itr = d->requests.find(reqNumber);
-				quint16 dataType = data.read<quint16>(LittleEndian);
-				quint8 success = data.read<quint8>(LittleEndian);
-				if (itr == d->requests.end()) {
-					debug() << "Unexpected metainfo response" << reqNumber;
-					return;
-				}
-				if (success == 0x0a) {
-					if (!itr.value()->handleData(dataType, data))
-						debug() << "Unexpected metainfo response with type" << hex << dataType;
-				} else {
-					debug() << "Meta request failed" << hex << success;
-					itr.value()->close(false, AbstractMetaRequest::ProtocolError, tr("Incorrect format of the metarequest"));
-				}
-			}
-		}
-	} else if (snac.family() == ExtensionsFamily && snac.subtype() == ExtensionsMetaError) {
+	if (snac.family() == ExtensionsFamily && snac.subtype() == ExtensionsMetaError) {
 		ProtocolError error(snac);
-		debug() << QString("MetaInfo service error (%1, %2): %3")
+		debug(MetaInfoDebug) << QString("MetaInfo service error (%1, %2): %3")
 				.arg(error.code(), 2, 16)
 				.arg(error.subcode(), 2, 16)
 				.arg(error.errorString());
@@ -99,8 +236,8 @@ void MetaInfo::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 			DataUnit data(error.tlvs().value(0x21));
 			data.skipData(6); // skip field length + my uin
 			quint16 metaType = data.read<quint16>(LittleEndian);
-			if (metaType == 0x07d0) {
-				quint16 reqNumber = data.read<quint16>(LittleEndian);
+			quint16 reqNumber = data.read<quint16>(LittleEndian);
+			if (!data.hasError() && metaType == 0x07d0) {
 				AbstractMetaRequest *request = d->requests.value(reqNumber);
 				if (request) {
 					request->close(false, AbstractMetaRequest::ProtocolError, error.errorString());
@@ -110,6 +247,29 @@ void MetaInfo::handleSNAC(AbstractConnection *conn, const SNAC &snac)
 	}
 }
 
+void MetaInfo::handleMetaReply(const MetaReply &reply)
+{
+	Q_ASSERT(reply.type == 0x07da);
+	QHash<quint16, AbstractMetaRequest*>::iterator itr = d->requests.find(reply.sequence);
+	if (itr == d->requests.end()) {
+		debug(MetaInfoDebug) << "Unexpected metainfo response" << reply.sequence;
+		return;
+	}
+	quint16 dataType = reply.data.read<quint16>(LittleEndian);
+	quint8 success = reply.data.read<quint8>(LittleEndian);
+	if (!reply.data.hasError() && success == 0x0a) {
+		d->dispatchData(itr.value(), dataType, reply.data.readData(reply.data.dataSize()));
+	} else {
+		debug(MetaInfoDebug) << "Meta request failed" << hex << success;
+		itr.value()->close(false, AbstractMetaRequest::ProtocolError, tr("Incorrect format of the metarequest"));
+	}
+}
+
+void MetaInfo::replayCachedReplies()
+{
+	d->replayCachedReplies();
+}
+
 void MetaInfo::onDisconnected()
 {
 	QHash<quint16, AbstractMetaRequest*> requests = d->requests;
@@ -28,6 +28,7 @@
 
 #include "../ireen_global.h"
 #include "../core/snachandler.h"
+#include "../core/metareplyhandler.h"
 #include <QScopedPointer>
 
 namespace Ireen {
@@ -35,20 +36,31 @@ namespace Ireen {
 class Client;
 class MetaInfoPrivate;
 
-class MetaInfo : public QObject, public SNACHandler
+class MetaInfo : public QObject, public SNACHandler, public MetaReplyHandler
 {
 	Q_OBJECT
-	Q_INTERFACES(Ireen::SNACHandler)
+	Q_INTERFACES(Ireen::SNACHandler Ireen::MetaReplyHandler)
 public:
 	MetaInfo(Client *client);
 	~MetaInfo();
 	Client *client() const;
+	// Replies to identical info requests are reused for the given number of seconds.
+	// Both the short and the full info of a uin are cached, as separate entries
+	// with the same lifetime. Zero timeout disables the cache.
+	void setCacheTimeout(int secs);
+	int cacheTimeout() const;
+	void setCacheSize(int maxEntries);
+	int cacheSize() const;
+	void clearCache(const QString &uin = QString());
 protected:
 	void handleSNAC(AbstractConnection *conn, const SNAC &snac);
+	void handleMetaReply(const MetaReply &reply);
 private slots:
+	void replayCachedReplies();
 	void onDisconnected();
 private:
 	friend class AbstractMetaRequest;
+	friend class MetaInfoPrivate;
 	QScopedPointer<MetaInfoPrivate> d;
 };
 
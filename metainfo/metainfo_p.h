@@ -29,19 +29,52 @@
 #include "metainfo.h"
 #include "abstractmetarequest_p.h"
 #include "../client.h"
+#include <QCache>
+#include <QDateTime>
 
 namespace Ireen {
 
+typedef QPair<quint16, QByteArray> MetaInfoPacket;
+
+struct MetaInfoCacheEntry
+{
+	QList<MetaInfoPacket> packets;
+	QDateTime time;
+};
+
+// The request that has been sent to the server and the requests
+// that wait for the same reply.
+struct SharedMetaRequest
+{
+	AbstractMetaRequest *leader;
+	QList<AbstractMetaRequest*> followers;
+	QList<MetaInfoPacket> packets;
+};
+
 class MetaInfoPrivate
 {
 public:
 	void addRequest(AbstractMetaRequest *request);
 	bool removeRequest(AbstractMetaRequest *request);
 	quint16 nextId() { return ++sequence; }
+	static QByteArray cacheKey(quint16 type, const QByteArray &data);
+	bool replayCached(AbstractMetaRequest *request, const QByteArray &key);
+	void replayCachedReplies();
+	bool attachRequest(AbstractMetaRequest *request, const QByteArray &key);
+	void startSharedRequest(AbstractMetaRequest *request, const QByteArray &key);
+	void dispatchData(AbstractMetaRequest *request, quint16 type, const QByteArray &data);
+	void finishRequest(AbstractMetaRequest *request, bool ok, AbstractMetaRequest::ErrorType error,
+					   const QString &errorString);
 public:
+	MetaInfo *q;
 	quint16 sequence;
 	Client *client;
 	QHash<quint16, AbstractMetaRequest*> requests;
+	QHash<QByteArray, SharedMetaRequest> sharedRequests;
+	QCache<QByteArray, MetaInfoCacheEntry> cache;
+	// The cached replies waiting to be delivered to their requests, by request ids
+	QHash<quint16, QList<MetaInfoPacket> > cachedReplies;
+	int cacheTimeout;
 };
 
 } // namespace Ireen
@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "metainfovalues_p.h"
+#include "metafields_p.h"
+#include <QDate>
+
+namespace Ireen {
+
+MetaInfoValuesPrivate::FieldType MetaInfoValuesPrivate::fieldType(MetaFieldEnum field)
+{
+	switch (field) {
+	case HomeCountry:
+	case OriginalCountry:
+	case WorkCountry:
+	case WorkOccupation:
+	case Gender:
+		return CodeField;
+	case AuthFlag:
+	case WebawareFlag:
+	case DirectConnectionFlag:
+	case PublishPrimaryEmailFlag:
+		return FlagField;
+	case GMT:
+	case Age:
+		return NumberField;
+	case Birthday:
+		return DateField;
+	case Emails:
+		return StringListField;
+	case Languages:
+		return CodeListField;
+	case Interests:
+	case Pasts:
+	case Affilations:
+		return CategoryListField;
+	default:
+		return StringField;
+	}
+}
+
+const FieldNamesTable *MetaInfoValuesPrivate::fieldTable(MetaFieldEnum field)
+{
+	switch (field) {
+	case HomeCountry:
+	case OriginalCountry:
+	case WorkCountry:
+		return &countries();
+	case WorkOccupation:
+		return &occupations();
+	case Gender:
+		return &genders();
+	case Languages:
+		return &languages();
+	case Interests:
+		return &interests();
+	case Pasts:
+		return &pasts();
+	case Affilations:
+		return &affilations();
+	default:
+		return 0;
+	}
+}
+
+MetaInfoValuesPrivate::StringRef MetaInfoValuesPrivate::addString(const QString &str)
+{
+	StringRef ref;
+	ref.offset = arena.size();
+	ref.size = str.size();
+	arena += str;
+	return ref;
+}
+
+void MetaInfoValuesPrivate::setString(MetaFieldEnum field, const QString &str)
+{
+	Q_ASSERT(field < SlotsCount);
+	strings[field] = addString(str);
+	setPresent(field);
+}
+
+void MetaInfoValuesPrivate::setNumber(MetaFieldEnum field, qint32 number)
+{
+	Q_ASSERT(field < SlotsCount);
+	numbers[field] = number;
+	setPresent(field);
+}
+
+void MetaInfoValuesPrivate::addItem(MetaFieldEnum field, quint16 code, const QString &str)
+{
+	Q_ASSERT(field < SlotsCount);
+	Item item;
+	item.field = field;
+	item.code = code;
+	item.str = addString(str);
+	items.append(item);
+	setPresent(field);
+}
+
+MetaInfoValues::MetaInfoValues() :
+	d(new MetaInfoValuesPrivate)
+{
+}
+
+MetaInfoValues::MetaInfoValues(const MetaInfoValues &other) :
+	d(other.d)
+{
+}
+
+MetaInfoValues::~MetaInfoValues()
+{
+}
+
+MetaInfoValues &MetaInfoValues::operator=(const MetaInfoValues &rhs)
+{
+	d = rhs.d;
+	return *this;
+}
+
+bool MetaInfoValues::isEmpty() const
+{
+	return d->present == 0;
+}
+
+bool MetaInfoValues::contains(MetaFieldEnum field) const
+{
+	return d->contains(field);
+}
+
+QString MetaInfoValues::string(MetaFieldEnum field) const
+{
+	if (!d->contains(field))
+		return QString();
+	switch (MetaInfoValuesPrivate::fieldType(field)) {
+	case MetaInfoValuesPrivate::StringField:
+		return d->string(d->strings[field]);
+	case MetaInfoValuesPrivate::CodeField:
+		return MetaInfoValuesPrivate::fieldTable(field)->value(d->numbers[field]);
+	default:
+		return QString();
+	}
+}
+
+bool MetaInfoValues::flag(MetaFieldEnum field) const
+{
+	return d->contains(field) && MetaInfoValuesPrivate::fieldType(field) == MetaInfoValuesPrivate::FlagField
+			&& d->numbers[field];
+}
+
+int MetaInfoValues::number(MetaFieldEnum field) const
+{
+	if (!d->contains(field))
+		return 0;
+	MetaInfoValuesPrivate::FieldType type = MetaInfoValuesPrivate::fieldType(field);
+	if (type != MetaInfoValuesPrivate::NumberField && type != MetaInfoValuesPrivate::CodeField)
+		return 0;
+	return d->numbers[field];
+}
+
+QDate MetaInfoValues::date(MetaFieldEnum field) const
+{
+	if (!d->contains(field) || MetaInfoValuesPrivate::fieldType(field) != MetaInfoValuesPrivate::DateField)
+		return QDate();
+	return QDate::fromJulianDay(d->numbers[field]);
+}
+
+QStringList MetaInfoValues::stringList(MetaFieldEnum field) const
+{
+	QStringList list;
+	if (!d->contains(field))
+		return list;
+	const FieldNamesTable *table = MetaInfoValuesPrivate::fieldTable(field);
+	foreach (const MetaInfoValuesPrivate::Item &item, d->items) {
+		if (item.field != field)
+			continue;
+		if (table)
+			list << table->value(item.code);
+		else
+			list << d->string(item.str);
+	}
+	return list;
+}
+
+CategoryList MetaInfoValues::categories(MetaFieldEnum field) const
+{
+	CategoryList list;
+	if (!d->contains(field) || MetaInfoValuesPrivate::fieldType(field) != MetaInfoValuesPrivate::CategoryListField)
+		return list;
+	const FieldNamesTable *table = MetaInfoValuesPrivate::fieldTable(field);
+	Category category;
+	foreach (const MetaInfoValuesPrivate::Item &item, d->items) {
+		if (item.field != field)
+			continue;
+		category.category = table->value(item.code);
+		category.keyword = d->string(item.str);
+		list << category;
+	}
+	return list;
+}
+
+QVariant MetaInfoValues::value(MetaFieldKey key, const QVariant &defaultValue) const
+{
+	MetaFieldEnum field = key.value();
+	if (!d->contains(field))
+		return defaultValue;
+	switch (MetaInfoValuesPrivate::fieldType(field)) {
+	case MetaInfoValuesPrivate::StringField:
+	case MetaInfoValuesPrivate::CodeField:
+		return string(field);
+	case MetaInfoValuesPrivate::FlagField:
+		return flag(field);
+	case MetaInfoValuesPrivate::NumberField:
+		return number(field);
+	case MetaInfoValuesPrivate::DateField:
+		return date(field);
+	case MetaInfoValuesPrivate::StringListField:
+	case MetaInfoValuesPrivate::CodeListField:
+		return stringList(field);
+	case MetaInfoValuesPrivate::CategoryListField:
+		return QVariant::fromValue(categories(field));
+	}
+	return defaultValue;
+}
+
+MetaInfoValuesHash MetaInfoValues::toHash() const
+{
+	MetaInfoValuesHash hash;
+	for (int i = 0; i < MetaInfoValuesPrivate::SlotsCount; ++i) {
+		MetaFieldEnum field = static_cast<MetaFieldEnum>(i);
+		if (d->contains(field))
+			hash.insert(field, value(field));
+	}
+	return hash;
+}
+
+} // namespace Ireen
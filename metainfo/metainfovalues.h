@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_METAINFOVALUES_H
+#define IREEN_METAINFOVALUES_H
+
+#include <QSharedDataPointer>
+#include <QStringList>
+#include <QVariant>
+#include "metafield.h"
+
+class QDate;
+
+namespace Ireen {
+
+class MetaInfoValuesPrivate;
+
+// The result of the information requests.
+//
+// Unlike MetaInfoValuesHash, the fields from Nick to Affilations are kept
+// in fixed slots: strings share one buffer and the fields which contain
+// protocol codes (countries, languages, interests, etc) are converted
+// to names only when they are accessed.
+class IREEN_EXPORT MetaInfoValues
+{
+public:
+	MetaInfoValues();
+	MetaInfoValues(const MetaInfoValues &other);
+	~MetaInfoValues();
+	MetaInfoValues &operator=(const MetaInfoValues &rhs);
+	bool isEmpty() const;
+	bool contains(MetaFieldEnum field) const;
+	// The value of a string field or the name of a coded field
+	QString string(MetaFieldEnum field) const;
+	bool flag(MetaFieldEnum field) const;
+	// The value of a numeric field or the protocol code of a coded field
+	int number(MetaFieldEnum field) const;
+	QDate date(MetaFieldEnum field) const;
+	// Emails and Languages
+	QStringList stringList(MetaFieldEnum field) const;
+	// Interests, Pasts and Affilations
+	CategoryList categories(MetaFieldEnum field) const;
+	QVariant value(MetaFieldKey key, const QVariant &defaultValue = QVariant()) const;
+	MetaInfoValuesHash toHash() const;
+private:
+	friend class ShortInfoMetaRequestPrivate;
+	QSharedDataPointer<MetaInfoValuesPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_METAINFOVALUES_H
@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_METAINFOVALUES_P_H
+#define IREEN_METAINFOVALUES_P_H
+
+#include "metainfovalues.h"
+#include <QVector>
+
+namespace Ireen {
+
+struct FieldNamesTable;
+
+class MetaInfoValuesPrivate : public QSharedData
+{
+public:
+	static const int SlotsCount = LastMetaField + 1;
+	enum FieldType {
+		StringField,
+		CodeField,
+		FlagField,
+		NumberField,
+		DateField,
+		StringListField,
+		CodeListField,
+		CategoryListField
+	};
+	struct StringRef
+	{
+		int offset;
+		int size;
+	};
+	// An element of Emails, Languages, Interests, Pasts or Affilations
+	struct Item
+	{
+		quint8 field;
+		quint16 code;
+		StringRef str;
+	};
+
+	MetaInfoValuesPrivate() : present(0) {}
+	static FieldType fieldType(MetaFieldEnum field);
+	static const FieldNamesTable *fieldTable(MetaFieldEnum field);
+	bool contains(MetaFieldEnum field) const
+	{ return field < SlotsCount && (present & (Q_UINT64_C(1) << field)); }
+	QString string(const StringRef &ref) const { return arena.mid(ref.offset, ref.size); }
+	void setString(MetaFieldEnum field, const QString &str);
+	void setNumber(MetaFieldEnum field, qint32 number);
+	void addItem(MetaFieldEnum field, quint16 code, const QString &str = QString());
+
+	quint64 present;
+	qint32 numbers[SlotsCount];
+	StringRef strings[SlotsCount];
+	QVector<Item> items;
+	QString arena;
+private:
+	StringRef addString(const QString &str);
+	void setPresent(MetaFieldEnum field) { present |= Q_UINT64_C(1) << field; }
+};
+
+} // namespace Ireen
+
+#endif // IREEN_METAINFOVALUES_P_H
@@ -59,7 +59,7 @@ void TlvBasedMetaRequestPrivate::addField(quint16 id, MetaFieldEnum key, DataUni
 }
 
 template <typename T>
-void TlvBasedMetaRequestPrivate::addCategoryId(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesList &list) const
+void TlvBasedMetaRequestPrivate::addCategoryId(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesTable &list) const
 {
 	if (values.contains(key)) {
 		QStringList d = values.value(key).toStringList();
@@ -78,7 +78,7 @@ void TlvBasedMetaRequestPrivate::addCategoryId(quint16 id, MetaFieldEnum key, Da
 	}
 }
 
-void TlvBasedMetaRequestPrivate::addCategory(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesList &list) const
+void TlvBasedMetaRequestPrivate::addCategory(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesTable &list) const
 {
 	if (values.contains(key)) {
 		QVariant val = values.value(key);
@@ -32,6 +32,8 @@
 
 namespace Ireen {
 
+struct FieldNamesTable;
+
 class TlvBasedMetaRequestPrivate : public AbstractMetaRequestPrivate
 {
 public:
@@ -40,8 +42,8 @@ public:
 	template <typename T>
 	void addField(quint16 id, MetaFieldEnum key, DataUnit &data, bool test = true) const;
 	template <typename T>
-	void addCategoryId(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesList &list) const;
-	void addCategory(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesList &list) const;
+	void addCategoryId(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesTable &list) const;
+	void addCategory(quint16 id, MetaFieldEnum key, DataUnit &data, const FieldNamesTable &list) const;
 	MetaInfoValuesHash values;
 };
 
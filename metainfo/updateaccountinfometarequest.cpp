@@ -25,6 +25,8 @@
 
 #include "updateaccountinfometarequest.h"
 #include "tlvbasedmetarequest_p.h"
+#include "metainfo.h"
+#include "../client.h"
 
 namespace Ireen {
 
@@ -49,7 +51,8 @@ bool UpdateAccountInfoMetaRequest::handleData(quint16 type, const DataUnit &data
 {
 	Q_UNUSED(data);
 	if (type == 0x0c3f) {
-		debug() << "Account info successfully has been updated";
+		debug(MetaInfoDebug) << "Account info successfully has been updated";
+		d_func()->metaInfo->clearCache(client()->uin());
 		emit infoUpdated();
 		return true;
 	}
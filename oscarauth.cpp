@@ -30,6 +30,15 @@
 #include <QNetworkReply>
 #include <QUrl>
 #include <QNetworkProxy>
+#include <QSettings>
+#include <QMutex>
+#include <QThreadStorage>
+#include <QThread>
+#include <QCoreApplication>
+#include <QBasicTimer>
+#include <QTimerEvent>
+#include <QFile>
+#include <QSet>
 #if defined(OSCAR_USE_3RDPARTY_HMAC)
 #ifdef Q_OS_HAIKU
 # define SHA2_TYPES
@@ -41,7 +50,7 @@
 # error Oscar authorization module depends on hmac-sha256 support
 #endif
 
-#include "k8json/k8json.h"
+#include "jsonreader.h"
 
 #define ICQ_LOGIN_URL "https://api.login.icq.net/auth/clientLogin"
 #define ICQ_START_SESSION_URL "http://api.icq.net/aim/startOSCARSession"
@@ -80,29 +89,51 @@ public:
 	AbstractConnection::ConnectionError error() const;
 	QString resultString() const;
 	int detailCode() const;
-	QVariantMap rawResult() const;
-	QVariantMap data() const;
+	// The field of the response data, like "token/a"
+	QVariant data(const char *name) const;
 private:
-	QVariantMap m_data;
+	QHash<QByteArray, QVariant> m_fields;
 	ResultCode m_result;
 	QString m_resultString;
-	QVariantMap m_rawResult;
 	int m_detailCode;
 };
 
+// The only fields of the replies which are used
+struct OscarResponseFields : public QSet<QByteArray>
+{
+	OscarResponseFields()
+	{
+		static const char * const fields[] = {
+			"response/statusCode",
+			"response/statusDetailCode",
+			"response/statusText",
+			// clientLogin
+			"response/data/token/a",
+			"response/data/token/expiresIn",
+			"response/data/token/sessionSecret",
+			"response/data/token/hostTime",
+			"response/data/sessionSecret",
+			"response/data/hostTime",
+			// startOSCARSession
+			"response/data/host",
+			"response/data/port",
+			"response/data/cookie",
+			"response/data/ts"
+		};
+		for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i)
+			insert(QByteArray(fields[i]));
+	}
+};
+
+Q_GLOBAL_STATIC(OscarResponseFields, oscarResponseFields)
+
 OscarResponse::OscarResponse(const QByteArray &json)
 {
 	DEBUG() << json;
-	QVariant dataVar;
-	int len = json.length();
-	K8JSON::parseRecord(dataVar, reinterpret_cast<const uchar*>(json.data()), &len);
-	QVariantMap data = dataVar.toMap();
-	QVariantMap response = data.value(QLatin1String("response")).toMap();
-	m_rawResult = data;
-	m_result = static_cast<ResultCode>(response.value(QLatin1String("statusCode")).toInt());
-	m_detailCode = response.value(QLatin1String("statusDetailCode")).toInt();
-	m_resultString = response.value(QLatin1String("statusText")).toString();
-	m_data = response.value(QLatin1String("data")).toMap();
+	m_fields = JsonReader::readFields(json, *oscarResponseFields());
+	m_result = static_cast<ResultCode>(m_fields.value("response/statusCode").toInt());
+	m_detailCode = m_fields.value("response/statusDetailCode").toInt();
+	m_resultString = m_fields.value("response/statusText").toString();
 }
 
 OscarResponse::~OscarResponse()
@@ -153,14 +184,330 @@ QString OscarResponse::resultString() const
 	return m_resultString;
 }
 
-QVariantMap OscarResponse::rawResult() const
+QVariant OscarResponse::data(const char *name) const
+{
+	return m_fields.value(QByteArray("response/data/") + name);
+}
+
+// HMAC-SHA256 state reused by all logins of the thread. The keyed state
+// is kept between the signatures and is rebuilt only when the key changes.
+class HmacSha256
+{
+public:
+	HmacSha256() : m_keyed(false) {}
+	QByteArray sign(const QByteArray &key, const QByteArray &data);
+private:
+#if defined(OSCAR_USE_3RDPARTY_HMAC)
+	hmac_sha256_ctx m_ctx;
+#elif defined(OSCAR_USE_QCA2)
+	QScopedPointer<QCA::MessageAuthenticationCode> m_mac;
+#endif
+	QByteArray m_key;
+	bool m_keyed;
+};
+
+QByteArray HmacSha256::sign(const QByteArray &key, const QByteArray &data)
+{
+#if defined(OSCAR_USE_3RDPARTY_HMAC)
+	if (m_keyed && key == m_key) {
+		hmac_sha256_reinit(&m_ctx);
+	} else {
+		hmac_sha256_init(&m_ctx, reinterpret_cast<unsigned char*>(const_cast<char*>(key.data())),
+						 key.length());
+		m_key = key;
+		m_keyed = true;
+	}
+	QByteArray mac(SHA256_DIGEST_SIZE, 0);
+	hmac_sha256_update(&m_ctx, reinterpret_cast<unsigned char*>(const_cast<char*>(data.data())),
+					   data.length());
+	hmac_sha256_final(&m_ctx, reinterpret_cast<unsigned char*>(mac.data()), mac.size());
+	return mac.toBase64();
+#elif defined(OSCAR_USE_QCA2)
+	if (!m_mac) {
+		m_mac.reset(new QCA::MessageAuthenticationCode(QLatin1String("hmac(sha256)"), key));
+		m_key = key;
+	} else if (key != m_key) {
+		m_mac->setup(key);
+		m_key = key;
+	}
+	m_mac->update(data);
+	QByteArray mac = m_mac->final().toByteArray();
+	// Drops the message but keeps the key
+	m_mac->clear();
+	return mac.toBase64();
+#else
+# error Oscar authorization module depends on hmac-sha256 support
+#endif
+}
+
+static QThreadStorage<HmacSha256*> hmacContexts;
+static void registerThreadDataCleanup();
+
+static QByteArray sha256hmac(const QByteArray &array, const QByteArray &sessionSecret)
+{
+	if (!hmacContexts.hasLocalData()) {
+		hmacContexts.setLocalData(new HmacSha256);
+		registerThreadDataCleanup();
+	}
+	return hmacContexts.localData()->sign(sessionSecret, array);
+}
+
+// Network managers shared by all logins of the thread, one per proxy,
+// so the connections to the authorization servers are kept alive and reused
+class NetworkManagerPool
+{
+public:
+	~NetworkManagerPool() { qDeleteAll(m_managers); }
+	QNetworkAccessManager *manager(const QNetworkProxy &proxy);
+private:
+	QHash<QString, QNetworkAccessManager*> m_managers;
+};
+
+QNetworkAccessManager *NetworkManagerPool::manager(const QNetworkProxy &proxy)
+{
+	QString key = QString::number(proxy.type());
+	if (proxy.type() != QNetworkProxy::NoProxy && proxy.type() != QNetworkProxy::DefaultProxy) {
+		key += QLatin1Char('|') + proxy.hostName()
+				+ QLatin1Char(':') + QString::number(proxy.port())
+				+ QLatin1Char('|') + proxy.user()
+				+ QLatin1Char('|') + proxy.password();
+	}
+	QNetworkAccessManager *&manager = m_managers[key];
+	if (!manager) {
+		manager = new QNetworkAccessManager;
+		manager->setProxy(proxy);
+	}
+	return manager;
+}
+
+static QThreadStorage<NetworkManagerPool*> networkManagerPools;
+
+static QNetworkAccessManager *networkManager(const QNetworkProxy &proxy)
 {
-	return m_rawResult;
+	if (!networkManagerPools.hasLocalData()) {
+		networkManagerPools.setLocalData(new NetworkManagerPool);
+		registerThreadDataCleanup();
+	}
+	return networkManagerPools.localData()->manager(proxy);
 }
 
-QVariantMap OscarResponse::data() const
+// The thread storage of the main thread would be freed only during the static
+// destruction, when the application and QCA are already gone. Other threads
+// free their storage as soon as they finish.
+static void cleanupThreadData()
 {
-	return m_data;
+	networkManagerPools.setLocalData(0);
+	hmacContexts.setLocalData(0);
+}
+
+static void registerThreadDataCleanup()
+{
+	// Touched only from the main thread
+	static bool registered = false;
+	QCoreApplication *app = QCoreApplication::instance();
+	if (!registered && app && app->thread() == QThread::currentThread()) {
+		qAddPostRoutine(cleanupThreadData);
+		registered = true;
+	}
+}
+
+#if defined(OSCAR_USE_QCA2)
+Q_GLOBAL_STATIC(QMutex, qcaInitLock)
+#endif
+
+// Changes of the tokens are collected for a while and written at once,
+// so a restart of many accounts does not rewrite the file for each of them
+const int tokenCacheWriteDelay = 1000;
+
+class OAuthTokenCacheWriter : public QObject
+{
+protected:
+	void customEvent(QEvent *event);
+	void timerEvent(QTimerEvent *event);
+private:
+	QBasicTimer m_timer;
+};
+
+class OAuthTokenCacheData
+{
+public:
+	OAuthTokenCacheData() : cleared(false), writer(0) {}
+	void markDirty(const QString &uin);
+	void scheduleWrite();
+	void write();
+	QMutex mutex;
+	QString fileName;
+	QHash<QString, QVariantMap> tokens;
+	// The uins whose tokens have changed since the last write
+	QSet<QString> dirty;
+	bool cleared;
+	OAuthTokenCacheWriter *writer;
+};
+
+Q_GLOBAL_STATIC(OAuthTokenCacheData, tokenCache)
+
+static bool isTokenValid(const QVariantMap &token)
+{
+	return !token.value(QLatin1String("a")).toByteArray().isEmpty()
+			&& token.value(QLatin1String("expiresAt")).toDateTime() > QDateTime::currentDateTime();
+}
+
+static void writeTokenCache()
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->write();
+	delete cache->writer;
+	cache->writer = 0;
+}
+
+void OAuthTokenCacheWriter::customEvent(QEvent *event)
+{
+	if (event->type() == QEvent::User && !m_timer.isActive())
+		m_timer.start(tokenCacheWriteDelay, this);
+}
+
+void OAuthTokenCacheWriter::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_timer.timerId()) {
+		QObject::timerEvent(event);
+		return;
+	}
+	m_timer.stop();
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->write();
+}
+
+void OAuthTokenCacheData::markDirty(const QString &uin)
+{
+	if (fileName.isEmpty())
+		return;
+	bool scheduled = !dirty.isEmpty() || cleared;
+	dirty.insert(uin);
+	if (!scheduled)
+		scheduleWrite();
+}
+
+void OAuthTokenCacheData::scheduleWrite()
+{
+	// The writer lives in the main thread, the tokens may come from any
+	QCoreApplication *app = QCoreApplication::instance();
+	if (!app) {
+		write();
+		return;
+	}
+	if (!writer) {
+		writer = new OAuthTokenCacheWriter;
+		writer->moveToThread(app->thread());
+		qAddPostRoutine(writeTokenCache);
+	}
+	QCoreApplication::postEvent(writer, new QEvent(QEvent::User));
+}
+
+void OAuthTokenCacheData::write()
+{
+	if (fileName.isEmpty() || (dirty.isEmpty() && !cleared))
+		return;
+	{
+		QSettings settings(fileName, QSettings::IniFormat);
+		if (cleared)
+			settings.remove(QLatin1String("tokens"));
+		settings.beginGroup(QLatin1String("tokens"));
+		foreach (const QString &uin, dirty) {
+			QHash<QString, QVariantMap>::const_iterator itr = tokens.constFind(uin);
+			if (itr != tokens.constEnd())
+				settings.setValue(uin, *itr);
+			else
+				settings.remove(uin);
+		}
+	}
+	dirty.clear();
+	cleared = false;
+	// The tokens carry the session secrets in plain text
+	QFile::setPermissions(fileName, QFile::ReadOwner | QFile::WriteOwner);
+}
+
+void OAuthTokenCache::setFileName(const QString &fileName)
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	// The pending changes belong to the previous file
+	cache->write();
+	cache->fileName = fileName;
+	if (fileName.isEmpty())
+		return;
+	QSettings settings(fileName, QSettings::IniFormat);
+	settings.beginGroup(QLatin1String("tokens"));
+	foreach (const QString &uin, settings.childKeys()) {
+		QVariantMap token = settings.value(uin).toMap();
+		if (isTokenValid(token))
+			cache->tokens.insert(uin, token);
+		else
+			settings.remove(uin);
+	}
+}
+
+QString OAuthTokenCache::fileName()
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	return cache->fileName;
+}
+
+QVariant OAuthTokenCache::token(const QString &uin)
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	QHash<QString, QVariantMap>::iterator itr = cache->tokens.find(uin);
+	if (itr == cache->tokens.end())
+		return QVariant();
+	if (!isTokenValid(*itr)) {
+		cache->tokens.erase(itr);
+		cache->markDirty(uin);
+		return QVariant();
+	}
+	return *itr;
+}
+
+void OAuthTokenCache::setToken(const QString &uin, const QVariant &token)
+{
+	QVariantMap map = token.toMap();
+	if (map.isEmpty()) {
+		removeToken(uin);
+		return;
+	}
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->tokens.insert(uin, map);
+	cache->markDirty(uin);
+}
+
+void OAuthTokenCache::removeToken(const QString &uin)
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	if (cache->tokens.remove(uin))
+		cache->markDirty(uin);
+}
+
+void OAuthTokenCache::clear()
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->tokens.clear();
+	cache->dirty.clear();
+	if (!cache->fileName.isEmpty() && !cache->cleared) {
+		cache->cleared = true;
+		cache->scheduleWrite();
+	}
+}
+
+void OAuthTokenCache::sync()
+{
+	OAuthTokenCacheData *cache = tokenCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->write();
 }
 
 OscarAuth::OscarAuth(Client *client, const OAuthLoginData &loginData) :
@@ -168,17 +515,24 @@ OscarAuth::OscarAuth(Client *client, const OAuthLoginData &loginData) :
 	m_client(client),
 	m_state(Invalid),
 	m_loginData(loginData),
-	m_tokenData(loginData.lastToken().toMap())
+	m_tokenData(loginData.lastToken().toMap()),
+	m_storedToken(false)
 {
+	if (m_tokenData.isEmpty())
+		m_tokenData = OAuthTokenCache::token(client->uin()).toMap();
 #if defined(OSCAR_USE_QCA2)
-	static bool qcaInited = false;
-	if (!qcaInited) {
-		qcaInited = true;
-		QCA::init();
-		QCA::setAppName("ireen");
+	{
+		// The clients may be created in different threads
+		QMutexLocker locker(qcaInitLock());
+		static bool qcaInited = false;
+		if (!qcaInited) {
+			qcaInited = true;
+			QCA::init();
+			QCA::setAppName("ireen");
+		}
 	}
 #endif
-	m_manager.setProxy(m_client->proxy());
+	m_manager = networkManager(m_client->proxy());
 	connect(m_client, SIGNAL(proxyUpdated(QNetworkProxy)),
 			SLOT(setProxy(QNetworkProxy)));
 }
@@ -197,14 +551,14 @@ QAbstractSocket::SocketState OscarAuth::socketState()
 
 void OscarAuth::setProxy(const QNetworkProxy &proxy)
 {
-	m_manager.setProxy(proxy);
+	m_manager = networkManager(proxy);
 }
 
 void OscarAuth::login()
 {
 #if defined(OSCAR_USE_QCA2)
 	if (!QCA::isSupported("hmac(sha256)")) {
-		critical(DebugVeryVerbose) << "HMAC-SHA1 feature for QCA is not found. Try to install qca2-plugin-ossl";
+		critical(ConnectionDebug, DebugVeryVerbose) << "HMAC-SHA1 feature for QCA is not found. Try to install qca2-plugin-ossl";
 		emit error(AbstractConnection::InternalClientError);
 		deleteLater();
 		return;
@@ -214,6 +568,7 @@ void OscarAuth::login()
 		QByteArray a = m_tokenData.value(QLatin1String("a")).toByteArray();
 		QDateTime expiresAt = m_tokenData.value(QLatin1String("expiresAt")).toDateTime();
 		if (expiresAt > QDateTime::currentDateTime()) {
+			m_storedToken = true;
 			startSession(a, m_tokenData.value(QLatin1String("sessionSecret")).toByteArray());
 			return;
 		}
@@ -221,24 +576,10 @@ void OscarAuth::login()
 	clientLogin(true);
 }
 
-static QByteArray sha256hmac(const QByteArray &array, const QByteArray &sessionSecret)
+void OscarAuth::updateToken()
 {
-#if defined(OSCAR_USE_3RDPARTY_HMAC)
-	QByteArray mac(SHA256_DIGEST_SIZE, 0);
-	hmac_sha256(reinterpret_cast<unsigned char*>(const_cast<char*>(sessionSecret.data())),
-				sessionSecret.length(),
-				reinterpret_cast<unsigned char*>(const_cast<char*>(array.data())),
-				array.length(),
-				reinterpret_cast<unsigned char*>(mac.data()),
-				mac.size());
-	return mac.toBase64();
-#elif defined(OSCAR_USE_QCA2)
-	QCA::MessageAuthenticationCode hash(QLatin1String("hmac(sha256)"), sessionSecret);
-	hash.update(array);
-	return hash.final().toByteArray().toBase64();
-#else
-# error Oscar authorization module depends on hmac-sha256 support
-#endif
+	OAuthTokenCache::setToken(m_client->uin(), m_tokenData);
+	emit m_client->loginTokenUpdated(m_tokenData);
 }
 
 static QByteArray paranoicEscape(const QByteArray &raw)
@@ -257,7 +598,9 @@ static QByteArray paranoicEscape(const QByteArray &raw)
 
 void OscarAuth::clientLogin(bool longTerm)
 {
-	QUrl url = QUrl::fromEncoded(ICQ_LOGIN_URL);
+	QUrl url = m_loginData.clientLoginUrl().isEmpty()
+			? QUrl::fromEncoded(ICQ_LOGIN_URL)
+			: QUrl::fromEncoded(m_loginData.clientLoginUrl().toLatin1());
 	url.addQueryItem(QLatin1String("devId"), m_loginData.developerId());
 	url.addQueryItem(QLatin1String("f"), QLatin1String("json"));
 	url.addQueryItem(QLatin1String("s"), m_client->uin());
@@ -273,7 +616,7 @@ void OscarAuth::clientLogin(bool longTerm)
 	DEBUG() << Q_FUNC_INFO << url << query;
 	QNetworkRequest request(url);
 	request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
-	QNetworkReply *reply = m_manager.post(request, query);
+	QNetworkReply *reply = m_manager->post(request, query);
 	m_cleanupHandler.add(reply);
 	connect(reply, SIGNAL(finished()), this, SLOT(onClientLoginFinished()));
 }
@@ -290,7 +633,6 @@ void OscarAuth::onClientLoginFinished()
 		return;
 	}
 	OscarResponse response(reply->readAll());
-	DEBUG() << Q_FUNC_INFO << response.rawResult();
 	if (response.result() != OscarResponse::Success) {
 		m_errorString = response.resultString();
 		emit error(response.error());
@@ -298,12 +640,18 @@ void OscarAuth::onClientLoginFinished()
 		return;
 	}
 
-	QVariantMap data = response.data().value(QLatin1String("token")).toMap();
-	QByteArray token = data.value(QLatin1String("a")).toByteArray();
-	int expiresIn = data.value(QLatin1String("expiresIn")).toInt();
+	QByteArray token = response.data("token/a").toByteArray();
+	int expiresIn = response.data("token/expiresIn").toInt();
 	QDateTime expiresAt = QDateTime::currentDateTime().addSecs(expiresIn);
-	QByteArray sessionSecret = data.value(QLatin1String("sessionSecret")).toByteArray();
-	int hostTime = data.value(QLatin1String("hostTime")).toInt();
+	// The server puts them next to the token, look inside it as well
+	QVariant sessionSecretVar = response.data("sessionSecret");
+	if (sessionSecretVar.isNull())
+		sessionSecretVar = response.data("token/sessionSecret");
+	QVariant hostTimeVar = response.data("hostTime");
+	if (hostTimeVar.isNull())
+		hostTimeVar = response.data("token/hostTime");
+	QByteArray sessionSecret = sessionSecretVar.toByteArray();
+	int hostTime = hostTimeVar.toInt();
 	int localTime = QDateTime::currentDateTime().toUTC().toTime_t();
 	sessionSecret = sha256hmac(sessionSecret, m_loginData.password().toUtf8());
 	{
@@ -311,14 +659,17 @@ void OscarAuth::onClientLoginFinished()
 		m_tokenData.insert(QLatin1String("expiresAt"), expiresAt.toString(Qt::ISODate));
 		m_tokenData.insert(QLatin1String("sessionSecret"), sessionSecret);
 		m_tokenData.insert(QLatin1String("hostTimeDelta"), hostTime - localTime);
-		emit m_client->loginTokenUpdated(m_tokenData);
+		updateToken();
 	}
+	m_storedToken = false;
 	startSession(token, sessionSecret);
 }
 
 void OscarAuth::startSession(const QByteArray &token, const QByteArray &sessionKey)
 {
-	QUrl url = QUrl::fromEncoded(ICQ_START_SESSION_URL);
+	QUrl url = m_loginData.startSessionUrl().isEmpty()
+			? QUrl::fromEncoded(ICQ_START_SESSION_URL)
+			: QUrl::fromEncoded(m_loginData.startSessionUrl().toLatin1());
 	url.addEncodedQueryItem("a", token.toPercentEncoding());
 	url.addQueryItem(QLatin1String("distId"), m_loginData.distributionId());
 	url.addQueryItem(QLatin1String("f"), QLatin1String("json"));
@@ -341,7 +692,7 @@ void OscarAuth::startSession(const QByteArray &token, const QByteArray &sessionK
 	QNetworkRequest request(url);
 	//	Some strange error at ICQ servers. I receive "Parameter error" if it is set no anything else
 	request.setRawHeader("Accept-Language", generateLanguage().toLatin1());
-	QNetworkReply *reply = m_manager.get(request);
+	QNetworkReply *reply = m_manager->get(request);
 	m_cleanupHandler.add(reply);
 	connect(reply, SIGNAL(finished()), SLOT(onStartSessionFinished()));
 	connect(reply, SIGNAL(sslErrors(QList<QSslError>)), SLOT(onSslErrors(QList<QSslError>)));
@@ -352,34 +703,43 @@ void OscarAuth::onStartSessionFinished()
 	QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
 	Q_ASSERT(reply);
 	reply->deleteLater();
-	deleteLater();
 	if (reply->error() != QNetworkReply::NoError) {
 		m_errorString = reply->errorString();
 		emit error(AbstractConnection::SocketError);
+		deleteLater();
 		return;
 	}
 	OscarResponse response(reply->readAll());
-	DEBUG() << Q_FUNC_INFO << response.rawResult();
-	QVariantMap data = response.data();
 	if (response.result() == OscarResponse::InvalidRequest
 			&& response.detailCode() == 1015) {
 		// Invalid local time
-		int hostTime = data.value(QLatin1String("ts")).toInt();
+		int hostTime = response.data("ts").toInt();
 		int localTime = QDateTime::currentDateTime().toUTC().toTime_t();
 		m_tokenData.insert(QLatin1String("hostTimeDelta"), hostTime - localTime);
-		emit m_client->loginTokenUpdated(m_tokenData);
+		updateToken();
 		login();
 		return;
 	}
 	if (response.result() != OscarResponse::Success) {
+		if (m_storedToken && response.error() != AbstractConnection::RateLimitExceeded) {
+			// The stored token is not accepted anymore, get the new one
+			DEBUG() << "The stored token is rejected:" << response.resultString();
+			OAuthTokenCache::removeToken(m_client->uin());
+			m_tokenData.clear();
+			m_storedToken = false;
+			clientLogin(true);
+			return;
+		}
 		m_errorString = response.resultString();
-//		m_account->config(QLatin1String("general")).remove(QLatin1String("token"));
 		emit error(response.error());
+		deleteLater();
 		return;
 	}
-	QString host = data.value(QLatin1String("host")).toString();
-	int port = data.value(QLatin1String("port"), 443).toInt();
-	QByteArray cookie = QByteArray::fromBase64(data.value(QLatin1String("cookie")).toByteArray());
+	QString host = response.data("host").toString();
+	QVariant portVar = response.data("port");
+	int port = portVar.isNull() ? 443 : portVar.toInt();
+	QByteArray cookie = QByteArray::fromBase64(response.data("cookie").toByteArray());
+	deleteLater();
 	m_client->d_func()->connectToBOSS(host, port, cookie);
 }
 
@@ -72,12 +72,16 @@ private:
 	QString generateLanguage();
 	int version() const;
 	QByteArray generateSignature(const QByteArray &method, const QByteArray &sessionSecret, const QUrl &url);
+	void updateToken();
 private:
 	Client *m_client;
 	State m_state;
 	OAuthLoginData m_loginData;
 	QVariantMap m_tokenData;
-	QNetworkAccessManager m_manager;
+	// The session is being started with the token of the previous login
+	bool m_storedToken;
+	// Shared by all logins of the thread
+	QNetworkAccessManager *m_manager;
 	QObjectCleanupHandler m_cleanupHandler;
 };
 
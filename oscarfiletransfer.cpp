@@ -31,11 +31,37 @@
 #include <QDir>
 #include <QTimer>
 #include <QApplication>
+#include <QMutex>
+#include <QSet>
 
 namespace Ireen {
 
-QHash<quint16, OftServer*> OftManagerPrivate::servers;
-bool OftManagerPrivate::allowAnyPort = true;
+// The ports are shared by all clients of the process. A port is reserved
+// by the first connection which needs it and the server listening on it
+// lives in the thread of that connection until the port is released.
+struct OftServerConfig
+{
+	OftServerConfig() : allowAnyPort(true) {}
+	bool reservePort(quint16 port)
+	{
+		QMutexLocker locker(&mutex);
+		if (busyPorts.contains(port))
+			return false;
+		busyPorts.insert(port);
+		return true;
+	}
+	void releasePort(quint16 port)
+	{
+		QMutexLocker locker(&mutex);
+		busyPorts.remove(port);
+	}
+	QMutex mutex;
+	bool allowAnyPort;
+	QList<quint16> ports;
+	QSet<quint16> busyPorts;
+};
+
+Q_GLOBAL_STATIC(OftServerConfig, oftServerConfig)
 
 const int BUFFER_SIZE = 4096;
 using namespace Util;
@@ -130,7 +156,7 @@ static void resizeArray(QByteArray &data, int size)
 void OftHeader::writeData(QIODevice *dev)
 {
 	DataUnit data;
-	debug() << "Outgoing oft message with type" << hex << type;
+	debug(FileTransferDebug) << "Outgoing oft message with type" << hex << type;
 	data.append<quint16>(type);
 	data.append<quint64>(cookie);
 	data.append<quint16>(encrypt);
@@ -213,7 +239,7 @@ void OftSocket::directConnect(const QHostAddress &addr, quint16 port)
 	connectToHost(addr, port);
 	m_clientPort = port;
 	m_timer.start();
-	debug().nospace() << "Trying to establish a direct connection to "
+	debug(FileTransferDebug).nospace() << "Trying to establish a direct connection to "
 			<< addr.toString().toLocal8Bit().constData()
 			<< ":" << port;
 }
@@ -251,7 +277,7 @@ void OftSocket::proxyConnect(QHostAddress addr, quint16 port)
 void OftSocket::connectToProxy(const QHostAddress &addr, quint16 port)
 {
 	connectToHost(addr, port);
-	debug().nospace() << "Trying to connect to the proxy "
+	debug(FileTransferDebug).nospace() << "Trying to connect to the proxy "
 			<< addr.toString().toLocal8Bit().constData()
 			<< ":" << port;
 	m_timer.start();
@@ -275,7 +301,7 @@ void OftSocket::onReadyRead()
 			data.setData(read(4));
 			m_len = data.read<quint16>() - 2;
 			if (data.read<quint16>() != 0x044A)
-				debug() << "Unknown proxy protocol version";
+				debug(FileTransferDebug) << "Unknown proxy protocol version";
 		}
 		if (bytesAvailable() <= m_len) {
 			data.setData(read(m_len));
@@ -287,7 +313,7 @@ void OftSocket::onReadyRead()
 		data.skipData(4); // unknown
 		quint16 flags = data.read<quint16>();
 		Q_UNUSED(flags);
-		debug() << "Rendezvous proxy packet. Type" << type;
+		debug(FileTransferDebug) << "Rendezvous proxy packet. Type" << type;
 		switch (type) {
 		case 0x0001 : { // error
 			quint16 code = data.read<quint16>();
@@ -300,7 +326,7 @@ void OftSocket::onReadyRead()
 				str = "Accept Period Timed Out";
 			else
 				str = QString("Unknown rendezvous proxy error: %1").arg(code);
-			debug() << "Rendezvous proxy error:" << str;
+			debug(FileTransferDebug) << "Rendezvous proxy error:" << str;
 			setSocketError(QAbstractSocket::ProxyProtocolError);
 			setErrorString(str);
 			emit error(QAbstractSocket::ProxyProtocolError);
@@ -377,20 +403,29 @@ void OftSocket::onTimeout()
 	close();
 }
 
-OftServer::OftServer(quint16 port) :
-	m_port(port)
+OftServer::OftServer(quint16 port, OftConnection *conn) :
+	QTcpServer(conn), m_conn(conn), m_port(port)
 {
 	m_timer.setInterval(FILETRANSFER_WAITING_TIMEOUT);
 	m_timer.setSingleShot(true);
 	connect(&m_timer, SIGNAL(timeout()), SLOT(onTimeout()));
 }
 
-void OftServer::listen()
+OftServer::~OftServer()
 {
+	releasePort();
+}
+
+bool OftServer::listen()
+{
+	if (!QTcpServer::listen(QHostAddress::Any, m_port)) {
+		debug(FileTransferDebug) << "Could not listen for incoming connections on port"
+				<< m_port << errorString();
+		return false;
+	}
 	m_timer.start();
-	QTcpServer::listen();
-	debug() << "Started listening for incoming connections on port" << serverPort();
-	//emit m_conn->localPortChanged(serverPort());
+	debug(FileTransferDebug) << "Started listening for incoming connections on port" << serverPort();
+	return true;
 }
 
 void OftServer::close()
@@ -398,6 +433,17 @@ void OftServer::close()
 	m_conn = 0;
 	m_timer.stop();
 	QTcpServer::close();
+	releasePort();
+	// A server is never reused, the next request gets a new one
+	deleteLater();
+}
+
+void OftServer::releasePort()
+{
+	if (m_port != 0) {
+		oftServerConfig()->releasePort(m_port);
+		m_port = 0;
+	}
 }
 
 void OftServer::setConnection(OftConnection *conn)
@@ -408,7 +454,7 @@ void OftServer::setConnection(OftConnection *conn)
 void OftServer::incomingConnection(int socketDescriptor)
 {
 	OftSocket *socket = new OftSocket(m_conn->client(), socketDescriptor);
-	debug().nospace() << "Incoming oscar transfer connection from "
+	debug(FileTransferDebug).nospace() << "Incoming oscar transfer connection from "
 			<< socket->peerAddress().toString().toLatin1().constData()
 			<< ":" << socket->peerPort();
 	m_conn->d->setSocket(socket);
@@ -673,7 +719,7 @@ void OftConnectionPrivate::close(bool error)
 void OftConnectionPrivate::handleRendezvous(quint16 reqType, const TLVMap &tlvs)
 {
 	if (reqType == MsgRequest) {
-		debug() << uin << "has sent file transfer request";
+		debug(FileTransferDebug) << uin << "has sent file transfer request";
 		stage = tlvs.value<quint16>(0x000A);
 		QHostAddress proxyIP(tlvs.value<quint32>(0x0002));
 		QHostAddress clientIP(tlvs.value<quint32>(0x0003));
@@ -711,7 +757,7 @@ void OftConnectionPrivate::handleRendezvous(quint16 reqType, const TLVMap &tlvs)
 				if (server)
 					server->close();
 				if (socket) {
-					debug() << "Sender has sent the request for reverse connection (stage 2)"
+					debug(FileTransferDebug) << "Sender has sent the request for reverse connection (stage 2)"
 							<< "but the connection already initialized at stage 1";
 					return;
 				}
@@ -728,7 +774,7 @@ void OftConnectionPrivate::handleRendezvous(quint16 reqType, const TLVMap &tlvs)
 		}
 
 		if (!errorStr.isEmpty()) {
-			debug() << errorStr;
+			debug(FileTransferDebug) << errorStr;
 			close();
 			return;
 		}
@@ -753,9 +799,9 @@ void OftConnectionPrivate::handleRendezvous(quint16 reqType, const TLVMap &tlvs)
 			socket->proxyConnect(proxyIP, port);
 		q->connect(socket, SIGNAL(timeout()), SLOT(startNextStage()));
 	} else if (reqType == MsgAccept) {
-		debug() << uin << "accepted file transfing";
+		debug(FileTransferDebug) << uin << "accepted file transfing";
 	} else if (reqType == MsgCancel) {
-		debug() << uin << "canceled file transfing";
+		debug(FileTransferDebug) << uin << "canceled file transfing";
 		close(false);
 		setState(OftConnection::Error);
 		setError(OftConnection::Canceled);
@@ -782,7 +828,7 @@ void OftConnectionPrivate::setSocket(OftSocket *newSocket)
 		emit q->localPortChanged(socket->localPort());
 	} else {
 		newSocket->deleteLater();
-		debug() << "Cannot change socket in an initialized oscar file transfer connection";
+		debug(FileTransferDebug) << "Cannot change socket in an initialized oscar file transfer connection";
 	}
 }
 
@@ -806,10 +852,8 @@ void OftConnectionPrivate::sendFileRequest()
 		proxyAddr = socket->proxyIP().toIPv4Address();
 		port = socket->proxyPort();
 	} else {
-		server = OftManagerPrivate::getFreeServer();
+		server = OftManagerPrivate::getFreeServer(q);
 		if (server) {
-			server->setConnection(q);
-			server->listen();
 			// That does not work well with all clients
 			// connect(server, SIGNAL(timeout(OftConnection*)), SLOT(close()));
 			clientAddr = manager->client()->socket()->localAddress().toIPv4Address();
@@ -850,7 +894,7 @@ void OftConnectionPrivate::sendFileRequest()
 	}
 	ServerMessage message(uin, data);
 	manager->client()->send(message);
-	debug() << "A stage" << stage << "file transfer request has been sent";
+	debug(FileTransferDebug) << "A stage" << stage << "file transfer request has been sent";
 }
 
 void OftConnectionPrivate::connected()
@@ -877,11 +921,11 @@ void OftConnectionPrivate::onError(QAbstractSocket::SocketError error)
 		startNextStage();
 	} else {
 		if (connClosed && header.bytesReceived == header.size && header.filesLeft <= 1) {
-			debug() << "File transfer connection closed";
+			debug(FileTransferDebug) << "File transfer connection closed";
 			setState(OftConnection::Finished);
 			close(false);
 		} else {
-			debug() << "File transfer connection error" << socket->errorString();
+			debug(FileTransferDebug) << "File transfer connection error" << socket->errorString();
 			close();
 		}
 	}
@@ -890,7 +934,7 @@ void OftConnectionPrivate::onError(QAbstractSocket::SocketError error)
 void OftConnectionPrivate::onNewData()
 {
 	if (!data) {
-		debug() << "File transfer data has been received when the output file is not initialized";
+		debug(FileTransferDebug) << "File transfer data has been received when the output file is not initialized";
 		return;
 	}
 	if (socket->bytesAvailable() <= 0)
@@ -1039,15 +1083,15 @@ void OftConnectionPrivate::onHeaderReaded()
 				error = QString("Oft message type %1 is not allowed during sending");
 		}
 		if (!error.isEmpty()) {
-			debug() << error.arg(header.type);
+			debug(FileTransferDebug) << error.arg(header.type);
 			close();
 			return;
 		}
-		debug() << "Incoming oft message with type" << hex << header.type;
+		debug(FileTransferDebug) << "Incoming oft message with type" << hex << header.type;
 		switch (header.type) {
 		case OftPrompt: { // Sender has sent us info about file transfer
 			if (data) {
-				debug() << "Prompt messages are not allowed during resuming receiving";
+				debug(FileTransferDebug) << "Prompt messages are not allowed during resuming receiving";
 				return;
 			}
 
@@ -1055,7 +1099,7 @@ void OftConnectionPrivate::onHeaderReaded()
 
 			currentFileIndex = header.totalFiles - header.filesLeft;
 			if (currentFileIndex >= filesCount) {
-				debug() << "Sender sent wrong OftPrompt filetransfer request";
+				debug(FileTransferDebug) << "Sender sent wrong OftPrompt filetransfer request";
 				close();
 				break;
 			}
@@ -1075,7 +1119,7 @@ void OftConnectionPrivate::onHeaderReaded()
 		}
 		case OftReceiverResume: { // Receiver wants to resume old file transfer
 			if (!data) {
-				debug() << "Sender sent OftReceiverResume filetransfer request before OftPrompt";
+				debug(FileTransferDebug) << "Sender sent OftReceiverResume filetransfer request before OftPrompt";
 				close();
 				return;
 			}
@@ -1087,7 +1131,7 @@ void OftConnectionPrivate::onHeaderReaded()
 		}
 		case OftSenderResume: { // Sender responded at our resuming request
 			if (!data) {
-				debug() << "The sender had sent OftReceiverResume filetransfer request"
+				debug(FileTransferDebug) << "The sender had sent OftReceiverResume filetransfer request"
 						<< "before the receiver sent OftPromt";
 				close();
 				return;
@@ -1096,12 +1140,12 @@ void OftConnectionPrivate::onHeaderReaded()
 			header.type = OftResumeAcknowledge;
 			if (header.bytesReceived) { // ok. resume receiving
 				flags = QIODevice::WriteOnly | QIODevice::Append;
-				debug() << "Receiving of file" << header.fileName << "will be resumed";
+				debug(FileTransferDebug) << "Receiving of file" << header.fileName << "will be resumed";
 			} else { // sender said that our local file is corrupt
 				flags = QIODevice::WriteOnly;
 				header.receivedChecksum = 0xffff0000;
 				header.bytesReceived = 0;
-				debug() << "File" << header.fileName << "will be rewritten";
+				debug(FileTransferDebug) << "File" << header.fileName << "will be rewritten";
 			}
 			if (data.data()->open(flags)) {
 				header.writeData(socket);
@@ -1123,7 +1167,7 @@ void OftConnectionPrivate::onHeaderReaded()
 			break;
 		}
 		default:
-			debug() << "Unknown oft message type" << hex << header.type;
+			debug(FileTransferDebug) << "Unknown oft message type" << hex << header.type;
 			socket->dataReaded();
 		}
 	}
@@ -1137,7 +1181,7 @@ void OftManagerPrivate::processMessage(const QString &uin, const Capability &gui
 	TLVMap tlvs = DataUnit(data).read<TLVMap>();
 	OftConnection *conn = connection(cookie.id());
 	if (conn && conn->uin() != uin) {
-		debug() << "Cannot create two oscar file transfer with the same cookie" << cookie.id();
+		debug(FileTransferDebug) << "Cannot create two oscar file transfer with the same cookie" << cookie.id();
 		return;
 	}
 	bool newRequest = reqType == MsgRequest && !conn;
@@ -1151,7 +1195,7 @@ void OftManagerPrivate::processMessage(const QString &uin, const Capability &gui
 		else
 			q->incomingConnection(conn);
 	} else {
-		debug() << "Skipped oscar file transfer request with unknown cookie";
+		debug(FileTransferDebug) << "Skipped oscar file transfer request with unknown cookie";
 	}
 }
 
@@ -1170,58 +1214,45 @@ void OftManagerPrivate::removeConnection(OftConnection *connection)
 	connections.remove(connection->cookie());
 }
 
-OftServer *OftManagerPrivate::getFreeServer()
+OftServer *OftManagerPrivate::getFreeServer(OftConnection *conn)
 {
+	OftServerConfig *config = oftServerConfig();
+	QMutexLocker locker(&config->mutex);
+	bool allowAnyPort = config->allowAnyPort;
+	QList<quint16> ports = config->ports;
+	locker.unlock();
+
 	if (allowAnyPort) {
-		OftServer *server = new OftServer(0);
-		QObject::connect(server, SIGNAL(closed(OftConnection*)),
-						 server, SLOT(deleteLater()));
-		return server;
-	} else {
-		foreach (OftServer *server, servers) {
-			if (!server->isListening())
-				return server;
-		}
+		OftServer *server = new OftServer(0, conn);
+		if (server->listen())
+			return server;
+		delete server;
+		return 0;
+	}
+	foreach (quint16 port, ports) {
+		if (!config->reservePort(port))
+			continue;
+		// The port may still be taken by another application
+		OftServer *server = new OftServer(port, conn);
+		if (server->listen())
+			return server;
+		delete server;
 	}
 	return 0;
 }
 
-void OftManagerPrivate::deleteOftServer(OftServer *server)
+void OftManagerPrivate::setAllowAnyServerPort(bool allowAnyPort)
 {
-	if (server->isListening())
-		QObject::connect(server, SIGNAL(closed(OftConnection*)),
-						 server, SLOT(deleteLater()));
-	else
-		server->deleteLater();
-}
-
-
-void OftManagerPrivate::setAllowAnyServerPort(bool _allowAnyPort)
-{
-	allowAnyPort = _allowAnyPort;
-	if (allowAnyPort) {
-		std::for_each(servers.constBegin(), servers.constEnd(),
-					  &deleteOftServer);
-		servers.clear();
-	}
+	OftServerConfig *config = oftServerConfig();
+	QMutexLocker locker(&config->mutex);
+	config->allowAnyPort = allowAnyPort;
 }
 
 void OftManagerPrivate::setServerPorts(const QList<quint16> &ports)
 {
-	QSet<quint16> oldServers = servers.keys().toSet();
-
-	// Update servers list
-	foreach (quint16 port, ports) {
-		if (!servers.contains(port))
-			servers.insert(port, new OftServer(port));
-		oldServers.remove(port);
-	}
-
-	// Remove disabled servers
-	foreach (quint16 port, oldServers) {
-		OftServer *server = servers.take(port);
-		deleteOftServer(server);
-	}
+	OftServerConfig *config = oftServerConfig();
+	QMutexLocker locker(&config->mutex);
+	config->ports = ports;
 }
 
 OftManager::OftManager(MessageHandler *messageHandler) :
@@ -151,8 +151,9 @@ class OftServer : public QTcpServer
 {
 	Q_OBJECT
 public:
-	explicit OftServer(quint16 port);
-	void listen();
+	OftServer(quint16 port, OftConnection *conn);
+	~OftServer();
+	bool listen();
 	void close();
 	void setConnection(OftConnection *conn);
 	OftConnection *conn() { return m_conn; }
@@ -164,6 +165,7 @@ protected:
 private slots:
 	void onTimeout();
 private:
+	void releasePort();
 	OftConnection *m_conn;
 	quint16 m_port;
 	QTimer m_timer;
@@ -244,8 +246,7 @@ public:
 	void addConnection(OftConnection *connection);
 	void removeConnection(OftConnection *connection);
 public:
-	static OftServer *getFreeServer();
-	static void deleteOftServer(OftServer *server);
+	static OftServer *getFreeServer(OftConnection *conn);
 	static void setAllowAnyServerPort(bool allowAnyServerPort);
 	static void setServerPorts(const QList<quint16> &ports);
 public:
@@ -253,8 +254,6 @@ public:
 	OftManager *q;
 	Client *client;
 	QHash<quint64, OftConnection*> connections;
-	static QHash<quint16, OftServer*> servers;
-	static bool allowAnyPort;
 };
 
 } // namespace Ireen
@@ -105,25 +105,25 @@ bool PrivacyLists::handleFeedbagItem(Feedbag *feedbag, const FeedbagItem &item,
 	}
 	case SsiPermit: {
 		if (isItemAdded)
-			debug() << item.name() << "has been added to visible list";
+			debug(RosterDebug) << item.name() << "has been added to visible list";
 		else
-			debug() << item.name() << "has been removed from visible list";
+			debug(RosterDebug) << item.name() << "has been removed from visible list";
 		listType = VisibleList;
 		break;
 	}
 	case SsiDeny: {
 		if (isItemAdded)
-			debug() << item.name() << "has been added to invisible list";
+			debug(RosterDebug) << item.name() << "has been added to invisible list";
 		else
-			debug() << item.name() << "has been removed from invisible list";
+			debug(RosterDebug) << item.name() << "has been removed from invisible list";
 		listType = InvisibleList;
 		break;
 	}
 	case SsiIgnore: {
 		if (isItemAdded)
-			debug() << item.name() << "has been added to ignore list";
+			debug(RosterDebug) << item.name() << "has been added to ignore list";
 		else
-			debug() << item.name() << "has been removed from ignore list";
+			debug(RosterDebug) << item.name() << "has been removed from ignore list";
 		listType = IgnoreList;
 		break;
 	default:
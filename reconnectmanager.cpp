@@ -0,0 +1,372 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "reconnectmanager_p.h"
+#include "client_p.h"
+#include <QMutex>
+#include <QTimerEvent>
+
+namespace Ireen {
+
+struct CachedHost
+{
+	QList<QHostAddress> addresses;
+	QDateTime expiresAt;
+};
+
+class HostCache
+{
+public:
+	HostCache() : lifetime(10 * 60 * 1000) {}
+	QMutex mutex;
+	QHash<QString, CachedHost> hosts;
+	int lifetime;
+};
+
+Q_GLOBAL_STATIC(HostCache, hostCache)
+
+QList<QHostAddress> ReconnectManagerPrivate::cachedAddresses(const QString &host)
+{
+	HostCache *cache = hostCache();
+	QMutexLocker locker(&cache->mutex);
+	QHash<QString, CachedHost>::iterator itr = cache->hosts.find(host);
+	if (itr == cache->hosts.end())
+		return QList<QHostAddress>();
+	if (itr->expiresAt <= QDateTime::currentDateTime()) {
+		cache->hosts.erase(itr);
+		return QList<QHostAddress>();
+	}
+	return itr->addresses;
+}
+
+void ReconnectManagerPrivate::cacheAddresses(const QString &host, const QList<QHostAddress> &addresses)
+{
+	if (addresses.isEmpty())
+		return;
+	HostCache *cache = hostCache();
+	QMutexLocker locker(&cache->mutex);
+	if (cache->lifetime <= 0)
+		return;
+	CachedHost &cached = cache->hosts[host];
+	cached.addresses = addresses;
+	cached.expiresAt = QDateTime::currentDateTime().addMSecs(cache->lifetime);
+}
+
+void ReconnectManagerPrivate::dropAddresses(const QString &host)
+{
+	HostCache *cache = hostCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->hosts.remove(host);
+}
+
+int ReconnectManagerPrivate::nextDelay()
+{
+	int delay = initialDelay;
+	for (int i = 1; i < attempt && delay < maximumDelay; ++i)
+		delay = delay > maximumDelay / 2 ? maximumDelay : delay * 2;
+	delay = qMin(delay, maximumDelay);
+	// Only a half of the delay is random, so it still grows with every attempt
+	int half = delay / 2;
+	if (half > 0)
+		delay -= qrand() % (half + 1);
+	return delay;
+}
+
+void ReconnectManagerPrivate::setLoginData(const MD5LoginData &data)
+{
+	method = Md5Method;
+	md5Data = data;
+}
+
+#if IREEN_SSL_SUPPORT
+void ReconnectManagerPrivate::setLoginData(const OAuthLoginData &data)
+{
+	method = OAuthMethod;
+	oauthData = data;
+}
+#endif
+
+void ReconnectManagerPrivate::setEndpoint(const QString &host, quint16 port, const QByteArray &cookie)
+{
+	// The endpoint being reused must not prolong its own life
+	if (cookie == bossCookie && host == bossHost && port == bossPort)
+		return;
+	bossHost = host;
+	bossPort = port;
+	bossCookie = cookie;
+	bossExpiresAt = QDateTime::currentDateTime().addMSecs(endpointLifetime);
+}
+
+bool ReconnectManagerPrivate::hasEndpoint() const
+{
+	return endpointLifetime > 0
+			&& !bossCookie.isEmpty()
+			&& bossExpiresAt > QDateTime::currentDateTime();
+}
+
+ReconnectManager::ReconnectManager(Client *client) :
+	QObject(client), d(new ReconnectManagerPrivate)
+{
+	d->q = this;
+	d->client = client;
+	d->enabled = false;
+	d->wanted = false;
+	d->initialDelay = 2000;
+	d->maximumDelay = 5 * 60 * 1000;
+	d->maximumAttempts = 0;
+	d->attempt = 0;
+	d->method = ReconnectManagerPrivate::NoMethod;
+	d->bossPort = 0;
+	d->endpointLifetime = 0;
+	d->usingEndpoint = false;
+	connect(client, SIGNAL(loginFinished()), SLOT(onLoginFinished()));
+	connect(client, SIGNAL(disconnected()), SLOT(onDisconnected()));
+	connect(client, SIGNAL(loginTokenUpdated(QVariant)), SLOT(onLoginTokenUpdated(QVariant)));
+}
+
+ReconnectManager::~ReconnectManager()
+{
+}
+
+Client *ReconnectManager::client() const
+{
+	return d->client;
+}
+
+void ReconnectManager::setEnabled(bool enabled)
+{
+	d->enabled = enabled;
+	if (!enabled) {
+		d->timer.stop();
+		d->attempt = 0;
+	}
+}
+
+bool ReconnectManager::isEnabled() const
+{
+	return d->enabled;
+}
+
+void ReconnectManager::setDelays(int initialMsec, int maximumMsec)
+{
+	d->initialDelay = qMax(initialMsec, 0);
+	d->maximumDelay = qMax(maximumMsec, d->initialDelay);
+}
+
+int ReconnectManager::initialDelay() const
+{
+	return d->initialDelay;
+}
+
+int ReconnectManager::maximumDelay() const
+{
+	return d->maximumDelay;
+}
+
+void ReconnectManager::setMaximumAttempts(int count)
+{
+	d->maximumAttempts = qMax(count, 0);
+}
+
+int ReconnectManager::maximumAttempts() const
+{
+	return d->maximumAttempts;
+}
+
+int ReconnectManager::attempt() const
+{
+	return d->attempt;
+}
+
+bool ReconnectManager::isReconnectScheduled() const
+{
+	return d->timer.isActive();
+}
+
+void ReconnectManager::setEndpointLifetime(int msec)
+{
+	d->endpointLifetime = msec;
+	if (msec <= 0)
+		d->bossCookie.clear();
+}
+
+int ReconnectManager::endpointLifetime() const
+{
+	return d->endpointLifetime;
+}
+
+void ReconnectManager::clearCache()
+{
+	d->bossHost.clear();
+	d->bossPort = 0;
+	d->bossCookie.clear();
+}
+
+void ReconnectManager::setAddressCacheLifetime(int msec)
+{
+	HostCache *cache = hostCache();
+	QMutexLocker locker(&cache->mutex);
+	cache->lifetime = msec;
+	if (msec <= 0)
+		cache->hosts.clear();
+}
+
+int ReconnectManager::addressCacheLifetime()
+{
+	HostCache *cache = hostCache();
+	QMutexLocker locker(&cache->mutex);
+	return cache->lifetime;
+}
+
+bool ReconnectManager::isRecoverable(AbstractConnection::ConnectionError error)
+{
+	switch (error) {
+	case AbstractConnection::NoError:
+	case AbstractConnection::ServiceUnaivalable:
+	case AbstractConnection::NoAccessToDatabase:
+	case AbstractConnection::NoAccessToResolver:
+	case AbstractConnection::BadDatabaseStatus:
+	case AbstractConnection::BadResolverStatus:
+	case AbstractConnection::InternalError:
+	case AbstractConnection::ServiceOffline:
+	case AbstractConnection::DBSendError:
+	case AbstractConnection::DBLinkError:
+	case AbstractConnection::ReservationMapError:
+	case AbstractConnection::ReservationLinkError:
+	case AbstractConnection::ConnectionLimitExceeded:
+	case AbstractConnection::ConnectionLimitExceededReservation:
+	case AbstractConnection::RateLimitExceededReservation:
+	case AbstractConnection::ReservationTimeout:
+	case AbstractConnection::RateLimitExceeded:
+	case AbstractConnection::IcqNetworkError:
+	case AbstractConnection::SocketError:
+	case AbstractConnection::HostNotFound:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void ReconnectManager::reconnect()
+{
+	d->timer.stop();
+	if (d->client->socketState() != QAbstractSocket::UnconnectedState)
+		return;
+	emit reconnecting(d->attempt);
+	if (d->hasEndpoint()) {
+		debug(ConnectionDebug) << "Reconnecting to the BOSS server of the last session";
+		d->wanted = true;
+		d->usingEndpoint = true;
+		d->client->setError(AbstractConnection::NoError);
+		d->client->d_func()->connectToBOSS(d->bossHost, d->bossPort, d->bossCookie);
+		return;
+	}
+	switch (d->method) {
+	case ReconnectManagerPrivate::Md5Method:
+		d->client->login(d->md5Data);
+		break;
+#if IREEN_SSL_SUPPORT
+	case ReconnectManagerPrivate::OAuthMethod:
+		d->client->login(d->oauthData);
+		break;
+#endif
+	default:
+		warning(ConnectionDebug) << "Cannot reconnect the client which has never logged in";
+		break;
+	}
+}
+
+void ReconnectManager::cancel()
+{
+	d->timer.stop();
+	d->wanted = false;
+	d->usingEndpoint = false;
+	d->attempt = 0;
+}
+
+void ReconnectManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == d->timer.timerId())
+		reconnect();
+	else
+		QObject::timerEvent(event);
+}
+
+void ReconnectManager::onLoginFinished()
+{
+	d->wanted = true;
+	d->usingEndpoint = false;
+	d->attempt = 0;
+}
+
+void ReconnectManager::onDisconnected()
+{
+	// The login method is replacing the connection
+	if (d->client->d_func()->auth)
+		return;
+	if (!d->enabled || !d->wanted || d->method == ReconnectManagerPrivate::NoMethod)
+		return;
+	AbstractConnection::ConnectionError error = d->client->error();
+	if (d->usingEndpoint) {
+		// The server has not accepted the cookie of the previous session,
+		// so do the full login at once
+		d->usingEndpoint = false;
+		d->bossCookie.clear();
+		if (error != AbstractConnection::AnotherClientLogined) {
+			debug(ConnectionDebug) << "The BOSS endpoint of the last session is rejected";
+			d->timer.start(0, this);
+			return;
+		}
+	}
+	if (!isRecoverable(error)) {
+		d->wanted = false;
+		d->attempt = 0;
+		return;
+	}
+	++d->attempt;
+	if (d->maximumAttempts > 0 && d->attempt > d->maximumAttempts) {
+		d->wanted = false;
+		d->attempt = 0;
+		emit gaveUp();
+		return;
+	}
+	int delay = d->nextDelay();
+	debug(ConnectionDebug) << "Reconnecting in" << delay << "msec, attempt" << d->attempt;
+	d->timer.start(delay, this);
+	emit reconnectScheduled(delay);
+}
+
+void ReconnectManager::onLoginTokenUpdated(const QVariant &token)
+{
+#if IREEN_SSL_SUPPORT
+	// OAuthLoginData is implicitly shared, the user's copy stays untouched
+	if (d->method == ReconnectManagerPrivate::OAuthMethod)
+		d->oauthData.setLastToken(token);
+#else
+	Q_UNUSED(token);
+#endif
+}
+
+} // namespace Ireen
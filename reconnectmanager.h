@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_RECONNECTMANAGER_H
+#define IREEN_RECONNECTMANAGER_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include "abstractconnection.h"
+
+namespace Ireen {
+
+class Client;
+class ReconnectManagerPrivate;
+
+// Brings the client back online after the connection has been lost.
+// Attempts are delayed by a jittered exponential backoff, and the state
+// of the previous session is reused to make them cheap:
+// - the addresses of the login servers are resolved once per process;
+// - the OAuth token updated during the session is used for the next login;
+// - optionally, the BOSS server and the cookie of the last session are tried
+//   first, see setEndpointLifetime().
+// The rate classes of the last session are kept by the connection itself,
+// see AbstractConnection::setPipelinedStartup().
+class IREEN_EXPORT ReconnectManager : public QObject
+{
+	Q_OBJECT
+public:
+	explicit ReconnectManager(Client *client);
+	virtual ~ReconnectManager();
+	Client *client() const;
+	// Reconnecting is disabled by default
+	void setEnabled(bool enabled);
+	bool isEnabled() const;
+	// The delay starts from initialMsec and doubles after every failed attempt,
+	// up to maximumMsec. A random part of up to a half of the delay is subtracted
+	// from it, so the clients disconnected at once do not come back at once.
+	void setDelays(int initialMsec, int maximumMsec);
+	int initialDelay() const;
+	int maximumDelay() const;
+	// 0 means no limit
+	void setMaximumAttempts(int count);
+	int maximumAttempts() const;
+	// Number of the failed attempts since the last successful login
+	int attempt() const;
+	bool isReconnectScheduled() const;
+	// The BOSS server and the cookie of the last session are reused for msec.
+	// OSCAR servers usually accept a cookie only once, and then every reconnect
+	// costs a rejected connection before the full login, so the reuse is
+	// disabled (0) by default. Enable it only for the servers known to accept them.
+	void setEndpointLifetime(int msec);
+	int endpointLifetime() const;
+	void clearCache();
+	// The addresses are shared by all clients of the process, 0 disables the cache
+	static void setAddressCacheLifetime(int msec);
+	static int addressCacheLifetime();
+	static bool isRecoverable(AbstractConnection::ConnectionError error);
+public slots:
+	void reconnect();
+	void cancel();
+signals:
+	void reconnectScheduled(int msec);
+	void reconnecting(int attempt);
+	void gaveUp();
+protected:
+	void timerEvent(QTimerEvent *event);
+private slots:
+	void onLoginFinished();
+	void onDisconnected();
+	void onLoginTokenUpdated(const QVariant &token);
+private:
+	friend class Client;
+	friend class ClientPrivate;
+	QScopedPointer<ReconnectManagerPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_RECONNECTMANAGER_H
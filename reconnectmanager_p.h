@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_RECONNECTMANAGER_P_H
+#define IREEN_RECONNECTMANAGER_P_H
+
+#include "reconnectmanager.h"
+#include "client.h"
+#include <QBasicTimer>
+#include <QDateTime>
+
+namespace Ireen {
+
+class ReconnectManagerPrivate
+{
+public:
+	enum LoginMethod
+	{
+		NoMethod,
+		Md5Method,
+		OAuthMethod
+	};
+	int nextDelay();
+	void setLoginData(const MD5LoginData &data);
+#if IREEN_SSL_SUPPORT
+	void setLoginData(const OAuthLoginData &data);
+#endif
+	void setEndpoint(const QString &host, quint16 port, const QByteArray &cookie);
+	bool hasEndpoint() const;
+	// Process-wide cache of the resolved login servers
+	static QList<QHostAddress> cachedAddresses(const QString &host);
+	static void cacheAddresses(const QString &host, const QList<QHostAddress> &addresses);
+	static void dropAddresses(const QString &host);
+public:
+	ReconnectManager *q;
+	Client *client;
+	bool enabled;
+	// The user wants the client to be online
+	bool wanted;
+	int initialDelay;
+	int maximumDelay;
+	int maximumAttempts;
+	int attempt;
+	QBasicTimer timer;
+	LoginMethod method;
+	MD5LoginData md5Data;
+#if IREEN_SSL_SUPPORT
+	OAuthLoginData oauthData;
+#endif
+	// BOSS endpoint of the last session
+	QString bossHost;
+	quint16 bossPort;
+	QByteArray bossCookie;
+	QDateTime bossExpiresAt;
+	int endpointLifetime;
+	bool usingEndpoint;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_RECONNECTMANAGER_P_H
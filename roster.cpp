@@ -201,7 +201,7 @@ QDateTime StatusItem::statusTextUpdateTime() const
 {
 	if (d->statusData.contains(0x0d)) {
 		quint16 time = d->statusData.value(0x0d).read<quint16>();
-		debug() << "Status note update time" << time;
+		debug(RosterDebug) << "Status note update time" << time;
 		return QDateTime::fromTime_t(time);
 	}
 	return QDateTime();
@@ -217,7 +217,7 @@ QString StatusItem::statusText() const
 		if (!encoding.isEmpty()) {
 			codec = QTextCodec::codecForName(encoding);
 			if (!codec)
-				debug() << "Server sent wrong encoding for status note";
+				debug(RosterDebug) << "Server sent wrong encoding for status note";
 		}
 		if (!codec)
 			codec = Util::utf8Codec();
@@ -319,7 +319,7 @@ void Roster::handleAddModifyCLItem(const FeedbagItem &item, Feedbag::ModifyType
 	case SsiBuddy: {
 		if (item.name().isEmpty())
 			break;
-		debug(DebugVerbose) << "The contact" << item.name() << "has been added or updated";
+		debug(RosterDebug, DebugVerbose) << "The contact" << item.name() << "has been added or updated";
 		ContactItem newContact;
 		newContact.d->setFeedbagItem(item);
 		emit contactItemReceived(newContact);
@@ -331,11 +331,11 @@ void Roster::handleAddModifyCLItem(const FeedbagItem &item, Feedbag::ModifyType
 		if (type == Feedbag::Modify) {
 			FeedbagItem old = item.feedbag()->groupItem(item.groupId());
 			if (old.name() != item.name()) {
-				debug(DebugVerbose) << "The group" << old.name() << "has been renamed to" << item.name();
+				debug(RosterDebug, DebugVerbose) << "The group" << old.name() << "has been renamed to" << item.name();
 				emit groupItemRenamed(item.name(), old.name());
 			}
 		} else {
-			debug(DebugVerbose) << "The group" << item.name() << "has been added";
+			debug(RosterDebug, DebugVerbose) << "The group" << item.name() << "has been added";
 			emit groupItemAdded(item.name());
 
 		}
@@ -348,14 +348,14 @@ void Roster::handleRemoveCLItem(const FeedbagItem &item)
 {
 	switch (item.type()) {
 	case SsiBuddy: {
-		debug(DebugVerbose) << "The contact" << item.name() << "has been removed";
+		debug(RosterDebug, DebugVerbose) << "The contact" << item.name() << "has been removed";
 		emit contactItemRemoved(item.name());
 		break;
 	}
 	case SsiGroup: {
 		if (item.groupId() == 0) // Skip Root group
 			break;
-		debug(DebugVerbose) << "The group" << item.name() << "has been removed";
+		debug(RosterDebug, DebugVerbose) << "The group" << item.name() << "has been removed";
 		emit groupItemRemoved(item.name());
 		break;
 	}
@@ -388,12 +388,16 @@ void Roster::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		handleNewStatus(sn, false);
 		break;
 	case BuddyFamily << 16 | UserSrvReplyBuddy:
-		debug() << IMPLEMENT_ME << "BuddyFamily, UserSrvReplyBuddy";
+		debug(RosterDebug) << IMPLEMENT_ME << "BuddyFamily, UserSrvReplyBuddy";
 		break;
 	case ListsFamily << 16 | ListsAuthRequest: {
 		QString uin = sn.read<QString, quint8>();
 		QString reason = sn.read<QString, qint16>();
-		debug() << QString("Authorization request from \"%1\" with reason \"%2").arg(uin).arg(reason);
+		if (sn.hasError()) {
+			warning(RosterDebug) << "Malformed authorization request";
+			break;
+		}
+		debug(RosterDebug) << QString("Authorization request from \"%1\" with reason \"%2").arg(uin).arg(reason);
 		emit authorizationRequestReceived(uin, reason);
 		break;
 	}
@@ -401,8 +405,12 @@ void Roster::handleSNAC(AbstractConnection *conn, const SNAC &sn)
 		QString uin = sn.read<QString, qint8>();
 		bool isAccepted = sn.read<qint8>();
 		QString reason = sn.read<QString, qint16>();
+		if (sn.hasError()) {
+			warning(RosterDebug) << "Malformed authorization reply";
+			break;
+		}
 		QString verb = isAccepted ? "accepted" : "declined";
-		debug() << QString("Our authorization request to \"%1\" has been %2 with reason \"%3")
+		debug(RosterDebug) << QString("Our authorization request to \"%1\" has been %2 with reason \"%3")
 				   .arg(uin)
 				   .arg(verb)
 				   .arg(reason);
@@ -418,6 +426,10 @@ void Roster::handleNewStatus(const SNAC &snac, bool online)
 	quint16 warning_level = snac.read<quint16>();
 	Q_UNUSED(warning_level);
 	TLVMap tlvs = snac.read<TLVMap, quint16>();
+	if (snac.hasError()) {
+		warning(RosterDebug) << "Malformed status update of" << uin;
+		return;
+	}
 
 	StatusItem status;
 	status.d->setTlvs(tlvs, online);
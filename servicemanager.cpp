@@ -0,0 +1,360 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "servicemanager_p.h"
+#include "client.h"
+#include <QTimerEvent>
+#include <QNetworkProxy>
+
+namespace Ireen {
+
+ServiceConnection::ServiceConnection(quint16 family, Client *client, QObject *parent) :
+	AbstractConnection(parent),
+	m_family(family),
+	m_client(client),
+	m_requestId(0),
+	m_redirected(false)
+{
+	registerHandler(this);
+	socket()->setProxy(client->socket()->proxy());
+	connect(socket(), SIGNAL(readyRead()), SLOT(onActivity()));
+	m_lastActivity.start();
+}
+
+ServiceConnection::~ServiceConnection()
+{
+}
+
+void ServiceConnection::handleSNAC(AbstractConnection *conn, const SNAC &sn)
+{
+	AbstractConnection::handleSNAC(conn, sn);
+	sn.resetState();
+	if (sn.family() == ServiceFamily && sn.subtype() == ServiceServerAsksServices) {
+		SNAC snac(ServiceFamily, ServiceClientReady);
+		snac.append<quint16>(ServiceFamily);
+		snac.append<quint16>(0x0004);
+		snac.append<quint32>(0x0110164f);
+		snac.append<quint16>(m_family);
+		snac.append<quint16>(0x0001);
+		snac.append<quint32>(0x0110164f);
+		send(snac);
+		setState(Connected);
+		emit ready();
+	}
+}
+
+void ServiceConnection::processNewConnection()
+{
+	AbstractConnection::processNewConnection();
+	FLAP flap(0x01);
+	flap.append<quint32>(0x01);
+	flap.appendTLV<QByteArray>(0x0006, m_cookie);
+	m_cookie.clear();
+	send(flap);
+}
+
+void ServiceConnection::connectToService(const QString &host, quint16 port, const QByteArray &cookie)
+{
+	m_cookie = cookie;
+	m_redirected = true;
+	m_lastActivity.start();
+	socket()->connectToHost(host, port);
+}
+
+void ServiceConnection::onActivity()
+{
+	m_lastActivity.start();
+}
+
+bool ServiceManagerPrivate::evictConnection()
+{
+	ServiceConnection *oldest = 0;
+	int oldestIdle = -1;
+	foreach (ServiceConnection *conn, connections) {
+		if (queuedSnacs.contains(conn->family()))
+			continue;
+		int idle = conn->m_lastActivity.elapsed();
+		if (idle > oldestIdle) {
+			oldest = conn;
+			oldestIdle = idle;
+		}
+	}
+	if (!oldest)
+		return false;
+	debug(ConnectionDebug) << "Closing the least recently used service" << hex << oldest->family();
+	removeConnection(oldest);
+	return true;
+}
+
+void ServiceManagerPrivate::removeConnection(ServiceConnection *conn)
+{
+	quint16 family = conn->family();
+	connections.remove(family);
+	queuedSnacs.remove(family);
+	conn->disconnect(q);
+	conn->disconnectFromHost(false);
+	if (isWaitingRedirect(conn))
+		client->requestTracker()->cancel(PendingRequest::SnacKey, conn->m_requestId);
+	conn->deleteLater();
+	updateIdleTimer();
+	emit q->serviceClosed(family);
+}
+
+bool ServiceManagerPrivate::isWaitingRedirect(const ServiceConnection *conn)
+{
+	return !conn->m_redirected;
+}
+
+void ServiceManagerPrivate::onRedirectTimeout(const PendingRequest &request)
+{
+	if (request.status() != PendingRequest::TimedOut)
+		return;
+	foreach (ServiceConnection *conn, connections) {
+		if (isWaitingRedirect(conn) && conn->m_requestId == request.id()) {
+			warning(ConnectionDebug) << "The server has not redirected to the service" << hex << conn->family();
+			removeConnection(conn);
+			break;
+		}
+	}
+}
+
+void ServiceManagerPrivate::updateIdleTimer()
+{
+	if (idleTimeout > 0 && !connections.isEmpty()) {
+		if (!idleTimer.isActive())
+			idleTimer.start(qBound(1000, idleTimeout / 4, 60000), q);
+	} else {
+		idleTimer.stop();
+	}
+}
+
+ServiceManager::ServiceManager(Client *client) :
+	QObject(client), d(new ServiceManagerPrivate(this))
+{
+	d->client = client;
+	d->maximumConnections = 4;
+	d->idleTimeout = 5 * 60 * 1000;
+	d->redirectTimeout = 30 * 1000;
+	m_infos << SNACInfo(ServiceFamily, ServerRedirectService)
+			<< SNACInfo(ServiceFamily, ServiceError);
+	client->registerHandler(this);
+	connect(client, SIGNAL(disconnected()), SLOT(onClientDisconnected()));
+}
+
+ServiceManager::~ServiceManager()
+{
+}
+
+void ServiceManager::registerHandler(quint16 family, SNACHandler *handler)
+{
+	d->handlers.insert(family, handler);
+	if (ServiceConnection *conn = d->connections.value(family))
+		conn->registerHandler(handler);
+}
+
+ServiceConnection *ServiceManager::requestService(quint16 family)
+{
+	if (ServiceConnection *conn = d->connections.value(family))
+		return conn;
+	if (d->client->state() == AbstractConnection::Unconnected)
+		return 0;
+	if (d->connections.size() >= d->maximumConnections && !d->evictConnection()) {
+		warning(ConnectionDebug) << "There is no room for the connection to the service" << hex << family;
+		return 0;
+	}
+	ServiceConnection *conn = new ServiceConnection(family, d->client, this);
+	conn->setPipelinedStartup(d->client->isPipelinedStartup());
+	connect(conn, SIGNAL(ready()), SLOT(onServiceReady()));
+	connect(conn, SIGNAL(disconnected()), SLOT(onServiceDisconnected()));
+	foreach (SNACHandler *handler, d->handlers.values(family))
+		conn->registerHandler(handler);
+	debug(ConnectionDebug) << "Requesting the service" << hex << family;
+	SNAC snac(ServiceFamily, ServiceClientNewService);
+	snac.append<quint16>(family);
+	// Sent past the rate queue to know its id, the server reports errors with it.
+	// There is one such request per connection of the pool.
+	conn->m_requestId = d->client->sendSnac(snac);
+	if (!conn->m_requestId) {
+		delete conn;
+		return 0;
+	}
+	d->client->requestTracker()->start(PendingRequest::SnacKey, conn->m_requestId, d->redirectTimeout,
+									   continuation(d.data(), &ServiceManagerPrivate::onRedirectTimeout));
+	d->connections.insert(family, conn);
+	d->updateIdleTimer();
+	return conn;
+}
+
+ServiceConnection *ServiceManager::connection(quint16 family) const
+{
+	return d->connections.value(family);
+}
+
+QList<ServiceConnection*> ServiceManager::connections() const
+{
+	return d->connections.values();
+}
+
+void ServiceManager::closeService(quint16 family)
+{
+	if (ServiceConnection *conn = d->connections.value(family))
+		d->removeConnection(conn);
+}
+
+void ServiceManager::send(SNAC &snac, bool priority)
+{
+	quint16 family = snac.family();
+	if (d->client->servicesList().contains(family)) {
+		d->client->send(snac, priority);
+		return;
+	}
+	ServiceConnection *conn = requestService(family);
+	if (!conn) {
+		warning(ConnectionDebug) << QString("SNAC(0x%1, 0x%2) is dropped, the service is unavailable")
+									.arg(snac.family(), 4, 16, QChar('0'))
+									.arg(snac.subtype(), 4, 16, QChar('0'));
+		return;
+	}
+	conn->m_lastActivity.start();
+	if (conn->isReady())
+		conn->send(snac, priority);
+	else
+		d->queuedSnacs[family] << QueuedSnac(snac, priority);
+}
+
+void ServiceManager::setMaximumConnections(int count)
+{
+	d->maximumConnections = qMax(count, 1);
+	while (d->connections.size() > d->maximumConnections && d->evictConnection()) {}
+}
+
+int ServiceManager::maximumConnections() const
+{
+	return d->maximumConnections;
+}
+
+void ServiceManager::setIdleTimeout(int msec)
+{
+	d->idleTimeout = msec;
+	d->idleTimer.stop();
+	d->updateIdleTimer();
+}
+
+int ServiceManager::idleTimeout() const
+{
+	return d->idleTimeout;
+}
+
+void ServiceManager::setRedirectTimeout(int msec)
+{
+	d->redirectTimeout = qMax(msec, 0);
+}
+
+int ServiceManager::redirectTimeout() const
+{
+	return d->redirectTimeout;
+}
+
+void ServiceManager::handleSNAC(AbstractConnection *conn, const SNAC &snac)
+{
+	Q_UNUSED(conn);
+	Q_ASSERT(conn == d->client);
+	if (snac.family() == ServiceFamily && snac.subtype() == ServiceError) {
+		foreach (ServiceConnection *service, d->connections) {
+			if (ServiceManagerPrivate::isWaitingRedirect(service) && service->m_requestId == snac.id()) {
+				ProtocolError error(snac);
+				warning(ConnectionDebug) << "The server refused the service" << hex << service->family()
+										 << ":" << error.errorString();
+				d->client->requestTracker()->finish(PendingRequest::SnacKey, service->m_requestId);
+				d->removeConnection(service);
+				break;
+			}
+		}
+		return;
+	}
+	if (snac.family() != ServiceFamily || snac.subtype() != ServerRedirectService)
+		return;
+	TLVMap tlvs = snac.read<TLVMap>();
+	quint16 family = tlvs.value(0x0D).read<quint16>();
+	ServiceConnection *service = d->connections.value(family);
+	// The redirect may be requested by someone else, e.g. by BuddyPictureHandler
+	if (!service || service->socket()->state() != QAbstractSocket::UnconnectedState)
+		return;
+	if (!tlvs.contains(0x05) || !tlvs.contains(0x06)) {
+		warning(ConnectionDebug) << "Invalid redirect to the service" << hex << family;
+		d->removeConnection(service);
+		return;
+	}
+	QList<QByteArray> list = tlvs.value(0x05).data().split(':');
+	quint16 port = list.size() > 1 ? atoi(list.at(1).constData()) : 5190;
+	service->connectToService(list.at(0), port, tlvs.value(0x06).data());
+	d->updateRedirectTimer();
+}
+
+void ServiceManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != d->idleTimer.timerId()) {
+		QObject::timerEvent(event);
+		return;
+	}
+	QList<ServiceConnection*> idleConnections;
+	foreach (ServiceConnection *conn, d->connections) {
+		if (!d->queuedSnacs.contains(conn->family())
+				&& conn->m_lastActivity.elapsed() > d->idleTimeout) {
+			idleConnections << conn;
+		}
+	}
+	foreach (ServiceConnection *conn, idleConnections) {
+		debug(ConnectionDebug) << "Closing the idle service" << hex << conn->family();
+		d->removeConnection(conn);
+	}
+}
+
+void ServiceManager::onServiceReady()
+{
+	ServiceConnection *conn = qobject_cast<ServiceConnection*>(sender());
+	Q_ASSERT(conn);
+	quint16 family = conn->family();
+	QList<QueuedSnac> queue = d->queuedSnacs.take(family);
+	for (int i = 0; i < queue.size(); ++i)
+		conn->send(queue[i].snac, queue[i].priority);
+	emit serviceReady(family);
+}
+
+void ServiceManager::onServiceDisconnected()
+{
+	ServiceConnection *conn = qobject_cast<ServiceConnection*>(sender());
+	Q_ASSERT(conn);
+	if (d->connections.value(conn->family()) == conn)
+		d->removeConnection(conn);
+}
+
+void ServiceManager::onClientDisconnected()
+{
+	foreach (ServiceConnection *conn, d->connections.values())
+		d->removeConnection(conn);
+}
+
+} // namespace Ireen
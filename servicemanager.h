@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_SERVICEMANAGER_H
+#define IREEN_SERVICEMANAGER_H
+
+#include "abstractconnection.h"
+#include <QScopedPointer>
+#include <QTime>
+
+namespace Ireen {
+
+class Client;
+class ServiceManager;
+class ServiceManagerPrivate;
+
+// Connection to the server of a family which is not served by BOSS,
+// it is created by ServiceManager after the redirect
+class IREEN_EXPORT ServiceConnection : public AbstractConnection
+{
+	Q_OBJECT
+public:
+	virtual ~ServiceConnection();
+	quint16 family() const { return m_family; }
+	Client *client() const { return m_client; }
+	bool isReady() const { return state() == Connected; }
+signals:
+	void ready();
+protected:
+	void handleSNAC(AbstractConnection *conn, const SNAC &snac);
+	void processNewConnection();
+private slots:
+	void onActivity();
+private:
+	friend class ServiceManager;
+	friend class ServiceManagerPrivate;
+	ServiceConnection(quint16 family, Client *client, QObject *parent);
+	void connectToService(const QString &host, quint16 port, const QByteArray &cookie);
+	quint16 m_family;
+	Client *m_client;
+	QByteArray m_cookie;
+	QTime m_lastActivity;
+	// Id of the redirect request, its deadline is tracked by the RequestTracker of the client
+	quint32 m_requestId;
+	bool m_redirected;
+};
+
+// Keeps the connections to the auxiliary services of the client.
+// The redirects for different families are requested in parallel,
+// the snacs are routed to the connection of their family and each
+// connection has its own rate classes.
+class IREEN_EXPORT ServiceManager : public QObject, public SNACHandler
+{
+	Q_OBJECT
+	Q_INTERFACES(Ireen::SNACHandler)
+public:
+	explicit ServiceManager(Client *client);
+	virtual ~ServiceManager();
+	// The handler is registered on every connection serving the family
+	void registerHandler(quint16 family, SNACHandler *handler);
+	// Requests the redirect if there is no connection to the family yet,
+	// returns 0 if the client is offline or the pool is full of busy connections
+	ServiceConnection *requestService(quint16 family);
+	ServiceConnection *connection(quint16 family) const;
+	QList<ServiceConnection*> connections() const;
+	void closeService(quint16 family);
+	// Snacs of the families served by BOSS are sent through the client,
+	// all others wait until the connection of their family is ready
+	void send(SNAC &snac, bool priority = true);
+	// The least recently used connection is closed when the limit is reached
+	void setMaximumConnections(int count);
+	int maximumConnections() const;
+	// Connections without traffic are closed after this timeout, 0 disables it
+	void setIdleTimeout(int msec);
+	int idleTimeout() const;
+	// A service is closed together with its queued snacs if the server
+	// has not sent the redirect in time, 30 sec by default.
+	// The timeout is applied to the redirects requested afterwards.
+	void setRedirectTimeout(int msec);
+	int redirectTimeout() const;
+signals:
+	void serviceReady(quint16 family);
+	void serviceClosed(quint16 family);
+protected:
+	void handleSNAC(AbstractConnection *conn, const SNAC &snac);
+	void timerEvent(QTimerEvent *event);
+private slots:
+	void onServiceReady();
+	void onServiceDisconnected();
+	void onClientDisconnected();
+private:
+	QScopedPointer<ServiceManagerPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_SERVICEMANAGER_H
@@ -0,0 +1,65 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_SERVICEMANAGER_P_H
+#define IREEN_SERVICEMANAGER_P_H
+
+#include "servicemanager.h"
+#include "requesttracker.h"
+#include <QBasicTimer>
+#include <QMultiHash>
+
+namespace Ireen {
+
+struct QueuedSnac
+{
+	QueuedSnac(const SNAC &snac_, bool priority_) : snac(snac_), priority(priority_) {}
+	SNAC snac;
+	bool priority;
+};
+
+class ServiceManagerPrivate
+{
+public:
+	ServiceManagerPrivate(ServiceManager *q_ptr) : q(q_ptr) {}
+	bool evictConnection();
+	void removeConnection(ServiceConnection *conn);
+	void updateIdleTimer();
+	void onRedirectTimeout(const PendingRequest &request);
+	static bool isWaitingRedirect(const ServiceConnection *conn);
+	ServiceManager *q;
+	Client *client;
+	QHash<quint16, ServiceConnection*> connections;
+	QHash<quint16, QList<QueuedSnac> > queuedSnacs;
+	QMultiHash<quint16, SNACHandler*> handlers;
+	int maximumConnections;
+	int idleTimeout;
+	QBasicTimer idleTimer;
+	int redirectTimeout;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_SERVICEMANAGER_P_H
@@ -25,19 +25,30 @@
 ****************************************************************************/
 
 #include "status.h"
+#include <QReadWriteLock>
 
 namespace Ireen {
 
-static QSet<QString> allCaps;
+struct CapabilityTypes
+{
+	QReadWriteLock lock;
+	QSet<QString> types;
+};
+
+Q_GLOBAL_STATIC(CapabilityTypes, allCaps)
 
 QSet<QString> Status::allSupportedCapabilityTypes()
 {
-	return allCaps;
+	CapabilityTypes *caps = allCaps();
+	QReadLocker locker(&caps->lock);
+	return caps->types;
 }
 
 void Status::registerCapabilityType(const QString &type)
 {
-	allCaps << type;
+	CapabilityTypes *caps = allCaps();
+	QWriteLocker locker(&caps->lock);
+	caps->types << type;
 }
 
 } // namespace Ireen
@@ -73,4 +73,6 @@ private:
 
 } // namespace Ireen
 
+Q_DECLARE_METATYPE(Ireen::Status)
+
 #endif // IREEN_STATUS_H
@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+// The avatar replies are held back by the latency of the server,
+// so the requests sent meanwhile stay in flight
+static const int replyLatency = 300;
+
+class tst_BuddyPicture : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init();
+	void cleanup();
+	void inFlightCap();
+	void priority();
+	void dedupe();
+	void cancel();
+private:
+	bool connectAccount(TestClient &account);
+	void requestPictures(TestClient &account, int first, int last);
+	MockOscarServer *m_server;
+	QSignalSpy *m_requests;
+};
+
+bool tst_BuddyPicture::connectAccount(TestClient &account)
+{
+	QSignalSpy spy(m_server, SIGNAL(avatarServiceReady(QString)));
+	account.login(m_server);
+	if (!account.waitForLogin() || !TestClient::waitFor(spy, 1))
+		return false;
+	m_server->setLatency(replyLatency);
+	return true;
+}
+
+void tst_BuddyPicture::requestPictures(TestClient &account, int first, int last)
+{
+	for (int i = first; i <= last; ++i) {
+		QString uin = MockOscarServer::contactUin(i);
+		BuddyPicture picture = { MockOscarServer::avatarHash(uin), 1, 1 };
+		account.buddyPictureHandler()->requestPicture(uin, picture);
+	}
+}
+
+void tst_BuddyPicture::init()
+{
+	m_server = new MockOscarServer(this);
+	// Nothing is requested but the pictures requested by the tests
+	m_server->setAvatarsEnabled(false);
+	m_server->setRateLimitsEnabled(false);
+	QVERIFY(m_server->start());
+	m_requests = new QSignalSpy(m_server, SIGNAL(avatarRequested(QString,QString)));
+}
+
+void tst_BuddyPicture::cleanup()
+{
+	delete m_requests;
+	m_requests = 0;
+	delete m_server;
+	m_server = 0;
+}
+
+void tst_BuddyPicture::inFlightCap()
+{
+	TestClient account("1001", TestClient::WithAvatars);
+	QVERIFY(connectAccount(account));
+	requestPictures(account, 0, 9);
+	QVERIFY(TestClient::waitFor(*m_requests, 4));
+	QTest::qWait(replyLatency / 2);
+	QCOMPARE(m_requests->count(), 4);
+	BuddyPictureQueueStats stats = account.buddyPictureHandler()->queueStats();
+	QCOMPARE(stats.inFlight, 4);
+	QCOMPARE(stats.queueLength, 6);
+	// The next requests are sent as the replies arrive
+	QVERIFY(TestClient::waitFor(*m_requests, 8));
+	QVERIFY(account.buddyPictureHandler()->queueStats().inFlight <= 4);
+	QVERIFY(TestClient::waitFor(account.avatars, 10));
+	QCOMPARE(m_requests->count(), 10);
+	stats = account.buddyPictureHandler()->queueStats();
+	QCOMPARE(stats.inFlight, 0);
+	QCOMPARE(stats.queueLength, 0);
+	QCOMPARE(stats.received, quint32(10));
+}
+
+void tst_BuddyPicture::priority()
+{
+	TestClient account("1001", TestClient::WithAvatars);
+	QVERIFY(connectAccount(account));
+	requestPictures(account, 0, 7);
+	QVERIFY(TestClient::waitFor(*m_requests, 4));
+	// The last queued contact is scrolled into view
+	account.buddyPictureHandler()->setContactVisible(MockOscarServer::contactUin(7));
+	QVERIFY(TestClient::waitFor(*m_requests, 5));
+	QCOMPARE(m_requests->at(4).at(1).toString(), MockOscarServer::contactUin(7));
+	QVERIFY(TestClient::waitFor(account.avatars, 8));
+	QTest::qWait(replyLatency);
+	// The contact has left the background queue, so it is requested once
+	QCOMPARE(m_requests->count(), 8);
+	QStringList uins;
+	for (int i = 4; i < m_requests->count(); ++i)
+		uins << m_requests->at(i).at(1).toString();
+	QCOMPARE(uins, QStringList() << MockOscarServer::contactUin(7)
+			 << MockOscarServer::contactUin(4)
+			 << MockOscarServer::contactUin(5)
+			 << MockOscarServer::contactUin(6));
+}
+
+void tst_BuddyPicture::dedupe()
+{
+	TestClient account("1001", TestClient::WithAvatars);
+	QVERIFY(connectAccount(account));
+	requestPictures(account, 0, 4);
+	QVERIFY(TestClient::waitFor(*m_requests, 4));
+	// The first one is in flight and the last one is still queued
+	requestPictures(account, 0, 0);
+	requestPictures(account, 4, 4);
+	BuddyPictureQueueStats stats = account.buddyPictureHandler()->queueStats();
+	QCOMPARE(stats.inFlight, 4);
+	QCOMPARE(stats.queueLength, 1);
+	QVERIFY(TestClient::waitFor(account.avatars, 5));
+	QTest::qWait(replyLatency * 2);
+	QCOMPARE(m_requests->count(), 5);
+	QCOMPARE(account.avatars, 5);
+}
+
+void tst_BuddyPicture::cancel()
+{
+	TestClient account("1001", TestClient::WithAvatars);
+	QVERIFY(connectAccount(account));
+	requestPictures(account, 0, 6);
+	QVERIFY(TestClient::waitFor(*m_requests, 4));
+	account.buddyPictureHandler()->cancelPictureRequest(MockOscarServer::contactUin(4));
+	account.buddyPictureHandler()->cancelPictureRequest(MockOscarServer::contactUin(5));
+	QCOMPARE(account.buddyPictureHandler()->queueStats().queueLength, 1);
+	// The request again takes the last place in the queue
+	requestPictures(account, 4, 4);
+	QCOMPARE(account.buddyPictureHandler()->queueStats().queueLength, 2);
+	QVERIFY(TestClient::waitFor(account.avatars, 6));
+	QTest::qWait(replyLatency * 2);
+	QCOMPARE(m_requests->count(), 6);
+	QCOMPARE(m_requests->at(4).at(1).toString(), MockOscarServer::contactUin(6));
+	QCOMPARE(m_requests->at(5).at(1).toString(), MockOscarServer::contactUin(4));
+}
+
+QTEST_MAIN(tst_BuddyPicture)
+#include "tst_buddypicture.moc"
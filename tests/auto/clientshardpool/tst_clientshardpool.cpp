@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "testshardpool.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class tst_ClientShardPool : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init();
+	void cleanup();
+	void threads();
+	void messages();
+	void destroyClient();
+	void queuedCalls();
+private:
+	MockOscarServer *m_server;
+};
+
+void tst_ClientShardPool::init()
+{
+	m_server = new MockOscarServer(this);
+	QVERIFY(m_server->start());
+}
+
+void tst_ClientShardPool::cleanup()
+{
+	delete m_server;
+	m_server = 0;
+}
+
+void tst_ClientShardPool::threads()
+{
+	TestShardPool pool(3);
+	QCOMPARE(pool.threadCount(), 3);
+	QSet<QThread*> threads;
+	for (int i = 0; i < 6; ++i) {
+		Client *client = pool.createClient(QString::number(1001 + i));
+		QVERIFY(client);
+		QCOMPARE(client->uin(), QString::number(1001 + i));
+		threads << client->thread();
+	}
+	// The clients are spread evenly over the worker threads
+	QCOMPARE(threads.size(), 3);
+	QVERIFY(!threads.contains(QThread::currentThread()));
+	QCOMPARE(pool.clients().size(), 6);
+}
+
+void tst_ClientShardPool::messages()
+{
+	TestShardPool pool(2);
+	QSignalSpy loggedIn(m_server, SIGNAL(clientLoggedIn(QString)));
+	QStringList uins;
+	for (int i = 0; i < 4; ++i) {
+		uins << QString::number(1001 + i);
+		pool.login(pool.createClient(uins.last()), m_server);
+	}
+	QVERIFY(TestClient::waitFor(pool.logins, 4, 10000));
+	QVERIFY(TestClient::waitFor(loggedIn, 4, 10000));
+	for (int i = 0; i < 10; ++i) {
+		foreach (const QString &uin, uins)
+			QVERIFY(m_server->sendMessage(uin, MockOscarServer::contactUin(0), "Hello"));
+	}
+	QVERIFY(TestClient::waitFor(pool.messages, 40, 10000));
+	QCOMPARE(int(pool.messages), 40);
+	// Everything is delivered in the threads of the clients
+	QCOMPARE(int(pool.foreignThreadEvents), 0);
+}
+
+void tst_ClientShardPool::destroyClient()
+{
+	TestShardPool pool(2);
+	QSignalSpy loggedIn(m_server, SIGNAL(clientLoggedIn(QString)));
+	Client *first = pool.createClient("1001");
+	Client *second = pool.createClient("1002");
+	pool.login(first, m_server);
+	pool.login(second, m_server);
+	QVERIFY(TestClient::waitFor(loggedIn, 2, 10000));
+	// A connected client is torn down in its own thread
+	pool.destroyClient(first);
+	QCOMPARE(pool.clients(), QList<Client*>() << second);
+	QVERIFY(m_server->sendMessage("1002", MockOscarServer::contactUin(0), "Hello"));
+	QVERIFY(TestClient::waitFor(pool.messages, 1, 10000));
+}
+
+void tst_ClientShardPool::queuedCalls()
+{
+	TestShardPool pool(2);
+	QSignalSpy loggedIn(m_server, SIGNAL(clientLoggedIn(QString)));
+	QSignalSpy statuses(m_server, SIGNAL(statusReceived(QString,quint16)));
+	Client *client = pool.createClient("1001");
+	// The typed calls of the pool are queued to the thread of the client
+	MD5LoginData data(QLatin1String("password"));
+	data.setLoginServer(m_server->host(), m_server->port());
+	pool.login(client, data);
+	QVERIFY(TestClient::waitFor(pool.logins, 1, 10000));
+	QVERIFY(TestClient::waitFor(loggedIn, 1, 10000));
+	statuses.clear();
+	pool.sendStatus(client, Status(Status::Away));
+	QVERIFY(TestClient::waitFor(statuses, 1, 10000));
+	QCOMPARE(statuses.last().at(1).toUInt(), uint(Status::Away));
+	pool.disconnectFromHost(client, true);
+	QVERIFY(TestClient::waitFor(pool.disconnects, 1, 10000));
+	QCOMPARE(int(pool.foreignThreadEvents), 0);
+}
+
+QTEST_MAIN(tst_ClientShardPool)
+#include "tst_clientshardpool.moc"
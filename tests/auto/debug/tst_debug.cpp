@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "snacreplay.h"
+#include "client.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+// Counts how many times it has been formatted
+struct Formatted
+{
+	static int count;
+};
+
+int Formatted::count = 0;
+
+QDebug operator<<(QDebug dbg, const Formatted &)
+{
+	++Formatted::count;
+	return dbg << "formatted";
+}
+
+static QStringList messages;
+
+static void messageHandler(QtMsgType type, const char *msg)
+{
+	Q_UNUSED(type);
+	// QDebug of Qt 4 leaves the separator after the last item
+	messages << QString::fromLocal8Bit(msg).trimmed();
+}
+
+class tst_Debug : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init();
+	void cleanup();
+	void levels();
+	void categories();
+	void formatting();
+	void macros();
+	void maximumLevel();
+	void unhandledSnac();
+private:
+	QtMsgHandler m_previousHandler;
+};
+
+void tst_Debug::init()
+{
+	messages.clear();
+	Formatted::count = 0;
+	setDebugLevel(DebugInfo);
+	m_previousHandler = qInstallMsgHandler(messageHandler);
+}
+
+void tst_Debug::cleanup()
+{
+	qInstallMsgHandler(m_previousHandler);
+	setDebugLevel(DebugInfo);
+}
+
+void tst_Debug::levels()
+{
+	debug() << "info";
+	debug(DebugVerbose) << "verbose";
+	warning() << "warning";
+	critical() << "critical";
+	QCOMPARE(messages, QStringList() << "info" << "warning" << "critical");
+
+	messages.clear();
+	setDebugLevel(DebugDisabled);
+	QCOMPARE(debugLevel(GeneralDebug), DebugDisabled);
+	debug() << "info";
+	warning() << "warning";
+	critical() << "critical";
+	QVERIFY(messages.isEmpty());
+	QVERIFY(!isDebugEnabled());
+}
+
+void tst_Debug::categories()
+{
+	setDebugLevel(DebugDisabled);
+	setDebugLevel(RosterDebug, DebugVerbose);
+	QCOMPARE(debugLevel(RosterDebug), DebugVerbose);
+	QCOMPARE(debugLevel(ConnectionDebug), DebugDisabled);
+	debug(RosterDebug, DebugVerbose) << "roster";
+	debug(ConnectionDebug) << "connection";
+	debug(MessagesDebug) << "messages";
+	QCOMPARE(messages, QStringList() << "roster");
+}
+
+void tst_Debug::formatting()
+{
+	// The arguments of a disabled stream are not formatted
+	setDebugLevel(ConnectionDebug, DebugInfo);
+	DebugStream disabled = debug(ConnectionDebug, DebugVerbose);
+	QVERIFY(!disabled.isEnabled());
+	disabled << Formatted();
+	QCOMPARE(Formatted::count, 0);
+	debug(ConnectionDebug) << Formatted();
+	QCOMPARE(Formatted::count, 1);
+	QCOMPARE(messages, QStringList() << "formatted");
+}
+
+void tst_Debug::macros()
+{
+	// Nothing after the macro is evaluated for a disabled level
+	int count = 0;
+	setDebugLevel(ConnectionDebug, DebugInfo);
+	IREEN_DEBUG(ConnectionDebug, DebugVerbose) << ++count << Formatted();
+	IREEN_WARNING(ConnectionDebug, DebugVerbose) << ++count;
+	QCOMPARE(count, 0);
+	QCOMPARE(Formatted::count, 0);
+	IREEN_DEBUG(ConnectionDebug) << ++count;
+	IREEN_CRITICAL() << ++count;
+	QCOMPARE(count, 2);
+	QCOMPARE(messages, QStringList() << "1" << "2");
+
+	// The macro is a single statement, the else is not taken by it
+	if (count == 0)
+		IREEN_DEBUG() << "if";
+	else
+		IREEN_DEBUG() << "else";
+	QCOMPARE(messages.last(), QString("else"));
+}
+
+void tst_Debug::maximumLevel()
+{
+	// The levels above the ceiling the library is built with
+	// cannot be enabled at runtime
+	setDebugLevel(DebugVeryVerbose);
+	QCOMPARE(debugLevel(GeneralDebug), debugMaxLevel());
+	QCOMPARE(isDebugEnabled(GeneralDebug, DebugVeryVerbose), DebugVeryVerbose <= debugMaxLevel());
+	QCOMPARE(isDebugEnabled(GeneralDebug, DebugVerbose), DebugVerbose <= debugMaxLevel());
+	QVERIFY(isDebugEnabled(GeneralDebug, DebugInfo));
+}
+
+void tst_Debug::unhandledSnac()
+{
+	Client client("123456789", 0);
+	QByteArray snac = SNAC(0x7777, 0x0001).toByteArray();
+
+	// Nothing is written for the SNACs with the logging off
+	setDebugLevel(ConnectionDebug, DebugDisabled);
+	replaySnac(&client, snac);
+	QVERIFY(messages.isEmpty());
+
+	setDebugLevel(ConnectionDebug, DebugInfo);
+	replaySnac(&client, snac);
+	QCOMPARE(messages.size(), 1);
+	QVERIFY(messages.first().contains("No handlers for SNAC(0x7777, 0x0001)"));
+}
+
+QTEST_MAIN(tst_Debug)
+#include "tst_debug.moc"
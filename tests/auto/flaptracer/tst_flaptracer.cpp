@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "flaptracer.h"
+#include <QtTest>
+#include <QTemporaryFile>
+
+using namespace Ireen;
+
+class tst_FlapTracer : public QObject
+{
+	Q_OBJECT
+private slots:
+	void replay();
+	void connectionIds();
+};
+
+void tst_FlapTracer::replay()
+{
+	MockOscarServer server;
+	QVERIFY(server.start());
+	server.setRosterSize(10);
+	QTemporaryFile capture;
+	QVERIFY(capture.open());
+	FlapTracer tracer;
+	QVERIFY(tracer.open(capture.fileName()));
+	TestClient traced("1001");
+	traced.client()->setTracer(&tracer);
+	traced.login(&server);
+	QVERIFY(traced.waitForLogin());
+	QVERIFY(TestClient::waitFor(traced.contacts, 10));
+	tracer.close();
+	QCOMPARE(tracer.droppedCount(), 0);
+
+	TestClient offline("1001");
+	QVERIFY(FlapTracer::replay(capture.fileName(), offline.client()) > 0);
+	QCOMPARE(offline.contacts, traced.contacts);
+	// The login FLAPs are not replayed, the connection stays offline
+	QCOMPARE(offline.client()->state(), AbstractConnection::Unconnected);
+}
+
+void tst_FlapTracer::connectionIds()
+{
+	FlapTracer tracer;
+	TestClient client("1001");
+	// More connections than fit in a byte get distinct ids
+	QSet<quint16> ids;
+	for (int i = 0; i < 300; ++i)
+		ids << tracer.registerConnection(client.client());
+	QCOMPARE(ids.size(), 300);
+	// The ids of the destroyed connections are reused
+	tracer.unregisterConnection(42);
+	QCOMPARE(tracer.registerConnection(client.client()), quint16(42));
+	QCOMPARE(tracer.registerConnection(client.client()), quint16(300));
+}
+
+QTEST_MAIN(tst_FlapTracer)
+#include "tst_flaptracer.moc"
@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class tst_Liveness : public QObject
+{
+	Q_OBJECT
+private slots:
+	void silentServer();
+};
+
+void tst_Liveness::silentServer()
+{
+	// The mock server sends nothing after the login and does not answer
+	// the probe, so the client has to give up on it by itself.
+	// The checks run every 5 seconds, so this takes about 10 seconds.
+	MockOscarServer server;
+	QVERIFY(server.start());
+	QSignalSpy probes(&server, SIGNAL(infoRequested(QString)));
+	TestClient account("1001");
+	account.client()->setReadIdleTimeout(8000);
+	account.login(&server);
+	QVERIFY(account.waitForLogin());
+	probes.clear();
+	QVERIFY(TestClient::waitFor(probes, 1, 8000));
+	QCOMPARE(account.disconnects, 0);
+	QVERIFY(TestClient::waitFor(account.disconnects, 1, 8000));
+	QCOMPARE(probes.count(), 1);
+	QCOMPARE(account.client()->error(), AbstractConnection::SocketError);
+}
+
+QTEST_MAIN(tst_Liveness)
+#include "tst_liveness.moc"
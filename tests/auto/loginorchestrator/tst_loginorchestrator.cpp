@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "loginorchestrator.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class tst_LoginOrchestrator : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase();
+	void init();
+	void cleanup();
+	void allOnline();
+	void rate();
+	void wrongPassword();
+	void connectionLost();
+private:
+	void addClients(int count, const QString &password = QLatin1String("password"));
+	MockOscarServer *m_server;
+	LoginOrchestrator *m_orchestrator;
+	QList<TestClient*> m_accounts;
+};
+
+void tst_LoginOrchestrator::addClients(int count, const QString &password)
+{
+	for (int i = 0; i < count; ++i) {
+		TestClient *account = new TestClient(QString::number(1001 + i));
+		MD5LoginData data(password);
+		data.setLoginServer(m_server->host(), m_server->port());
+		m_orchestrator->addClient(account->client(), data);
+		m_accounts << account;
+	}
+}
+
+void tst_LoginOrchestrator::initTestCase()
+{
+	qRegisterMetaType<Ireen::Client*>("Ireen::Client*");
+	qRegisterMetaType<Ireen::AbstractConnection::ConnectionError>("Ireen::AbstractConnection::ConnectionError");
+}
+
+void tst_LoginOrchestrator::init()
+{
+	m_server = new MockOscarServer(this);
+	QVERIFY(m_server->start());
+	m_orchestrator = new LoginOrchestrator(this);
+}
+
+void tst_LoginOrchestrator::cleanup()
+{
+	qDeleteAll(m_accounts);
+	m_accounts.clear();
+	delete m_orchestrator;
+	m_orchestrator = 0;
+	delete m_server;
+	m_server = 0;
+}
+
+void tst_LoginOrchestrator::allOnline()
+{
+	addClients(20);
+	m_orchestrator->setRate(1000, 20);
+	QSignalSpy online(m_orchestrator, SIGNAL(clientOnline(Ireen::Client*)));
+	QSignalSpy finished(m_orchestrator, SIGNAL(finished()));
+	m_orchestrator->start();
+	QVERIFY(TestClient::waitFor(finished, 1, 10000));
+	QCOMPARE(online.count(), 20);
+	QCOMPARE(m_orchestrator->onlineCount(), 20);
+	QCOMPARE(m_orchestrator->failedCount(), 0);
+	QCOMPARE(m_orchestrator->pendingCount(), 0);
+	QVERIFY(m_orchestrator->timeToAllOnline() >= 0);
+	QCOMPARE(m_server->loginCount(), 20);
+	foreach (TestClient *account, m_accounts)
+		QCOMPARE(account->logins, 1);
+}
+
+void tst_LoginOrchestrator::rate()
+{
+	// Two logins at once, then one every 50 msec
+	addClients(6);
+	m_orchestrator->setRate(20, 2);
+	QSignalSpy finished(m_orchestrator, SIGNAL(finished()));
+	m_orchestrator->start();
+	QVERIFY(m_orchestrator->inProgressCount() <= 2);
+	QVERIFY(TestClient::waitFor(finished, 1, 10000));
+	QCOMPARE(m_orchestrator->onlineCount(), 6);
+	QVERIFY(m_orchestrator->timeToAllOnline() >= 180);
+}
+
+void tst_LoginOrchestrator::wrongPassword()
+{
+	addClients(3, "wrong");
+	QSignalSpy failed(m_orchestrator, SIGNAL(clientFailed(Ireen::Client*,Ireen::AbstractConnection::ConnectionError)));
+	QSignalSpy finished(m_orchestrator, SIGNAL(finished()));
+	m_orchestrator->start();
+	QVERIFY(TestClient::waitFor(finished, 1, 10000));
+	// The error is not recoverable, the logins are not retried
+	QCOMPARE(failed.count(), 3);
+	QCOMPARE(m_orchestrator->failedCount(), 3);
+	QCOMPARE(m_orchestrator->onlineCount(), 0);
+	QCOMPARE(m_server->loginCount(), 0);
+}
+
+void tst_LoginOrchestrator::connectionLost()
+{
+	addClients(5);
+	m_orchestrator->setRate(1000, 5);
+	QSignalSpy online(m_orchestrator, SIGNAL(clientOnline(Ireen::Client*)));
+	QSignalSpy finished(m_orchestrator, SIGNAL(finished()));
+	m_orchestrator->start();
+	QVERIFY(TestClient::waitFor(finished, 1, 10000));
+	// The clients which drop after coming online are brought back
+	m_server->disconnectClients();
+	QVERIFY(TestClient::waitFor(online, 10, 10000));
+	QCOMPARE(m_orchestrator->onlineCount(), 5);
+	QCOMPARE(m_server->loginCount(), 10);
+}
+
+QTEST_MAIN(tst_LoginOrchestrator)
+#include "tst_loginorchestrator.moc"
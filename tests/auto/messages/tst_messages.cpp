@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "core/messages.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+Q_DECLARE_METATYPE(Ireen::Cookie)
+
+class tst_Messages : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase();
+	void encoding_data();
+	void encoding();
+	void ack();
+	void batchSend();
+};
+
+void tst_Messages::initTestCase()
+{
+	qRegisterMetaType<Ireen::Cookie>("Ireen::Cookie");
+}
+
+void tst_Messages::encoding_data()
+{
+	QTest::addColumn<QString>("uin");
+	QTest::addColumn<QString>("text");
+	QTest::addColumn<bool>("utf16");
+	QTest::addColumn<bool>("storeMessage");
+
+	QTest::newRow("ansi") << "123456789" << "Hello, world!" << false << true;
+	QTest::newRow("utf16") << "123456789" << QString::fromUtf8("Привет, мир!") << true << true;
+	QTest::newRow("no store") << "123456789" << "Hello" << true << false;
+	QTest::newRow("empty") << "1001" << QString() << true << true;
+	QTest::newRow("screenname") << "someone@example.com" << "Hello" << true << true;
+	QTest::newRow("long") << "123456789" << QString(2000, QChar('x')) << true << true;
+}
+
+// The template must encode exactly what the per-recipient constructor does
+void tst_Messages::encoding()
+{
+	QFETCH(QString, uin);
+	QFETCH(QString, text);
+	QFETCH(bool, utf16);
+	QFETCH(bool, storeMessage);
+
+	QTextCodec *codec = utf16 ? Util::utf16Codec() : QTextCodec::codecForName("ISO-8859-1");
+	Channel1MessageData data(text, codec);
+	MessageTemplate message(data, storeMessage, false);
+	Cookie cookie(true);
+	ServerMessage expected(uin, data, cookie, storeMessage);
+	ServerMessage actual(uin, message, cookie);
+	QCOMPARE(actual.toByteArray(), expected.toByteArray());
+
+	// The template is reused for the next recipient, only the header differs
+	Cookie next(true);
+	QCOMPARE(ServerMessage("1002", message, next).toByteArray(),
+			 ServerMessage("1002", data, next, storeMessage).toByteArray());
+}
+
+void tst_Messages::ack()
+{
+	// TLV 3 goes between the message and TLV 6
+	Channel1MessageData data(QString("Hello"));
+	Cookie cookie(true);
+	ServerMessage expected("123456789", data, cookie, false);
+	expected.appendTLV(0x0003);
+	expected.appendTLV(0x0006);
+	QCOMPARE(ServerMessage("123456789", MessageTemplate(data), cookie).toByteArray(),
+			 expected.toByteArray());
+	QVERIFY(MessageTemplate().isEmpty());
+	QVERIFY(!MessageTemplate(data).isEmpty());
+}
+
+void tst_Messages::batchSend()
+{
+	MockOscarServer server;
+	QVERIFY(server.start());
+	TestClient account("1001");
+	account.login(&server);
+	QVERIFY(account.waitForLogin());
+
+	QStringList uins;
+	for (int i = 0; i < 30; ++i)
+		uins << MockOscarServer::contactUin(i);
+	QSignalSpy received(&server, SIGNAL(messageReceived(QString,QString,quint16,QByteArray)));
+	QSignalSpy accepted(account.messageHandler(), SIGNAL(messageAccepted(Ireen::Cookie,QString,quint16)));
+	MessageTemplate message(Channel1MessageData(QString("Hello, everyone")));
+	QList<Cookie> cookies = account.messageHandler()->sendMessage(uins, message);
+	QCOMPARE(cookies.size(), uins.size());
+	QVERIFY(TestClient::waitFor(accepted, uins.size()));
+
+	// Every recipient gets the same body in the order of the list
+	QCOMPARE(received.count(), uins.size());
+	for (int i = 0; i < uins.size(); ++i) {
+		QCOMPARE(received.at(i).at(1).toString(), uins.at(i));
+		QCOMPARE(received.at(i).at(2).toInt(), 1);
+		QCOMPARE(received.at(i).at(3).toByteArray(), message.body());
+	}
+	// Every message is acknowledged with its own cookie
+	QSet<quint64> ids;
+	for (int i = 0; i < uins.size(); ++i) {
+		Cookie cookie = accepted.at(i).at(0).value<Cookie>();
+		QCOMPARE(cookie.id(), cookies.at(i).id());
+		QCOMPARE(accepted.at(i).at(1).toString(), uins.at(i));
+		ids << cookie.id();
+	}
+	QCOMPARE(ids.size(), uins.size());
+	QCOMPARE(account.acceptedMessages, uins.size());
+}
+
+QTEST_MAIN(tst_Messages)
+#include "tst_messages.moc"
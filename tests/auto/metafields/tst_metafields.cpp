@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "metainfo/metafields_p.h"
+#include "baselinefields.h"
+#include <QtTest>
+
+namespace Ireen {
+// It is defined in metafields.cpp but is not used by the library yet
+const FieldNamesTable &maritals();
+}
+
+using namespace Ireen;
+
+typedef const FieldNamesTable *FieldNamesTablePtr;
+typedef QHash<quint32, QString> BaselineTable;
+Q_DECLARE_METATYPE(FieldNamesTablePtr)
+Q_DECLARE_METATYPE(BaselineTable)
+
+class tst_MetaFields : public QObject
+{
+	Q_OBJECT
+private slots:
+	void sorted_data();
+	void sorted();
+	void values_data();
+	void values();
+	void keys_data();
+	void keys();
+};
+
+template <typename Key>
+static BaselineTable toBaseline(const QHash<Key, QString> &hash)
+{
+	BaselineTable result;
+	typename QHash<Key, QString>::const_iterator itr = hash.constBegin();
+	for (; itr != hash.constEnd(); ++itr)
+		result.insert(itr.key(), itr.value());
+	return result;
+}
+
+void tst_MetaFields::sorted_data()
+{
+	QTest::addColumn<FieldNamesTablePtr>("table");
+	QTest::addColumn<BaselineTable>("baseline");
+
+	QTest::newRow("countries") << &countries() << toBaseline(Baseline::init_countries_list());
+	QTest::newRow("interests") << &interests() << toBaseline(Baseline::init_interests_list());
+	QTest::newRow("languages") << &languages() << toBaseline(Baseline::init_languages_list());
+	QTest::newRow("pasts") << &pasts() << toBaseline(Baseline::init_pasts_list());
+	QTest::newRow("genders") << &genders() << toBaseline(Baseline::init_genders_list());
+	QTest::newRow("study_levels") << &study_levels() << toBaseline(Baseline::init_study_levels_list());
+	QTest::newRow("industries") << &industries() << toBaseline(Baseline::init_industries_list());
+	QTest::newRow("occupations") << &occupations() << toBaseline(Baseline::init_occupations_list());
+	QTest::newRow("affilations") << &affilations() << toBaseline(Baseline::init_affilations_list());
+	QTest::newRow("ages") << &ages() << toBaseline(Baseline::init_ages_list());
+	QTest::newRow("maritals") << &maritals() << toBaseline(Baseline::init_maritals_list());
+	QTest::newRow("fields") << &fields() << toBaseline(Baseline::init_fields_list());
+	QTest::newRow("fields_names") << &fields_names() << toBaseline(Baseline::init_fields_names_list());
+}
+
+// FieldNamesTable uses binary search, so the codes must be strictly ascending
+void tst_MetaFields::sorted()
+{
+	QFETCH(FieldNamesTablePtr, table);
+	QFETCH(BaselineTable, baseline);
+
+	QCOMPARE(table->count, baseline.size());
+	for (int i = 1; i < table->count; ++i)
+		QVERIFY2(table->names[i - 1].code < table->names[i].code,
+				 qPrintable(QString::number(table->names[i].code)));
+}
+
+void tst_MetaFields::values_data()
+{
+	sorted_data();
+}
+
+void tst_MetaFields::values()
+{
+	QFETCH(FieldNamesTablePtr, table);
+	QFETCH(BaselineTable, baseline);
+
+	BaselineTable::const_iterator itr = baseline.constBegin();
+	for (; itr != baseline.constEnd(); ++itr) {
+		QVERIFY2(table->contains(itr.key()), qPrintable(itr.value()));
+		QCOMPARE(table->value(itr.key()), itr.value());
+		// No translator is installed, so the names are returned as is
+		QCOMPARE(table->translatedValue(itr.key()), itr.value());
+	}
+	for (int i = 0; i < table->count; ++i)
+		QVERIFY2(baseline.contains(table->names[i].code), table->names[i].text);
+
+	QVERIFY(!table->contains(0xfffffff0));
+	QVERIFY(table->value(0xfffffff0).isNull());
+	QVERIFY(table->translatedValue(0xfffffff0).isNull());
+}
+
+void tst_MetaFields::keys_data()
+{
+	sorted_data();
+}
+
+void tst_MetaFields::keys()
+{
+	QFETCH(FieldNamesTablePtr, table);
+	QFETCH(BaselineTable, baseline);
+
+	BaselineTable::const_iterator itr = baseline.constBegin();
+	for (; itr != baseline.constEnd(); ++itr) {
+		quint32 key = table->key(itr.value());
+		if (baseline.keys(itr.value()).count() == 1) {
+			QCOMPARE(key, baseline.key(itr.value()));
+		} else {
+			// QHash::key() returned any of the codes with the same name,
+			// the table returns the lowest one
+			QList<quint32> codes = baseline.keys(itr.value());
+			qSort(codes);
+			QCOMPARE(key, codes.first());
+		}
+	}
+	QCOMPARE(table->key("There is no such name", 42), quint32(42));
+}
+
+QTEST_MAIN(tst_MetaFields)
+#include "tst_metafields.moc"
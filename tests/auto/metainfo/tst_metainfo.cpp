@@ -0,0 +1,238 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "snacreplay.h"
+#include "metainfo/metainfo.h"
+#include "metainfo/findcontactsmetarequest.h"
+#include "metainfo/infometarequest.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class tst_MetaInfo : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init();
+	void cleanup();
+	void search();
+	void sequence();
+	void malformed();
+	void cachedReply();
+	void cacheTimeout();
+	void clearCache();
+	void canceledLeader();
+private:
+	bool requestInfo(const QString &uin);
+	MockOscarServer *m_server;
+	TestClient *m_account;
+	MetaInfo *m_metaInfo;
+};
+
+void tst_MetaInfo::init()
+{
+	m_server = new MockOscarServer(this);
+	QVERIFY(m_server->start());
+	m_account = new TestClient("1001");
+	m_metaInfo = new MetaInfo(m_account->client());
+	m_account->login(m_server);
+	QVERIFY(m_account->waitForLogin());
+}
+
+void tst_MetaInfo::cleanup()
+{
+	// The handlers are deleted before the client they are registered in
+	delete m_metaInfo;
+	m_metaInfo = 0;
+	delete m_account;
+	m_account = 0;
+	delete m_server;
+	m_server = 0;
+}
+
+void tst_MetaInfo::search()
+{
+	m_server->setSearchResultCount(25);
+	MetaInfoValuesHash values;
+	values.insert(Nick, "Contact");
+	FindContactsMetaRequest request(m_metaInfo, values);
+	QSignalSpy done(&request, SIGNAL(done(bool)));
+	request.send();
+	QVERIFY(TestClient::waitFor(done, 1));
+	QCOMPARE(done.at(0).at(0).toBool(), true);
+	QVERIFY(request.isDone());
+	QCOMPARE(request.contacts().size(), 25);
+	FindContactsMetaRequest::FoundContact contact = request.contacts().value(MockOscarServer::contactUin(7));
+	QCOMPARE(contact.uin, MockOscarServer::contactUin(7));
+	QCOMPARE(contact.nick, QString("Contact 7"));
+	QCOMPARE(contact.firstName, QString("First"));
+	QCOMPARE(contact.lastName, QString("Last"));
+	QCOMPARE(contact.email, QString("contact7@example.com"));
+	QCOMPARE(contact.status, FindContactsMetaRequest::Online);
+	QCOMPARE(contact.age, quint16(27));
+}
+
+void tst_MetaInfo::sequence()
+{
+	// No reply is sent, the request stays open
+	m_server->setSearchResultCount(0);
+	FindContactsMetaRequest request(m_metaInfo);
+	QSignalSpy done(&request, SIGNAL(done(bool)));
+	request.send();
+	QString uin = m_account->client()->uin();
+
+	// The replies are routed to the request with their sequence only
+	replaySnac(m_account->client(), MockOscarServer::searchResult(uin, request.id() + 1, 0, true));
+	QCOMPARE(request.contacts().size(), 0);
+	replaySnac(m_account->client(), MockOscarServer::searchResult(uin, request.id(), 0, false));
+	replaySnac(m_account->client(), MockOscarServer::searchResult(uin, request.id(), 1, false));
+	QCOMPARE(request.contacts().size(), 2);
+	QCOMPARE(done.count(), 0);
+	replaySnac(m_account->client(), MockOscarServer::searchResult(uin, request.id(), 2, true));
+	QCOMPARE(request.contacts().size(), 3);
+	QCOMPARE(done.count(), 1);
+	QVERIFY(request.isDone());
+
+	// The sequence is not routed anywhere after the request has finished
+	replaySnac(m_account->client(), MockOscarServer::searchResult(uin, request.id(), 3, true));
+	QCOMPARE(request.contacts().size(), 3);
+}
+
+void tst_MetaInfo::malformed()
+{
+	m_server->setSearchResultCount(0);
+	FindContactsMetaRequest request(m_metaInfo);
+	request.send();
+	QString uin = m_account->client()->uin();
+	// The meta header is cut off after the uin, the reply is dropped by the client
+	DataUnit header;
+	header.append<quint16>(4, LittleEndian);
+	header.append<quint32>(uin.toUInt(), LittleEndian);
+	SNAC reply(ExtensionsFamily, ExtensionsMetaSrvReply);
+	reply.appendTLV(0x0001, header.data());
+	replaySnac(m_account->client(), reply.toByteArray());
+	QCOMPARE(request.contacts().size(), 0);
+	QVERIFY(!request.isDone());
+	// Without TLV 1 too
+	replaySnac(m_account->client(), SNAC(ExtensionsFamily, ExtensionsMetaSrvReply).toByteArray());
+	QVERIFY(!request.isDone());
+	QCOMPARE(m_account->client()->state(), AbstractConnection::Connected);
+}
+
+bool tst_MetaInfo::requestInfo(const QString &uin)
+{
+	ShortInfoMetaRequest request(m_metaInfo, uin);
+	request.send();
+	QSignalSpy done(&request, SIGNAL(done(bool)));
+	return TestClient::waitFor(done, 1) && request.isDone()
+			&& request.value(Nick).toString() == QLatin1String("Nick ") + uin;
+}
+
+void tst_MetaInfo::cachedReply()
+{
+	QString uin = MockOscarServer::contactUin(0);
+	QVERIFY(requestInfo(uin));
+	QCOMPARE(m_server->metaRequestCount(), 1);
+	// The cached reply comes from the event loop, so it is not missed
+	// by the receivers connected after send()
+	ShortInfoMetaRequest request(m_metaInfo, uin);
+	request.send();
+	QVERIFY(!request.isDone());
+	QSignalSpy done(&request, SIGNAL(done(bool)));
+	QVERIFY(TestClient::waitFor(done, 1));
+	QCOMPARE(done.at(0).at(0).toBool(), true);
+	QCOMPARE(request.value(Nick).toString(), QString("Nick ") + uin);
+	QCOMPARE(m_server->metaRequestCount(), 1);
+
+	// The canceled request does not get the cached reply
+	ShortInfoMetaRequest canceled(m_metaInfo, uin);
+	QSignalSpy canceledDone(&canceled, SIGNAL(done(bool)));
+	canceled.send();
+	canceled.cancel();
+	QTest::qWait(50);
+	QCOMPARE(canceledDone.count(), 1);
+	QCOMPARE(canceledDone.at(0).at(0).toBool(), false);
+	QVERIFY(canceled.value(Nick).isNull());
+}
+
+void tst_MetaInfo::cacheTimeout()
+{
+	m_metaInfo->setCacheTimeout(1);
+	QString uin = MockOscarServer::contactUin(0);
+	QVERIFY(requestInfo(uin));
+	QVERIFY(requestInfo(uin));
+	QCOMPARE(m_server->metaRequestCount(), 1);
+	QTest::qWait(2100);
+	QVERIFY(requestInfo(uin));
+	QCOMPARE(m_server->metaRequestCount(), 2);
+}
+
+void tst_MetaInfo::clearCache()
+{
+	QString first = MockOscarServer::contactUin(0);
+	QString second = MockOscarServer::contactUin(1);
+	QVERIFY(requestInfo(first));
+	QVERIFY(requestInfo(second));
+	QCOMPARE(m_server->metaRequestCount(), 2);
+	m_metaInfo->clearCache(first);
+	QVERIFY(requestInfo(second));
+	QCOMPARE(m_server->metaRequestCount(), 2);
+	QVERIFY(requestInfo(first));
+	QCOMPARE(m_server->metaRequestCount(), 3);
+	m_metaInfo->clearCache();
+	QVERIFY(requestInfo(second));
+	QCOMPARE(m_server->metaRequestCount(), 4);
+}
+
+void tst_MetaInfo::canceledLeader()
+{
+	QString uin = MockOscarServer::contactUin(0);
+	ShortInfoMetaRequest leader(m_metaInfo, uin);
+	ShortInfoMetaRequest first(m_metaInfo, uin);
+	ShortInfoMetaRequest second(m_metaInfo, uin);
+	QSignalSpy leaderDone(&leader, SIGNAL(done(bool)));
+	QSignalSpy firstDone(&first, SIGNAL(done(bool)));
+	QSignalSpy secondDone(&second, SIGNAL(done(bool)));
+	leader.send();
+	first.send();
+	second.send();
+	// The followers wait for the reply to the leader,
+	// the first of them resends the request after it is canceled
+	leader.cancel();
+	QCOMPARE(leaderDone.count(), 1);
+	QVERIFY(TestClient::waitFor(firstDone, 1));
+	QVERIFY(TestClient::waitFor(secondDone, 1));
+	QCOMPARE(firstDone.at(0).at(0).toBool(), true);
+	QCOMPARE(secondDone.at(0).at(0).toBool(), true);
+	QCOMPARE(second.value(Nick).toString(), QString("Nick ") + uin);
+	QCOMPARE(m_server->metaRequestCount(), 2);
+	QCOMPARE(leaderDone.count(), 1);
+	QVERIFY(leader.value(Nick).isNull());
+}
+
+QTEST_MAIN(tst_MetaInfo)
+#include "tst_metainfo.moc"
@@ -0,0 +1,209 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class tst_MockServer : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init();
+	void cleanup();
+	void login();
+	void wrongPassword();
+	void largeRoster();
+	void presenceStorm();
+	void messages();
+	void typingNotifications();
+	void avatars();
+	void latency();
+	void pipelinedLogin();
+	void loss();
+private:
+	bool connectAccount(TestClient &account);
+	MockOscarServer *m_server;
+};
+
+bool tst_MockServer::connectAccount(TestClient &account)
+{
+	// The server may receive ServiceClientReady after the client has finished the login
+	QSignalSpy spy(m_server, SIGNAL(clientLoggedIn(QString)));
+	account.login(m_server);
+	return account.waitForLogin() && TestClient::waitFor(spy, 1);
+}
+
+void tst_MockServer::init()
+{
+	m_server = new MockOscarServer(this);
+	QVERIFY(m_server->start());
+}
+
+void tst_MockServer::cleanup()
+{
+	delete m_server;
+	m_server = 0;
+}
+
+void tst_MockServer::login()
+{
+	QSignalSpy spy(m_server, SIGNAL(clientLoggedIn(QString)));
+	TestClient account("1001");
+	account.login(m_server);
+	QVERIFY(account.waitForLogin());
+	QVERIFY(TestClient::waitFor(spy, 1));
+	QCOMPARE(spy.at(0).at(0).toString(), QString("1001"));
+	QCOMPARE(account.client()->state(), AbstractConnection::Connected);
+	QCOMPARE(account.contacts, m_server->rosterSize());
+	QVERIFY(m_server->isLoggedIn("1001"));
+}
+
+void tst_MockServer::wrongPassword()
+{
+	QSignalSpy spy(m_server, SIGNAL(loginFailed(QString)));
+	TestClient account("1001");
+	account.login(m_server, "wrong");
+	QVERIFY(TestClient::waitFor(account.errors, 1));
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(account.logins, 0);
+	QCOMPARE(m_server->loginCount(), 0);
+}
+
+void tst_MockServer::largeRoster()
+{
+	// Sent in several ListsList packets
+	m_server->setRosterSize(1500);
+	TestClient account("1001");
+	account.login(m_server);
+	QVERIFY(account.waitForLogin(10000));
+	QCOMPARE(account.contacts, 1500);
+}
+
+void tst_MockServer::presenceStorm()
+{
+	m_server->setRosterSize(100);
+	TestClient account("1001");
+	QVERIFY(connectAccount(account));
+	m_server->sendPresenceStorm(1000);
+	QVERIFY(TestClient::waitFor(account.statusUpdates, 1000));
+	m_server->sendPresenceStorm(100, false);
+	QVERIFY(TestClient::waitFor(account.statusUpdates, 1100));
+}
+
+void tst_MockServer::messages()
+{
+	TestClient first("1001");
+	TestClient second("1002");
+	QVERIFY(connectAccount(first));
+	QVERIFY(connectAccount(second));
+	QSignalSpy serverSpy(m_server, SIGNAL(messageReceived(QString,QString,quint16,QByteArray)));
+
+	MessageTemplate message(Channel1MessageData(QString::fromUtf8("Привет")));
+	first.messageHandler()->sendMessage(QStringList() << "1002", message);
+	QVERIFY(TestClient::waitFor(second.messages, 1));
+	QCOMPARE(second.lastMessage, QString::fromUtf8("Привет"));
+	QVERIFY(TestClient::waitFor(first.acceptedMessages, 1));
+	QCOMPARE(serverSpy.count(), 1);
+
+	QVERIFY(m_server->sendMessage("1001", "1003", "Hello"));
+	QVERIFY(TestClient::waitFor(first.messages, 1));
+	QCOMPARE(first.lastMessage, QString("Hello"));
+}
+
+void tst_MockServer::typingNotifications()
+{
+	TestClient account("1001");
+	account.messageHandler()->setTypingNotificationDebounce(0);
+	QVERIFY(connectAccount(account));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(TestClient::waitFor(account.typingNotifications, 1));
+	QCOMPARE(account.lastTypingState, MtnBegun);
+}
+
+void tst_MockServer::avatars()
+{
+	m_server->setRosterSize(20);
+	m_server->setAvatarsEnabled(true);
+	QSignalSpy spy(m_server, SIGNAL(avatarServiceReady(QString)));
+	TestClient account("1001", TestClient::WithAvatars);
+	QVERIFY(connectAccount(account));
+	QVERIFY(TestClient::waitFor(spy, 1));
+	m_server->sendPresenceStorm(20);
+	QVERIFY(TestClient::waitFor(account.avatars, 20));
+	QCOMPARE(account.lastAvatar.left(6), QByteArray("GIF89a"));
+}
+
+void tst_MockServer::latency()
+{
+	const int latency = 50;
+	m_server->setLatency(latency);
+	TestClient account("1001");
+	QTime time;
+	time.start();
+	account.login(m_server);
+	QVERIFY(account.waitForLogin());
+	// At least the hello, the auth key and the login reply of the login server
+	// and the hello, the families, the rates and the roster of BOSS
+	QVERIFY(time.elapsed() >= 7 * latency);
+	QCOMPARE(account.contacts, m_server->rosterSize());
+}
+
+void tst_MockServer::pipelinedLogin()
+{
+	m_server->setLatency(20);
+	TestClient account("1001");
+	account.client()->setPipelinedStartup(true);
+	QVERIFY(connectAccount(account));
+	QCOMPARE(account.contacts, m_server->rosterSize());
+	account.client()->disconnectFromHost(true);
+	QVERIFY(TestClient::waitFor(account.disconnects, 1));
+	// The second session starts the services with the rate classes of the first
+	// one, the snacs queued by them must survive the arrival of the actual rates
+	QSignalSpy spy(m_server, SIGNAL(clientLoggedIn(QString)));
+	account.login(m_server);
+	QVERIFY(TestClient::waitFor(account.logins, 2));
+	QVERIFY(TestClient::waitFor(spy, 1));
+	QCOMPARE(account.client()->state(), AbstractConnection::Connected);
+}
+
+void tst_MockServer::loss()
+{
+	m_server->setLossRate(1.0);
+	TestClient account("1001");
+	QVERIFY(connectAccount(account));
+	m_server->sendPresenceStorm(50);
+	QCOMPARE(m_server->droppedPackets(), 50);
+	// The next packet which cannot be lost is still delivered
+	QVERIFY(m_server->sendMessage("1001", "1002", "Hello"));
+	QVERIFY(TestClient::waitFor(account.messages, 1));
+	QCOMPARE(account.statusUpdates, 0);
+	QCOMPARE(account.client()->state(), AbstractConnection::Connected);
+}
+
+QTEST_MAIN(tst_MockServer)
+#include "tst_mockserver.moc"
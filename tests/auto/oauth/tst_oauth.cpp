@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "mockauthserver.h"
+#include "testclient.h"
+#include <QtTest>
+#include <QSslSocket>
+#include <QTemporaryFile>
+
+using namespace Ireen;
+
+// The OAuth login against the local HTTPS stand-in of the ICQ servers,
+// which sends the clients on to the mock OSCAR server
+class tst_OAuth : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase();
+	void init();
+	void cleanup();
+	void login();
+	void storedToken();
+	void wrongPassword();
+	void connectionReuse();
+	void tokenFile();
+private:
+	TestClient *addAccount(const QString &uin);
+	OAuthLoginData loginData(const QString &password = QLatin1String("password")) const;
+	MockOscarServer *m_server;
+	MockAuthServer *m_auth;
+	QList<TestClient*> m_accounts;
+};
+
+TestClient *tst_OAuth::addAccount(const QString &uin)
+{
+	TestClient *account = new TestClient(uin);
+	m_accounts << account;
+	return account;
+}
+
+OAuthLoginData tst_OAuth::loginData(const QString &password) const
+{
+	OAuthLoginData data;
+	data.setPassword(password);
+	data.setSslMode(false);
+	data.setAuthUrls(m_auth->clientLoginUrl(), m_auth->startSessionUrl());
+	return data;
+}
+
+void tst_OAuth::initTestCase()
+{
+	if (!QSslSocket::supportsSsl())
+		QSKIP("Qt is built without openssl", SkipAll);
+	QSslSocket::addDefaultCaCertificate(MockAuthServer::certificate());
+}
+
+void tst_OAuth::init()
+{
+	OAuthTokenCache::clear();
+	m_server = new MockOscarServer(this);
+	m_auth = new MockAuthServer(m_server, this);
+	QVERIFY(m_server->start());
+	QVERIFY(m_auth->start());
+}
+
+void tst_OAuth::cleanup()
+{
+	qDeleteAll(m_accounts);
+	m_accounts.clear();
+	delete m_auth;
+	m_auth = 0;
+	delete m_server;
+	m_server = 0;
+}
+
+void tst_OAuth::login()
+{
+	TestClient *account = addAccount("1001");
+	account->client()->login(loginData());
+	QVERIFY(account->waitForLogin(10000));
+	QVERIFY(m_server->isLoggedIn("1001"));
+	QCOMPARE(account->errors, 0);
+	QCOMPARE(m_auth->clientLoginCount(), 1);
+	QCOMPARE(m_auth->startSessionCount(), 1);
+	// The token is kept for the next login
+	QVariantMap token = OAuthTokenCache::token("1001").toMap();
+	QCOMPARE(token.value("a").toByteArray(), QByteArray("token-1001"));
+}
+
+void tst_OAuth::storedToken()
+{
+	TestClient *account = addAccount("1001");
+	account->client()->login(loginData());
+	QVERIFY(TestClient::waitFor(account->logins, 1, 10000));
+	account->client()->disconnectFromHost(true);
+	QVERIFY(TestClient::waitFor(account->disconnects, 1));
+	// The second login goes straight to startOSCARSession
+	account->client()->login(loginData());
+	QVERIFY(TestClient::waitFor(account->logins, 2, 10000));
+	QCOMPARE(m_auth->clientLoginCount(), 1);
+	QCOMPARE(m_auth->startSessionCount(), 2);
+}
+
+void tst_OAuth::wrongPassword()
+{
+	TestClient *account = addAccount("1001");
+	account->client()->login(loginData("wrong"));
+	QVERIFY(TestClient::waitFor(account->errors, 1, 10000));
+	QCOMPARE(account->client()->error(), AbstractConnection::MismatchNickOrPassword);
+	QCOMPARE(account->logins, 0);
+	QCOMPARE(m_auth->startSessionCount(), 0);
+	QVERIFY(m_server->loggedInClients().isEmpty());
+	QVERIFY(OAuthTokenCache::token("1001").isNull());
+}
+
+void tst_OAuth::connectionReuse()
+{
+	// The logins share the network manager of the thread,
+	// so the later ones reuse the TLS connection of the first one
+	for (int i = 0; i < 3; ++i) {
+		TestClient *account = addAccount(QString::number(1001 + i));
+		account->client()->login(loginData());
+		QVERIFY(account->waitForLogin(10000));
+	}
+	QCOMPARE(m_auth->clientLoginCount(), 3);
+	QCOMPARE(m_auth->startSessionCount(), 3);
+	QCOMPARE(m_auth->connectionCount(), 1);
+}
+
+void tst_OAuth::tokenFile()
+{
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.setPermissions(file.permissions() | QFile::ReadGroup | QFile::ReadOther);
+	OAuthTokenCache::setFileName(file.fileName());
+	QVariantMap token;
+	token.insert("a", QByteArray("token"));
+	token.insert("expiresAt", QDateTime::currentDateTime().addDays(1).toString(Qt::ISODate));
+	token.insert("sessionSecret", QByteArray("secret"));
+	for (int i = 0; i < 50; ++i)
+		OAuthTokenCache::setToken(QString::number(1001 + i), token);
+	// The tokens are written at once, a while after the first change
+	QCOMPARE(QSettings(file.fileName(), QSettings::IniFormat).childGroups(), QStringList());
+	QTest::qWait(1500);
+	{
+		QSettings settings(file.fileName(), QSettings::IniFormat);
+		settings.beginGroup("tokens");
+		QCOMPARE(settings.childKeys().size(), 50);
+	}
+	QCOMPARE(QFile::permissions(file.fileName()) & (QFile::ReadOther | QFile::ReadGroup),
+			 QFile::Permissions(0));
+	OAuthTokenCache::removeToken("1001");
+	OAuthTokenCache::sync();
+	{
+		QSettings settings(file.fileName(), QSettings::IniFormat);
+		settings.beginGroup("tokens");
+		QCOMPARE(settings.childKeys().size(), 49);
+		QVERIFY(!settings.contains("1001"));
+	}
+	OAuthTokenCache::clear();
+	OAuthTokenCache::setFileName(QString());
+	QCOMPARE(QSettings(file.fileName(), QSettings::IniFormat).childGroups(), QStringList());
+}
+
+QTEST_MAIN(tst_OAuth)
+#include "tst_oauth.moc"
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "reconnectmanager.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class tst_ReconnectManager : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init();
+	void cleanup();
+	void fullLogin();
+	void reusedEndpoint();
+	void rejectedEndpoint();
+private:
+	void reconnect(bool reuseEndpoint);
+	MockOscarServer *m_server;
+	int m_logins;
+};
+
+void tst_ReconnectManager::init()
+{
+	m_server = new MockOscarServer(this);
+	QVERIFY(m_server->start());
+	m_logins = 0;
+}
+
+void tst_ReconnectManager::cleanup()
+{
+	delete m_server;
+	m_server = 0;
+}
+
+// Logs in, drops the connection on the server side and waits until
+// the client comes back, m_logins is set to the number of full logins
+void tst_ReconnectManager::reconnect(bool reuseEndpoint)
+{
+	QSignalSpy loggedIn(m_server, SIGNAL(clientLoggedIn(QString)));
+	TestClient account("1001");
+	ReconnectManager *manager = account.client()->reconnectManager();
+	manager->setEnabled(true);
+	manager->setDelays(50, 500);
+	if (reuseEndpoint)
+		manager->setEndpointLifetime(60 * 1000);
+	account.login(m_server);
+	QVERIFY(TestClient::waitFor(loggedIn, 1));
+	m_server->disconnectClients();
+	QVERIFY(TestClient::waitFor(loggedIn, 2));
+	QCOMPARE(manager->attempt(), 0);
+	m_logins = m_server->loginCount();
+}
+
+void tst_ReconnectManager::fullLogin()
+{
+	QCOMPARE(TestClient("1001").client()->reconnectManager()->endpointLifetime(), 0);
+	reconnect(false);
+	if (QTest::currentTestFailed())
+		return;
+	QCOMPARE(m_logins, 2);
+}
+
+void tst_ReconnectManager::reusedEndpoint()
+{
+	reconnect(true);
+	if (QTest::currentTestFailed())
+		return;
+	QCOMPARE(m_logins, 1);
+}
+
+void tst_ReconnectManager::rejectedEndpoint()
+{
+	// The cookie of the first session is rejected, the client
+	// falls back to the full login at once
+	m_server->setSingleUseCookies(true);
+	reconnect(true);
+	if (QTest::currentTestFailed())
+		return;
+	QCOMPARE(m_logins, 2);
+}
+
+QTEST_MAIN(tst_ReconnectManager)
+#include "tst_reconnectmanager.moc"
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "requesttracker.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+class Recorder
+{
+public:
+	void resolve(const PendingRequest &request)
+	{
+		ids << request.id();
+		statuses << request.status();
+	}
+	QList<quint64> ids;
+	QList<PendingRequest::Status> statuses;
+};
+
+class tst_RequestTracker : public QObject
+{
+	Q_OBJECT
+private slots:
+	void deadlineOrder();
+	void finish();
+	void cancelBeforeTimeout();
+	void restart();
+	void keyTypes();
+};
+
+void tst_RequestTracker::deadlineOrder()
+{
+	RequestTracker tracker;
+	Recorder recorder;
+	tracker.start(PendingRequest::SnacKey, 1, 300, continuation(&recorder, &Recorder::resolve));
+	tracker.start(PendingRequest::SnacKey, 2, 100, continuation(&recorder, &Recorder::resolve));
+	tracker.start(PendingRequest::SnacKey, 3, 200, continuation(&recorder, &Recorder::resolve));
+	QCOMPARE(tracker.inFlightCount(PendingRequest::SnacKey), 3);
+	QTest::qWait(150);
+	QCOMPARE(recorder.ids, QList<quint64>() << 2);
+	QTest::qWait(300);
+	QCOMPARE(recorder.ids, QList<quint64>() << 2 << 3 << 1);
+	foreach (PendingRequest::Status status, recorder.statuses)
+		QCOMPARE(status, PendingRequest::TimedOut);
+	QCOMPARE(tracker.inFlightCount(PendingRequest::SnacKey), 0);
+	QCOMPARE(tracker.statistics(PendingRequest::SnacKey, 0).timedOut, 3u);
+}
+
+void tst_RequestTracker::finish()
+{
+	RequestTracker tracker;
+	Recorder recorder;
+	tracker.start(PendingRequest::CookieKey, 1, 100, continuation(&recorder, &Recorder::resolve));
+	QVERIFY(tracker.contains(PendingRequest::CookieKey, 1));
+	QVERIFY(tracker.finish(PendingRequest::CookieKey, 1));
+	QVERIFY(!tracker.finish(PendingRequest::CookieKey, 1));
+	QCOMPARE(recorder.statuses, QList<PendingRequest::Status>() << PendingRequest::Finished);
+	QTest::qWait(200);
+	QCOMPARE(recorder.ids.size(), 1);
+	QCOMPARE(tracker.statistics(PendingRequest::CookieKey, 0).finished, 1u);
+}
+
+void tst_RequestTracker::cancelBeforeTimeout()
+{
+	RequestTracker tracker;
+	Recorder recorder;
+	tracker.start(PendingRequest::SnacKey, 1, 50, continuation(&recorder, &Recorder::resolve));
+	tracker.start(PendingRequest::SnacKey, 2, 100, continuation(&recorder, &Recorder::resolve));
+	QVERIFY(tracker.cancel(PendingRequest::SnacKey, 1));
+	QVERIFY(!tracker.contains(PendingRequest::SnacKey, 1));
+	QVERIFY(!tracker.cancel(PendingRequest::SnacKey, 1));
+	QTest::qWait(200);
+	// The canceled request never reaches its continuation
+	QCOMPARE(recorder.ids, QList<quint64>() << 2);
+	RequestStatistics stats = tracker.statistics(PendingRequest::SnacKey, 0);
+	QCOMPARE(stats.canceled, 1u);
+	QCOMPARE(stats.timedOut, 1u);
+	QCOMPARE(stats.inFlight, 0);
+}
+
+void tst_RequestTracker::restart()
+{
+	RequestTracker tracker;
+	Recorder first;
+	Recorder second;
+	tracker.start(PendingRequest::MetaSequenceKey, 1, 50, continuation(&first, &Recorder::resolve));
+	tracker.start(PendingRequest::MetaSequenceKey, 1, 300, continuation(&second, &Recorder::resolve));
+	QCOMPARE(tracker.inFlightCount(PendingRequest::MetaSequenceKey), 1);
+	// The first deadline is dropped together with the first request
+	QTest::qWait(150);
+	QVERIFY(first.ids.isEmpty());
+	QVERIFY(second.ids.isEmpty());
+	QVERIFY(tracker.contains(PendingRequest::MetaSequenceKey, 1));
+	QTest::qWait(300);
+	QVERIFY(first.ids.isEmpty());
+	QCOMPARE(second.statuses, QList<PendingRequest::Status>() << PendingRequest::TimedOut);
+	QCOMPARE(tracker.statistics(PendingRequest::MetaSequenceKey, 0).canceled, 1u);
+}
+
+void tst_RequestTracker::keyTypes()
+{
+	RequestTracker tracker;
+	Recorder recorder;
+	tracker.start(PendingRequest::CookieKey, 1, 1000, continuation(&recorder, &Recorder::resolve));
+	tracker.start(PendingRequest::SnacKey, 1, 1000, continuation(&recorder, &Recorder::resolve), 5);
+	QVERIFY(tracker.finish(PendingRequest::SnacKey, 1));
+	QVERIFY(tracker.contains(PendingRequest::CookieKey, 1));
+	QCOMPARE(tracker.kinds(PendingRequest::SnacKey), QList<quint32>() << 5);
+	QCOMPARE(tracker.statistics(PendingRequest::SnacKey, 5).finished, 1u);
+	QCOMPARE(tracker.inFlightCount(PendingRequest::CookieKey), 1);
+}
+
+QTEST_MAIN(tst_RequestTracker)
+#include "tst_requesttracker.moc"
@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include <QtTest>
+
+using namespace Ireen;
+
+Q_DECLARE_METATYPE(Ireen::MTN)
+
+// The outgoing notifications are checked on the server, the incoming ones
+// by the typingNotification() signal. The flush timer of MessageHandler
+// ticks every 100 msec, so the bounds of the timings are loose.
+class tst_Typing : public QObject
+{
+	Q_OBJECT
+private slots:
+	void initTestCase();
+	void init();
+	void cleanup();
+	void coalesce();
+	void redundant();
+	void cancelled();
+	void interval();
+	void contacts();
+	void debounce();
+	void reverted();
+	void debounceDisabled();
+private:
+	static MTN state(const QSignalSpy &spy, int index);
+	MockOscarServer *m_server;
+	TestClient *m_account;
+	QSignalSpy *m_sent;
+	QSignalSpy *m_received;
+};
+
+void tst_Typing::initTestCase()
+{
+	qRegisterMetaType<Ireen::MTN>("Ireen::MTN");
+}
+
+void tst_Typing::init()
+{
+	m_server = new MockOscarServer(this);
+	QVERIFY(m_server->start());
+	m_account = new TestClient("1001");
+	m_sent = new QSignalSpy(m_server, SIGNAL(typingReceived(QString,QString,quint16)));
+	m_received = new QSignalSpy(m_account->messageHandler(), SIGNAL(typingNotification(QString,Ireen::MTN)));
+	// Nothing is sent until the client is ready
+	QSignalSpy loggedIn(m_server, SIGNAL(clientLoggedIn(QString)));
+	m_account->login(m_server);
+	QVERIFY(m_account->waitForLogin());
+	QVERIFY(TestClient::waitFor(loggedIn, 1));
+}
+
+void tst_Typing::cleanup()
+{
+	delete m_received;
+	m_received = 0;
+	delete m_sent;
+	m_sent = 0;
+	delete m_account;
+	m_account = 0;
+	delete m_server;
+	m_server = 0;
+}
+
+MTN tst_Typing::state(const QSignalSpy &spy, int index)
+{
+	return spy.at(index).last().value<Ireen::MTN>();
+}
+
+void tst_Typing::coalesce()
+{
+	MessageHandler *handler = m_account->messageHandler();
+	handler->setTypingNotificationDelays(200, 1000);
+	QTime time;
+	time.start();
+	handler->sendTypingNotification("1002", MtnBegun);
+	handler->sendTypingNotification("1002", MtnTyped);
+	handler->sendTypingNotification("1002", MtnBegun);
+	handler->sendTypingNotification("1002", MtnTyped);
+	QVERIFY(TestClient::waitFor(*m_sent, 1));
+	// The changes within the window are sent as one, with the last state
+	QVERIFY(time.elapsed() >= 180);
+	QCOMPARE(m_sent->at(0).at(1).toString(), QString("1002"));
+	QCOMPARE(m_sent->at(0).at(2).toInt(), int(MtnTyped));
+	QVERIFY(!TestClient::waitFor(*m_sent, 2, 500));
+}
+
+void tst_Typing::redundant()
+{
+	MessageHandler *handler = m_account->messageHandler();
+	handler->setTypingNotificationDelays(0, 0);
+	handler->sendTypingNotification("1002", MtnBegun);
+	QVERIFY(TestClient::waitFor(*m_sent, 1));
+	// The contact already knows the state
+	handler->sendTypingNotification("1002", MtnBegun);
+	handler->sendTypingNotification("1002", MtnBegun);
+	QVERIFY(!TestClient::waitFor(*m_sent, 2, 300));
+	handler->sendTypingNotification("1002", MtnFinished);
+	QVERIFY(TestClient::waitFor(*m_sent, 2));
+	QCOMPARE(m_sent->at(1).at(2).toInt(), int(MtnFinished));
+}
+
+void tst_Typing::cancelled()
+{
+	MessageHandler *handler = m_account->messageHandler();
+	handler->setTypingNotificationDelays(200, 0);
+	// The contact has never seen the typing, so nothing is sent
+	handler->sendTypingNotification("1002", MtnBegun);
+	handler->sendTypingNotification("1002", MtnFinished);
+	QVERIFY(!TestClient::waitFor(*m_sent, 1, 500));
+}
+
+void tst_Typing::interval()
+{
+	MessageHandler *handler = m_account->messageHandler();
+	handler->setTypingNotificationDelays(0, 500);
+	QTime time;
+	time.start();
+	handler->sendTypingNotification("1002", MtnBegun);
+	QVERIFY(TestClient::waitFor(*m_sent, 1));
+	int first = time.elapsed();
+	handler->sendTypingNotification("1002", MtnTyped);
+	QVERIFY(TestClient::waitFor(*m_sent, 2));
+	// A contact gets no more than one notification per interval
+	QVERIFY(time.elapsed() - first >= 450);
+	QCOMPARE(m_sent->at(1).at(2).toInt(), int(MtnTyped));
+}
+
+void tst_Typing::contacts()
+{
+	MessageHandler *handler = m_account->messageHandler();
+	handler->setTypingNotificationDelays(0, 2000);
+	QTime time;
+	time.start();
+	// The interval is kept for every contact on its own
+	handler->sendTypingNotification("1002", MtnBegun);
+	handler->sendTypingNotification("1003", MtnBegun);
+	handler->sendTypingNotification("1004", MtnBegun);
+	QVERIFY(TestClient::waitFor(*m_sent, 3));
+	QVERIFY(time.elapsed() < 1000);
+	QSet<QString> uins;
+	for (int i = 0; i < 3; ++i)
+		uins << m_sent->at(i).at(1).toString();
+	QCOMPARE(uins, QSet<QString>() << "1002" << "1003" << "1004");
+}
+
+void tst_Typing::debounce()
+{
+	m_account->messageHandler()->setTypingNotificationDebounce(300);
+	QTime time;
+	time.start();
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnTyped));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnTyped));
+	// The first change is reported at once, the last state after the debounce delay
+	QVERIFY(TestClient::waitFor(*m_received, 1));
+	QCOMPARE(state(*m_received, 0), MtnBegun);
+	QVERIFY(TestClient::waitFor(*m_received, 2));
+	QVERIFY(time.elapsed() >= 280);
+	QCOMPARE(m_received->at(1).at(0).toString(), QString("1002"));
+	QCOMPARE(state(*m_received, 1), MtnTyped);
+	QVERIFY(!TestClient::waitFor(*m_received, 3, 500));
+
+	// Other contacts are not held back by the debounce of 1002
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnFinished));
+	QVERIFY(m_server->sendTypingNotification("1001", "1003", MtnBegun));
+	QVERIFY(TestClient::waitFor(*m_received, 4));
+	QCOMPARE(m_received->at(2).at(0).toString(), QString("1002"));
+	QCOMPARE(m_received->at(3).at(0).toString(), QString("1003"));
+}
+
+void tst_Typing::reverted()
+{
+	m_account->messageHandler()->setTypingNotificationDebounce(300);
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(TestClient::waitFor(*m_received, 1));
+	// The change is reverted before it is due, the application never sees it
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnTyped));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(!TestClient::waitFor(*m_received, 2, 600));
+}
+
+void tst_Typing::debounceDisabled()
+{
+	m_account->messageHandler()->setTypingNotificationDebounce(0);
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnTyped));
+	QVERIFY(m_server->sendTypingNotification("1001", "1002", MtnBegun));
+	QVERIFY(TestClient::waitFor(*m_received, 3));
+	QCOMPARE(state(*m_received, 2), MtnBegun);
+}
+
+QTEST_MAIN(tst_Typing)
+#include "tst_typing.moc"
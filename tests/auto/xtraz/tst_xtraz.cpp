@@ -0,0 +1,573 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+****************************************************************************/
+
+#include "xtraz.h"
+#include "xtraz_p.h"
+#include <QtTest>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+using namespace Ireen;
+
+typedef QHash<QString, QString> XtrazValues;
+Q_DECLARE_METATYPE(XtrazValues)
+
+// The result of QXmlStreamReader based parsing, which was used before XtrazReader
+struct ParsedXtraz
+{
+	ParsedXtraz() : type(Xtraz::Invalid) {}
+	Xtraz::Type type;
+	QString pluginId;
+	QString service;
+	QString event;
+	XtrazValues values;
+};
+
+class tst_Xtraz : public QObject
+{
+	Q_OBJECT
+private slots:
+	void writer_data();
+	void writer();
+	void roundTrip_data();
+	void roundTrip();
+	void emptyElements();
+	void reader_data();
+	void reader();
+private:
+	void compare(const QByteArray &payload, const ParsedXtraz &expected);
+};
+
+// The request and response documents written by QXmlStreamWriter,
+// the same way XtrazRequest::snac() and XtrazResponse::snac() did it before
+static QString oldRequestBody(const QString &pluginId, const QString &service, const XtrazValues &values)
+{
+	QString query;
+	{
+		QXmlStreamWriter xml(&query);
+		xml.writeStartElement("Q");
+		xml.writeStartElement("PluginID");
+		xml.writeCharacters(pluginId);
+		xml.writeEndElement();
+		xml.writeEndElement();
+		query.replace('"', '\'');
+	}
+	QString notify;
+	{
+		QXmlStreamWriter xml(&notify);
+		xml.writeStartElement("srv");
+		xml.writeStartElement("id");
+		xml.writeCharacters(service);
+		xml.writeEndElement();
+		xml.writeStartElement("req");
+		QHashIterator<QString, QString> itr(values);
+		while (itr.hasNext()) {
+			itr.next();
+			xml.writeStartElement(itr.key());
+			xml.writeCharacters(itr.value());
+			xml.writeEndElement();
+		}
+		xml.writeEndElement();
+		xml.writeEndElement();
+		notify.replace('"', '\'');
+	}
+	QString body;
+	{
+		QXmlStreamWriter xml(&body);
+		xml.writeStartElement("N");
+		xml.writeStartElement("QUERY");
+		xml.writeCharacters(query);
+		xml.writeEndElement();
+		xml.writeStartElement("NOTIFY");
+		xml.writeCharacters(notify);
+		xml.writeEndElement();
+		xml.writeEndElement();
+	}
+	return body;
+}
+
+static QString oldResponseBody(const QString &event, const QString &service, const XtrazValues &values)
+{
+	QString response;
+	{
+		QXmlStreamWriter xml(&response);
+		xml.writeStartElement("ret");
+		xml.writeAttribute("event", event);
+		xml.writeStartElement("srv");
+		xml.writeStartElement("id");
+		xml.writeCharacters(service);
+		xml.writeEndElement();
+		xml.writeStartElement("val");
+		xml.writeAttribute("srv_id", service);
+		xml.writeStartElement("Root");
+		QHashIterator<QString, QString> itr(values);
+		while (itr.hasNext()) {
+			itr.next();
+			xml.writeStartElement(itr.key());
+			xml.writeCharacters(itr.value());
+			xml.writeEndElement();
+		}
+		xml.writeEndElement();
+		xml.writeEndElement();
+		xml.writeEndElement();
+		xml.writeEndElement();
+		response.replace('"', '\'');
+	}
+	QString body;
+	{
+		QXmlStreamWriter xml(&body);
+		xml.writeStartElement("NR");
+		xml.writeStartElement("RES");
+		xml.writeCharacters(response);
+		xml.writeEndElement();
+		xml.writeEndElement();
+	}
+	return body;
+}
+
+// The same documents written by XtrazWriter, as XtrazRequest::snac()
+// and XtrazResponse::snac() do it now
+static QByteArray requestBody(const QString &pluginId, const QString &service, const XtrazValues &values)
+{
+	QByteArray body;
+	XtrazWriter xml(&body);
+	xml.writeStartElement("N");
+	xml.writeStartElement("QUERY");
+	xml.beginEmbedded();
+	xml.writeStartElement("Q");
+	xml.writeTextElement("PluginID", pluginId);
+	xml.writeEndElement();
+	xml.endEmbedded();
+	xml.writeEndElement();
+	xml.writeStartElement("NOTIFY");
+	xml.beginEmbedded();
+	xml.writeStartElement("srv");
+	xml.writeTextElement("id", service);
+	xml.writeStartElement("req");
+	QHashIterator<QString, QString> itr(values);
+	while (itr.hasNext()) {
+		itr.next();
+		xml.writeTextElement(itr.key().toUtf8(), itr.value());
+	}
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.endEmbedded();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	return body;
+}
+
+static QByteArray responseBody(const QString &event, const QString &service, const XtrazValues &values)
+{
+	QByteArray body;
+	XtrazWriter xml(&body);
+	xml.writeStartElement("NR");
+	xml.writeStartElement("RES");
+	xml.beginEmbedded();
+	xml.writeStartElement("ret");
+	xml.writeAttribute("event", event);
+	xml.writeStartElement("srv");
+	xml.writeTextElement("id", service);
+	xml.writeStartElement("val");
+	xml.writeAttribute("srv_id", service);
+	xml.writeStartElement("Root");
+	QHashIterator<QString, QString> itr(values);
+	while (itr.hasNext()) {
+		itr.next();
+		xml.writeTextElement(itr.key().toUtf8(), itr.value());
+	}
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	xml.endEmbedded();
+	xml.writeEndElement();
+	xml.writeEndElement();
+	return body;
+}
+
+// QXmlStreamWriter writes the elements without content as <tag/>,
+// while XtrazWriter always closes them with </tag>
+static QByteArray expandEmptyElements(QString body)
+{
+	body.replace(QRegExp("&lt;([^&/ ]+)/&gt;"), "&lt;\\1&gt;&lt;/\\1&gt;");
+	return body.toUtf8();
+}
+
+// Both parsers normalize the line ends of the text, as XML requires
+static XtrazValues normalizeLineEnds(const XtrazValues &values)
+{
+	XtrazValues result;
+	QHashIterator<QString, QString> itr(values);
+	while (itr.hasNext()) {
+		itr.next();
+		QString value = itr.value();
+		value.replace("\r\n", "\n").replace('\r', '\n');
+		result.insert(itr.key(), value);
+	}
+	return result;
+}
+
+static void oldParseData(QXmlStreamReader &xml, XtrazValues &values)
+{
+	while (!xml.atEnd()) {
+		xml.readNext();
+		if (xml.isStartElement())
+			values.insert(xml.name().toString(), xml.readElementText());
+		else if (xml.isEndElement())
+			return;
+	}
+}
+
+// Parses <srv> of both the requests and the responses, the values
+// are in <req> of a request and in <val><Root> of a response
+static void oldParseSrv(QXmlStreamReader &xml, ParsedXtraz &result)
+{
+	while (!xml.atEnd()) {
+		xml.readNext();
+		if (xml.isStartElement()) {
+			if (xml.name() == "id") {
+				result.service = xml.readElementText();
+			} else if (xml.name() == "req" && result.type == Xtraz::Request) {
+				oldParseData(xml, result.values);
+			} else if (xml.name() == "val" && result.type == Xtraz::Response) {
+				while (!xml.atEnd()) {
+					xml.readNext();
+					if (xml.isStartElement()) {
+						if (xml.name() == "Root")
+							oldParseData(xml, result.values);
+						else
+							xml.skipCurrentElement();
+					} else if (xml.isEndElement()) {
+						break;
+					}
+				}
+			} else {
+				xml.skipCurrentElement();
+			}
+		} else if (xml.isEndElement()) {
+			return;
+		}
+	}
+}
+
+static ParsedXtraz oldParse(const QString &message)
+{
+	ParsedXtraz result;
+	QString query;
+	QString notify;
+	QString response;
+	{
+		QXmlStreamReader xml(message);
+		while (!xml.atEnd()) {
+			xml.readNext();
+			if (xml.isStartElement()) {
+				if (xml.name() == "QUERY")
+					query = xml.readElementText();
+				else if (xml.name() == "NOTIFY")
+					notify = xml.readElementText();
+				else if (xml.name() == "RES")
+					response = xml.readElementText();
+			}
+		}
+	}
+	if (!query.isEmpty() && !notify.isEmpty()) {
+		result.type = Xtraz::Request;
+		QXmlStreamReader xml(query);
+		while (!xml.atEnd()) {
+			xml.readNext();
+			if (xml.isStartElement() && xml.name() == "PluginID")
+				result.pluginId = xml.readElementText();
+		}
+		if (result.pluginId.isEmpty())
+			return result;
+		xml.clear();
+		xml.addData(notify);
+		while (!xml.atEnd()) {
+			xml.readNext();
+			if (xml.isStartElement()) {
+				if (xml.name() == "srv")
+					oldParseSrv(xml, result);
+				else
+					xml.skipCurrentElement();
+			} else if (xml.isEndElement()) {
+				break;
+			}
+		}
+	} else if (!response.isEmpty()) {
+		result.type = Xtraz::Response;
+		QXmlStreamReader xml(response);
+		while (!xml.atEnd()) {
+			xml.readNext();
+			if (xml.isStartElement()) {
+				if (xml.name() != "ret") {
+					xml.skipCurrentElement();
+					continue;
+				}
+				result.event = xml.attributes().value("event").toString();
+				while (!xml.atEnd()) {
+					xml.readNext();
+					if (xml.isStartElement()) {
+						if (xml.name() == "srv")
+							oldParseSrv(xml, result);
+						else
+							xml.skipCurrentElement();
+					} else if (xml.isEndElement()) {
+						break;
+					}
+				}
+			} else if (xml.isEndElement()) {
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+// Parses the payload with Xtraz and checks that it gives the same result as
+// the old parser; the values of Xtraz cannot be enumerated, so only the
+// expected ones are checked
+void tst_Xtraz::compare(const QByteArray &payload, const ParsedXtraz &expected)
+{
+	Xtraz xtraz(payload);
+	QCOMPARE(int(xtraz.type()), int(expected.type));
+	if (expected.type == Xtraz::Request) {
+		XtrazRequest request = xtraz.request();
+		QCOMPARE(request.pluginId(), expected.pluginId);
+		QCOMPARE(request.serviceId(), expected.service);
+		QHashIterator<QString, QString> itr(expected.values);
+		while (itr.hasNext()) {
+			itr.next();
+			QVERIFY2(request.contains(itr.key()), qPrintable(itr.key()));
+			QCOMPARE(request.value(itr.key()), itr.value());
+		}
+	} else if (expected.type == Xtraz::Response) {
+		XtrazResponse response = xtraz.response();
+		QCOMPARE(response.event(), expected.event);
+		QCOMPARE(response.serviceId(), expected.service);
+		QHashIterator<QString, QString> itr(expected.values);
+		while (itr.hasNext()) {
+			itr.next();
+			QVERIFY2(response.contains(itr.key()), qPrintable(itr.key()));
+			QCOMPARE(response.value(itr.key()), itr.value());
+		}
+	}
+}
+
+void tst_Xtraz::writer_data()
+{
+	QTest::addColumn<QString>("pluginId");
+	QTest::addColumn<QString>("service");
+	QTest::addColumn<QString>("event");
+	QTest::addColumn<XtrazValues>("values");
+
+	XtrazValues values;
+	values.insert("id", "AwayStat");
+	values.insert("trans", "1");
+	values.insert("senderId", "123456789");
+	QTest::newRow("away status request") << "srvMng" << "cAwaySrv" << "OnRemoteNotification" << values;
+
+	values.clear();
+	values.insert("CASXtraSetAwayMessage", "");
+	values.insert("uin", "123456789");
+	values.insert("index", "5");
+	values.insert("title", "Coffee");
+	values.insert("desc", "Back in 5 min");
+	QTest::newRow("away status response") << "srvMng" << "cAwaySrv" << "OnRemoteNotification" << values;
+
+	values.clear();
+	values.insert("title", "<b>bold</b> & \"quoted\" 'text'");
+	values.insert("desc", "a &amp; b &lt;c&gt;");
+	QTest::newRow("escaping") << "srv&Mng" << "c<Away>Srv" << "On\"Remote\"Notification" << values;
+
+	values.clear();
+	values.insert("title", "line 1\r\nline 2\tcolumn");
+	values.insert("desc", " leading and trailing spaces ");
+	QTest::newRow("whitespace") << "srvMng" << "cAwaySrv" << "On\nRemote\tNotification\r" << values;
+
+	values.clear();
+	values.insert("title", QString::fromUtf8("\xd0\x9d\xd0\xb0 \xd1\x80\xd0\xb0\xd0\xb1\xd0\xbe\xd1\x82\xd0\xb5"));
+	values.insert(QString::fromUtf8("\xd0\xbe\xd0\xbf\xd0\xb8\xd1\x81\xd0\xb0\xd0\xbd\xd0\xb8\xd0\xb5"),
+				  QString::fromUtf8("\xe2\x98\x95 \xf0\x9f\x98\x80"));
+	QTest::newRow("unicode") << "srvMng" << "cAwaySrv" << "OnRemoteNotification" << values;
+
+	QTest::newRow("no values") << "srvMng" << "cAwaySrv" << "OnRemoteNotification" << XtrazValues();
+}
+
+void tst_Xtraz::writer()
+{
+	QFETCH(QString, pluginId);
+	QFETCH(QString, service);
+	QFETCH(QString, event);
+	QFETCH(XtrazValues, values);
+
+	QCOMPARE(requestBody(pluginId, service, values),
+			 expandEmptyElements(oldRequestBody(pluginId, service, values)));
+	QCOMPARE(responseBody(event, service, values),
+			 expandEmptyElements(oldResponseBody(event, service, values)));
+}
+
+void tst_Xtraz::roundTrip_data()
+{
+	writer_data();
+}
+
+void tst_Xtraz::roundTrip()
+{
+	QFETCH(QString, pluginId);
+	QFETCH(QString, service);
+	QFETCH(QString, event);
+	QFETCH(XtrazValues, values);
+
+	XtrazValues expected = normalizeLineEnds(values);
+	ParsedXtraz request;
+	request.type = Xtraz::Request;
+	request.pluginId = pluginId;
+	request.service = service;
+	request.values = expected;
+
+	ParsedXtraz response;
+	response.type = Xtraz::Response;
+	response.service = service;
+	response.event = event;
+	response.values = expected;
+
+	// The new documents are read back by both parsers
+	QByteArray body = requestBody(pluginId, service, values);
+	ParsedXtraz old = oldParse(QString::fromUtf8(body));
+	QCOMPARE(old.pluginId, pluginId);
+	QCOMPARE(old.service, service);
+	QCOMPARE(old.values, expected);
+	compare(body, request);
+	if (QTest::currentTestFailed())
+		return;
+
+	body = responseBody(event, service, values);
+	old = oldParse(QString::fromUtf8(body));
+	QCOMPARE(old.event, event);
+	QCOMPARE(old.service, service);
+	QCOMPARE(old.values, expected);
+	compare(body, response);
+	if (QTest::currentTestFailed())
+		return;
+
+	// The documents written by QXmlStreamWriter are still understood
+	compare(oldRequestBody(pluginId, service, values).toUtf8(), request);
+	if (QTest::currentTestFailed())
+		return;
+	compare(oldResponseBody(event, service, values).toUtf8(), response);
+}
+
+void tst_Xtraz::emptyElements()
+{
+	XtrazValues values;
+	QString oldRequest = oldRequestBody("srvMng", "cAwaySrv", values);
+	QByteArray request = requestBody("srvMng", "cAwaySrv", values);
+	QVERIFY(oldRequest.contains("&lt;req/&gt;"));
+	QVERIFY(request.contains("&lt;req&gt;&lt;/req&gt;"));
+	QCOMPARE(int(Xtraz(request).type()), int(Xtraz::Request));
+	QCOMPARE(int(Xtraz(oldRequest.toUtf8()).type()), int(Xtraz::Request));
+
+	QString oldResponse = oldResponseBody("OnRemoteNotification", "cAwaySrv", values);
+	QByteArray response = responseBody("OnRemoteNotification", "cAwaySrv", values);
+	QVERIFY(oldResponse.contains("&lt;Root/&gt;"));
+	QVERIFY(response.contains("&lt;Root&gt;&lt;/Root&gt;"));
+	QCOMPARE(oldParse(QString::fromUtf8(response)).service, QString("cAwaySrv"));
+	QCOMPARE(Xtraz(oldResponse.toUtf8()).response().serviceId(), QString("cAwaySrv"));
+
+	// An empty value is written with the closing tag by both writers
+	values.insert("CASXtraSetAwayMessage", QString());
+	QVERIFY(oldResponseBody("OnRemoteNotification", "cAwaySrv", values)
+			.contains("&lt;CASXtraSetAwayMessage&gt;&lt;/CASXtraSetAwayMessage&gt;"));
+	QVERIFY(responseBody("OnRemoteNotification", "cAwaySrv", values)
+			.contains("&lt;CASXtraSetAwayMessage&gt;&lt;/CASXtraSetAwayMessage&gt;"));
+
+	// Empty elements written as <tag/> by the other clients are read as empty values
+	Xtraz xtraz(QByteArray("<NR><RES>&lt;ret event='OnRemoteNotification'&gt;&lt;srv&gt;"
+						   "&lt;id&gt;cAwaySrv&lt;/id&gt;&lt;val srv_id='cAwaySrv'&gt;&lt;Root&gt;"
+						   "&lt;CASXtraSetAwayMessage/&gt;&lt;index&gt;3&lt;/index&gt;"
+						   "&lt;/Root&gt;&lt;/val&gt;&lt;/srv&gt;&lt;/ret&gt;</RES></NR>"));
+	QCOMPARE(int(xtraz.type()), int(Xtraz::Response));
+	QVERIFY(xtraz.response().contains("CASXtraSetAwayMessage"));
+	QCOMPARE(xtraz.response().value("CASXtraSetAwayMessage", "default"), QString());
+	QCOMPARE(xtraz.response().value("index"), QString("3"));
+}
+
+// The payloads captured from the other ICQ clients
+void tst_Xtraz::reader_data()
+{
+	QTest::addColumn<QByteArray>("payload");
+
+	QTest::newRow("request")
+			<< QByteArray("<N><QUERY>&lt;Q&gt;&lt;PluginID&gt;srvMng&lt;/PluginID&gt;&lt;/Q&gt;</QUERY>"
+						  "<NOTIFY>&lt;srv&gt;&lt;id&gt;cAwaySrv&lt;/id&gt;&lt;req&gt;&lt;id&gt;AwayStat&lt;/id&gt;"
+						  "&lt;trans&gt;1&lt;/trans&gt;&lt;senderId&gt;123456789&lt;/senderId&gt;&lt;/req&gt;"
+						  "&lt;/srv&gt;</NOTIFY></N>\r\n");
+	QTest::newRow("request without plugin id")
+			<< QByteArray("<N><QUERY>&lt;Q&gt;&lt;/Q&gt;</QUERY>"
+						  "<NOTIFY>&lt;srv&gt;&lt;id&gt;cAwaySrv&lt;/id&gt;&lt;/srv&gt;</NOTIFY></N>");
+	QTest::newRow("response")
+			<< QByteArray("<NR><RES>&lt;ret event='OnRemoteNotification'&gt;&lt;srv&gt;&lt;id&gt;cAwaySrv&lt;/id&gt;"
+						  "&lt;val srv_id='cAwaySrv'&gt;&lt;Root&gt;&lt;CASXtraSetAwayMessage&gt;&lt;/CASXtraSetAwayMessage&gt;"
+						  "&lt;uin&gt;123456789&lt;/uin&gt;&lt;index&gt;5&lt;/index&gt;&lt;title&gt;Coffee&lt;/title&gt;"
+						  "&lt;desc&gt;Back in 5 min &amp;amp; more&lt;/desc&gt;&lt;/Root&gt;&lt;/val&gt;&lt;/srv&gt;"
+						  "&lt;/ret&gt;</RES></NR>\r\n");
+	QTest::newRow("response with line breaks")
+			<< QByteArray("<NR>\r\n<RES>&lt;ret event='OnRemoteNotification'&gt;\r\n&lt;srv&gt;&lt;id&gt;cAwaySrv&lt;/id&gt;\r\n"
+						  "&lt;val srv_id='cAwaySrv'&gt;&lt;Root&gt;\r\n&lt;uin&gt;123456789&lt;/uin&gt;\r\n"
+						  "&lt;title&gt;Line 1\r\nLine 2&lt;/title&gt;\r\n&lt;/Root&gt;&lt;/val&gt;&lt;/srv&gt;"
+						  "&lt;/ret&gt;</RES>\r\n</NR>\r\n");
+	QTest::newRow("response with character references")
+			<< QByteArray("<NR><RES>&lt;ret event='OnRemoteNotification'&gt;&lt;srv&gt;&lt;id&gt;cAwaySrv&lt;/id&gt;"
+						  "&lt;val srv_id='cAwaySrv'&gt;&lt;Root&gt;&lt;title&gt;&amp;#1053;&amp;#x430; "
+						  "\xd1\x80\xd0\xb0\xd0\xb1\xd0\xbe\xd1\x82\xd0\xb5&lt;/title&gt;&lt;desc&gt;&amp;quot;"
+						  "&amp;apos;&amp;gt;&lt;/desc&gt;&lt;/Root&gt;&lt;/val&gt;&lt;/srv&gt;&lt;/ret&gt;</RES></NR>");
+	QTest::newRow("cdata request")
+			<< QByteArray("<N><QUERY><![CDATA[<Q><PluginID>srvMng</PluginID></Q>]]></QUERY>"
+						  "<NOTIFY><![CDATA[<srv><id>cAwaySrv</id><req><id>AwayStat</id><trans>2</trans>"
+						  "<senderId>123456789</senderId></req></srv>]]></NOTIFY></N>");
+	QTest::newRow("cdata response")
+			<< QByteArray("<NR><RES><![CDATA[<ret event='OnRemoteNotification'><srv><id>cAwaySrv</id>"
+						  "<val srv_id='cAwaySrv'><Root><CASXtraSetAwayMessage></CASXtraSetAwayMessage>"
+						  "<uin>123456789</uin><index>12</index><title>\xd0\x9d\xd0\xb0 \xd1\x80\xd0\xb0\xd0\xb1"
+						  "\xd0\xbe\xd1\x82\xd0\xb5</title><desc>a &amp; b</desc></Root></val></srv></ret>]]>"
+						  "</RES></NR>");
+	QTest::newRow("inner declaration")
+			<< QByteArray("<NR><RES>&lt;?xml version=\"1.0\"?&gt;&lt;ret event='OnRemoteNotification'&gt;"
+						  "&lt;srv&gt;&lt;id&gt;cAwaySrv&lt;/id&gt;&lt;val srv_id='cAwaySrv'&gt;&lt;Root&gt;"
+						  "&lt;index&gt;7&lt;/index&gt;&lt;/Root&gt;&lt;/val&gt;&lt;/srv&gt;&lt;/ret&gt;</RES></NR>");
+	QTest::newRow("not xtraz") << QByteArray("Hello, world!");
+	QTest::newRow("empty") << QByteArray();
+}
+
+void tst_Xtraz::reader()
+{
+	QFETCH(QByteArray, payload);
+	compare(payload, oldParse(QString::fromUtf8(payload)));
+}
+
+QTEST_MAIN(tst_Xtraz)
+#include "tst_xtraz.moc"
@@ -0,0 +1,268 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "benchmarkutils.h"
+#include "core/dataunit.h"
+#include "core/tlv.h"
+#include "core/snac.h"
+#include "core/sessiondataitem.h"
+#include "core/capability.h"
+#include "core/messages.h"
+#include <QCoreApplication>
+
+using namespace Ireen;
+
+// The units are reused until they grow to a few kilobytes,
+// so the cost of the growth is spread over the appends
+template<typename T>
+class AppendInt
+{
+public:
+	AppendInt(ByteOrder bo) : m_bo(bo), m_value(0) {}
+	void operator()()
+	{
+		if (m_unit.data().size() >= 4096)
+			m_unit.setData(QByteArray());
+		m_unit.append<T>(++m_value, m_bo);
+	}
+private:
+	DataUnit m_unit;
+	ByteOrder m_bo;
+	T m_value;
+};
+
+template<typename T>
+class ReadInt
+{
+public:
+	ReadInt(ByteOrder bo) : m_unit(QByteArray(4096, '\x5a')), m_bo(bo) {}
+	void operator()()
+	{
+		if (m_unit.dataSize() < sizeof(T))
+			m_unit.resetState();
+		benchmarkSink(m_unit.read<T>(m_bo));
+	}
+private:
+	DataUnit m_unit;
+	ByteOrder m_bo;
+};
+
+class ReadString
+{
+public:
+	ReadString(QTextCodec *codec) : m_codec(codec)
+	{
+		QString text = QString::fromUtf8("Hello, world! Привет, мир! ");
+		m_unit.append<quint16>(codec->fromUnicode(text.repeated(4)));
+	}
+	void operator()()
+	{
+		m_unit.resetState();
+		benchmarkSink(m_unit.read<QString, quint16>(m_codec).size());
+	}
+private:
+	DataUnit m_unit;
+	QTextCodec *m_codec;
+};
+
+static QByteArray tlvData(int count)
+{
+	DataUnit data;
+	for (int i = 0; i < count; ++i) {
+		if (i % 2)
+			data.appendTLV<quint32>(i, 0x12345678);
+		else
+			data.appendTLV(i, QByteArray("0123456789abcdef"));
+	}
+	return data.data();
+}
+
+class ParseTlvs
+{
+public:
+	ParseTlvs(int count) : m_data(tlvData(count)) {}
+	void operator()()
+	{
+		benchmarkSink(DataUnit(m_data).read<TLVMap>().size());
+	}
+private:
+	QByteArray m_data;
+};
+
+class SerializeTlvs
+{
+public:
+	SerializeTlvs(int count) : m_tlvs(DataUnit(tlvData(count)).read<TLVMap>()) {}
+	void operator()()
+	{
+		benchmarkSink(static_cast<QByteArray>(m_tlvs).size());
+	}
+private:
+	TLVMap m_tlvs;
+};
+
+// The status data of a contact: an avatar hash and a mood
+static QByteArray sessionData()
+{
+	DataUnit data;
+	data.append<quint16>(0x0001);
+	data.append<quint8>(0x01);
+	data.append<quint8>(QByteArray(16, '\x11'));
+	data.append<quint16>(0x000e);
+	data.append<quint8>(0x00);
+	data.append<quint8>(QByteArray("0icqmood23"));
+	return data.data();
+}
+
+class ParseSessionData
+{
+public:
+	ParseSessionData() : m_data(sessionData()) {}
+	void operator()()
+	{
+		SessionDataItemMap items((DataUnit(m_data)));
+		benchmarkSink(items.size());
+	}
+private:
+	QByteArray m_data;
+};
+
+class SerializeSessionData
+{
+public:
+	SerializeSessionData() : m_items(DataUnit(sessionData())) {}
+	void operator()()
+	{
+		benchmarkSink(static_cast<QByteArray>(m_items).size());
+	}
+private:
+	SessionDataItemMap m_items;
+};
+
+class ParseCapability
+{
+public:
+	ParseCapability() : m_data(QByteArray::fromHex("094613494c7f11d18222444553540000")) {}
+	void operator()()
+	{
+		benchmarkSink(Capability(m_data).isEmpty());
+	}
+private:
+	QByteArray m_data;
+};
+
+class ParseSnac
+{
+public:
+	ParseSnac()
+	{
+		// A channel 1 message
+		SNAC snac(MessageFamily, MessageSrvRecv);
+		snac.setId(0x12345678);
+		snac.append<quint64>(Q_UINT64_C(0x0102030405060708));
+		snac.append<quint16>(1);
+		snac.append<quint8>(QByteArray("123456789"));
+		snac.append<quint16>(0);
+		snac.append<quint16>(1);
+		snac.appendTLV<quint16>(0x0001, 0x0050);
+		snac.appendTLV(0x0002, QByteArray(64, 'x'));
+		m_data = snac.toByteArray();
+	}
+	void operator()()
+	{
+		benchmarkSink(SNAC::fromByteArray(m_data).dataSize());
+	}
+private:
+	QByteArray m_data;
+};
+
+// One recipient of a broadcast, the text is encoded for every message
+class EncodeMessage
+{
+public:
+	EncodeMessage() : m_text(QString::fromUtf8("Hello, world! Привет, мир! ").repeated(4)) {}
+	void operator()()
+	{
+		ServerMessage snac("123456789", Channel1MessageData(m_text), Cookie(Q_UINT64_C(0x0102030405060708)));
+		benchmarkSink(snac.toByteArray().size());
+	}
+private:
+	QString m_text;
+};
+
+// The same with the text encoded once into MessageTemplate
+class EncodeMessageTemplate
+{
+public:
+	EncodeMessageTemplate() :
+		m_message(Channel1MessageData(QString::fromUtf8("Hello, world! Привет, мир! ").repeated(4)), true, false)
+	{
+	}
+	void operator()()
+	{
+		ServerMessage snac("123456789", m_message, Cookie(Q_UINT64_C(0x0102030405060708)));
+		benchmarkSink(snac.toByteArray().size());
+	}
+private:
+	MessageTemplate m_message;
+};
+
+template<typename T>
+static void runIntBenchmarks(BenchmarkRunner &runner, const char *type)
+{
+	QString name = QLatin1String("dataunit/%1/") + QLatin1String(type) + QLatin1String("/%2");
+	runner.run(name.arg("append", "be"), AppendInt<T>(BigEndian));
+	runner.run(name.arg("append", "le"), AppendInt<T>(LittleEndian));
+	runner.run(name.arg("read", "be"), ReadInt<T>(BigEndian));
+	runner.run(name.arg("read", "le"), ReadInt<T>(LittleEndian));
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+
+	runIntBenchmarks<quint8>(runner, "quint8");
+	runIntBenchmarks<quint16>(runner, "quint16");
+	runIntBenchmarks<quint32>(runner, "quint32");
+	runIntBenchmarks<quint64>(runner, "quint64");
+
+	runner.run("dataunit/read/qstring/utf8", ReadString(Util::utf8Codec()));
+	runner.run("dataunit/read/qstring/utf16", ReadString(Util::utf16Codec()));
+
+	int tlvCounts[] = { 1, 8, 64 };
+	for (uint i = 0; i < sizeof(tlvCounts) / sizeof(int); ++i) {
+		runner.run(QString("tlvmap/parse/%1").arg(tlvCounts[i]), ParseTlvs(tlvCounts[i]));
+		runner.run(QString("tlvmap/serialize/%1").arg(tlvCounts[i]), SerializeTlvs(tlvCounts[i]));
+	}
+
+	runner.run("sessiondataitemmap/parse", ParseSessionData());
+	runner.run("sessiondataitemmap/serialize", SerializeSessionData());
+	runner.run("capability/fromByteArray", ParseCapability());
+	runner.run("snac/fromByteArray", ParseSnac());
+	runner.run("servermessage/encode/channel1", EncodeMessage());
+	runner.run("servermessage/encode/template", EncodeMessageTemplate());
+	return 0;
+}
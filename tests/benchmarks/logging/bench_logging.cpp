@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "benchmarkutils.h"
+#include "snacreplay.h"
+#include "client.h"
+#include "feedbag.h"
+#include "roster.h"
+#include <QCoreApplication>
+
+using namespace Ireen;
+
+// The output is measured up to qt_message_output(), not the terminal
+static void silentMessageHandler(QtMsgType, const char *)
+{
+}
+
+// A verbose message with the usual set of arguments
+class DebugMessage
+{
+public:
+	DebugMessage() : m_uin("100000"), m_value(0) {}
+	void operator()()
+	{
+		debug(RosterDebug, DebugVerbose) << "Receive item:" << m_uin << ++m_value << hex << 0x0003;
+	}
+private:
+	QString m_uin;
+	int m_value;
+};
+
+// The same message through the macro, which skips the arguments
+// of the disabled levels as the library does
+class MacroMessage
+{
+public:
+	MacroMessage() : m_uin("100000"), m_value(0) {}
+	void operator()()
+	{
+		IREEN_DEBUG(RosterDebug, DebugVerbose) << "Receive item:" << m_uin << ++m_value << hex << 0x0003;
+	}
+private:
+	QString m_uin;
+	int m_value;
+};
+
+// Feeds the same SNAC to the client over and over
+class ProcessSnac
+{
+public:
+	ProcessSnac(Client *client, const SNAC &snac) : m_client(client), m_data(snac.toByteArray()) {}
+	void operator()()
+	{
+		replaySnac(m_client, m_data);
+	}
+private:
+	Client *m_client;
+	QByteArray m_data;
+};
+
+// A presence notification of a contact, the most frequent SNAC of a big roster
+static SNAC userOnline()
+{
+	SNAC snac(BuddyFamily, UserOnline);
+	snac.append<quint8>(QByteArray("100000"));
+	snac.append<quint16>(0); // warning level
+	snac.append<quint16>(2);
+	snac.appendTLV<quint16>(0x0001, 0x0050); // user class
+	snac.appendTLV<quint32>(0x0006, 0x00000001); // away
+	return snac;
+}
+
+// Measures what the logging costs per message and per SNAC with the levels
+// off, at the default level and with everything enabled
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	qInstallMsgHandler(silentMessageHandler);
+
+	Client client("123456789", 0);
+	Feedbag feedbag(&client);
+	Roster roster(&client, &feedbag);
+	SNAC online = userOnline();
+	// No handler is registered for this one, it is reported as a warning
+	SNAC unknown(0x7777, 0x0001);
+
+	struct Level
+	{
+		const char *name;
+		DebugLevel level;
+	} levels[] = {
+		{ "off", DebugDisabled },
+		{ "info", DebugInfo },
+		{ "veryverbose", DebugVeryVerbose }
+	};
+	for (uint i = 0; i < sizeof(levels) / sizeof(Level); ++i) {
+		setDebugLevel(levels[i].level);
+		runner.run(QString("logging/message/%1").arg(levels[i].name), DebugMessage());
+		runner.run(QString("logging/macro/%1").arg(levels[i].name), MacroMessage());
+		runner.run(QString("logging/snac/useronline/%1").arg(levels[i].name), ProcessSnac(&client, online));
+		runner.run(QString("logging/snac/unhandled/%1").arg(levels[i].name), ProcessSnac(&client, unknown));
+	}
+	return 0;
+}
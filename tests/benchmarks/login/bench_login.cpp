@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "benchmarkutils.h"
+#include <QCoreApplication>
+#include <stdio.h>
+
+using namespace Ireen;
+
+// Measures the time from Client::login() to loginFinished() against the mock
+// server with the injected latency, for the lock-step and the pipelined startup.
+// The first login of an account negotiates everything, the next ones may reuse
+// the rate classes of the previous session.
+//   -logins <count>  the number of the logins of the account, 10 by default
+//   -latency <msec>  the latency of the server, 50 by default
+static void runLogins(BenchmarkRunner &runner, MockOscarServer &server, bool pipelined)
+{
+	int count = qMax(runner.intArgument("logins", 10), 2);
+	QString name = QString("login/%1/%2ms").arg(pipelined ? "pipelined" : "lockstep").arg(server.latency());
+	if (!runner.isEnabled(name))
+		return;
+
+	TestClient account(pipelined ? "400001" : "400000");
+	account.client()->setPipelinedStartup(pipelined);
+	qint64 first = 0;
+	qint64 next = 0;
+	for (int i = 0; i < count; ++i) {
+		qint64 start = benchmarkClock();
+		account.login(&server);
+		if (!TestClient::waitFor(account.logins, i + 1, 30000)) {
+			fprintf(stderr, "%s: login %d has not finished\n", qPrintable(name), i + 1);
+			return;
+		}
+		qint64 elapsed = benchmarkClock() - start;
+		if (i == 0)
+			first = elapsed;
+		else
+			next += elapsed;
+		account.client()->disconnectFromHost(true);
+		if (!TestClient::waitFor(account.disconnects, i + 1, 30000)) {
+			fprintf(stderr, "%s: the client has not disconnected\n", qPrintable(name));
+			return;
+		}
+	}
+
+	BenchmarkResult result(name);
+	result.add("logins", count);
+	result.add("first_login_ms", first / 1e6);
+	result.add("login_ms", next / 1e6 / (count - 1));
+	// The number of the round trips the startup takes
+	if (server.latency() > 0)
+		result.add("login_rtts", next / 1e6 / (count - 1) / server.latency());
+	runner.report(result);
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	setDebugLevel(DebugDisabled);
+
+	MockOscarServer server;
+	server.setRosterSize(200);
+	server.setLatency(runner.intArgument("latency", 50));
+	if (!server.start()) {
+		fprintf(stderr, "Cannot start the mock server\n");
+		return 1;
+	}
+	runLogins(runner, server, false);
+	runLogins(runner, server, true);
+	return 0;
+}
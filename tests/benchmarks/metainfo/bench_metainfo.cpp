@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "snacreplay.h"
+#include "benchmarkutils.h"
+#include "metainfo/metainfo.h"
+#include "metainfo/findcontactsmetarequest.h"
+#include <QCoreApplication>
+#include <stdio.h>
+
+using namespace Ireen;
+
+// Replays one reply of the meta server over and over
+class ReplayReply
+{
+public:
+	ReplayReply(Client *client, const QByteArray &reply) : m_client(client), m_reply(reply) {}
+	void operator()()
+	{
+		replaySnac(m_client, m_reply);
+	}
+private:
+	Client *m_client;
+	QByteArray m_reply;
+};
+
+// Sends a white pages search and replays all its results
+class ReplaySearch
+{
+public:
+	ReplaySearch(MetaInfo *metaInfo, int count) : m_metaInfo(metaInfo)
+	{
+		QString uin = m_metaInfo->client()->uin();
+		for (int i = 0; i < count; ++i)
+			m_replies << MockOscarServer::searchResult(uin, 0, i, i == count - 1).toByteArray();
+	}
+	void operator()()
+	{
+		FindContactsMetaRequest request(m_metaInfo);
+		request.send();
+		for (int i = 0; i < m_replies.size(); ++i) {
+			// The sequence of the request is patched into the meta header which follows
+			// the SNAC header, the TLV header, the field length, the uin and the meta type
+			QByteArray &reply = m_replies[i];
+			reply[22] = request.id() & 0xff;
+			reply[23] = request.id() >> 8;
+			replaySnac(m_metaInfo->client(), reply);
+		}
+		benchmarkSink(request.contacts().size());
+	}
+private:
+	MetaInfo *m_metaInfo;
+	QList<QByteArray> m_replies;
+};
+
+// Measures the routing of the meta server replies through the client to
+// the search requests of MetaInfo, the replies are replayed in-process.
+//   -results <count>  the number of the contacts found by a search, 100 by default
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	setDebugLevel(DebugDisabled);
+
+	MockOscarServer server;
+	// The requests are not throttled and the server does not answer them,
+	// only the replayed replies reach the requests
+	server.setRateLimitsEnabled(false);
+	server.setSearchResultCount(0);
+	if (!server.start()) {
+		fprintf(stderr, "Cannot start the mock server\n");
+		return 1;
+	}
+	TestClient account("800000");
+	MetaInfo *metaInfo = new MetaInfo(account.client());
+	account.login(&server);
+	if (!account.waitForLogin()) {
+		fprintf(stderr, "The client has not logged in\n");
+		return 1;
+	}
+	QString uin = account.client()->uin();
+	int results = qMax(runner.intArgument("results", 100), 1);
+
+	{
+		// A search which is never finished, every reply adds the same contact to it
+		FindContactsMetaRequest request(metaInfo);
+		request.send();
+		runner.run("metainfo/replay/result", ReplayReply(account.client(),
+				MockOscarServer::searchResult(uin, request.id(), 0, false)));
+		runner.run("metainfo/replay/unknownsequence", ReplayReply(account.client(),
+				MockOscarServer::searchResult(uin, request.id() + 1, 0, false)));
+	}
+	runner.run(QString("metainfo/replay/search/%1").arg(results), ReplaySearch(metaInfo, results));
+
+	delete metaInfo;
+	return 0;
+}
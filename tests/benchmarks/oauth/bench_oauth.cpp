@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "mockauthserver.h"
+#include "testclient.h"
+#include "benchmarkutils.h"
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <QSslSocket>
+#include <stdio.h>
+
+using namespace Ireen;
+
+// Starts the OAuth logins of all the accounts at once against the local HTTPS
+// stand-in of the ICQ servers and measures the time until the last of them
+// is online on the mock OSCAR server. The first run gets the tokens with
+// clientLogin, the second one reuses them and goes straight to startOSCARSession.
+// The connections to the authorization server are counted to see how well
+// the logins share them.
+//   -clients <count>  the number of the accounts, 100 by default
+struct LoginRun
+{
+	qint64 elapsed;
+	int connections;
+	int requests;
+};
+
+static bool loginAll(MockOscarServer &server, const QList<TestClient*> &accounts, LoginRun &run)
+{
+	// A new port every time, so the connections of the previous run are not reused
+	MockAuthServer auth(&server);
+	if (!auth.start()) {
+		fprintf(stderr, "Cannot start the authorization server\n");
+		return false;
+	}
+	OAuthLoginData data;
+	data.setPassword(QLatin1String("password"));
+	data.setSslMode(false);
+	data.setAuthUrls(auth.clientLoginUrl(), auth.startSessionUrl());
+
+	QSignalSpy online(&server, SIGNAL(clientLoggedIn(QString)));
+	qint64 start = benchmarkClock();
+	foreach (TestClient *account, accounts)
+		account->client()->login(data);
+	bool ok = TestClient::waitFor(online, accounts.size(), 60000);
+	run.elapsed = benchmarkClock() - start;
+	run.connections = auth.connectionCount();
+	run.requests = auth.clientLoginCount() + auth.startSessionCount();
+
+	foreach (TestClient *account, accounts) {
+		int disconnects = account->disconnects + 1;
+		account->client()->disconnectFromHost(true);
+		TestClient::waitFor(account->disconnects, disconnects);
+	}
+	return ok;
+}
+
+static void runLogins(BenchmarkRunner &runner, MockOscarServer &server,
+					  const QList<TestClient*> &accounts, bool storedToken)
+{
+	QString name = QString("oauth/%1/%2").arg(storedToken ? "storedtoken" : "login").arg(accounts.size());
+	if (!runner.isEnabled(name))
+		return;
+
+	LoginRun run;
+	if (!storedToken) {
+		OAuthTokenCache::clear();
+	} else if (OAuthTokenCache::token(accounts.first()->client()->uin()).isNull()) {
+		// The login run has been filtered out, get the tokens first
+		if (!loginAll(server, accounts, run)) {
+			fprintf(stderr, "%s: cannot get the tokens\n", qPrintable(name));
+			return;
+		}
+	}
+	if (!loginAll(server, accounts, run)) {
+		fprintf(stderr, "%s: not all the clients are online\n", qPrintable(name));
+		return;
+	}
+
+	BenchmarkResult result(name);
+	result.add("clients", accounts.size());
+	result.add("ms", run.elapsed / 1e6);
+	result.add("logins_per_sec", accounts.size() * 1e9 / run.elapsed);
+	result.add("tls_connections", run.connections);
+	result.add("http_requests", run.requests);
+	runner.report(result);
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	setDebugLevel(DebugDisabled);
+
+	if (!QSslSocket::supportsSsl()) {
+		fprintf(stderr, "Qt is built without openssl\n");
+		return 1;
+	}
+	QSslSocket::addDefaultCaCertificate(MockAuthServer::certificate());
+	MockOscarServer server;
+	if (!server.start()) {
+		fprintf(stderr, "Cannot start the mock server\n");
+		return 1;
+	}
+	int count = qMax(runner.intArgument("clients", 100), 1);
+	QList<TestClient*> accounts;
+	for (int i = 0; i < count; ++i)
+		accounts << new TestClient(QString::number(700000 + i));
+	runLogins(runner, server, accounts, false);
+	runLogins(runner, server, accounts, true);
+	qDeleteAll(accounts);
+	return 0;
+}
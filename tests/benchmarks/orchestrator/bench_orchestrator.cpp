@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "benchmarkutils.h"
+#include "loginorchestrator.h"
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <stdio.h>
+
+using namespace Ireen;
+
+// Measures the time it takes LoginOrchestrator to bring all the accounts
+// online against the mock server, with the configured admission rate and
+// without any throttling at all.
+//   -clients <count>  the number of the accounts, 100 by default
+//   -rate <count>     the logins per second, 50 by default
+//   -burst <count>    the logins admitted at once, 10 by default
+//   -latency <msec>   the latency of the server, 0 by default
+static void runOrchestrator(BenchmarkRunner &runner, MockOscarServer &server, bool throttled)
+{
+	int count = qMax(runner.intArgument("clients", 100), 1);
+	int rate = qMax(runner.intArgument("rate", 50), 1);
+	int burst = qMax(runner.intArgument("burst", 10), 1);
+	QString name = QString("orchestrator/%1/%2").arg(throttled ? "throttled" : "unthrottled").arg(count);
+	if (!runner.isEnabled(name))
+		return;
+
+	QList<TestClient*> accounts;
+	LoginOrchestrator orchestrator;
+	if (throttled) {
+		orchestrator.setRate(rate, burst);
+	} else {
+		orchestrator.setRate(count * 1000, count);
+		orchestrator.setMaximumInProgress(0);
+	}
+	int uin = throttled ? 500000 : 600000;
+	for (int i = 0; i < count; ++i) {
+		TestClient *account = new TestClient(QString::number(uin + i));
+		MD5LoginData data("password");
+		data.setLoginServer(server.host(), server.port());
+		orchestrator.addClient(account->client(), data);
+		accounts << account;
+	}
+
+	QSignalSpy finished(&orchestrator, SIGNAL(finished()));
+	int logins = server.loginCount();
+	orchestrator.start();
+	if (!TestClient::waitFor(finished, 1, 300000)) {
+		fprintf(stderr, "%s: only %d of %d clients are online\n", qPrintable(name),
+				orchestrator.onlineCount(), count);
+	} else {
+		BenchmarkResult result(name);
+		result.add("clients", count);
+		result.add("online", orchestrator.onlineCount());
+		result.add("failed", orchestrator.failedCount());
+		result.add("logins", server.loginCount() - logins);
+		result.add("ms_to_all_online", orchestrator.timeToAllOnline());
+		if (throttled) {
+			// The time the token bucket alone needs to admit all the clients
+			result.add("rate", rate);
+			result.add("burst", burst);
+			result.add("min_ms_to_all_online", qMax(count - burst, 0) * 1000.0 / rate);
+		}
+		runner.report(result);
+	}
+	orchestrator.stop();
+	qDeleteAll(accounts);
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	setDebugLevel(DebugDisabled);
+
+	MockOscarServer server;
+	server.setRosterSize(50);
+	server.setLatency(runner.intArgument("latency", 0));
+	if (!server.start()) {
+		fprintf(stderr, "Cannot start the mock server\n");
+		return 1;
+	}
+	runOrchestrator(runner, server, true);
+	runOrchestrator(runner, server, false);
+	return 0;
+}
@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "benchmarkutils.h"
+#include "reconnectmanager.h"
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <stdio.h>
+
+using namespace Ireen;
+
+// Drops all the accounts at once, like a restarted server does, and measures
+// how long it takes them to come back online. The warm accounts reuse the BOSS
+// endpoint and the rate classes of the last session, the cold ones do the full
+// login every time.
+//   -clients <count> the number of the accounts, 100 by default
+//   -rounds <count>  the number of the storms, 5 by default
+//   -delay <msec>    the initial reconnect delay, 100 by default
+//   -latency <msec>  the latency of the server, 0 by default
+//   -single-use 1    the server accepts every BOSS cookie only once, like the real
+//                    ones do, so the warm accounts pay for a rejected connection
+static void runStorm(BenchmarkRunner &runner, MockOscarServer &server, bool warm)
+{
+	int count = runner.intArgument("clients", 100);
+	int rounds = runner.intArgument("rounds", 5);
+	int delay = runner.intArgument("delay", 100);
+	QString name = QString("reconnect/storm/%1/%2").arg(warm ? "warm" : "cold").arg(count);
+	if (runner.intArgument("single-use", 0))
+		name += QLatin1String("/single-use");
+	if (!runner.isEnabled(name))
+		return;
+
+	QSignalSpy spy(&server, SIGNAL(clientLoggedIn(QString)));
+	QList<TestClient*> accounts;
+	for (int i = 0; i < count; ++i) {
+		TestClient *account = new TestClient(QString::number((warm ? 300000 : 200000) + i));
+		ReconnectManager *manager = account->client()->reconnectManager();
+		manager->setEnabled(true);
+		manager->setDelays(delay, 10 * delay);
+		manager->setEndpointLifetime(warm ? 60 * 1000 : 0);
+		account->client()->setPipelinedStartup(warm);
+		account->login(&server);
+		accounts << account;
+	}
+	if (!TestClient::waitFor(spy, count, 60000)) {
+		fprintf(stderr, "%s: only %d of %d accounts have logged in\n",
+				qPrintable(name), spy.count(), count);
+		qDeleteAll(accounts);
+		return;
+	}
+
+	int logins = server.loginCount();
+	qint64 allocs = allocationCount();
+	qint64 total = 0;
+	qint64 worst = 0;
+	int finished = 0;
+	for (; finished < rounds; ++finished) {
+		spy.clear();
+		qint64 start = benchmarkClock();
+		server.disconnectClients();
+		if (!TestClient::waitFor(spy, count, 60000)) {
+			fprintf(stderr, "%s: only %d of %d accounts have come back\n",
+					qPrintable(name), spy.count(), count);
+			break;
+		}
+		qint64 elapsed = benchmarkClock() - start;
+		total += elapsed;
+		worst = qMax(worst, elapsed);
+	}
+	allocs = allocationCount() - allocs;
+	logins = server.loginCount() - logins;
+
+	if (finished > 0) {
+		// The allocations of the server are counted too, as it runs in the same process
+		BenchmarkResult result(name);
+		result.add("clients", count);
+		result.add("rounds", finished);
+		result.add("ms_to_all_online", total / 1e6 / finished);
+		result.add("max_ms_to_all_online", worst / 1e6);
+		result.add("full_logins_per_round", double(logins) / finished);
+		result.add("allocs_per_reconnect", allocs < 0 ? -1 : double(allocs) / finished / count);
+		runner.report(result);
+	}
+	qDeleteAll(accounts);
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	setDebugLevel(DebugDisabled);
+
+	MockOscarServer server;
+	server.setRosterSize(50);
+	server.setLatency(runner.intArgument("latency", 0));
+	server.setSingleUseCookies(runner.intArgument("single-use", 0));
+	if (!server.start()) {
+		fprintf(stderr, "Cannot start the mock server\n");
+		return 1;
+	}
+	runStorm(runner, server, false);
+	runStorm(runner, server, true);
+	return 0;
+}
@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "testclient.h"
+#include "testshardpool.h"
+#include "benchmarkutils.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QSemaphore>
+#include <stdio.h>
+
+using namespace Ireen;
+
+// Feeds the accounts with the messages, lives in the thread of the server
+class MessageSource : public QObject
+{
+	Q_OBJECT
+public:
+	MessageSource(MockOscarServer *server) : m_server(server) {}
+public slots:
+	int loggedInCount(const QStringList &uins)
+	{
+		int count = 0;
+		foreach (const QString &uin, uins)
+			count += m_server->isLoggedIn(uin);
+		return count;
+	}
+	void send(const QStringList &uins, int count)
+	{
+		for (int i = 0; i < count; ++i) {
+			foreach (const QString &uin, uins)
+				m_server->sendMessage(uin, MockOscarServer::contactUin(i % m_server->rosterSize()),
+									  QLatin1String("Hello, world!"));
+		}
+	}
+private:
+	MockOscarServer *m_server;
+};
+
+// Runs the mock server in a thread of its own, so that the main thread
+// only waits for the results and the server does not share a thread with
+// any of the shards
+class ServerThread : public QThread
+{
+public:
+	ServerThread() : source(0), port(0) {}
+	bool startServer()
+	{
+		start();
+		m_ready.acquire();
+		return source;
+	}
+	MessageSource *source;
+	QString host;
+	quint16 port;
+protected:
+	void run()
+	{
+		MockOscarServer server;
+		server.setRateLimitsEnabled(false);
+		bool started = server.start();
+		MessageSource messageSource(&server);
+		if (started) {
+			host = server.host();
+			port = server.port();
+			source = &messageSource;
+		}
+		m_ready.release();
+		if (started)
+			exec();
+	}
+private:
+	QSemaphore m_ready;
+};
+
+// Measures the aggregate throughput of the incoming messages of all the accounts
+// of a ClientShardPool, from one worker thread up to -threads of them.
+//   -clients <count>   the number of the accounts, 100 by default
+//   -messages <count>  the number of the messages to every account, 100 by default
+//   -threads <count>   the maximum number of the threads, QThread::idealThreadCount() by default
+static void runShards(BenchmarkRunner &runner, ServerThread &server, int threads)
+{
+	int count = qMax(runner.intArgument("clients", 100), 1);
+	int messages = qMax(runner.intArgument("messages", 100), 1);
+	QString name = QString("shards/messages/%1threads").arg(threads);
+	if (!runner.isEnabled(name))
+		return;
+
+	// Every run has its own accounts, the ones of the previous run may be still disconnecting
+	static int nextUin = 700000;
+	TestShardPool pool(threads);
+	QStringList uins;
+	for (int i = 0; i < count; ++i) {
+		uins << QString::number(nextUin++);
+		pool.login(pool.createClient(uins.last()), server.host, server.port);
+	}
+	if (!TestClient::waitFor(pool.logins, count, 60000)) {
+		fprintf(stderr, "%s: only %d of %d clients are online\n", qPrintable(name), int(pool.logins), count);
+		return;
+	}
+	// The server sends the messages only to the clients which have sent ServiceClientReady
+	int loggedIn = 0;
+	for (int i = 0; i < 1000 && loggedIn < count; ++i) {
+		QMetaObject::invokeMethod(server.source, "loggedInCount", Qt::BlockingQueuedConnection,
+								  Q_RETURN_ARG(int, loggedIn), Q_ARG(QStringList, uins));
+		TestClient::waitFor(loggedIn, count, 10);
+	}
+
+	int total = count * messages;
+	qint64 start = benchmarkClock();
+	QMetaObject::invokeMethod(server.source, "send", Qt::QueuedConnection,
+							  Q_ARG(QStringList, uins), Q_ARG(int, messages));
+	if (!TestClient::waitFor(pool.messages, total, 300000)) {
+		fprintf(stderr, "%s: only %d of %d messages are received\n", qPrintable(name), int(pool.messages), total);
+		return;
+	}
+	qint64 elapsed = benchmarkClock() - start;
+
+	BenchmarkResult result(name);
+	result.add("threads", threads);
+	result.add("clients", count);
+	result.add("messages", total);
+	result.add("ms", elapsed / 1e6);
+	result.add("messages_per_sec", total * 1e9 / elapsed);
+	result.add("foreign_thread_events", pool.foreignThreadEvents);
+	runner.report(result);
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	BenchmarkRunner runner(app.arguments());
+	setDebugLevel(DebugDisabled);
+
+	ServerThread server;
+	if (!server.startServer()) {
+		fprintf(stderr, "Cannot start the mock server\n");
+		return 1;
+	}
+	int maxThreads = qMax(runner.intArgument("threads", QThread::idealThreadCount()), 1);
+	for (int threads = 1; threads < maxThreads; threads *= 2)
+		runShards(runner, server, threads);
+	runShards(runner, server, maxThreads);
+	server.quit();
+	server.wait();
+	return 0;
+}
+
+#include "bench_shards.moc"
@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "benchmarkutils.h"
+#include <QTextStream>
+#include <QTime>
+#include <stdio.h>
+#ifdef Q_OS_UNIX
+# include <time.h>
+#endif
+
+extern "C" long long ireen_allocation_count();
+
+namespace Ireen {
+
+qint64 benchmarkClock()
+{
+#if defined(Q_OS_UNIX) && defined(CLOCK_MONOTONIC)
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return qint64(time.tv_sec) * 1000000000 + time.tv_nsec;
+#else
+	// Millisecond precision is enough for the long benchmarks
+	static QTime start = QTime::currentTime();
+	return qint64(start.elapsed()) * 1000000;
+#endif
+}
+
+qint64 allocationCount()
+{
+	return ireen_allocation_count();
+}
+
+static volatile qint64 sink = 0;
+
+void benchmarkSink(qint64 value)
+{
+	sink += value;
+}
+
+BenchmarkResult::BenchmarkResult(const QString &name) :
+	m_name(name)
+{
+}
+
+BenchmarkResult &BenchmarkResult::add(const char *metric, double value)
+{
+	m_metrics << qMakePair(QByteArray(metric), value);
+	return *this;
+}
+
+QString BenchmarkResult::toJson() const
+{
+	QString json;
+	QTextStream out(&json);
+	out << "{\"name\": \"" << m_name << "\"";
+	for (int i = 0; i < m_metrics.size(); ++i)
+		out << ", \"" << m_metrics.at(i).first << "\": " << QString::number(m_metrics.at(i).second, 'g', 10);
+	out << "}";
+	out.flush();
+	return json;
+}
+
+BenchmarkRunner::BenchmarkRunner(const QStringList &arguments) :
+	m_arguments(arguments),
+	m_minTime(200)
+{
+	for (int i = 1; i + 1 < arguments.size(); ++i) {
+		if (arguments.at(i) == QLatin1String("-filter"))
+			m_filter = arguments.at(++i);
+		else if (arguments.at(i) == QLatin1String("-mintime"))
+			m_minTime = qMax(arguments.at(++i).toInt(), 1);
+	}
+}
+
+bool BenchmarkRunner::isEnabled(const QString &name) const
+{
+	return m_filter.isEmpty() || name.contains(m_filter);
+}
+
+int BenchmarkRunner::intArgument(const QString &name, int defaultValue) const
+{
+	int index = m_arguments.indexOf(QLatin1Char('-') + name);
+	if (index < 1 || index + 1 >= m_arguments.size())
+		return defaultValue;
+	bool ok;
+	int value = m_arguments.at(index + 1).toInt(&ok);
+	return ok ? value : defaultValue;
+}
+
+void BenchmarkRunner::report(const BenchmarkResult &result)
+{
+	// The results go to stdout, the debug output of the library goes to stderr
+	printf("%s\n", result.toJson().toUtf8().constData());
+	fflush(stdout);
+}
+
+} // namespace Ireen
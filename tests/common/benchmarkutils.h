@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_BENCHMARKUTILS_H
+#define IREEN_BENCHMARKUTILS_H
+
+#include <QStringList>
+#include <QPair>
+
+namespace Ireen {
+
+// Monotonic clock in nanoseconds
+qint64 benchmarkClock();
+// Number of the heap allocations made by the process so far,
+// -1 if they cannot be counted on this platform
+qint64 allocationCount();
+// Keeps the compiler from optimizing the measured code away
+void benchmarkSink(qint64 value);
+
+// One line of the output, e.g.
+// {"name": "dataunit/append/quint32/be", "iterations": 8388608, "ns_per_op": 3.1, "allocs_per_op": 0.02}
+class BenchmarkResult
+{
+public:
+	BenchmarkResult(const QString &name);
+	BenchmarkResult &add(const char *metric, double value);
+	QString toJson() const;
+private:
+	QString m_name;
+	QList<QPair<QByteArray, double> > m_metrics;
+};
+
+// Runs the benchmarks, which are selected by the arguments:
+//   -filter <text>  only the benchmarks with the text in the name
+//   -mintime <msec> the minimum measurement time of a benchmark, 200 by default
+// The other "-name value" arguments are the parameters of the scenarios
+class BenchmarkRunner
+{
+public:
+	BenchmarkRunner(const QStringList &arguments);
+	bool isEnabled(const QString &name) const;
+	int minTime() const { return m_minTime; }
+	int intArgument(const QString &name, int defaultValue) const;
+	// Calls func() until it takes at least minTime() and reports the cost of one call
+	template<typename Func>
+	void run(const QString &name, Func func);
+	void report(const BenchmarkResult &result);
+private:
+	QStringList m_arguments;
+	QString m_filter;
+	int m_minTime;
+};
+
+template<typename Func>
+void BenchmarkRunner::run(const QString &name, Func func)
+{
+	if (!isEnabled(name))
+		return;
+	func(); // warm up
+	qint64 iterations = 1;
+	forever {
+		qint64 allocs = allocationCount();
+		qint64 start = benchmarkClock();
+		for (qint64 i = 0; i < iterations; ++i)
+			func();
+		qint64 elapsed = benchmarkClock() - start;
+		allocs = allocationCount() - allocs;
+		if (elapsed >= qint64(m_minTime) * 1000000 || iterations >= (Q_INT64_C(1) << 40)) {
+			BenchmarkResult result(name);
+			result.add("iterations", iterations);
+			result.add("ns_per_op", double(elapsed) / iterations);
+			result.add("allocs_per_op", allocationCount() < 0 ? -1 : double(allocs) / iterations);
+			report(result);
+			return;
+		}
+		// Aim at the minimum time with some margin, but do not grow too fast
+		// as the first runs are too short to be precise
+		qint64 next = elapsed > 0 ? qint64(1.2e6 * m_minTime * iterations / elapsed) : iterations * 100;
+		iterations = qBound(iterations * 2, next, iterations * 100);
+	}
+}
+
+} // namespace Ireen
+
+#endif // IREEN_BENCHMARKUTILS_H
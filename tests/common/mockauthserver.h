@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_MOCKAUTHSERVER_H
+#define IREEN_MOCKAUTHSERVER_H
+
+#include <QTcpServer>
+#include <QSslCertificate>
+#include <QSslKey>
+#include <QHash>
+
+class QSslSocket;
+
+namespace Ireen {
+
+class MockOscarServer;
+
+// A local HTTPS stand-in for the ICQ authorization servers. It answers
+// clientLogin and startOSCARSession and sends the clients to the BOSS
+// of the mock OSCAR server. The certificate is self-signed for localhost,
+// so the tests have to add it to the default CA certificates.
+class MockAuthServer : public QTcpServer
+{
+	Q_OBJECT
+public:
+	MockAuthServer(MockOscarServer *oscarServer, QObject *parent = 0);
+	virtual ~MockAuthServer();
+	// Listens on a random port of the loopback interface
+	bool start();
+	QString clientLoginUrl() const;
+	QString startSessionUrl() const;
+	static QSslCertificate certificate();
+
+	// The password of every account, "password" by default
+	void setPassword(const QString &password);
+	// The number of the TLS connections the clients have opened
+	int connectionCount() const;
+	int clientLoginCount() const;
+	int startSessionCount() const;
+protected:
+	virtual void incomingConnection(int socketDescriptor);
+private slots:
+	void readData();
+	void onDisconnected();
+private:
+	struct Request
+	{
+		QByteArray method;
+		QByteArray path;
+		QByteArray body;
+	};
+	void processRequest(QSslSocket *socket, const Request &request);
+	QByteArray clientLogin(const QUrl &form);
+	QByteArray startSession(const QUrl &url);
+	void sendReply(QSslSocket *socket, int status, const QByteArray &json);
+	MockOscarServer *m_oscarServer;
+	QSslKey m_key;
+	QHash<QSslSocket*, QByteArray> m_buffers;
+	QString m_password;
+	int m_connections;
+	int m_clientLogins;
+	int m_startSessions;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_MOCKAUTHSERVER_H
@@ -0,0 +1,833 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mockoscarserver.h"
+#include "abstractconnection.h"
+#include "buddypicture.h"
+#include "core/messages.h"
+#include <QTcpSocket>
+#include <QTimerEvent>
+#include <QCryptographicHash>
+#include <QStringList>
+
+namespace Ireen {
+
+struct MockOscarSession
+{
+	enum Type { Login, Boss, Avatar };
+	MockOscarSession(QTcpSocket *socket) :
+		socket(socket), type(Login), seqNum(qrand() & 0x7fff), ready(false)
+	{}
+	QTcpSocket *socket;
+	FLAP flap;
+	Type type;
+	quint16 seqNum;
+	QString uin;
+	QByteArray authKey;
+	bool ready;
+};
+
+static const int rosterChunkSize = 100;
+static const QByteArray bossCookiePrefix("BOSS:");
+static const QByteArray avatarCookiePrefix("AVATAR:");
+
+MockOscarServer::MockOscarServer(QObject *parent) :
+	QObject(parent),
+	m_password(QLatin1String("password")),
+	m_rosterSize(10),
+	m_rateLimits(true),
+	m_avatars(false),
+	m_latency(0),
+	m_lossRate(0),
+	m_dropped(0),
+	m_logins(0),
+	m_searchResults(10),
+	m_metaRequests(0),
+	m_singleUseCookies(false),
+	m_cookieSerial(0)
+{
+	m_clock.start();
+	connect(&m_server, SIGNAL(newConnection()), SLOT(acceptConnection()));
+}
+
+MockOscarServer::~MockOscarServer()
+{
+	// The sockets would report their disconnection to the destroyed server
+	foreach (MockOscarSession *session, m_sessions) {
+		session->socket->disconnect(this);
+		delete session->socket;
+		delete session;
+	}
+}
+
+bool MockOscarServer::start()
+{
+	return m_server.listen(QHostAddress::LocalHost, 0);
+}
+
+QString MockOscarServer::host() const
+{
+	return m_server.serverAddress().toString();
+}
+
+quint16 MockOscarServer::port() const
+{
+	return m_server.serverPort();
+}
+
+void MockOscarServer::setPassword(const QString &password)
+{
+	m_password = password;
+}
+
+void MockOscarServer::setRosterSize(int size)
+{
+	// The item ids of the contacts have to fit in 15 bits
+	m_rosterSize = qBound(0, size, 0x7ffe);
+}
+
+int MockOscarServer::rosterSize() const
+{
+	return m_rosterSize;
+}
+
+QString MockOscarServer::contactUin(int index)
+{
+	return QString::number(100000 + index);
+}
+
+void MockOscarServer::setRateLimitsEnabled(bool enabled)
+{
+	m_rateLimits = enabled;
+}
+
+void MockOscarServer::setAvatarsEnabled(bool enabled)
+{
+	m_avatars = enabled;
+}
+
+QByteArray MockOscarServer::avatarHash(const QString &uin)
+{
+	return QCryptographicHash::hash(avatarData(uin), QCryptographicHash::Md5);
+}
+
+QByteArray MockOscarServer::avatarData(const QString &uin)
+{
+	QByteArray data("GIF89a avatar of ");
+	data += uin.toLatin1();
+	return data;
+}
+
+void MockOscarServer::setLatency(int msec)
+{
+	m_latency = qMax(msec, 0);
+}
+
+int MockOscarServer::latency() const
+{
+	return m_latency;
+}
+
+void MockOscarServer::setLossRate(double rate)
+{
+	m_lossRate = qBound(0.0, rate, 1.0);
+}
+
+int MockOscarServer::droppedPackets() const
+{
+	return m_dropped;
+}
+
+void MockOscarServer::setSingleUseCookies(bool enabled)
+{
+	m_singleUseCookies = enabled;
+	m_bossCookies.clear();
+}
+
+void MockOscarServer::setSearchResultCount(int count)
+{
+	m_searchResults = qMax(count, 0);
+}
+
+int MockOscarServer::searchResultCount() const
+{
+	return m_searchResults;
+}
+
+// The strings of the meta server end with a zero
+static void appendMetaString(DataUnit &data, const QString &str)
+{
+	data.append<quint16>(str.toLatin1() + '\0', LittleEndian);
+}
+
+SNAC MockOscarServer::searchResult(const QString &uin, quint16 sequence, int index, bool last)
+{
+	DataUnit contact;
+	contact.append<quint32>(contactUin(index).toUInt(), LittleEndian);
+	appendMetaString(contact, QString("Contact %1").arg(index));
+	appendMetaString(contact, QLatin1String("First"));
+	appendMetaString(contact, QLatin1String("Last"));
+	appendMetaString(contact, QString("contact%1@example.com").arg(index));
+	contact.append<quint8>(0x00); // auth flag
+	contact.append<quint16>(index % 2, LittleEndian); // status
+	contact.append<quint8>(0x01 + index % 2); // gender
+	contact.append<quint16>(20 + index % 50, LittleEndian); // age
+
+	DataUnit data;
+	data.append<quint32>(uin.toUInt(), LittleEndian);
+	data.append<quint16>(0x07da, LittleEndian);
+	data.append<quint16>(sequence, LittleEndian);
+	data.append<quint16>(last ? 0x01ae : 0x01a4, LittleEndian);
+	data.append<quint8>(0x0a); // success
+	data.append<quint16>(contact.data(), LittleEndian);
+	if (last)
+		data.append<quint32>(0, LittleEndian); // the number of the contacts which are left
+	DataUnit tlvData;
+	tlvData.append<quint16>(data.data(), LittleEndian);
+	SNAC snac(ExtensionsFamily, ExtensionsMetaSrvReply);
+	snac.appendTLV(0x0001, tlvData.data());
+	return snac;
+}
+
+SNAC MockOscarServer::shortInfo(const QString &uin, quint16 sequence, const QString &contact)
+{
+	DataUnit data;
+	data.append<quint32>(uin.toUInt(), LittleEndian);
+	data.append<quint16>(0x07da, LittleEndian);
+	data.append<quint16>(sequence, LittleEndian);
+	data.append<quint16>(0x0104, LittleEndian);
+	data.append<quint8>(0x0a); // success
+	appendMetaString(data, QLatin1String("Nick ") + contact);
+	appendMetaString(data, QLatin1String("First"));
+	appendMetaString(data, QLatin1String("Last"));
+	appendMetaString(data, contact + QLatin1String("@example.com"));
+	data.append<quint8>(0x00); // auth flag
+	data.append<quint16>(0x0000); // unknown
+	data.append<quint8>(0x01); // gender
+	DataUnit tlvData;
+	tlvData.append<quint16>(data.data(), LittleEndian);
+	SNAC snac(ExtensionsFamily, ExtensionsMetaSrvReply);
+	snac.appendTLV(0x0001, tlvData.data());
+	return snac;
+}
+
+int MockOscarServer::metaRequestCount() const
+{
+	return m_metaRequests;
+}
+
+QStringList MockOscarServer::loggedInClients() const
+{
+	QStringList uins;
+	foreach (MockOscarSession *session, m_clients) {
+		if (session->ready)
+			uins << session->uin;
+	}
+	return uins;
+}
+
+bool MockOscarServer::isLoggedIn(const QString &uin) const
+{
+	MockOscarSession *session = m_clients.value(uin);
+	return session && session->ready;
+}
+
+int MockOscarServer::loginCount() const
+{
+	return m_logins;
+}
+
+void MockOscarServer::sendPresenceStorm(int count, bool online)
+{
+	if (m_rosterSize == 0)
+		return;
+	foreach (MockOscarSession *session, m_clients) {
+		if (!session->ready)
+			continue;
+		for (int i = 0; i < count; ++i)
+			sendStatus(session, contactUin(i % m_rosterSize), i / m_rosterSize, online);
+	}
+}
+
+bool MockOscarServer::sendMessage(const QString &to, const QString &from, const QString &text)
+{
+	MockOscarSession *session = m_clients.value(to);
+	if (!session || !session->ready)
+		return false;
+	SNAC snac(MessageFamily, MessageSrvRecv);
+	snac.append<quint64>(Cookie::generateId());
+	snac.append<quint16>(1); // channel
+	snac.append<quint8>(from.toLatin1());
+	snac.append<quint16>(0); // warning level
+	snac.append<quint16>(1); // number of tlvs in the header
+	snac.appendTLV<quint16>(0x0001, 0x0050);
+	snac.appendTLV(0x0002, Channel1MessageData(text).data());
+	send(session, snac);
+	return true;
+}
+
+bool MockOscarServer::sendTypingNotification(const QString &to, const QString &from, quint16 type)
+{
+	MockOscarSession *session = m_clients.value(to);
+	if (!session || !session->ready)
+		return false;
+	SNAC snac(MessageFamily, MessageMtn);
+	snac.append<quint64>(0);
+	snac.append<quint16>(1);
+	snac.append<quint8>(from.toLatin1());
+	snac.append<quint16>(type);
+	send(session, snac, true);
+	return true;
+}
+
+void MockOscarServer::disconnectClients()
+{
+	foreach (MockOscarSession *session, m_sessions.values()) {
+		if (session->type != MockOscarSession::Login)
+			session->socket->abort();
+	}
+}
+
+void MockOscarServer::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_delayTimer.timerId()) {
+		QObject::timerEvent(event);
+		return;
+	}
+	int now = m_clock.elapsed();
+	while (!m_delayed.isEmpty() && m_delayed.head().due <= now) {
+		DelayedPacket packet = m_delayed.dequeue();
+		if (!packet.socket)
+			continue;
+		packet.socket->write(packet.data);
+		if (packet.close)
+			packet.socket->disconnectFromHost();
+	}
+	if (m_delayed.isEmpty())
+		m_delayTimer.stop();
+	else
+		m_delayTimer.start(qMax(m_delayed.head().due - now, 1), this);
+}
+
+void MockOscarServer::acceptConnection()
+{
+	while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+		MockOscarSession *session = new MockOscarSession(socket);
+		m_sessions.insert(socket, session);
+		connect(socket, SIGNAL(readyRead()), SLOT(readData()));
+		connect(socket, SIGNAL(disconnected()), SLOT(onDisconnected()));
+		FLAP flap(0x01);
+		flap.append<quint32>(0x00000001);
+		send(session, flap);
+	}
+}
+
+void MockOscarServer::readData()
+{
+	QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+	MockOscarSession *session = m_sessions.value(socket);
+	while (session && socket->bytesAvailable() > 0) {
+		if (!session->flap.readData(socket)) {
+			socket->abort();
+			return;
+		}
+		if (!session->flap.isFinished())
+			break;
+		processFlap(session);
+		// The session is deleted if the socket has been closed meanwhile
+		session = m_sessions.value(socket);
+		if (session)
+			session->flap.clear();
+	}
+}
+
+void MockOscarServer::onDisconnected()
+{
+	QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+	MockOscarSession *session = m_sessions.take(socket);
+	if (!session)
+		return;
+	if (session->type == MockOscarSession::Boss && m_clients.value(session->uin) == session)
+		m_clients.remove(session->uin);
+	delete session;
+	socket->deleteLater();
+}
+
+void MockOscarServer::processFlap(MockOscarSession *session)
+{
+	switch (session->flap.channel()) {
+	case 0x01:
+		processNewConnection(session);
+		break;
+	case 0x02:
+		processSnac(session, SNAC::fromByteArray(session->flap.data()));
+		break;
+	case 0x04:
+		session->socket->disconnectFromHost();
+		break;
+	default:
+		// Keep alive packets
+		break;
+	}
+}
+
+void MockOscarServer::processNewConnection(MockOscarSession *session)
+{
+	DataUnit data(session->flap.data());
+	data.skipData(4); // protocol version
+	TLVMap tlvs = data.read<TLVMap>();
+	if (!tlvs.contains(0x0006))
+		return; // The login connection, the client continues with SignonAuthRequest
+	QByteArray cookie = tlvs.value(0x0006).data();
+	QList<quint16> families;
+	if (cookie.startsWith(bossCookiePrefix)) {
+		if (m_singleUseCookies && !m_bossCookies.remove(cookie)) {
+			session->socket->abort();
+			return;
+		}
+		session->type = MockOscarSession::Boss;
+		session->uin = QString::fromLatin1(cookie.mid(bossCookiePrefix.size()).split(':').first());
+		// The last connection of the account wins, as on the real server
+		if (MockOscarSession *old = m_clients.value(session->uin))
+			old->socket->abort();
+		m_clients.insert(session->uin, session);
+		families << ServiceFamily << LocationFamily << BuddyFamily << MessageFamily
+				 << BosFamily << ListsFamily << ExtensionsFamily;
+	} else if (cookie.startsWith(avatarCookiePrefix)) {
+		session->type = MockOscarSession::Avatar;
+		session->uin = QString::fromLatin1(cookie.mid(avatarCookiePrefix.size()));
+		families << ServiceFamily << AvatarFamily;
+	} else {
+		session->socket->abort();
+		return;
+	}
+	SNAC snac(ServiceFamily, ServiceServerReady);
+	foreach (quint16 family, families)
+		snac.append<quint16>(family);
+	send(session, snac);
+}
+
+void MockOscarServer::processSnac(MockOscarSession *session, const SNAC &snac)
+{
+	switch (snac.family()) {
+	case AuthorizationFamily:
+		handleLogin(session, snac);
+		break;
+	case ServiceFamily:
+		handleService(session, snac);
+		break;
+	case ListsFamily:
+		handleFeedbag(session, snac);
+		break;
+	case MessageFamily:
+		handleMessage(session, snac);
+		break;
+	case AvatarFamily:
+		handleAvatar(session, snac);
+		break;
+	case ExtensionsFamily:
+		handleMetaRequest(session, snac);
+		break;
+	case LocationFamily:
+	case BuddyFamily:
+	case BosFamily:
+		if (snac.subtype() == 0x0002) {
+			// The rights replies are not parsed by the client
+			SNAC reply(snac.family(), 0x0003);
+			reply.setId(snac.id());
+			send(session, reply);
+		}
+		break;
+	}
+}
+
+void MockOscarServer::handleLogin(MockOscarSession *session, const SNAC &snac)
+{
+	TLVMap tlvs = snac.read<TLVMap>();
+	if (snac.subtype() == SignonAuthRequest) {
+		session->uin = QString::fromLatin1(tlvs.value(0x0001).data());
+		session->authKey = QByteArray::number(qrand());
+		SNAC reply(AuthorizationFamily, SignonAuthKey);
+		reply.setId(snac.id());
+		reply.append<quint16>(session->authKey);
+		send(session, reply);
+	} else if (snac.subtype() == SignonLoginRequest) {
+		QByteArray key = session->authKey;
+		key += QCryptographicHash::hash(m_password.toLatin1(), QCryptographicHash::Md5);
+		key += "AOL Instant Messenger (SM)";
+		bool accepted = !session->authKey.isEmpty()
+				&& tlvs.value(0x0025).data() == QCryptographicHash::hash(key, QCryptographicHash::Md5);
+		SNAC reply(AuthorizationFamily, SignonLoginReply);
+		reply.setId(snac.id());
+		reply.appendTLV(0x0001, session->uin.toLatin1());
+		if (accepted) {
+			QByteArray address = QString("%1:%2").arg(host()).arg(port()).toLatin1();
+			reply.appendTLV(0x0005, address);
+			QByteArray cookie = bossCookiePrefix + session->uin.toLatin1();
+			if (m_singleUseCookies) {
+				cookie += ':' + QByteArray::number(++m_cookieSerial);
+				m_bossCookies.insert(cookie);
+			}
+			reply.appendTLV(0x0006, cookie);
+			++m_logins;
+		} else {
+			reply.appendTLV<quint16>(0x0008, AbstractConnection::MismatchNickOrPassword);
+			emit loginFailed(session->uin);
+		}
+		send(session, reply);
+		FLAP flap(0x04);
+		send(session, flap, true);
+	}
+}
+
+void MockOscarServer::handleService(MockOscarSession *session, const SNAC &snac)
+{
+	switch (snac.subtype()) {
+	case ServiceClientFamilies: {
+		// Agree with every version the client supports
+		SNAC reply(ServiceFamily, ServiceServerFamilies2);
+		reply.setId(snac.id());
+		reply.append(snac.readAll());
+		send(session, reply);
+		break;
+	}
+	case ServiceClientReqRateInfo: {
+		SNAC reply(ServiceFamily, ServiceServerRateInfo);
+		reply.setId(snac.id());
+		reply.append<quint16>(1); // number of classes
+		reply.append<quint16>(1); // class id
+		reply.append<quint32>(m_rateLimits ? 0x00000050 : 0); // window size
+		reply.append<quint32>(0x000009c4); // clear level
+		reply.append<quint32>(0x000007d0); // alert level
+		reply.append<quint32>(0x000005dc); // limit level
+		reply.append<quint32>(0x00000320); // disconnect level
+		reply.append<quint32>(0x00001770); // current level
+		reply.append<quint32>(0x00001770); // max level
+		reply.append<quint32>(0x00000000); // last time
+		reply.append<quint8>(0); // current state
+		// All the snacs go through the first class by default
+		reply.append<quint16>(1);
+		reply.append<quint16>(0);
+		send(session, reply);
+		break;
+	}
+	case ServiceClientNewService: {
+		quint16 family = snac.read<quint16>();
+		if (session->type != MockOscarSession::Boss || family != AvatarFamily) {
+			SNAC reply(ServiceFamily, ServiceError);
+			reply.setId(snac.id());
+			reply.append<quint16>(0x0006); // not supported by host
+			send(session, reply);
+			break;
+		}
+		SNAC reply(ServiceFamily, ServerRedirectService);
+		reply.setId(snac.id());
+		reply.appendTLV<quint16>(0x000d, family);
+		reply.appendTLV(0x0005, QString("%1:%2").arg(host()).arg(port()).toLatin1());
+		reply.appendTLV(0x0006, avatarCookiePrefix + session->uin.toLatin1());
+		send(session, reply);
+		break;
+	}
+	case ServiceClientSetStatus: {
+		TLVMap tlvs = snac.read<TLVMap>();
+		if (tlvs.contains(0x0006))
+			emit statusReceived(session->uin, tlvs.value<quint32>(0x0006) & 0xffff);
+		break;
+	}
+	case ServiceClientReqinfo:
+		// Never answered, so a client probing a silent server gets no reply
+		emit infoRequested(session->uin);
+		break;
+	case ServiceClientReady:
+		session->ready = true;
+		if (session->type == MockOscarSession::Boss)
+			emit clientLoggedIn(session->uin);
+		else
+			emit avatarServiceReady(session->uin);
+		break;
+	}
+}
+
+void MockOscarServer::handleFeedbag(MockOscarSession *session, const SNAC &snac)
+{
+	switch (snac.subtype()) {
+	case ListsCliReqLists: {
+		SNAC reply(ListsFamily, ListsSrvReplyLists);
+		reply.setId(snac.id());
+		DataUnit limits;
+		for (int i = 0; i < 0x15; ++i)
+			limits.append<quint16>(i == SsiBuddy ? 0x7fff : 0x00ff);
+		reply.appendTLV(0x0004, limits.data());
+		send(session, reply);
+		break;
+	}
+	case ListsCliRequest:
+	case ListsCliCheck:
+		// The roster is sent even to the clients with a cache,
+		// as it is always newer than the cache
+		sendRoster(session);
+		break;
+	case ListsAddToList:
+	case ListsUpdateGroup:
+	case ListsRemoveFromList: {
+		SNAC reply(ListsFamily, ListsAck);
+		reply.setId(snac.id());
+		int count = 0;
+		while (snac.dataSize() > 0) {
+			snac.skipData(snac.read<quint16>()); // name
+			snac.skipData(6); // group id, item id and type
+			snac.skipData(snac.read<quint16>()); // tlvs
+			if (snac.hasError())
+				break;
+			reply.append<quint16>(0x0000); // no error
+			++count;
+		}
+		emit feedbagModified(session->uin, snac.subtype(), count);
+		send(session, reply);
+		break;
+	}
+	}
+}
+
+void MockOscarServer::handleMessage(MockOscarSession *session, const SNAC &snac)
+{
+	switch (snac.subtype()) {
+	case MessageCliReqIcbm: {
+		SNAC reply(MessageFamily, MessageSrvReplyIcbm);
+		reply.setId(snac.id());
+		reply.append<quint16>(0x0004); // channel
+		reply.append<quint32>(0x00000003); // flags
+		reply.append<quint16>(0x0200); // max message snac size
+		reply.append<quint16>(0x0384); // max sender warning level
+		reply.append<quint16>(0x03e7); // max receiver warning level
+		reply.append<quint32>(0x00000000); // minimum message interval
+		send(session, reply);
+		break;
+	}
+	case MessageSrvSend: {
+		quint64 cookie = snac.read<quint64>();
+		quint16 channel = snac.read<quint16>();
+		QString to = QString::fromLatin1(snac.read<QByteArray, quint8>());
+		QByteArray data = snac.readAll();
+		if (snac.hasError())
+			break;
+		emit messageReceived(session->uin, to, channel, data);
+		TLVMap tlvs = DataUnit(data).read<TLVMap>();
+		if (tlvs.contains(0x0003)) {
+			SNAC ack(MessageFamily, MessageSrvAck);
+			ack.setId(snac.id());
+			ack.append<quint64>(cookie);
+			ack.append<quint16>(channel);
+			ack.append<quint8>(to.toLatin1());
+			send(session, ack, true);
+		}
+		// The messages between the accounts of the server are delivered
+		MockOscarSession *target = m_clients.value(to);
+		if (target && target->ready) {
+			tlvs.remove(0x0003);
+			tlvs.remove(0x0006);
+			SNAC message(MessageFamily, MessageSrvRecv);
+			message.append<quint64>(cookie);
+			message.append<quint16>(channel);
+			message.append<quint8>(session->uin.toLatin1());
+			message.append<quint16>(0); // warning level
+			message.append<quint16>(0); // number of tlvs in the header
+			message.append(static_cast<QByteArray>(tlvs));
+			send(target, message);
+		}
+		break;
+	}
+	case MessageMtn: {
+		snac.skipData(8); // cookie
+		quint16 channel = snac.read<quint16>();
+		QString to = QString::fromLatin1(snac.read<QByteArray, quint8>());
+		quint16 type = snac.read<quint16>();
+		if (snac.hasError())
+			break;
+		emit typingReceived(session->uin, to, type);
+		MockOscarSession *target = m_clients.value(to);
+		if (target && target->ready) {
+			SNAC mtn(MessageFamily, MessageMtn);
+			mtn.append<quint64>(0);
+			mtn.append<quint16>(channel);
+			mtn.append<quint8>(session->uin.toLatin1());
+			mtn.append<quint16>(type);
+			send(target, mtn, true);
+		}
+		break;
+	}
+	}
+}
+
+void MockOscarServer::handleAvatar(MockOscarSession *session, const SNAC &snac)
+{
+	if (snac.subtype() != AvatarGetRequest)
+		return;
+	QString uin = QString::fromLatin1(snac.read<QByteArray, quint8>());
+	snac.skipData(1); // unknown
+	quint16 id = snac.read<quint16>();
+	quint8 flags = snac.read<quint8>();
+	snac.read<QByteArray, quint8>(); // hash
+	if (snac.hasError())
+		return;
+	emit avatarRequested(session->uin, uin);
+	QByteArray hash = avatarHash(uin);
+	SNAC reply(AvatarFamily, AvatarGetReply);
+	reply.setId(snac.id());
+	reply.append<quint8>(uin.toLatin1());
+	reply.append<quint16>(id);
+	reply.append<quint8>(flags);
+	reply.append<quint8>(hash);
+	reply.append(QByteArray(21, '\0'));
+	reply.append<quint16>(avatarData(uin));
+	send(session, reply, true);
+}
+
+void MockOscarServer::handleMetaRequest(MockOscarSession *session, const SNAC &snac)
+{
+	if (snac.subtype() != ExtensionsMetaCliRequest)
+		return;
+	DataUnit data(snac.read<TLVMap>().value(0x0001));
+	data.skipData(2); // field length
+	data.skipData(4); // uin
+	quint16 type = data.read<quint16>(LittleEndian);
+	quint16 sequence = data.read<quint16>(LittleEndian);
+	quint16 subtype = data.read<quint16>(LittleEndian);
+	if (data.hasError() || type != 0x07d0)
+		return;
+	++m_metaRequests;
+	if (subtype == 0x04ba) {
+		SNAC reply = shortInfo(session->uin, sequence, QString::number(data.read<quint32>(LittleEndian)));
+		reply.setId(snac.id());
+		send(session, reply);
+		return;
+	}
+	// The white pages search, by the uin and by the email
+	if (subtype != 0x055f && subtype != 0x0569 && subtype != 0x0573)
+		return;
+	for (int i = 0; i < m_searchResults; ++i) {
+		SNAC reply = searchResult(session->uin, sequence, i, i == m_searchResults - 1);
+		reply.setId(snac.id());
+		send(session, reply);
+	}
+}
+
+void MockOscarServer::sendRoster(MockOscarSession *session)
+{
+	// The root group, the only regular group and the contacts
+	int count = m_rosterSize + 2;
+	for (int i = 0; i < count; i += rosterChunkSize) {
+		int chunkSize = qMin(rosterChunkSize, count - i);
+		bool isLast = i + chunkSize == count;
+		SNAC snac(ListsFamily, ListsList);
+		snac.setFlags(isLast ? 0x0000 : 0x0001);
+		snac.append<quint8>(0); // version
+		snac.append<quint16>(chunkSize);
+		for (int j = i; j < i + chunkSize; ++j) {
+			DataUnit tlvs;
+			if (j == 0) {
+				snac.append<quint16>(QByteArray());
+				snac.append<quint16>(0); // group id
+				snac.append<quint16>(0); // item id
+				snac.append<quint16>(SsiGroup);
+				tlvs.appendTLV<quint16>(0x00c8, 1);
+			} else if (j == 1) {
+				snac.append<quint16>(QByteArray("General"));
+				snac.append<quint16>(1);
+				snac.append<quint16>(0);
+				snac.append<quint16>(SsiGroup);
+			} else {
+				QString uin = contactUin(j - 2);
+				snac.append<quint16>(uin.toLatin1());
+				snac.append<quint16>(1);
+				snac.append<quint16>(j - 1);
+				snac.append<quint16>(SsiBuddy);
+				tlvs.appendTLV(0x0131, QString("Contact %1").arg(j - 2).toUtf8());
+			}
+			snac.append<quint16>(tlvs.data());
+		}
+		if (isLast)
+			snac.append<quint32>(m_clock.elapsed() / 1000 + 1);
+		send(session, snac);
+	}
+}
+
+void MockOscarServer::sendStatus(MockOscarSession *session, const QString &uin, int seq, bool online)
+{
+	SNAC snac(BuddyFamily, online ? UserOnline : UserOffline);
+	snac.append<quint8>(uin.toLatin1());
+	snac.append<quint16>(0); // warning level
+	DataUnit tlvs;
+	int count = 1;
+	tlvs.appendTLV<quint16>(0x0001, 0x0050); // user class
+	if (online) {
+		// Away and online in turn, so every notification is a change
+		tlvs.appendTLV<quint32>(0x0006, seq % 2 ? 0x00000001 : 0x00000000);
+		++count;
+		if (m_avatars) {
+			DataUnit avatar;
+			avatar.append<quint16>(staticAvatar);
+			avatar.append<quint8>(0x01); // flags
+			avatar.append<quint8>(avatarHash(uin));
+			tlvs.appendTLV(0x001d, avatar.data());
+			++count;
+		}
+	}
+	snac.append<quint16>(count);
+	snac.append(tlvs.data());
+	send(session, snac, true);
+}
+
+void MockOscarServer::send(MockOscarSession *session, SNAC &snac, bool lossy)
+{
+	if (lossy && m_lossRate > 0 && qrand() < m_lossRate * RAND_MAX) {
+		++m_dropped;
+		return;
+	}
+	FLAP flap(0x02);
+	flap.append(snac.toByteArray());
+	send(session, flap);
+}
+
+void MockOscarServer::send(MockOscarSession *session, FLAP &flap, bool close)
+{
+	flap.setSeqNum(session->seqNum++);
+	if (m_latency == 0) {
+		session->socket->write(flap.toByteArray());
+		if (close)
+			session->socket->disconnectFromHost();
+		return;
+	}
+	DelayedPacket packet;
+	packet.socket = session->socket;
+	packet.data = flap.toByteArray();
+	packet.close = close;
+	packet.due = m_clock.elapsed() + m_latency;
+	m_delayed.enqueue(packet);
+	if (!m_delayTimer.isActive())
+		m_delayTimer.start(m_latency, this);
+}
+
+} // namespace Ireen
@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_MOCKOSCARSERVER_H
+#define IREEN_MOCKOSCARSERVER_H
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QBasicTimer>
+#include <QPointer>
+#include <QQueue>
+#include <QHash>
+#include <QSet>
+#include <QTime>
+#include "core/flap.h"
+#include "core/snac.h"
+
+namespace Ireen {
+
+struct MockOscarSession;
+
+// A local OSCAR server for the tests and the benchmarks. The same port serves
+// the login, the BOSS and the avatar connections; they are told apart by
+// the cookie which the client sends in its channel 1 FLAP.
+class MockOscarServer : public QObject
+{
+	Q_OBJECT
+public:
+	MockOscarServer(QObject *parent = 0);
+	virtual ~MockOscarServer();
+	// Listens on a random port of the loopback interface
+	bool start();
+	QString host() const;
+	quint16 port() const;
+
+	// The password of every account, "password" by default
+	void setPassword(const QString &password);
+	// The number of contacts in the roster of every account, 10 by default
+	void setRosterSize(int size);
+	int rosterSize() const;
+	static QString contactUin(int index);
+	// With the limits disabled the rate classes are sent empty,
+	// so the client does not throttle anything
+	void setRateLimitsEnabled(bool enabled);
+	// The presence notifications carry the avatar hashes of the contacts
+	void setAvatarsEnabled(bool enabled);
+	static QByteArray avatarHash(const QString &uin);
+	static QByteArray avatarData(const QString &uin);
+	// Every packet of the server is delayed by msec
+	void setLatency(int msec);
+	int latency() const;
+	// The share of the packets which the client is supposed to survive without,
+	// from 0 to 1: presence and typing notifications, message acks and avatar
+	// replies. The login and the feedbag are never lost, as TCP would stall
+	// the connection rather than lose a packet of them.
+	void setLossRate(double rate);
+	int droppedPackets() const;
+	// Every BOSS cookie is accepted only once, as on the real servers.
+	// Disabled by default, the cookie of an account is always the same then.
+	void setSingleUseCookies(bool enabled);
+	// Every white pages search finds count contacts, 10 by default
+	void setSearchResultCount(int count);
+	int searchResultCount() const;
+	// The reply of the meta server with the index-th contact of a search
+	static SNAC searchResult(const QString &uin, quint16 sequence, int index, bool last);
+	// The short info of a contact is its nick "Nick <uin>" and the common names
+	static SNAC shortInfo(const QString &uin, quint16 sequence, const QString &contact);
+	// The number of the meta requests received by the server
+	int metaRequestCount() const;
+
+	QStringList loggedInClients() const;
+	bool isLoggedIn(const QString &uin) const;
+	int loginCount() const;
+
+	// Every logged in client receives count presence notifications,
+	// cycling over its roster
+	void sendPresenceStorm(int count, bool online = true);
+	bool sendMessage(const QString &to, const QString &from, const QString &text);
+	bool sendTypingNotification(const QString &to, const QString &from, quint16 type);
+	// Aborts the BOSS and the avatar connections like a restarted server
+	void disconnectClients();
+signals:
+	void loginFailed(const QString &uin);
+	// The client has sent ServiceClientReady to BOSS
+	void clientLoggedIn(const QString &uin);
+	// The status mode of ServiceClientSetStatus, without the flags
+	void statusReceived(const QString &uin, quint16 status);
+	// The client has asked for its own info, e.g. to probe the connection
+	void infoRequested(const QString &uin);
+	void avatarServiceReady(const QString &uin);
+	// A channel 1 or 2 message, data contains the TLVs after the header
+	void messageReceived(const QString &from, const QString &to, quint16 channel, const QByteArray &data);
+	void typingReceived(const QString &from, const QString &to, quint16 type);
+	void avatarRequested(const QString &from, const QString &uin);
+	void feedbagModified(const QString &uin, quint16 subtype, int count);
+protected:
+	void timerEvent(QTimerEvent *event);
+private slots:
+	void acceptConnection();
+	void readData();
+	void onDisconnected();
+private:
+	void processFlap(MockOscarSession *session);
+	void processNewConnection(MockOscarSession *session);
+	void processSnac(MockOscarSession *session, const SNAC &snac);
+	void handleLogin(MockOscarSession *session, const SNAC &snac);
+	void handleService(MockOscarSession *session, const SNAC &snac);
+	void handleFeedbag(MockOscarSession *session, const SNAC &snac);
+	void handleMessage(MockOscarSession *session, const SNAC &snac);
+	void handleAvatar(MockOscarSession *session, const SNAC &snac);
+	void handleMetaRequest(MockOscarSession *session, const SNAC &snac);
+	void sendRoster(MockOscarSession *session);
+	void sendStatus(MockOscarSession *session, const QString &uin, int seq, bool online);
+	void send(MockOscarSession *session, SNAC &snac, bool lossy = false);
+	void send(MockOscarSession *session, FLAP &flap, bool close = false);
+	struct DelayedPacket
+	{
+		QPointer<QTcpSocket> socket;
+		QByteArray data;
+		bool close;
+		int due;
+	};
+	QTcpServer m_server;
+	QHash<QTcpSocket*, MockOscarSession*> m_sessions;
+	QHash<QString, MockOscarSession*> m_clients;
+	QString m_password;
+	int m_rosterSize;
+	bool m_rateLimits;
+	bool m_avatars;
+	int m_latency;
+	double m_lossRate;
+	int m_dropped;
+	int m_logins;
+	int m_searchResults;
+	int m_metaRequests;
+	bool m_singleUseCookies;
+	int m_cookieSerial;
+	QSet<QByteArray> m_bossCookies;
+	QTime m_clock;
+	QQueue<DelayedPacket> m_delayed;
+	QBasicTimer m_delayTimer;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_MOCKOSCARSERVER_H
@@ -0,0 +1,50 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "snacreplay.h"
+#include "abstractconnection_p.h"
+
+namespace Ireen {
+
+// Gives access to the incoming FLAP of any connection
+class FlapAccess : public AbstractConnection
+{
+public:
+	static FLAP &flap(AbstractConnection *conn)
+	{
+		QScopedPointer<AbstractConnectionPrivate> AbstractConnection::*d = &FlapAccess::d_ptr;
+		return (conn->*d)->flap;
+	}
+};
+
+void replaySnac(AbstractConnection *conn, const QByteArray &snac)
+{
+	FLAP &flap = FlapAccess::flap(conn);
+	flap.setChannel(0x02);
+	flap.setData(snac);
+	QMetaObject::invokeMethod(conn, "processSnac", Qt::DirectConnection);
+}
+
+} // namespace Ireen
@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "testclient.h"
+#include "mockoscarserver.h"
+#include <QEventLoop>
+#include <QSignalSpy>
+#include <QTimer>
+#include <QTime>
+
+namespace Ireen {
+
+// Sleeps in the event loop instead of spinning
+static void processEvents(int msec)
+{
+	QEventLoop loop;
+	QTimer::singleShot(msec, &loop, SLOT(quit()));
+	loop.exec();
+}
+
+TestClient::TestClient(const QString &uin, int options, QObject *parent) :
+	QObject(parent),
+	logins(0),
+	errors(0),
+	disconnects(0),
+	contacts(0),
+	statusUpdates(0),
+	messages(0),
+	acceptedMessages(0),
+	typingNotifications(0),
+	avatars(0),
+	lastTypingState(MtnUnknown),
+	m_buddyPictureHandler(0)
+{
+	m_client = new Client(uin, this);
+	m_feedbag = new Feedbag(m_client);
+	m_roster = new Roster(m_client, m_feedbag);
+	m_messageHandler = new MessageHandler(m_client);
+	if (options & WithAvatars) {
+		m_buddyPictureHandler = new BuddyPictureHandler(m_client, m_roster);
+		connect(m_buddyPictureHandler, SIGNAL(avatarUpdated(QString,Ireen::BuddyPicture)),
+				SLOT(onAvatarUpdated(QString,Ireen::BuddyPicture)));
+		connect(m_buddyPictureHandler, SIGNAL(avatarReceived(QString,QByteArray,QByteArray)),
+				SLOT(onAvatarReceived(QString,QByteArray,QByteArray)));
+	}
+	connect(m_client, SIGNAL(loginFinished()), SLOT(onLoginFinished()));
+	connect(m_client, SIGNAL(error(Ireen::AbstractConnection::ConnectionError)),
+			SLOT(onError(Ireen::AbstractConnection::ConnectionError)));
+	connect(m_client, SIGNAL(disconnected()), SLOT(onDisconnected()));
+	connect(m_roster, SIGNAL(contactItemReceived(Ireen::ContactItem)),
+			SLOT(onContactItemReceived(Ireen::ContactItem)));
+	connect(m_roster, SIGNAL(contactStatusUpdated(QString,Ireen::StatusItem)),
+			SLOT(onContactStatusUpdated(QString,Ireen::StatusItem)));
+	connect(m_messageHandler, SIGNAL(messageReceived(QString,QString,QDateTime,Ireen::Cookie,quint16)),
+			SLOT(onMessageReceived(QString,QString,QDateTime,Ireen::Cookie,quint16)));
+	connect(m_messageHandler, SIGNAL(messageAccepted(Ireen::Cookie,QString,quint16)),
+			SLOT(onMessageAccepted(Ireen::Cookie,QString,quint16)));
+	connect(m_messageHandler, SIGNAL(typingNotification(QString,Ireen::MTN)),
+			SLOT(onTypingNotification(QString,Ireen::MTN)));
+}
+
+TestClient::~TestClient()
+{
+	// The handlers are deleted before the client they are registered in
+	delete m_buddyPictureHandler;
+	delete m_messageHandler;
+	delete m_roster;
+	delete m_feedbag;
+	delete m_client;
+}
+
+void TestClient::login(MockOscarServer *server, const QString &password)
+{
+	MD5LoginData data(password);
+	data.setLoginServer(server->host(), server->port());
+	m_client->login(data);
+}
+
+bool TestClient::waitForLogin(int timeout) const
+{
+	return waitFor(logins, 1, timeout);
+}
+
+bool TestClient::waitFor(const int &counter, int value, int timeout)
+{
+	QTime time;
+	time.start();
+	while (counter < value && time.elapsed() < timeout)
+		processEvents(10);
+	return counter >= value;
+}
+
+bool TestClient::waitFor(const QSignalSpy &spy, int count, int timeout)
+{
+	QTime time;
+	time.start();
+	while (spy.count() < count && time.elapsed() < timeout)
+		processEvents(10);
+	return spy.count() >= count;
+}
+
+bool TestClient::waitFor(const QAtomicInt &counter, int value, int timeout)
+{
+	QTime time;
+	time.start();
+	while (counter < value && time.elapsed() < timeout)
+		processEvents(10);
+	return counter >= value;
+}
+
+void TestClient::onLoginFinished()
+{
+	++logins;
+}
+
+void TestClient::onError(AbstractConnection::ConnectionError error)
+{
+	Q_UNUSED(error);
+	++errors;
+}
+
+void TestClient::onDisconnected()
+{
+	++disconnects;
+}
+
+void TestClient::onContactItemReceived(const ContactItem &item)
+{
+	Q_UNUSED(item);
+	++contacts;
+}
+
+void TestClient::onContactStatusUpdated(const QString &uin, const StatusItem &status)
+{
+	Q_UNUSED(uin);
+	Q_UNUSED(status);
+	++statusUpdates;
+}
+
+void TestClient::onMessageReceived(const QString &uin, const QString &message, const QDateTime &time,
+								   const Cookie &cookie, quint16 channel)
+{
+	Q_UNUSED(uin);
+	Q_UNUSED(time);
+	Q_UNUSED(cookie);
+	Q_UNUSED(channel);
+	lastMessage = message;
+	++messages;
+}
+
+void TestClient::onMessageAccepted(const Cookie &cookie, const QString &uin, quint16 channel)
+{
+	Q_UNUSED(cookie);
+	Q_UNUSED(uin);
+	Q_UNUSED(channel);
+	++acceptedMessages;
+}
+
+void TestClient::onTypingNotification(const QString &uin, MTN state)
+{
+	Q_UNUSED(uin);
+	lastTypingState = state;
+	++typingNotifications;
+}
+
+void TestClient::onAvatarUpdated(const QString &uin, const BuddyPicture &picture)
+{
+	// As the applications do, there is no avatar cache
+	m_buddyPictureHandler->requestPicture(uin, picture);
+}
+
+void TestClient::onAvatarReceived(const QString &uin, const QByteArray &hash, const QByteArray &avatar)
+{
+	Q_UNUSED(uin);
+	Q_UNUSED(hash);
+	lastAvatar = avatar;
+	++avatars;
+}
+
+} // namespace Ireen
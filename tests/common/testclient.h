@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_TESTCLIENT_H
+#define IREEN_TESTCLIENT_H
+
+#include "client.h"
+#include "roster.h"
+#include "messagehandler.h"
+#include "buddypicture.h"
+#include <QAtomicInt>
+
+class QSignalSpy;
+
+namespace Ireen {
+
+class MockOscarServer;
+
+// An account with the usual set of handlers which counts
+// everything it receives from the server
+class TestClient : public QObject
+{
+	Q_OBJECT
+public:
+	enum Option
+	{
+		NoOptions = 0x00,
+		WithAvatars = 0x01
+	};
+	TestClient(const QString &uin, int options = NoOptions, QObject *parent = 0);
+	virtual ~TestClient();
+	Client *client() const { return m_client; }
+	Feedbag *feedbag() const { return m_feedbag; }
+	Roster *roster() const { return m_roster; }
+	MessageHandler *messageHandler() const { return m_messageHandler; }
+	BuddyPictureHandler *buddyPictureHandler() const { return m_buddyPictureHandler; }
+	void login(MockOscarServer *server, const QString &password = QLatin1String("password"));
+	bool waitForLogin(int timeout = 5000) const;
+	// Processes the events until the counter reaches the value
+	static bool waitFor(const int &counter, int value, int timeout = 5000);
+	static bool waitFor(const QSignalSpy &spy, int count, int timeout = 5000);
+	static bool waitFor(const QAtomicInt &counter, int value, int timeout = 5000);
+
+	int logins;
+	int errors;
+	int disconnects;
+	int contacts;
+	int statusUpdates;
+	int messages;
+	int acceptedMessages;
+	int typingNotifications;
+	int avatars;
+	QString lastMessage;
+	QByteArray lastAvatar;
+	MTN lastTypingState;
+public slots:
+	void onLoginFinished();
+	void onError(Ireen::AbstractConnection::ConnectionError error);
+	void onDisconnected();
+	void onContactItemReceived(const Ireen::ContactItem &item);
+	void onContactStatusUpdated(const QString &uin, const Ireen::StatusItem &status);
+	void onMessageReceived(const QString &uin, const QString &message, const QDateTime &time,
+						   const Ireen::Cookie &cookie, quint16 channel);
+	void onMessageAccepted(const Ireen::Cookie &cookie, const QString &uin, quint16 channel);
+	void onTypingNotification(const QString &uin, Ireen::MTN state);
+	void onAvatarUpdated(const QString &uin, const Ireen::BuddyPicture &picture);
+	void onAvatarReceived(const QString &uin, const QByteArray &hash, const QByteArray &avatar);
+private:
+	Client *m_client;
+	Feedbag *m_feedbag;
+	Roster *m_roster;
+	MessageHandler *m_messageHandler;
+	BuddyPictureHandler *m_buddyPictureHandler;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_TESTCLIENT_H
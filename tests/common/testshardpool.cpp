@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "testshardpool.h"
+#include "mockoscarserver.h"
+#include <QThread>
+
+namespace Ireen {
+
+ShardAccount::ShardAccount(Client *client, TestShardPool *pool) :
+	m_client(client), m_pool(pool)
+{
+	m_feedbag = new Feedbag(m_client);
+	m_roster = new Roster(m_client, m_feedbag);
+	m_messageHandler = new MessageHandler(m_client);
+	connect(m_client, SIGNAL(loginFinished()), SLOT(onLoginFinished()));
+	connect(m_client, SIGNAL(disconnected()), SLOT(onDisconnected()));
+	connect(m_messageHandler, SIGNAL(messageReceived(QString,QString,QDateTime,Ireen::Cookie,quint16)),
+			SLOT(onMessageReceived(QString,QString,QDateTime,Ireen::Cookie,quint16)));
+}
+
+ShardAccount::~ShardAccount()
+{
+	delete m_messageHandler;
+	delete m_roster;
+	delete m_feedbag;
+}
+
+void ShardAccount::onLoginFinished()
+{
+	checkThread();
+	m_pool->logins.ref();
+}
+
+void ShardAccount::onDisconnected()
+{
+	checkThread();
+	m_pool->disconnects.ref();
+}
+
+void ShardAccount::onMessageReceived(const QString &uin, const QString &message, const QDateTime &time,
+									 const Cookie &cookie, quint16 channel)
+{
+	Q_UNUSED(uin);
+	Q_UNUSED(message);
+	Q_UNUSED(time);
+	Q_UNUSED(cookie);
+	Q_UNUSED(channel);
+	checkThread();
+	m_pool->messages.ref();
+}
+
+void ShardAccount::checkThread()
+{
+	if (QThread::currentThread() != m_client->thread())
+		m_pool->foreignThreadEvents.ref();
+}
+
+TestShardPool::TestShardPool(int threadCount, QObject *parent) :
+	ClientShardPool(threadCount, parent)
+{
+}
+
+TestShardPool::~TestShardPool()
+{
+	// cleanupClient() cannot be reached from the destructor of the base class
+	foreach (Client *client, clients())
+		destroyClient(client);
+}
+
+void TestShardPool::login(Client *client, MockOscarServer *server)
+{
+	login(client, server->host(), server->port());
+}
+
+void TestShardPool::login(Client *client, const QString &host, quint16 port)
+{
+	MD5LoginData data(QLatin1String("password"));
+	data.setLoginServer(host, port);
+	login(client, data);
+}
+
+void TestShardPool::initClient(Client *client)
+{
+	ShardAccount *account = new ShardAccount(client, this);
+	QMutexLocker locker(&m_mutex);
+	m_accounts.insert(client, account);
+}
+
+void TestShardPool::cleanupClient(Client *client)
+{
+	QMutexLocker locker(&m_mutex);
+	delete m_accounts.take(client);
+}
+
+} // namespace Ireen
@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_TESTSHARDPOOL_H
+#define IREEN_TESTSHARDPOOL_H
+
+#include "clientshardpool.h"
+#include "client.h"
+#include "roster.h"
+#include "messagehandler.h"
+#include <QAtomicInt>
+#include <QMutex>
+#include <QHash>
+
+namespace Ireen {
+
+class MockOscarServer;
+class TestShardPool;
+
+// The handlers of one client of TestShardPool, lives in the thread of the client
+class ShardAccount : public QObject
+{
+	Q_OBJECT
+public:
+	ShardAccount(Client *client, TestShardPool *pool);
+	virtual ~ShardAccount();
+private slots:
+	void onLoginFinished();
+	void onDisconnected();
+	void onMessageReceived(const QString &uin, const QString &message, const QDateTime &time,
+						   const Ireen::Cookie &cookie, quint16 channel);
+private:
+	void checkThread();
+	Client *m_client;
+	Feedbag *m_feedbag;
+	Roster *m_roster;
+	MessageHandler *m_messageHandler;
+	TestShardPool *m_pool;
+};
+
+// ClientShardPool which attaches the usual set of handlers to its clients
+// and counts what all of them receive from the server
+class TestShardPool : public ClientShardPool
+{
+	Q_OBJECT
+public:
+	TestShardPool(int threadCount = 0, QObject *parent = 0);
+	virtual ~TestShardPool();
+	using ClientShardPool::login;
+	// Queue the login of the client to the server
+	void login(Client *client, MockOscarServer *server);
+	void login(Client *client, const QString &host, quint16 port);
+	QAtomicInt logins;
+	QAtomicInt disconnects;
+	QAtomicInt messages;
+	// The number of the signals which have been emitted outside of the thread of their client
+	QAtomicInt foreignThreadEvents;
+protected:
+	virtual void initClient(Client *client);
+	virtual void cleanupClient(Client *client);
+private:
+	QMutex m_mutex;
+	QHash<Client*, ShardAccount*> m_accounts;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_TESTSHARDPOOL_H
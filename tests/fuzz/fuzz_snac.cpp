@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+// libFuzzer target which feeds SNACs to the connections of an account with
+// all the handlers of the library registered.
+// The first byte of the input selects the connection (the BOSS one, the
+// avatar one or the login one), the rest is the SNAC with its header.
+
+#include "snacreplay.h"
+#include "client.h"
+#include "md5login.h"
+#include "feedbag.h"
+#include "roster.h"
+#include "messagehandler.h"
+#include "buddypicture.h"
+#include "privacylists.h"
+#include "xtrazstatus.h"
+#include "oscarfiletransfer.h"
+#include "metainfo/metainfo.h"
+#include <QCoreApplication>
+#include <stdint.h>
+
+using namespace Ireen;
+
+static void silentMessageHandler(QtMsgType, const char *)
+{
+}
+
+static void init()
+{
+	static int argc = 1;
+	static char name[] = "fuzz_snac";
+	static char *argv[] = { name, 0 };
+	new QCoreApplication(argc, argv);
+	qInstallMsgHandler(silentMessageHandler);
+	setDebugLevel(DebugDisabled);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	static bool initialized = false;
+	if (!initialized) {
+		init();
+		initialized = true;
+	}
+	if (size < 1)
+		return 0;
+
+	// The account is created for every input, so the inputs do not depend
+	// on the state left by the previous ones
+	Client *client = new Client("123456789", 0);
+	Feedbag *feedbag = new Feedbag(client);
+	Roster *roster = new Roster(client, feedbag);
+	MessageHandler *messageHandler = new MessageHandler(client);
+	BuddyPictureHandler *buddyPictureHandler = new BuddyPictureHandler(client, roster);
+	PrivacyLists *privacyLists = new PrivacyLists(feedbag);
+	MetaInfo *metaInfo = new MetaInfo(client);
+	XtrazStatusHandler *xtrazStatusHandler = new XtrazStatusHandler(client, roster, messageHandler);
+	OftManager *oftManager = new OftManager(messageHandler);
+	Md5Login *login = new Md5Login(client, MD5LoginData("password"));
+
+	AbstractConnection *connections[] = { client, buddyPictureHandler, login };
+	AbstractConnection *conn = connections[data[0] % 3];
+	replaySnac(conn, QByteArray(reinterpret_cast<const char*>(data + 1), size - 1));
+	QCoreApplication::sendPostedEvents();
+
+	// The handlers are deleted before the client they are registered in
+	delete login;
+	delete oftManager;
+	delete xtrazStatusHandler;
+	delete metaInfo;
+	delete privacyLists;
+	delete buddyPictureHandler;
+	delete messageHandler;
+	delete roster;
+	delete feedbag;
+	delete client;
+	QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+	return 0;
+}
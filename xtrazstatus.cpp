@@ -0,0 +1,267 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#include "xtrazstatus.h"
+#include "client.h"
+#include "roster.h"
+#include "buddycaps.h"
+#include "requesttracker.h"
+#include <QBasicTimer>
+#include <QQueue>
+#include <QTimerEvent>
+
+namespace Ireen {
+
+enum
+{
+	xtrazRequestInterval = 1000,
+	maxXtrazRequestsInFlight = 4,
+	xtrazRequestTimeout = 30000
+};
+
+struct XtrazStatusEntry
+{
+	XtrazStatusEntry() : fingerprint(0), valid(false), supportsXtraz(false) {}
+	XtrazResponse response;
+	uint fingerprint;
+	bool valid;
+	bool supportsXtraz;
+};
+
+class XtrazStatusHandlerPrivate
+{
+public:
+	void enqueue(const QString &uin);
+	void cancel(const QString &uin);
+	void sendNextRequest();
+	void onRequestResolved(const PendingRequest &request);
+	static uint statusFingerprint(const StatusItem &status);
+	Client *client;
+	bool autoRequest;
+	QHash<QString, XtrazStatusEntry> entries;
+	QQueue<QString> queue;
+	QSet<QString> queued;
+	QHash<quint64, QString> inFlight;
+	QBasicTimer timer;
+};
+
+void XtrazStatusHandlerPrivate::enqueue(const QString &uin)
+{
+	if (queued.contains(uin))
+		return;
+	foreach (const QString &requested, inFlight) {
+		if (requested == uin)
+			return;
+	}
+	queue.enqueue(uin);
+	queued.insert(uin);
+}
+
+void XtrazStatusHandlerPrivate::cancel(const QString &uin)
+{
+	if (queued.remove(uin))
+		queue.removeOne(uin);
+	QMutableHashIterator<quint64, QString> itr(inFlight);
+	while (itr.hasNext()) {
+		// The reply will be ignored
+		if (itr.next().value() == uin)
+			itr.remove();
+	}
+}
+
+void XtrazStatusHandlerPrivate::sendNextRequest()
+{
+	if (queue.isEmpty() || !client->isConnected()) {
+		timer.stop();
+		return;
+	}
+	if (inFlight.size() >= maxXtrazRequestsInFlight)
+		return;
+	// Leave the rest of the rate window for the messages of the user
+	if (!client->testRate(MessageFamily, MessageSrvSend, false))
+		return;
+	QString uin = queue.dequeue();
+	queued.remove(uin);
+
+	XtrazRequest request("cAwaySrv", "srvMng");
+	request.setValue("id", "AwayStat");
+	request.setValue("trans", "1");
+	request.setValue("senderId", client->uin());
+	SNAC snac = request.snac(uin);
+	Cookie cookie = snac.cookie();
+	cookie.setClient(client);
+	// The cookie is locked with its own continuation instead of by the snac
+	snac.setCookie(Cookie());
+	cookie.lock(continuation(this, &XtrazStatusHandlerPrivate::onRequestResolved), xtrazRequestTimeout);
+	inFlight.insert(cookie.id(), uin);
+	debug(MessagesDebug, DebugVerbose) << "Requesting xtraz status of" << uin;
+	client->send(snac, false);
+}
+
+void XtrazStatusHandlerPrivate::onRequestResolved(const PendingRequest &request)
+{
+	if (request.status() != PendingRequest::TimedOut)
+		return;
+	QString uin = inFlight.take(request.id());
+	if (!uin.isNull())
+		debug(MessagesDebug) << "Xtraz status request to" << uin << "has timed out";
+}
+
+uint XtrazStatusHandlerPrivate::statusFingerprint(const StatusItem &status)
+{
+	DataUnit data;
+	data.append<quint16>(status.statusId());
+	foreach (const Capability &capability, status.capabilities())
+		data.append(capability.data());
+	// Status note and mood
+	SessionDataItemMap statusData = status.statusData();
+	data.append(statusData.value(0x02).data());
+	data.append(statusData.value(0x0e).data());
+	return qHash(data.data());
+}
+
+XtrazStatusHandler::XtrazStatusHandler(Client *client, Roster *roster, MessageHandler *messageHandler) :
+	d(new XtrazStatusHandlerPrivate)
+{
+	d->client = client;
+	d->autoRequest = true;
+	messageHandler->registerHandler(MSG_XSTRAZ_SCRIPT, xtrazNotify, this);
+	connect(roster, SIGNAL(contactStatusUpdated(QString,Ireen::StatusItem)),
+			this, SLOT(onStatusChanged(QString,Ireen::StatusItem)));
+	connect(client, SIGNAL(loginFinished()), SLOT(onLoginFinished()));
+	connect(client, SIGNAL(disconnected()), SLOT(onDisconnected()));
+}
+
+XtrazStatusHandler::~XtrazStatusHandler()
+{
+}
+
+XtrazResponse XtrazStatusHandler::status(const QString &uin) const
+{
+	XtrazStatusEntry entry = d->entries.value(uin);
+	return entry.valid ? entry.response : XtrazResponse();
+}
+
+bool XtrazStatusHandler::containsStatus(const QString &uin) const
+{
+	return d->entries.value(uin).valid;
+}
+
+void XtrazStatusHandler::requestStatus(const QString &uin, bool force)
+{
+	XtrazStatusEntry &entry = d->entries[uin];
+	if (entry.valid && !force)
+		return;
+	d->enqueue(uin);
+	if (!d->timer.isActive() && d->client->isConnected())
+		d->timer.start(xtrazRequestInterval, this);
+}
+
+void XtrazStatusHandler::setAutoRequest(bool enable)
+{
+	d->autoRequest = enable;
+}
+
+bool XtrazStatusHandler::autoRequest() const
+{
+	return d->autoRequest;
+}
+
+void XtrazStatusHandler::processTlvs2711(const QString &uin, Capability guid, quint16 type,
+										 const DataUnit &data, const Cookie &cookie)
+{
+	Q_UNUSED(guid);
+	Q_UNUSED(type);
+	// Ignore the requests from contacts and the replies to requests
+	// which were not sent by us
+	if (d->inFlight.take(cookie.id()).isNull())
+		return;
+	// Stops the timeout of the request
+	Cookie(d->client, cookie.id()).unlock();
+	// The data could be already read by other plugins
+	DataUnit body(data.data());
+	Xtraz xtraz(body.read<QByteArray, quint32>(LittleEndian));
+	if (xtraz.type() != Xtraz::Response) {
+		debug(MessagesDebug) << "Incorrect reply to the xtraz status request from" << uin;
+		return;
+	}
+	XtrazStatusEntry &entry = d->entries[uin];
+	entry.response = xtraz.response();
+	entry.valid = true;
+	debug(MessagesDebug, DebugVerbose) << "Xtraz status of" << uin << "has been received";
+	emit statusReceived(uin, entry.response);
+}
+
+void XtrazStatusHandler::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == d->timer.timerId())
+		d->sendNextRequest();
+	else
+		QObject::timerEvent(event);
+}
+
+void XtrazStatusHandler::onStatusChanged(const QString &uin, const StatusItem &status)
+{
+	if (status.statusId() == Status::Offline) {
+		d->cancel(uin);
+		if (d->entries.take(uin).valid)
+			emit statusInvalidated(uin);
+		return;
+	}
+	bool supportsXtraz = status.capabilities().match(ICQ_CAPABILITY_XTRAZ);
+	uint fingerprint = XtrazStatusHandlerPrivate::statusFingerprint(status);
+	XtrazStatusEntry &entry = d->entries[uin];
+	if (entry.fingerprint == fingerprint && entry.supportsXtraz == supportsXtraz)
+		return;
+	entry.fingerprint = fingerprint;
+	entry.supportsXtraz = supportsXtraz;
+	if (entry.valid) {
+		entry.valid = false;
+		entry.response = XtrazResponse();
+		emit statusInvalidated(uin);
+	}
+	if (!supportsXtraz)
+		d->cancel(uin);
+	else if (d->autoRequest)
+		requestStatus(uin);
+}
+
+void XtrazStatusHandler::onLoginFinished()
+{
+	if (!d->queue.isEmpty())
+		d->timer.start(xtrazRequestInterval, this);
+}
+
+void XtrazStatusHandler::onDisconnected()
+{
+	// Statuses of all contacts will be received again after login
+	d->entries.clear();
+	d->queue.clear();
+	d->queued.clear();
+	d->inFlight.clear();
+	d->timer.stop();
+}
+
+} // namespace Ireen
@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Ireen — cross-platform OSCAR protocol library
+**
+** Copyright © 2012 Alexey Prokhin <alexey.prokhin@yandex.ru>
+**
+*****************************************************************************
+**
+** $IREEN_BEGIN_LICENSE$
+** This program is free software: you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as
+** published by the Free Software Foundation, either version 3
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+** See the GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program.  If not, see http://www.gnu.org/licenses/.
+** $IREEN_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IREEN_XTRAZSTATUS_H
+#define IREEN_XTRAZSTATUS_H
+
+#include "messagehandler.h"
+#include "core/xtraz.h"
+
+namespace Ireen {
+
+class Client;
+class Roster;
+class StatusItem;
+class XtrazStatusHandlerPrivate;
+
+// Keeps the last xtraz status of every contact. The status is requested
+// again only when the contact changes its status or capabilities, and the
+// requests are spread over time to stay within the message rate limits.
+class IREEN_EXPORT XtrazStatusHandler : public QObject, public Tlv2711Plugin
+{
+	Q_OBJECT
+	Q_INTERFACES(Ireen::Tlv2711Plugin)
+public:
+	XtrazStatusHandler(Client *client, Roster *roster, MessageHandler *messageHandler);
+	virtual ~XtrazStatusHandler();
+	// Returns the cached status of the contact without any requests
+	XtrazResponse status(const QString &uin) const;
+	bool containsStatus(const QString &uin) const;
+	// Queues the status request, unless the cached status is still valid
+	void requestStatus(const QString &uin, bool force = false);
+	// If enabled, the statuses of contacts supporting xtraz are requested
+	// every time they become outdated. Enabled by default.
+	void setAutoRequest(bool enable);
+	bool autoRequest() const;
+signals:
+	void statusReceived(const QString &uin, const Ireen::XtrazResponse &response);
+	void statusInvalidated(const QString &uin);
+protected:
+	void processTlvs2711(const QString &uin, Capability guid, quint16 type,
+						 const DataUnit &data, const Cookie &cookie);
+	void timerEvent(QTimerEvent *event);
+private slots:
+	void onStatusChanged(const QString &uin, const Ireen::StatusItem &status);
+	void onLoginFinished();
+	void onDisconnected();
+private:
+	QScopedPointer<XtrazStatusHandlerPrivate> d;
+};
+
+} // namespace Ireen
+
+#endif // IREEN_XTRAZSTATUS_H